@@ -202,6 +202,31 @@ imcc_preprocess_file_api(Parrot_PMC interp_pmc, Parrot_PMC compiler,
     IMCC_API_CALLOUT(interp_pmc, interp)
 }
 
+/*
+
+=item C<Parrot_Int imcc_set_optimization_api(Parrot_PMC interp_pmc, Parrot_PMC
+compiler, Parrot_String opts)>
+
+Set the optimization flags (as given to C<-O>) of the given IMCCompiler PMC.
+
+=cut
+
+*/
+
+PARROT_EXPORT
+PARROT_WARN_UNUSED_RESULT
+Parrot_Int
+imcc_set_optimization_api(Parrot_PMC interp_pmc, Parrot_PMC compiler,
+        Parrot_String opts)
+{
+    ASSERT_ARGS(imcc_set_optimization_api)
+    IMCC_API_CALLIN(interp_pmc, interp)
+    STRING * const meth_name = Parrot_str_new(interp, "set_optimization", 0);
+    Parrot_pcc_invoke_method_from_c_args(interp, compiler, meth_name,
+            "S->", opts);
+    IMCC_API_CALLOUT(interp_pmc, interp)
+}
+
 /*
  * Local variables:
  *   c-file-style: "parrot"
@@ -281,7 +281,7 @@ find_basic_blocks(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit), int first)
 
     ins = unit->instructions;
 
-    if (unit->type & IMC_PCCSUB) {
+    if ((unit->type & IMC_PCCSUB) && first) {
         IMCC_debug(imcc, DEBUG_CFG, "pcc_sub %s nparams %d\n",
                 ins->symregs[0]->name, ins->symregs[0]->pcc_sub->nargs);
         expand_pcc_sub(imcc, unit, ins);
@@ -1112,6 +1112,38 @@ natural_preheader(ARGIN(const IMC_Unit *unit), ARGIN(const Loop_info *loop_info)
 }
 
 
+/*
+
+=item C<int has_computed_jumps(const IMC_Unit *unit)>
+
+Returns true if the unit jumps to an address held in a register (C<set_addr>
+and C<jump>, as in the backtracking of regexes) or uses C<local_branch>. The
+CFG has no edges for these jumps, so its life info and dominators don't hold.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+PARROT_PURE_FUNCTION
+int
+has_computed_jumps(ARGIN(const IMC_Unit *unit))
+{
+    ASSERT_ARGS(has_computed_jumps)
+    const Instruction *ins;
+
+    for (ins = unit->instructions; ins; ins = ins->next) {
+        if (STREQ(ins->opname, "set_addr")
+        ||  STREQ(ins->opname, "jump")
+        ||  STREQ(ins->opname, "local_branch")
+        ||  STREQ(ins->opname, "local_return"))
+            return 1;
+    }
+
+    return 0;
+}
+
+
 /*
 
 =item C<static void mark_loop(imc_info_t *imcc, IMC_Unit *unit, const Edge *e)>
@@ -14,6 +14,10 @@ Routines for handling imc_units, which represent subs.
 
 Moved all register allocation and spill code to reg_alloc.c
 
+With C<-Oj>, the register allocation of the units of a file is deferred until
+the file is parsed, and then runs on several threads, see
+imc_compile_deferred_units().
+
 =head2 Functions
 
 =over 4
@@ -26,11 +30,40 @@ Moved all register allocation and spill code to reg_alloc.c
 #include "imc.h"
 #include "optimizer.h"
 
+#if defined(PARROT_HAS_THREADS) && defined(PARROT_HAS_HEADER_PTHREAD)
+#  include <pthread.h>
+#  include <signal.h>
+#  define IMC_THREADS 1
+#endif
+
+/* The units imc_compile_deferred_units() hands out to its workers */
+typedef struct imc_jobs_t {
+    imc_info_t      *imcc;
+    IMC_Unit       **units;
+    unsigned int     n_units;
+    unsigned int     next;
+#ifdef IMC_THREADS
+    pthread_mutex_t  lock;
+#endif
+} imc_jobs_t;
+
 /* HEADERIZER HFILE: compilers/imcc/imc.h */
 
 /* HEADERIZER BEGIN: static */
 /* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
 
+static void imc_compile_deferred_units(ARGMOD(imc_info_t * imcc))
+        __attribute__nonnull__(1)
+        FUNC_MODIFIES(* imcc);
+
+static void imc_defer_unit(
+    ARGMOD(imc_info_t * imcc),
+    ARGMOD(IMC_Unit *unit))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(* imcc)
+        FUNC_MODIFIES(*unit);
+
 static void imc_free_unit(ARGMOD(imc_info_t * imcc), ARGMOD(IMC_Unit *unit))
         __attribute__nonnull__(1)
         __attribute__nonnull__(2)
@@ -43,11 +76,23 @@ static IMC_Unit * imc_new_unit(ARGMOD(imc_info_t * imcc), IMC_Unit_Type t)
         __attribute__nonnull__(1)
         FUNC_MODIFIES(* imcc);
 
+PARROT_CAN_RETURN_NULL
+static void * imc_reg_alloc_worker(ARGMOD(void *arg))
+        __attribute__nonnull__(1)
+        FUNC_MODIFIES(*arg);
+
+#define ASSERT_ARGS_imc_compile_deferred_units __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc))
+#define ASSERT_ARGS_imc_defer_unit __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit))
 #define ASSERT_ARGS_imc_free_unit __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc) \
     , PARROT_ASSERT_ARG(unit))
 #define ASSERT_ARGS_imc_new_unit __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc))
+#define ASSERT_ARGS_imc_reg_alloc_worker __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(arg))
 /* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
 /* HEADERIZER END: static */
 
@@ -79,6 +124,7 @@ imc_compile_all_units(ARGMOD(imc_info_t * imcc))
     }
 #endif
 
+    imc_compile_deferred_units(imcc);
     emit_close(imcc, NULL);
 
     /* All done with compilation, now free all memory allocated
@@ -230,14 +276,194 @@ imc_close_unit(ARGMOD(imc_info_t * imcc), ARGIN_NULLOK(IMC_Unit *unit))
 {
     ASSERT_ARGS(imc_close_unit)
 #if COMPILE_IMMEDIATE
-    if (unit)
-        imc_compile_unit(imcc, unit);
+    if (unit) {
+        if (imcc->compile_jobs > 1 && !imcc->debug && !imcc->verbose)
+            imc_defer_unit(imcc, unit);
+        else
+            imc_compile_unit(imcc, unit);
+    }
+#endif
+
+    imcc->cur_unit = NULL;
+}
+
+
+/*
+
+=item C<static void imc_defer_unit(imc_info_t * imcc, IMC_Unit *unit)>
+
+Runs the steps of the compilation of C<unit> which need the parser state, and
+leaves its register allocation and code generation to
+imc_compile_deferred_units(). An C<:immediate> sub is run when it is emitted,
+and the code after it may depend on that, so it is compiled right away
+together with all units deferred before.
+
+=cut
+
+*/
+
+static void
+imc_defer_unit(ARGMOD(imc_info_t * imcc), ARGMOD(IMC_Unit *unit))
+{
+    ASSERT_ARGS(imc_defer_unit)
+    const Instruction * const ins = unit->instructions;
+
+    imcc->cur_unit = unit;
+    unit->deferred = 1;
+
+    if (!ins)
+        return;
+
+    imc_reg_alloc_prepare(imcc, unit);
+
+    if (ins->symregs[0] && ins->symregs[0]->pcc_sub
+    && (ins->symregs[0]->pcc_sub->pragma & P_IMMEDIATE))
+        imc_compile_deferred_units(imcc);
+}
+
+
+/*
+
+=item C<static void imc_compile_deferred_units(imc_info_t * imcc)>
+
+Allocates the registers of all units left by imc_defer_unit() on up to
+C<compile_jobs> threads, the calling one included, and then finishes and
+emits them one by one in their original order. The constants and fixups of
+all units are thus still created serially.
+
+=cut
+
+*/
+
+static void
+imc_compile_deferred_units(ARGMOD(imc_info_t * imcc))
+{
+    ASSERT_ARGS(imc_compile_deferred_units)
+    imc_jobs_t   jobs;
+    IMC_Unit    *unit;
+    unsigned int n_units = 0;
+
+    for (unit = imcc->imc_units; unit; unit = unit->next)
+        if (unit->deferred)
+            n_units++;
+
+    if (!n_units)
+        return;
+
+    jobs.imcc    = imcc;
+    jobs.units   = mem_gc_allocate_n_typed(imcc->interp, n_units, IMC_Unit *);
+    jobs.n_units = 0;
+    jobs.next    = 0;
+
+    for (unit = imcc->imc_units; unit; unit = unit->next)
+        if (unit->deferred && unit->instructions)
+            jobs.units[jobs.n_units++] = unit;
+
+#ifdef IMC_THREADS
+    pthread_mutex_init(&jobs.lock, NULL);
+
+    if (jobs.n_units > 1) {
+        const unsigned int n_threads = (unsigned int)imcc->compile_jobs < jobs.n_units
+                                     ? (unsigned int)imcc->compile_jobs - 1
+                                     : jobs.n_units - 1;
+        pthread_t * const  threads   = mem_gc_allocate_n_typed(imcc->interp,
+                                            n_threads + 1, pthread_t);
+        unsigned int       started;
+        sigset_t           all, old;
+
+        /* signals like SIGALRM must go to the interpreter's thread */
+        sigfillset(&all);
+        pthread_sigmask(SIG_BLOCK, &all, &old);
+
+        for (started = 0; started < n_threads; started++)
+            if (pthread_create(&threads[started], NULL, imc_reg_alloc_worker, &jobs))
+                break;
+
+        pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+        imc_reg_alloc_worker(&jobs);
+
+        while (started)
+            pthread_join(threads[--started], NULL);
+
+        mem_sys_free(threads);
+    }
+    else
+        imc_reg_alloc_worker(&jobs);
+
+    pthread_mutex_destroy(&jobs.lock);
+#else
+    imc_reg_alloc_worker(&jobs);
 #endif
 
+    mem_sys_free(jobs.units);
+
+    for (unit = imcc->imc_units; unit; unit = unit->next) {
+        if (!unit->deferred)
+            continue;
+
+        imcc->cur_unit = unit;
+        unit->deferred = 0;
+
+        if (unit->instructions)
+            imc_reg_alloc_finish(imcc, unit);
+
+        emit_flush(imcc, NULL, unit);
+    }
+
     imcc->cur_unit = NULL;
 }
 
 
+/*
+
+=item C<static void * imc_reg_alloc_worker(void *arg)>
+
+Takes units from the C<imc_jobs_t> C<arg> and allocates their registers until
+none is left. Each worker uses its own copy of the compiler state, as the
+allocation reads the current unit and the optimizer flags from it.
+
+=cut
+
+*/
+
+PARROT_CAN_RETURN_NULL
+static void *
+imc_reg_alloc_worker(ARGMOD(void *arg))
+{
+    ASSERT_ARGS(imc_reg_alloc_worker)
+    imc_jobs_t * const jobs = (imc_jobs_t *)arg;
+    imc_info_t * const imcc = mem_gc_allocate_typed(jobs->imcc->interp, imc_info_t);
+
+    *imcc = *jobs->imcc;
+
+    for (;;) {
+        IMC_Unit *unit = NULL;
+
+#ifdef IMC_THREADS
+        pthread_mutex_lock(&jobs->lock);
+#endif
+        if (jobs->next < jobs->n_units)
+            unit = jobs->units[jobs->next++];
+#ifdef IMC_THREADS
+        pthread_mutex_unlock(&jobs->lock);
+#endif
+
+        if (!unit)
+            break;
+
+        imcc->cur_unit        = unit;
+        imcc->optimizer_level = unit->optimizer_level;
+        imcc->dont_optimize   = unit->dont_optimize;
+
+        imc_reg_alloc_registers(imcc, unit);
+    }
+
+    mem_sys_free(imcc);
+    return NULL;
+}
+
+
 /*
 
 =item C<static void imc_free_unit(imc_info_t * imcc, IMC_Unit *unit)>
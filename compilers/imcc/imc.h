@@ -162,10 +162,41 @@ void imc_reg_alloc(ARGMOD(imc_info_t * imcc), ARGIN_NULLOK(IMC_Unit *unit))
         __attribute__nonnull__(1)
         FUNC_MODIFIES(* imcc);
 
+void imc_reg_alloc_finish(ARGMOD(imc_info_t * imcc), ARGMOD(IMC_Unit *unit))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(* imcc)
+        FUNC_MODIFIES(*unit);
+
+void imc_reg_alloc_prepare(
+    ARGMOD(imc_info_t * imcc),
+    ARGMOD(IMC_Unit *unit))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(* imcc)
+        FUNC_MODIFIES(*unit);
+
+void imc_reg_alloc_registers(
+    ARGMOD(imc_info_t * imcc),
+    ARGMOD(IMC_Unit *unit))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(* imcc)
+        FUNC_MODIFIES(*unit);
+
 #define ASSERT_ARGS_free_reglist __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(unit))
 #define ASSERT_ARGS_imc_reg_alloc __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc))
+#define ASSERT_ARGS_imc_reg_alloc_finish __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit))
+#define ASSERT_ARGS_imc_reg_alloc_prepare __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit))
+#define ASSERT_ARGS_imc_reg_alloc_registers __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit))
 /* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
 /* HEADERIZER END: compilers/imcc/reg_alloc.c */
 
@@ -388,10 +419,18 @@ typedef enum _enum_opt {
     OPT_PRE,
     OPT_CFG  = 0x002,
     OPT_SUB  = 0x004,
+    OPT_LEX  = 0x008,
+    OPT_UNBOX = 0x010,
+    OPT_REGS = 0x020,
+    OPT_GVN  = 0x040,
+    OPT_ESCAPE = 0x080,
     OPT_PASM = 0x100,
     OPT_J    = 0x200
 } enum_opt_t;
 
+/* the passes of optimize(), which need the life info */
+#define OPT_LIFE (OPT_CFG | OPT_GVN | OPT_UNBOX | OPT_ESCAPE)
+
 struct nodeType_t;
 
 /* see also imcc/imcc.l struct macro_frame_t */
@@ -421,6 +460,7 @@ typedef struct subs_t {
     struct subs_t *prev;
     struct subs_t *next;
     SymHash        fixup;              /* currently set_p_pc sub names only */
+    char          *label_key;          /* namespace and label, see index_sub */
     int            ins_line;           /* line number for debug */
     int            n_basic_blocks;     /* block count */
     int            pmc_const;          /* sub pmc index in const table */
@@ -437,6 +477,10 @@ typedef struct code_segment_t {
     struct code_segment_t *prev;          /* previous code segment */
     struct code_segment_t *next;          /* next code segment */
     SymHash                key_consts;    /* this seg's cached key constants */
+    Hash                  *labels;        /* first sub per namespace and label */
+    Hash                  *subids;        /* first sub per subid */
+    size_t                 code_size;     /* size of all subs so far in ops */
+    int                    ins_lines;     /* debug lines of all subs so far */
 } code_segment_t;
 
 typedef struct _imcc_globals_t {
@@ -473,6 +517,7 @@ struct _imc_info_t {
 
     char                 *macro_buffer;
     Hash                 *macros;
+    PMC                  *included_files;  /* see imcc_set_included_files */
     PackFile_Debug       *debug_seg;
     opcode_t             *pc;
 
@@ -503,6 +548,7 @@ struct _imc_info_t {
     int                   verbose;
     int                   seen_main;
     int                   unique_count;      /* A compile-time unique value */
+    int                   compile_jobs;      /* threads allocating registers */
     opcode_t              npc;
 };
 
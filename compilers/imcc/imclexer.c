@@ -4942,6 +4942,9 @@ include_file(ARGMOD(imc_info_t *imcc), ARGIN(STRING *file_name), void *yyscanner
             "No such file or directory '%Ss'", file_name);
     }
 
+    if (imcc->included_files)
+        VTABLE_push_string(imcc->interp, imcc->included_files, s);
+
     frame->s.file   = file_name;
     frame->s.handle = file;
 
@@ -48,6 +48,10 @@ PIOHANDLE determine_input_file_type(imc_info_t * imcc, STRING *sourcefile);
 /* HEADERIZER BEGIN: static */
 /* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
 
+PARROT_WARN_UNUSED_RESULT
+static int compile_jobs(ARGIN(const char *count))
+        __attribute__nonnull__(1);
+
 static void do_pre_process(
     ARGMOD(imc_info_t *imcc),
     ARGIN(STRING * sourcefile),
@@ -56,6 +60,11 @@ static void do_pre_process(
         __attribute__nonnull__(2)
         FUNC_MODIFIES(*imcc);
 
+PARROT_PURE_FUNCTION
+PARROT_WARN_UNUSED_RESULT
+static int has_level(ARGIN(const char *opts), char level)
+        __attribute__nonnull__(1);
+
 static void imcc_destroy_macro_values(ARGMOD(void *value))
         __attribute__nonnull__(1)
         FUNC_MODIFIES(*value);
@@ -91,9 +100,13 @@ static struct _imc_info_t* prepare_reentrant_compile(
     ARGIN(imc_info_t *imcc))
         __attribute__nonnull__(1);
 
+#define ASSERT_ARGS_compile_jobs __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(count))
 #define ASSERT_ARGS_do_pre_process __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc) \
     , PARROT_ASSERT_ARG(sourcefile))
+#define ASSERT_ARGS_has_level __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(opts))
 #define ASSERT_ARGS_imcc_destroy_macro_values __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(value))
 #define ASSERT_ARGS_imcc_get_scanner __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
@@ -150,9 +163,11 @@ imcc_reset(ARGMOD(imc_info_t *imcc))
     ASSERT_ARGS(imcc_reset)
     Interp * interp = imcc->interp;
     Hash * macros = imcc->macros;
+    PMC * included_files = imcc->included_files;
     memset(imcc, 0, sizeof (imc_info_t));
     imcc->interp = interp;
     imcc->macros = macros;
+    imcc->included_files = included_files;
 }
 
 /*
@@ -253,16 +268,125 @@ imcc_set_optimization_level(ARGMOD(imc_info_t *imcc), ARGIN(const char *opts))
         imcc->optimizer_level |= OPT_PASM;
     if (strchr(opts, 'c'))
         imcc->optimizer_level |= OPT_SUB;
+    if (strchr(opts, 'l'))
+        imcc->optimizer_level |= OPT_LEX;
+    if (strchr(opts, 'u'))
+        imcc->optimizer_level |= OPT_UNBOX;
+    if (strchr(opts, 'r'))
+        imcc->optimizer_level |= OPT_REGS;
+    if (strchr(opts, 'g'))
+        imcc->optimizer_level |= OPT_GVN;
+    if (strchr(opts, 'e'))
+        imcc->optimizer_level |= OPT_ESCAPE;
+    if (strchr(opts, 'j'))
+        imcc->compile_jobs = compile_jobs(strchr(opts, 'j') + 1);
 
     /* OLD DEFAULT: 1 */
 
     /* currently not ok due to different register allocation */
-    if (strchr(opts, '1')) {
+    if (has_level(opts, '1')) {
         imcc->optimizer_level |= OPT_PRE;
     }
-    if (strchr(opts, '2')) {
-        imcc->optimizer_level |= (OPT_PRE | OPT_CFG);
+    if (has_level(opts, '2')) {
+        imcc->optimizer_level |= (OPT_PRE | OPT_CFG | OPT_REGS);
+    }
+}
+
+/*
+
+=item C<INTVAL imcc_get_optimization_level(const imc_info_t *imcc)>
+
+Returns the C<OPT_*> flags set by C<imcc_set_optimization_level>, which
+change the bytecode IMCC emits.
+
+=cut
+
+*/
+
+PARROT_EXPORT
+PARROT_PURE_FUNCTION
+INTVAL
+imcc_get_optimization_level(ARGIN(const imc_info_t *imcc))
+{
+    ASSERT_ARGS(imcc_get_optimization_level)
+    return imcc->optimizer_level;
+}
+
+/*
+
+=item C<void imcc_set_included_files(imc_info_t *imcc, PMC *files)>
+
+Has IMCC push the name of every file it C<.include>s onto the string array
+C<files>, until this is called again with C<PMCNULL>. C<imcc_reset> keeps
+the array, so it sees a whole compilation.
+
+=cut
+
+*/
+
+PARROT_EXPORT
+void
+imcc_set_included_files(ARGMOD(imc_info_t *imcc), ARGIN(PMC *files))
+{
+    ASSERT_ARGS(imcc_set_included_files)
+    imcc->included_files = PMC_IS_NULL(files) ? NULL : files;
+}
+
+/*
+
+=item C<static int has_level(const char *opts, char level)>
+
+Returns true if the optimization flags C<opts> contain the digit C<level>,
+skipping the thread count which may follow the C<j> flag.
+
+=cut
+
+*/
+
+PARROT_PURE_FUNCTION
+PARROT_WARN_UNUSED_RESULT
+static int
+has_level(ARGIN(const char *opts), char level)
+{
+    ASSERT_ARGS(has_level)
+
+    for (; *opts; opts++) {
+        if (*opts == level)
+            return 1;
+
+        if (*opts == 'j')
+            while (isdigit((unsigned char)opts[1]))
+                opts++;
     }
+
+    return 0;
+}
+
+/*
+
+=item C<static int compile_jobs(const char *count)>
+
+Returns the number of threads the C<j> flag asks for: the C<count> following
+it, or one per online processor.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+static int
+compile_jobs(ARGIN(const char *count))
+{
+    ASSERT_ARGS(compile_jobs)
+
+    if (isdigit((unsigned char)*count))
+        return atoi(count);
+
+#ifdef _SC_NPROCESSORS_ONLN
+    return (int)sysconf(_SC_NPROCESSORS_ONLN);
+#else
+    return 1;
+#endif
 }
 
 /*
@@ -53,13 +53,28 @@ used_once ... deletes assignments, when LHS is unused
 
 constant_propagation
 
-post_optimizer: currently pcc_optimize in pcc.c
+unbox_numerics ... keeps PMC registers holding only plain Integer or Float
+values in I or N registers
+
+reuse_temporaries ... turns new into renew where the PMC the register held
+before is known to be garbage
+
+value_numbering ... deletes ops computing a value already computed by a
+dominating op
+
+loop_invariants ... moves loop invariant ops into the preheader of the loop
+
+post_optimizer: currently pcc_optimize in pcc.c and post_optimize
 ---------------
 
 runs after register allocation
 
 e.g. eliminate new Px .PerlUndef because Px where different before
 
+lexical_slots ... rewrite find_lex/store_lex with a constant name into
+find_lex_slot/store_lex_slot (depth, register) addressing, or into a plain
+set for the unit's own lexicals
+
 =head2 Functions
 
 =over 4
@@ -73,13 +88,96 @@ e.g. eliminate new Px .PerlUndef because Px where different before
 #include "pbc.h"
 #include "optimizer.h"
 #include "pmc/pmc_callcontext.h"
+#include "pmc/pmc_sub.h"
 #include "parrot/oplib/core_ops.h"
 
+/* Value kinds inferred by unbox_numerics(). A register's kind only moves
+ * from UB_UNKNOWN to UB_INT or UB_NUM, and from there to UB_BAD. */
+enum {
+    UB_UNKNOWN,
+    UB_INT,
+    UB_NUM,
+    UB_BAD
+};
+
+/* How an instruction uses its PMC registers, see unbox_use() */
+typedef enum {
+    UB_OTHER,       /* anything else: an escape, or a change that has no native form */
+    UB_NEW,         /* new Px, 'Integer' or new Px, 'Float' */
+    UB_BOX,         /* box Px, Ix|Nx */
+    UB_SET,         /* set Px, Ix|Nx */
+    UB_GET,         /* set Ix|Nx, Px */
+    UB_INPLACE,     /* add|sub|mul Px, Py|Ix|Nx */
+    UB_INCDEC,      /* inc|dec Px */
+    UB_ARITH,       /* add|sub|mul Px, Py, Pz|Ix|Nx */
+    UB_BRANCH,      /* eq|ne|lt|le|gt|ge Px, Py|Ix|Nx, label */
+    UB_TEST,        /* iseq|isne|islt|isle|isgt|isge|cmp Ix, Px, Py|Ix|Nx */
+    UB_IF           /* if|unless Px, label */
+} unbox_use_t;
+
+typedef struct unbox_reg_t {
+    const SymReg *reg;      /* the PMC register */
+    SymReg       *native;   /* the I or N register replacing it */
+    int           kind;
+    int           has_def;  /* set to a new PMC by new, box or PMC arithmetic */
+    int           has_use;  /* used by an op with a native form */
+} unbox_reg_t;
+
+typedef struct unbox_info_t {
+    unbox_reg_t  *regs;     /* candidates, sorted by register address */
+    unsigned int  n_regs;
+} unbox_info_t;
+
+/* A PMC register considered by reuse_temporaries() */
+typedef struct reuse_reg_t {
+    const SymReg *reg;
+    int           escapes;  /* used by an op reuse_safe() doesn't accept */
+} reuse_reg_t;
+
+/* How value_numbering() and loop_invariants() may treat an op, see gvn_kind() */
+typedef enum {
+    GVN_NONE,       /* not a candidate */
+    GVN_PURE,       /* native op, which can't throw */
+    GVN_THROWS,     /* native op, which may throw, e.g. div or substr */
+    GVN_GLOBAL,     /* get_*global or get_*namespace of a constant name */
+    GVN_LEX,        /* find_lex of a constant name, which isn't a lexical of the unit */
+    GVN_ATTR        /* getattribute of a constant name */
+} gvn_kind_t;
+
+/* Ops changing the result of a lookup, see gvn_kills() */
+enum {
+    GVN_KILL_GLOBAL = 1 << 0,
+    GVN_KILL_LEX    = 1 << 1,
+    GVN_KILL_ATTR   = 1 << 2
+};
+
+typedef struct gvn_def_t {
+    const SymReg *reg;          /* a register written by exactly one instruction */
+    Instruction  *def;          /* that instruction */
+    int           dominates;    /* def dominates every read of the register */
+    int           keyed;        /* the register is part of a key */
+} gvn_def_t;
+
+typedef struct gvn_info_t {
+    gvn_def_t     *defs;        /* sorted by register address */
+    unsigned int   n_defs;
+    const SymReg **ns_regs;     /* registers set by get_*namespace */
+    unsigned int   n_ns_regs;
+} gvn_info_t;
+
 /* HEADERIZER HFILE: compilers/imcc/optimizer.h */
 
 /* HEADERIZER BEGIN: static */
 /* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
 
+PARROT_WARN_UNUSED_RESULT
+static int always_executed(
+    ARGIN(const IMC_Unit *unit),
+    ARGIN(const Loop_info *loop),
+    int bb)
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
 static int branch_branch(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit))
         __attribute__nonnull__(1)
         __attribute__nonnull__(2)
@@ -146,18 +244,245 @@ static int eval_ins(
         __attribute__nonnull__(4)
         FUNC_MODIFIES(*imcc);
 
+PARROT_WARN_UNUSED_RESULT
+PARROT_CAN_RETURN_NULL
+static SymReg * find_lexical_slot(
+    ARGMOD(imc_info_t *imcc),
+    ARGIN(IMC_Unit *unit),
+    ARGIN(SymReg *name),
+    int set,
+    ARGOUT(INTVAL *depth),
+    ARGOUT(INTVAL *regno))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        __attribute__nonnull__(5)
+        __attribute__nonnull__(6)
+        FUNC_MODIFIES(*imcc)
+        FUNC_MODIFIES(*depth)
+        FUNC_MODIFIES(*regno);
+
+PARROT_WARN_UNUSED_RESULT
+PARROT_CAN_RETURN_NULL
+static SymReg * find_unit_lexical(
+    ARGMOD(imc_info_t *imcc),
+    ARGIN(const IMC_Unit *unit),
+    ARGIN(const SymReg *name))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        FUNC_MODIFIES(*imcc);
+
+PARROT_WARN_UNUSED_RESULT
+static gvn_kind_t gvn_candidate(
+    ARGMOD(imc_info_t *imcc),
+    ARGIN(IMC_Unit *unit),
+    ARGIN(const gvn_info_t *info),
+    ARGIN(const Instruction *ins),
+    int kills)
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        __attribute__nonnull__(4)
+        FUNC_MODIFIES(*imcc);
+
+static void gvn_collect(
+    ARGMOD(imc_info_t *imcc),
+    ARGMOD(IMC_Unit *unit),
+    ARGOUT(gvn_info_t *info))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        FUNC_MODIFIES(*imcc)
+        FUNC_MODIFIES(*unit)
+        FUNC_MODIFIES(*info);
+
+PARROT_WARN_UNUSED_RESULT
+static int gvn_def_cmp(ARGIN(const void *a), ARGIN(const void *b))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+PARROT_WARN_UNUSED_RESULT
+PARROT_CAN_RETURN_NULL
+static gvn_def_t * gvn_find_def(
+    ARGIN(const gvn_info_t *info),
+    ARGIN(const SymReg *r))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+PARROT_WARN_UNUSED_RESULT
+static int gvn_ins_cmp(ARGIN(const void *a), ARGIN(const void *b))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+PARROT_WARN_UNUSED_RESULT
+static int gvn_kills(
+    ARGIN(const gvn_info_t *info),
+    ARGIN(const Instruction *ins))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+PARROT_WARN_UNUSED_RESULT
+static gvn_kind_t gvn_kind(
+    ARGMOD(imc_info_t *imcc),
+    ARGIN(IMC_Unit *unit),
+    ARGIN(const Instruction *ins))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        FUNC_MODIFIES(*imcc);
+
 static int if_branch(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit))
         __attribute__nonnull__(1)
         __attribute__nonnull__(2)
         FUNC_MODIFIES(*imcc)
         FUNC_MODIFIES(*unit);
 
+PARROT_WARN_UNUSED_RESULT
+static int ins_dominates(
+    ARGIN(const IMC_Unit *unit),
+    ARGIN(const Instruction *a),
+    ARGIN(const Instruction *b))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3);
+
+static int lexical_slots(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(*imcc)
+        FUNC_MODIFIES(*unit);
+
+static int loop_invariants(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(*imcc)
+        FUNC_MODIFIES(*unit);
+
+PARROT_WARN_UNUSED_RESULT
+static int reuse_new_site(
+    ARGMOD(imc_info_t *imcc),
+    ARGIN(const Instruction *ins))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(*imcc);
+
+PARROT_WARN_UNUSED_RESULT
+static int reuse_reg_cmp(ARGIN(const void *a), ARGIN(const void *b))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+PARROT_WARN_UNUSED_RESULT
+static int reuse_safe(ARGIN(const Instruction *ins), int i)
+        __attribute__nonnull__(1);
+
+static int reuse_temporaries(
+    ARGMOD(imc_info_t *imcc),
+    ARGMOD(IMC_Unit *unit))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(*imcc)
+        FUNC_MODIFIES(*unit);
+
 static int strength_reduce(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit))
         __attribute__nonnull__(1)
         __attribute__nonnull__(2)
         FUNC_MODIFIES(*imcc)
         FUNC_MODIFIES(*unit);
 
+PARROT_WARN_UNUSED_RESULT
+static int unbox_block_use(
+    ARGIN_NULLOK(const Instruction *ins),
+    ARGIN(const Instruction *end),
+    ARGIN(const SymReg *r))
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3);
+
+static int unbox_check(
+    ARGMOD(imc_info_t *imcc),
+    ARGMOD(IMC_Unit *unit),
+    ARGMOD(unbox_info_t *info))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        FUNC_MODIFIES(*imcc)
+        FUNC_MODIFIES(*unit)
+        FUNC_MODIFIES(*info);
+
+PARROT_WARN_UNUSED_RESULT
+PARROT_CAN_RETURN_NULL
+static unbox_reg_t * unbox_find(
+    ARGIN(const unbox_info_t *info),
+    ARGIN(const SymReg *r))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+PARROT_WARN_UNUSED_RESULT
+static int unbox_kind(
+    ARGIN(const unbox_info_t *info),
+    ARGIN(const SymReg *r))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+PARROT_WARN_UNUSED_RESULT
+static int unbox_mentions(
+    ARGIN(const Instruction *ins),
+    ARGIN(const SymReg *r))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+static int unbox_numerics(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(*imcc)
+        FUNC_MODIFIES(*unit);
+
+PARROT_WARN_UNUSED_RESULT
+static int unbox_reg_cmp(ARGIN(const void *a), ARGIN(const void *b))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+static int unbox_rewrite(
+    ARGMOD(imc_info_t *imcc),
+    ARGMOD(IMC_Unit *unit),
+    ARGIN(const unbox_info_t *info))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        FUNC_MODIFIES(*imcc)
+        FUNC_MODIFIES(*unit);
+
+static int unbox_scan(
+    ARGMOD(imc_info_t *imcc),
+    ARGMOD(IMC_Unit *unit),
+    ARGMOD(unbox_info_t *info))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        FUNC_MODIFIES(*imcc)
+        FUNC_MODIFIES(*unit)
+        FUNC_MODIFIES(*info);
+
+PARROT_WARN_UNUSED_RESULT
+static unbox_use_t unbox_use(
+    ARGMOD(imc_info_t *imcc),
+    ARGIN(const Instruction *ins))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(*imcc);
+
+PARROT_WARN_UNUSED_RESULT
+static int unbox_used_after(
+    ARGMOD(imc_info_t *imcc),
+    ARGIN(const IMC_Unit *unit),
+    ARGIN(const Instruction *ins),
+    ARGIN(const SymReg *r))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        __attribute__nonnull__(4)
+        FUNC_MODIFIES(*imcc);
+
 PARROT_WARN_UNUSED_RESULT
 static int unused_label(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit))
         __attribute__nonnull__(1)
@@ -171,6 +496,15 @@ static int used_once(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit))
         FUNC_MODIFIES(*imcc)
         FUNC_MODIFIES(*unit);
 
+static int value_numbering(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(*imcc)
+        FUNC_MODIFIES(*unit);
+
+#define ASSERT_ARGS_always_executed __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(unit) \
+    , PARROT_ASSERT_ARG(loop))
 #define ASSERT_ARGS_branch_branch __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc) \
     , PARROT_ASSERT_ARG(unit))
@@ -196,18 +530,115 @@ static int used_once(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit))
        PARROT_ASSERT_ARG(imcc) \
     , PARROT_ASSERT_ARG(op) \
     , PARROT_ASSERT_ARG(r))
+#define ASSERT_ARGS_find_lexical_slot __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit) \
+    , PARROT_ASSERT_ARG(name) \
+    , PARROT_ASSERT_ARG(depth) \
+    , PARROT_ASSERT_ARG(regno))
+#define ASSERT_ARGS_find_unit_lexical __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit) \
+    , PARROT_ASSERT_ARG(name))
+#define ASSERT_ARGS_gvn_candidate __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit) \
+    , PARROT_ASSERT_ARG(info) \
+    , PARROT_ASSERT_ARG(ins))
+#define ASSERT_ARGS_gvn_collect __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit) \
+    , PARROT_ASSERT_ARG(info))
+#define ASSERT_ARGS_gvn_def_cmp __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(a) \
+    , PARROT_ASSERT_ARG(b))
+#define ASSERT_ARGS_gvn_find_def __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(info) \
+    , PARROT_ASSERT_ARG(r))
+#define ASSERT_ARGS_gvn_ins_cmp __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(a) \
+    , PARROT_ASSERT_ARG(b))
+#define ASSERT_ARGS_gvn_kills __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(info) \
+    , PARROT_ASSERT_ARG(ins))
+#define ASSERT_ARGS_gvn_kind __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit) \
+    , PARROT_ASSERT_ARG(ins))
 #define ASSERT_ARGS_if_branch __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc) \
     , PARROT_ASSERT_ARG(unit))
+#define ASSERT_ARGS_ins_dominates __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(unit) \
+    , PARROT_ASSERT_ARG(a) \
+    , PARROT_ASSERT_ARG(b))
+#define ASSERT_ARGS_lexical_slots __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit))
+#define ASSERT_ARGS_loop_invariants __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit))
+#define ASSERT_ARGS_reuse_new_site __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(ins))
+#define ASSERT_ARGS_reuse_reg_cmp __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(a) \
+    , PARROT_ASSERT_ARG(b))
+#define ASSERT_ARGS_reuse_safe __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(ins))
+#define ASSERT_ARGS_reuse_temporaries __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit))
 #define ASSERT_ARGS_strength_reduce __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc) \
     , PARROT_ASSERT_ARG(unit))
+#define ASSERT_ARGS_unbox_block_use __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(end) \
+    , PARROT_ASSERT_ARG(r))
+#define ASSERT_ARGS_unbox_check __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit) \
+    , PARROT_ASSERT_ARG(info))
+#define ASSERT_ARGS_unbox_find __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(info) \
+    , PARROT_ASSERT_ARG(r))
+#define ASSERT_ARGS_unbox_kind __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(info) \
+    , PARROT_ASSERT_ARG(r))
+#define ASSERT_ARGS_unbox_mentions __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(ins) \
+    , PARROT_ASSERT_ARG(r))
+#define ASSERT_ARGS_unbox_numerics __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit))
+#define ASSERT_ARGS_unbox_reg_cmp __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(a) \
+    , PARROT_ASSERT_ARG(b))
+#define ASSERT_ARGS_unbox_rewrite __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit) \
+    , PARROT_ASSERT_ARG(info))
+#define ASSERT_ARGS_unbox_scan __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit) \
+    , PARROT_ASSERT_ARG(info))
+#define ASSERT_ARGS_unbox_use __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(ins))
+#define ASSERT_ARGS_unbox_used_after __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit) \
+    , PARROT_ASSERT_ARG(ins) \
+    , PARROT_ASSERT_ARG(r))
 #define ASSERT_ARGS_unused_label __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc) \
     , PARROT_ASSERT_ARG(unit))
 #define ASSERT_ARGS_used_once __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc) \
     , PARROT_ASSERT_ARG(unit))
+#define ASSERT_ARGS_value_numbering __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit))
 /* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
 /* HEADERIZER END: static */
 
@@ -279,6 +710,16 @@ Runs after the CFG is built and handles constant propagation.
 
 used_once ... deletes assignments, when LHS is unused
 
+value_numbering ... deletes ops whose value an op dominating them computed
+
+loop_invariants ... moves ops computing the same value in every iteration
+in front of the loop
+
+unbox_numerics ... replaces Integer and Float PMC temporaries by native
+registers
+
+reuse_temporaries ... lets new sites whose PMC never escapes recycle it
+
 =cut
 
 */
@@ -294,6 +735,45 @@ optimize(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit))
         if (used_once(imcc, unit))
             return 1;
     }
+    if (imcc->optimizer_level & OPT_GVN) {
+        if (value_numbering(imcc, unit))
+            return 1;
+        if (loop_invariants(imcc, unit))
+            return 1;
+    }
+    if (imcc->optimizer_level & OPT_UNBOX) {
+        if (unbox_numerics(imcc, unit))
+            return 1;
+    }
+    if (imcc->optimizer_level & OPT_ESCAPE) {
+        if (reuse_temporaries(imcc, unit))
+            return 1;
+    }
+    return any;
+}
+
+/*
+
+=item C<int post_optimize(imc_info_t *imcc, IMC_Unit *unit)>
+
+Runs after register allocation, when the register of every lexical in this
+unit and in its already compiled C<:outer> subs is known.
+
+lexical_slots ... resolves constant lexical names to (depth, register)
+
+=cut
+
+*/
+
+int
+post_optimize(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit))
+{
+    ASSERT_ARGS(post_optimize)
+    int any = 0;
+    if (imcc->optimizer_level & OPT_LEX) {
+        IMCC_info(imcc, 2, "post_optimize\n");
+        any = lexical_slots(imcc, unit);
+    }
     return any;
 }
 
@@ -734,11 +1214,13 @@ constant_propagation(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit))
                                 }
                             }
                             else {
+                                op_info_t * const old_op = ins2->op;
                                 char fullname[128];
                                 check_op(imcc, &ins2->op, fullname, ins2->opname,
                                     ins2->symregs, ins2->symreg_count, ins2->keys);
                                 if (!ins2->op) {
                                     ins2->symregs[i] = old;
+                                    ins2->op         = old_op;
                                     IMCC_debug(imcc, DEBUG_OPT2,
                                             " - no %s\n", fullname);
                                 }
@@ -1575,7 +2057,8 @@ dead_code_remove(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit))
 
 =item C<static int used_once(imc_info_t *imcc, IMC_Unit *unit)>
 
-used_once ... deletes assignments, when LHS is unused
+used_once ... deletes assignments, when LHS is unused. Ops taking a PMC are
+kept, as a vtable override of the PMC may do more than compute the LHS.
 
 =cut
 
@@ -1591,6 +2074,15 @@ used_once(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit))
     for (ins = unit->instructions; ins; ins = ins->next) {
         if (ins->symregs) {
             SymReg * const r = ins->symregs[0];
+            int i;
+
+            for (i = 0; i < ins->symreg_count; i++)
+                if (ins->symregs[i] && ins->symregs[i]->set == 'P')
+                    break;
+
+            if (i < ins->symreg_count)
+                continue;
+
             if (r && (r->use_count == 1 && r->lhs_use_count == 1)) {
                 IMCC_debug(imcc, DEBUG_OPT2, "used once '%d' deleted\n", ins);
                 ins = delete_ins(unit, ins);
@@ -1612,6 +2104,1771 @@ used_once(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit))
 
 /*
 
+=item C<static int unbox_reg_cmp(const void *a, const void *b)>
+
+Orders C<unbox_reg_t> entries by the address of their register, for
+C<qsort> and C<bsearch>.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+static int
+unbox_reg_cmp(ARGIN(const void *a), ARGIN(const void *b))
+{
+    ASSERT_ARGS(unbox_reg_cmp)
+    const SymReg * const ra = ((const unbox_reg_t *)a)->reg;
+    const SymReg * const rb = ((const unbox_reg_t *)b)->reg;
+
+    return ra < rb ? -1 : ra > rb ? 1 : 0;
+}
+
+/*
+
+=item C<static unbox_reg_t * unbox_find(const unbox_info_t *info, const SymReg
+*r)>
+
+Returns the unboxing candidate for register C<r>, or NULL if C<r> isn't one.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+PARROT_CAN_RETURN_NULL
+static unbox_reg_t *
+unbox_find(ARGIN(const unbox_info_t *info), ARGIN(const SymReg *r))
+{
+    ASSERT_ARGS(unbox_find)
+    unbox_reg_t key;
+
+    if (r->set != 'P' || !info->n_regs)
+        return NULL;
+
+    key.reg = r;
+    return (unbox_reg_t *)bsearch(&key, info->regs, info->n_regs,
+            sizeof (unbox_reg_t), unbox_reg_cmp);
+}
+
+/*
+
+=item C<static unbox_use_t unbox_use(imc_info_t *imcc, const Instruction *ins)>
+
+Classifies C<ins> by the way it uses its PMC registers, see C<unbox_use_t>.
+Only the forms which have a native I or N register counterpart with the
+same result for plain Integer and Float PMCs are recognized.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+static unbox_use_t
+unbox_use(ARGMOD(imc_info_t *imcc), ARGIN(const Instruction *ins))
+{
+    ASSERT_ARGS(unbox_use)
+    const char * const name = ins->opname;
+    SymReg * const * const r = ins->symregs;
+    const int n = ins->symreg_count;
+
+    if (!name || ins->keys || n < 1 || n > 3)
+        return UB_OTHER;
+
+#define UB_NATIVE(s) ((s)->set == 'I' || (s)->set == 'N')
+#define UB_VALUE(s)  ((s)->set == 'P' || UB_NATIVE(s))
+
+    if (n == 1) {
+        if (r[0]->set == 'P' && (STREQ(name, "inc") || STREQ(name, "dec")))
+            return UB_INCDEC;
+        return UB_OTHER;
+    }
+
+    if (n == 2) {
+        if (STREQ(name, "new")) {
+            if (r[0]->set == 'P' && r[1]->set == 'S' && (r[1]->type & VTCONST)) {
+                const INTVAL type = Parrot_pmc_get_type_str(imcc->interp,
+                        IMCC_string_from_reg(imcc, r[1]));
+                if (type == enum_class_Integer || type == enum_class_Float)
+                    return UB_NEW;
+            }
+            return UB_OTHER;
+        }
+        if (STREQ(name, "box"))
+            return r[0]->set == 'P' && UB_NATIVE(r[1]) ? UB_BOX : UB_OTHER;
+        if (STREQ(name, "set")) {
+            if (r[0]->set == 'P' && UB_NATIVE(r[1]))
+                return UB_SET;
+            if (UB_NATIVE(r[0]) && !(r[0]->type & VTCONST) && r[1]->set == 'P')
+                return UB_GET;
+            return UB_OTHER;
+        }
+        if (STREQ(name, "add") || STREQ(name, "sub") || STREQ(name, "mul"))
+            return r[0]->set == 'P' && UB_VALUE(r[1]) ? UB_INPLACE : UB_OTHER;
+        if (STREQ(name, "if") || STREQ(name, "unless"))
+            return r[0]->set == 'P' ? UB_IF : UB_OTHER;
+        return UB_OTHER;
+    }
+
+    if (STREQ(name, "add") || STREQ(name, "sub") || STREQ(name, "mul"))
+        return r[0]->set == 'P' && r[1]->set == 'P' && UB_VALUE(r[2])
+             ? UB_ARITH : UB_OTHER;
+
+    if (STREQ(name, "eq") || STREQ(name, "ne") || STREQ(name, "lt")
+    ||  STREQ(name, "le") || STREQ(name, "gt") || STREQ(name, "ge"))
+        return r[0]->set == 'P' && UB_VALUE(r[1]) && (r[2]->type & VTADDRESS)
+             ? UB_BRANCH : UB_OTHER;
+
+    if (STREQ(name, "iseq") || STREQ(name, "isne") || STREQ(name, "islt")
+    ||  STREQ(name, "isle") || STREQ(name, "isgt") || STREQ(name, "isge")
+    ||  STREQ(name, "cmp"))
+        return r[0]->set == 'I' && r[1]->set == 'P' && UB_VALUE(r[2])
+             ? UB_TEST : UB_OTHER;
+
+#undef UB_NATIVE
+#undef UB_VALUE
+
+    return UB_OTHER;
+}
+
+/*
+
+=item C<static int unbox_kind(const unbox_info_t *info, const SymReg *r)>
+
+Returns the value kind of operand C<r>: the inferred kind of a candidate,
+C<UB_INT> or C<UB_NUM> for native operands and C<UB_BAD> for anything else.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+static int
+unbox_kind(ARGIN(const unbox_info_t *info), ARGIN(const SymReg *r))
+{
+    ASSERT_ARGS(unbox_kind)
+    const unbox_reg_t * const u = unbox_find(info, r);
+
+    if (u)
+        return u->kind;
+
+    return r->set == 'I' ? UB_INT
+         : r->set == 'N' ? UB_NUM
+         :                 UB_BAD;
+}
+
+/*
+
+=item C<static int unbox_mentions(const Instruction *ins, const SymReg *r)>
+
+Returns true if C<r> is an operand of C<ins> or a register in one of its
+keys.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+static int
+unbox_mentions(ARGIN(const Instruction *ins), ARGIN(const SymReg *r))
+{
+    ASSERT_ARGS(unbox_mentions)
+    int i;
+
+    for (i = 0; i < ins->symreg_count; i++) {
+        const SymReg * const ri = ins->symregs[i];
+
+        if (ri == r)
+            return 1;
+
+        if (ri->set == 'K') {
+            const SymReg *key;
+            for (key = ri->nextkey; key; key = key->nextkey)
+                if (key->reg == r)
+                    return 1;
+        }
+    }
+
+    return 0;
+}
+
+/*
+
+=item C<static int unbox_block_use(const Instruction *ins, const Instruction
+*end, const SymReg *r)>
+
+Looks at the instructions from C<ins> up to and including C<end>. Returns 1
+if one of them uses the PMC in C<r>, -1 if C<r> is first set to a new PMC
+and 0 if the instructions don't mention C<r>.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+static int
+unbox_block_use(ARGIN_NULLOK(const Instruction *ins), ARGIN(const Instruction *end),
+        ARGIN(const SymReg *r))
+{
+    ASSERT_ARGS(unbox_block_use)
+    for (; ins; ins = ins->next) {
+        if (unbox_mentions(ins, r)) {
+            const int n = ins->symreg_count;
+
+            if (n >= 2 && ins->symregs[0] == r && !ins->keys
+            &&  (STREQ(ins->opname, "new") || STREQ(ins->opname, "box")
+            ||  (n == 3 && ins->symregs[1] != r && ins->symregs[2] != r
+            &&   (STREQ(ins->opname, "add") || STREQ(ins->opname, "sub")
+            ||    STREQ(ins->opname, "mul")))))
+                return -1;
+
+            return 1;
+        }
+
+        if (ins == end)
+            break;
+    }
+
+    return 0;
+}
+
+/*
+
+=item C<static int unbox_used_after(imc_info_t *imcc, const IMC_Unit *unit,
+const Instruction *ins, const SymReg *r)>
+
+Returns true if the PMC in C<r> may be used again after C<ins>, following
+the CFG until C<r> is set to a new PMC.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+static int
+unbox_used_after(ARGMOD(imc_info_t *imcc), ARGIN(const IMC_Unit *unit),
+        ARGIN(const Instruction *ins), ARGIN(const SymReg *r))
+{
+    ASSERT_ARGS(unbox_used_after)
+    const Basic_block *bb    = unit->bb_list[ins->bbindex];
+    Set * const        seen  = set_make(imcc, unit->n_basic_blocks);
+    unsigned int * const todo = mem_gc_allocate_n_typed(imcc->interp,
+                                    unit->n_basic_blocks, unsigned int);
+    unsigned int       n_todo = 0;
+    int                use    = unbox_block_use(ins == bb->end ? NULL : ins->next,
+                                    bb->end, r);
+
+    for (;;) {
+        if (use == 0) {
+            const Edge *e;
+            for (e = bb->succ_list; e; e = e->succ_next) {
+                const unsigned int to = e->to->index;
+                if (!set_contains(seen, to)) {
+                    set_add(seen, to);
+                    todo[n_todo++] = to;
+                }
+            }
+        }
+
+        if (use > 0 || !n_todo)
+            break;
+
+        bb  = unit->bb_list[todo[--n_todo]];
+        use = unbox_block_use(bb->start, bb->end, r);
+    }
+
+    mem_gc_free(imcc->interp, todo);
+    set_free(seen);
+    return use > 0;
+}
+
+/*
+
+=item C<static int unbox_scan(imc_info_t *imcc, IMC_Unit *unit, unbox_info_t
+*info)>
+
+One pass of the kind inference over all instructions. The PMC operands of
+an instruction with a native form must all be of the same kind; a candidate
+used any other way is rejected if the instruction could change it. Returns
+the number of candidates whose kind changed.
+
+=cut
+
+*/
+
+static int
+unbox_scan(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit), ARGMOD(unbox_info_t *info))
+{
+    ASSERT_ARGS(unbox_scan)
+    op_lib_t * const core_ops = PARROT_GET_CORE_OPLIB(imcc->interp);
+    Instruction     *ins;
+    int              changes = 0;
+
+    for (ins = unit->instructions; ins; ins = ins->next) {
+        const unbox_use_t use = unbox_use(imcc, ins);
+        int kind = UB_UNKNOWN, link = 0, def = 0, native = 1, i;
+
+        switch (use) {
+          case UB_NEW:
+            kind = Parrot_pmc_get_type_str(imcc->interp,
+                        IMCC_string_from_reg(imcc, ins->symregs[1])) == enum_class_Integer
+                 ? UB_INT : UB_NUM;
+            link = 0x1; def = 1; native = 0;
+            break;
+          case UB_BOX:     link = 0x3; def = 1; native = 0; break;
+          case UB_SET:     link = 0x3; native = 0;          break;
+          case UB_ARITH:   link = 0x7; def = 1;             break;
+          case UB_INPLACE:
+          case UB_BRANCH:  link = 0x3;                      break;
+          case UB_TEST:    link = 0x6;                      break;
+          case UB_GET:     link = 0x2;                      break;
+          case UB_INCDEC:
+          case UB_IF:      link = 0x1;                      break;
+          case UB_OTHER:
+          default:
+            for (i = 0; i < ins->symreg_count; i++) {
+                SymReg      * const r = ins->symregs[i];
+                unbox_reg_t *u        = unbox_find(info, r);
+
+                if (!u && r->set == 'K') {
+                    const SymReg *key;
+                    for (key = r->nextkey; key && !u; key = key->nextkey)
+                        if (key->reg)
+                            u = unbox_find(info, key->reg);
+                }
+
+                /* escapes are checked later, when the kinds are known */
+                if (u && u->kind != UB_BAD
+                && (u->reg != r
+                ||  ins->flags & (IF_r0_write << i)
+                ||  ins->keys & (1 << (i + 1))
+                ||  ins->op == &core_ops->op_info_table[PARROT_OP_get_params_pc]
+                ||  ins->op == &core_ops->op_info_table[PARROT_OP_get_results_pc])) {
+                    u->kind = UB_BAD;
+                    changes++;
+                }
+            }
+            continue;
+        }
+
+        for (i = 0; i < ins->symreg_count; i++) {
+            if (link & (1 << i)) {
+                const int k = unbox_kind(info, ins->symregs[i]);
+                if (k != UB_UNKNOWN && k != kind)
+                    kind = kind == UB_UNKNOWN ? k : UB_BAD;
+            }
+        }
+
+        for (i = 0; i < ins->symreg_count; i++) {
+            unbox_reg_t * const u = unbox_find(info, ins->symregs[i]);
+
+            if (!u || !(link & (1 << i)))
+                continue;
+
+            if (kind != UB_UNKNOWN && u->kind != kind) {
+                u->kind = kind;
+                changes++;
+            }
+            if (def && i == 0)
+                u->has_def = 1;
+            if (native)
+                u->has_use = 1;
+        }
+    }
+
+    return changes;
+}
+
+/*
+
+=item C<static int unbox_check(imc_info_t *imcc, IMC_Unit *unit, unbox_info_t
+*info)>
+
+Rejects the candidates of unknown kind, those never created in this unit
+or never used by an op with a native form, and those that escape (are
+passed to any other op) while their PMC may still be used afterwards: the
+PMC boxed at the escape would then not be the one the rest of the unit
+sees. Returns the number of candidates rejected.
+
+=cut
+
+*/
+
+static int
+unbox_check(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit), ARGMOD(unbox_info_t *info))
+{
+    ASSERT_ARGS(unbox_check)
+    Instruction *ins;
+    unsigned int i;
+    int          rejected = 0;
+
+    for (i = 0; i < info->n_regs; i++) {
+        unbox_reg_t * const u = info->regs + i;
+
+        if (u->kind != UB_BAD
+        && (u->kind == UB_UNKNOWN || !u->has_def || !u->has_use)) {
+            u->kind = UB_BAD;
+            rejected++;
+        }
+    }
+
+    for (ins = unit->instructions; ins; ins = ins->next) {
+        int j;
+
+        if (unbox_use(imcc, ins) != UB_OTHER)
+            continue;
+
+        for (j = 0; j < ins->symreg_count; j++) {
+            unbox_reg_t * const u = unbox_find(info, ins->symregs[j]);
+
+            if (u && u->kind != UB_BAD && unbox_used_after(imcc, unit, ins, u->reg)) {
+                u->kind = UB_BAD;
+                rejected++;
+            }
+        }
+    }
+
+    return rejected;
+}
+
+/*
+
+=item C<static int unbox_rewrite(imc_info_t *imcc, IMC_Unit *unit, const
+unbox_info_t *info)>
+
+Replaces the accepted candidates by their native registers, and boxes them
+into a new PMC in front of each instruction they escape to. Returns the
+number of instructions changed.
+
+=cut
+
+*/
+
+static int
+unbox_rewrite(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit),
+        ARGIN(const unbox_info_t *info))
+{
+    ASSERT_ARGS(unbox_rewrite)
+    Instruction *ins;
+    int          changes = 0;
+
+    for (ins = unit->instructions; ins; ins = ins->next) {
+        const unbox_use_t use = unbox_use(imcc, ins);
+        SymReg           *regs[3];
+        const char       *name = ins->opname;
+        Instruction      *tmp;
+        int               i, any = 0;
+
+        for (i = 0; i < ins->symreg_count; i++) {
+            const unbox_reg_t * const u = unbox_find(info, ins->symregs[i]);
+
+            if (use == UB_OTHER) {
+                int j;
+
+                if (!u || u->kind == UB_BAD)
+                    continue;
+
+                for (j = 0; j < i; j++)
+                    if (ins->symregs[j] == u->reg)
+                        break;
+
+                if (j < i)
+                    continue;
+
+                IMCC_debug(imcc, DEBUG_OPT1, "unbox: box %s before %d\n",
+                        u->reg->name, ins);
+                regs[0] = ins->symregs[i];
+                regs[1] = mk_const(imcc, u->kind == UB_INT ? "'Integer'" : "'Float'", 'S');
+                prepend_ins(unit, ins, INS(imcc, unit, "new", "", regs, 2, 0, 0));
+                regs[1] = u->native;
+                prepend_ins(unit, ins, INS(imcc, unit, "set", "", regs, 2, 0, 0));
+                changes++;
+            }
+            else if (u && u->kind != UB_BAD) {
+                regs[i] = u->native;
+                any     = 1;
+            }
+            else
+                regs[i] = ins->symregs[i];
+        }
+
+        if (!any)
+            continue;
+
+        if (use == UB_NEW) {
+            name    = "set";
+            regs[1] = regs[0]->set == 'I' ? mk_const(imcc, "0", 'I')
+                                          : mk_const(imcc, "0.0", 'N');
+        }
+        else if (use == UB_BOX)
+            name = "set";
+
+        IMCC_debug(imcc, DEBUG_OPT1, "unbox %d => ", ins);
+        tmp = INS(imcc, unit, name, "", regs, ins->symreg_count, 0, 0);
+        IMCC_debug(imcc, DEBUG_OPT1, "%d\n", tmp);
+        subst_ins(unit, ins, tmp, 1);
+        ins = tmp;
+        changes++;
+    }
+
+    return changes;
+}
+
+/*
+
+=item C<static int unbox_numerics(imc_info_t *imcc, IMC_Unit *unit)>
+
+Keeps PMC registers which only ever hold a plain Integer or Float created
+in this unit in native I or N registers:
+
+  new $P0, 'Integer'      => set $I0, 0
+  add $P0, $P1            => add $I0, $I1
+  $P2 = $P0 * $P1         => mul $I2, $I0, $I1
+  lt $P0, 10, loop        => lt $I0, 10, loop
+  $P0 = 5                 => set $I0, 5
+
+A register qualifies only if every op using it has a native counterpart,
+and all PMC operands of such an op qualify with the same type. Other uses
+(calls, returns, stores into aggregates and so on) are escapes: a new PMC
+is boxed from the native register in front of them, which is only done if
+the PMC isn't used again afterwards. Integer arithmetic then wraps around
+instead of being promoted to BigInt.
+
+=cut
+
+*/
+
+static int
+unbox_numerics(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit))
+{
+    ASSERT_ARGS(unbox_numerics)
+    unbox_info_t info;
+    unsigned int i;
+    int          changes = 0;
+
+    /* new and box may give HLL mapped types */
+    if (unit->hll_id != 0 || !unit->n_basic_blocks)
+        return 0;
+
+    IMCC_info(imcc, 2, "\tunbox_numerics\n");
+
+    info.regs   = mem_gc_allocate_n_zeroed_typed(imcc->interp,
+                        unit->n_symbols ? unit->n_symbols : 1, unbox_reg_t);
+    info.n_regs = 0;
+
+    for (i = 0; i < unit->n_symbols; i++) {
+        SymReg * const r = unit->reglist[i];
+
+        if (r->set == 'P'
+        &&  (r->type & (VTREG | VTIDENTIFIER))
+        && !(r->type & (VTREGKEY | VTPASM | VTCONST))
+        && !(r->usage & (U_LEXICAL | U_KEYED)))
+            info.regs[info.n_regs++].reg = r;
+    }
+
+    if (info.n_regs) {
+        qsort(info.regs, info.n_regs, sizeof (unbox_reg_t), unbox_reg_cmp);
+
+        do {
+            while (unbox_scan(imcc, unit, &info))
+                ;
+        } while (unbox_check(imcc, unit, &info));
+
+        for (i = 0; i < info.n_regs; i++) {
+            unbox_reg_t * const u = info.regs + i;
+
+            if (u->kind != UB_BAD) {
+                u->native = mk_temp_reg(imcc, u->kind == UB_INT ? 'I' : 'N');
+                unit->ostat.unboxed++;
+                changes = 1;
+            }
+        }
+
+        if (changes)
+            changes = unbox_rewrite(imcc, unit, &info);
+    }
+
+    mem_gc_free(imcc->interp, info.regs);
+    return changes;
+}
+
+/*
+
+=item C<static int reuse_reg_cmp(const void *a, const void *b)>
+
+Orders C<reuse_reg_t> entries by the address of their register, for
+C<qsort> and C<bsearch>.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+static int
+reuse_reg_cmp(ARGIN(const void *a), ARGIN(const void *b))
+{
+    ASSERT_ARGS(reuse_reg_cmp)
+    const SymReg * const ra = ((const reuse_reg_t *)a)->reg;
+    const SymReg * const rb = ((const reuse_reg_t *)b)->reg;
+
+    return ra < rb ? -1 : ra > rb ? 1 : 0;
+}
+
+/*
+
+=item C<static int reuse_new_site(imc_info_t *imcc, const Instruction *ins)>
+
+Returns true if C<ins> is C<new Px, 'Type'> for one of the core value and
+container types whose vtable functions never hand out the PMC itself.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+static int
+reuse_new_site(ARGMOD(imc_info_t *imcc), ARGIN(const Instruction *ins))
+{
+    ASSERT_ARGS(reuse_new_site)
+    SymReg * const * const r = ins->symregs;
+    INTVAL type;
+
+    if (!ins->opname || !STREQ(ins->opname, "new") || ins->symreg_count != 2
+    ||  ins->keys || r[0]->set != 'P' || r[1]->set != 'S' || !(r[1]->type & VTCONST))
+        return 0;
+
+    type = Parrot_pmc_get_type_str(imcc->interp, IMCC_string_from_reg(imcc, r[1]));
+
+    switch (type) {
+      case enum_class_Integer:
+      case enum_class_Float:
+      case enum_class_String:
+      case enum_class_Boolean:
+      case enum_class_StringBuilder:
+      case enum_class_Hash:
+      case enum_class_ResizablePMCArray:
+      case enum_class_ResizableIntegerArray:
+      case enum_class_ResizableFloatArray:
+      case enum_class_ResizableStringArray:
+        return 1;
+      default:
+        return 0;
+    }
+}
+
+/*
+
+=item C<static int reuse_safe(const Instruction *ins, int i)>
+
+Returns true if the PMC register operand C<i> of C<ins> is only the
+invocant of the vtable functions C<ins> calls, with native or constant
+arguments, or PMCs to store into it or fetched from it. The op doesn't
+assign the register and the PMC can't end up anywhere else: not in another
+PMC, a call, a return, a lexical or global, or in another register.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+static int
+reuse_safe(ARGIN(const Instruction *ins), int i)
+{
+    ASSERT_ARGS(reuse_safe)
+    const char * const     name  = ins->opname;
+    SymReg * const * const r     = ins->symregs;
+    const int              n     = ins->symreg_count;
+    const int              keyed = ins->keys & (1 << (i + 1));
+    int                    j;
+
+    if (!name || ins->flags & (IF_r0_write << i))
+        return 0;
+
+    /* the PMC must not be passed twice, and keys hold no other PMCs */
+    for (j = 0; j < n; j++) {
+        if (j != i && r[j] == r[i])
+            return 0;
+
+        if (ins->keys & (1 << j) && r[j]->set == 'P')
+            return 0;
+
+        if (r[j]->set == 'K') {
+            const SymReg *key;
+            for (key = r[j]->nextkey; key; key = key->nextkey)
+                if ((key->reg ? key->reg : key)->set == 'P')
+                    return 0;
+        }
+    }
+
+#define RU_NATIVE(s) ((s)->set != 'P')
+
+    if (STREQ(name, "set"))
+        return (i == 0 && (keyed || (n == 2 && RU_NATIVE(r[1]))))
+            || (i == 1 && (keyed || RU_NATIVE(r[0])));
+
+    if (STREQ(name, "inc") || STREQ(name, "dec")
+    ||  STREQ(name, "print") || STREQ(name, "say"))
+        return i == 0 && n == 1;
+
+    if (STREQ(name, "add") || STREQ(name, "sub") || STREQ(name, "mul")
+    ||  STREQ(name, "div") || STREQ(name, "fdiv") || STREQ(name, "mod"))
+        return i == 0 && n == 2 && RU_NATIVE(r[1]);
+
+    if (STREQ(name, "concat"))
+        return i == 0 && n == 2 && r[1]->set == 'S';
+
+    if (STREQ(name, "push") || STREQ(name, "unshift"))
+        return i == 0 && n == 2;
+
+    if (STREQ(name, "pop") || STREQ(name, "shift"))
+        return i == 1 && n == 2;
+
+    if (STREQ(name, "elements") || STREQ(name, "defined") || STREQ(name, "exists")
+    ||  STREQ(name, "isnull"))
+        return i == 1 && RU_NATIVE(r[0]);
+
+    if (STREQ(name, "delete"))
+        return i == 0 && keyed;
+
+    if (STREQ(name, "if") || STREQ(name, "unless")
+    ||  STREQ(name, "if_null") || STREQ(name, "unless_null"))
+        return i == 0 && n == 2;
+
+    if (STREQ(name, "eq") || STREQ(name, "ne") || STREQ(name, "lt")
+    ||  STREQ(name, "le") || STREQ(name, "gt") || STREQ(name, "ge"))
+        return i == 0 && n == 3 && RU_NATIVE(r[1]) && (r[2]->type & VTADDRESS);
+
+    if (STREQ(name, "join") || STREQ(name, "sprintf"))
+        return i == 2 && n == 3;
+
+#undef RU_NATIVE
+
+    return 0;
+}
+
+/*
+
+=item C<static int reuse_temporaries(imc_info_t *imcc, IMC_Unit *unit)>
+
+Rewrites C<new Px, 'Type'> into C<renew Px, 'Type'> for the PMC registers
+set only by such C<new>s and otherwise only used by the ops C<reuse_safe()>
+accepts:
+
+  $P0 = new 'ResizablePMCArray'   => renew $P0, 'ResizablePMCArray'
+  push $P0, $P1
+  $S0 = join ',', $P0
+
+Nothing but the register ever refers to these PMCs, so the PMC the register
+still holds when the C<new> runs again, e.g. in the next iteration of a
+loop, is garbage and C<renew> resets it in place instead of allocating a
+new one. As C<renew> reads the register, the variable is live around the
+loop and the register allocator doesn't give its register to another one.
+
+=cut
+
+*/
+
+static int
+reuse_temporaries(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit))
+{
+    ASSERT_ARGS(reuse_temporaries)
+    reuse_reg_t *regs;
+    unsigned int n_regs = 0, i;
+    Instruction *ins;
+    int          changes = 0;
+
+    IMCC_info(imcc, 2, "\treuse_temporaries\n");
+
+    regs = mem_gc_allocate_n_zeroed_typed(imcc->interp,
+                unit->n_symbols ? unit->n_symbols : 1, reuse_reg_t);
+
+    for (i = 0; i < unit->n_symbols; i++) {
+        SymReg * const r = unit->reglist[i];
+
+        if (r->set == 'P'
+        &&  (r->type & (VTREG | VTIDENTIFIER))
+        && !(r->type & (VTREGKEY | VTPASM | VTCONST))
+        && !(r->usage & U_LEXICAL))
+            regs[n_regs++].reg = r;
+    }
+
+    if (n_regs)
+        qsort(regs, n_regs, sizeof (reuse_reg_t), reuse_reg_cmp);
+
+    for (ins = unit->instructions; ins && n_regs; ins = ins->next) {
+        const int is_new = reuse_new_site(imcc, ins);
+        int       j;
+
+        for (j = 0; j < ins->symreg_count; j++) {
+            const SymReg * const r = ins->symregs[j];
+            reuse_reg_t          key;
+            reuse_reg_t         *u;
+
+            if (r->set == 'K') {
+                const SymReg *k;
+                for (k = r->nextkey; k; k = k->nextkey) {
+                    key.reg = k->reg ? k->reg : k;
+                    u = (reuse_reg_t *)bsearch(&key, regs, n_regs,
+                            sizeof (reuse_reg_t), reuse_reg_cmp);
+                    if (u)
+                        u->escapes = 1;
+                }
+                continue;
+            }
+
+            key.reg = r;
+            u       = (reuse_reg_t *)bsearch(&key, regs, n_regs,
+                            sizeof (reuse_reg_t), reuse_reg_cmp);
+
+            if (!u)
+                continue;
+
+            if (!(is_new && j == 0) && !reuse_safe(ins, j))
+                u->escapes = 1;
+        }
+    }
+
+    for (ins = unit->instructions; ins && n_regs; ins = ins->next) {
+        reuse_reg_t        key;
+        const reuse_reg_t *u;
+        Instruction       *tmp;
+
+        if (!reuse_new_site(imcc, ins))
+            continue;
+
+        key.reg = ins->symregs[0];
+        u       = (const reuse_reg_t *)bsearch(&key, regs, n_regs,
+                        sizeof (reuse_reg_t), reuse_reg_cmp);
+
+        if (!u || u->escapes)
+            continue;
+
+        IMCC_debug(imcc, DEBUG_OPT1, "renew %d => ", ins);
+        tmp = INS(imcc, unit, "renew", "", ins->symregs, 2, 0, 0);
+        IMCC_debug(imcc, DEBUG_OPT1, "%d\n", tmp);
+        subst_ins(unit, ins, tmp, 1);
+        ins = tmp;
+        unit->ostat.renewed++;
+        changes++;
+    }
+
+    mem_gc_free(imcc->interp, regs);
+    return changes;
+}
+
+/*
+
+=item C<static gvn_kind_t gvn_kind(imc_info_t *imcc, IMC_Unit *unit, const
+Instruction *ins)>
+
+Tells whether C<ins> computes its only output register from its input
+operands alone, so that value_numbering() and loop_invariants() may delete
+or move it. The output must be a plain register, not a lexical. Native ops
+qualify when all their operands are I, N or S; lookups when all their names
+are constants.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+static gvn_kind_t
+gvn_kind(ARGMOD(imc_info_t *imcc), ARGIN(IMC_Unit *unit), ARGIN(const Instruction *ins))
+{
+    ASSERT_ARGS(gvn_kind)
+    static const char * const native_ops[] = {
+        "abs", "add", "and", "band", "bor", "bxor", "bytelength", "ceil",
+        "chr", "cmp", "concat", "div", "downcase", "fdiv", "floor", "index",
+        "iseq", "isge", "isgt", "isle", "islt", "isne", "length", "lsr",
+        "mod", "mul", "neg", "not", "or", "ord", "repeat", "rindex", "shl",
+        "shr", "sqrt", "sub", "substr", "titlecase", "upcase", "xor"
+    };
+    /* these throw on a zero divisor or an invalid argument */
+    static const char * const throwing_ops[] = {
+        "chr", "div", "fdiv", "index", "mod", "ord", "repeat", "rindex",
+        "substr"
+    };
+    static const char * const global_ops[] = {
+        "get_global", "get_hll_global", "get_root_global",
+        "get_namespace", "get_hll_namespace", "get_root_namespace"
+    };
+    const op_info_t * const op  = ins->op;
+    const SymReg    *out;
+    gvn_kind_t       kind = GVN_PURE;
+    size_t           k;
+    int              i;
+
+    if (!op || op->lib != PARROT_GET_CORE_OPLIB(imcc->interp)
+    ||  !ins->symreg_count || ins->symreg_count != op->op_count - 1
+    ||  op->dirs[0] != PARROT_ARGDIR_OUT)
+        return GVN_NONE;
+
+    out = ins->symregs[0];
+    if (!(out->type & (VTREG | VTIDENTIFIER))
+    ||  (out->type & (VTREGKEY | VTPASM | VTCONST))
+    ||  (out->usage & U_LEXICAL))
+        return GVN_NONE;
+
+    for (i = 1; i < ins->symreg_count; i++)
+        if (op->dirs[i] != PARROT_ARGDIR_IN)
+            return GVN_NONE;
+
+    for (k = 0; k < N_ELEMENTS(global_ops); k++) {
+        if (STREQ(ins->opname, global_ops[k])) {
+            for (i = 1; i < ins->symreg_count; i++)
+                if (!(ins->symregs[i]->type & VTCONST))
+                    return GVN_NONE;
+
+            return GVN_GLOBAL;
+        }
+    }
+
+    if (STREQ(ins->opname, "find_lex")) {
+        if (ins->symreg_count == 2
+        &&  (ins->symregs[1]->type & VTCONST)
+        &&  !find_unit_lexical(imcc, unit, ins->symregs[1]))
+            return GVN_LEX;
+
+        return GVN_NONE;
+    }
+
+    if (STREQ(ins->opname, "getattribute")) {
+        if (ins->symreg_count == 3
+        &&  ins->symregs[1]->set == 'P'
+        &&  (ins->symregs[2]->type & VTCONST))
+            return GVN_ATTR;
+
+        return GVN_NONE;
+    }
+
+    for (k = 0; k < N_ELEMENTS(native_ops); k++)
+        if (STREQ(ins->opname, native_ops[k]))
+            break;
+
+    if (k == N_ELEMENTS(native_ops))
+        return GVN_NONE;
+
+    for (k = 0; k < N_ELEMENTS(throwing_ops); k++)
+        if (STREQ(ins->opname, throwing_ops[k]))
+            kind = GVN_THROWS;
+
+    for (i = 0; i < ins->symreg_count; i++) {
+        const SymReg * const r = ins->symregs[i];
+
+        if (r->set != 'I' && r->set != 'N' && r->set != 'S')
+            return GVN_NONE;
+
+        /* string ops die on a null string */
+        if (i && r->set == 'S' && !(r->type & VTCONST))
+            kind = GVN_THROWS;
+    }
+
+    return kind;
+}
+
+/*
+
+=item C<static int gvn_kills(const gvn_info_t *info, const Instruction *ins)>
+
+Returns the C<GVN_KILL_*> bits of the lookups whose result C<ins> may
+change. Calls may change lexicals, through a closure, and attributes, but
+are assumed to leave namespaces alone. So may any op taking a PMC other than
+the lookups themselves, as a vtable override of the PMC runs like a call.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+static int
+gvn_kills(ARGIN(const gvn_info_t *info), ARGIN(const Instruction *ins))
+{
+    ASSERT_ARGS(gvn_kills)
+    static const char * const call_ops[] = {
+        "callmethod", "callmethodcc", "invoke", "invokecc", "runinterp",
+        "tailcall", "tailcallmethod", "yield"
+    };
+    static const char * const leave_ops[] = {
+        "die", "exit", "load_bytecode", "load_language", "rethrow", "throw"
+    };
+    static const char * const lookup_ops[] = {
+        "find_lex", "get_global", "get_hll_global", "get_hll_namespace",
+        "get_namespace", "get_root_global", "get_root_namespace",
+        "getattribute"
+    };
+    size_t       k;
+    unsigned int n;
+    int          i;
+    int          kills = 0;
+
+    if (ins->type & (ITPCCSUB | ITCALL))
+        return GVN_KILL_LEX | GVN_KILL_ATTR;
+
+    for (k = 0; k < N_ELEMENTS(call_ops); k++)
+        if (STREQ(ins->opname, call_ops[k]))
+            return GVN_KILL_LEX | GVN_KILL_ATTR;
+
+    /* the code running next, e.g. an exception handler, may change anything */
+    for (k = 0; k < N_ELEMENTS(leave_ops); k++)
+        if (STREQ(ins->opname, leave_ops[k]))
+            return GVN_KILL_GLOBAL | GVN_KILL_LEX | GVN_KILL_ATTR;
+
+    if (STREQ(ins->opname, "set_global")
+    ||  STREQ(ins->opname, "set_hll_global")
+    ||  STREQ(ins->opname, "set_root_global"))
+        kills |= GVN_KILL_GLOBAL;
+
+    for (k = 0; k < N_ELEMENTS(lookup_ops); k++)
+        if (STREQ(ins->opname, lookup_ops[k]))
+            break;
+
+    /* e.g. "$I0 = obj" may run a get_integer override setting an attribute */
+    if (k == N_ELEMENTS(lookup_ops)) {
+        for (i = 0; i < ins->symreg_count; i++)
+            if (ins->symregs[i]->set == 'P') {
+                kills |= GVN_KILL_LEX | GVN_KILL_ATTR;
+                break;
+            }
+    }
+
+    if (STREQ(ins->opname, "store_lex")
+    ||  STREQ(ins->opname, "store_dynamic_lex"))
+        kills |= GVN_KILL_LEX;
+
+    if (STREQ(ins->opname, "setattribute")
+    ||  STREQ(ins->opname, "assign")
+    ||  STREQ(ins->opname, "copy")
+    ||  STREQ(ins->opname, "morph"))
+        kills |= GVN_KILL_ATTR;
+
+    /* anything done to a namespace besides looking it up may change it */
+    if (strncmp(ins->opname, "get_", 4) != 0) {
+        for (i = 0; i < ins->symreg_count; i++)
+            for (n = 0; n < info->n_ns_regs; n++)
+                if (ins->symregs[i] == info->ns_regs[n])
+                    return kills | GVN_KILL_GLOBAL;
+    }
+
+    return kills;
+}
+
+/*
+
+=item C<static int gvn_def_cmp(const void *a, const void *b)>
+
+Orders C<gvn_def_t> entries by the address of their register, for C<qsort>
+and C<bsearch>.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+static int
+gvn_def_cmp(ARGIN(const void *a), ARGIN(const void *b))
+{
+    ASSERT_ARGS(gvn_def_cmp)
+    const SymReg * const ra = ((const gvn_def_t *)a)->reg;
+    const SymReg * const rb = ((const gvn_def_t *)b)->reg;
+
+    return ra < rb ? -1 : ra > rb ? 1 : 0;
+}
+
+/*
+
+=item C<static gvn_def_t * gvn_find_def(const gvn_info_t *info, const SymReg
+*r)>
+
+Returns the entry of C<r> in C<info>, or NULL if C<r> isn't written by
+exactly one instruction.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+PARROT_CAN_RETURN_NULL
+static gvn_def_t *
+gvn_find_def(ARGIN(const gvn_info_t *info), ARGIN(const SymReg *r))
+{
+    ASSERT_ARGS(gvn_find_def)
+    gvn_def_t key;
+
+    if (!info->n_defs)
+        return NULL;
+
+    key.reg = r;
+    return (gvn_def_t *)bsearch(&key, info->defs, info->n_defs,
+                sizeof (gvn_def_t), gvn_def_cmp);
+}
+
+/*
+
+=item C<static int ins_dominates(const IMC_Unit *unit, const Instruction *a,
+const Instruction *b)>
+
+Returns true if every path from the start of the unit to C<b> passes C<a>
+before.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+static int
+ins_dominates(ARGIN(const IMC_Unit *unit), ARGIN(const Instruction *a),
+        ARGIN(const Instruction *b))
+{
+    ASSERT_ARGS(ins_dominates)
+
+    if (a->bbindex == b->bbindex)
+        return a->index < b->index;
+
+    return set_contains(unit->dominators[b->bbindex], a->bbindex);
+}
+
+/*
+
+=item C<static void gvn_collect(imc_info_t *imcc, IMC_Unit *unit, gvn_info_t
+*info)>
+
+Fills C<info> with the registers which are written by exactly one
+instruction, noting whether that instruction dominates all their reads, and
+with the registers holding a namespace.
+
+=cut
+
+*/
+
+static void
+gvn_collect(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit), ARGOUT(gvn_info_t *info))
+{
+    ASSERT_ARGS(gvn_collect)
+    op_lib_t    * const core_ops = PARROT_GET_CORE_OPLIB(imcc->interp);
+    Instruction *ins;
+    unsigned int n_regs = 0;
+    unsigned int i, j;
+
+    for (ins = unit->instructions; ins; ins = ins->next)
+        n_regs += ins->symreg_count;
+
+    info->defs      = mem_gc_allocate_n_zeroed_typed(imcc->interp,
+                            n_regs ? n_regs : 1, gvn_def_t);
+    info->ns_regs   = mem_gc_allocate_n_zeroed_typed(imcc->interp,
+                            n_regs ? n_regs : 1, const SymReg *);
+    info->n_defs    = 0;
+    info->n_ns_regs = 0;
+
+    for (ins = unit->instructions; ins; ins = ins->next) {
+        /* a call writes the results of the get_results after it */
+        const Instruction * const res = (ins->type & ITPCCSUB) && ins->next
+                && ins->next->op == &core_ops->op_info_table[PARROT_OP_get_results_pc]
+                ? ins->next : ins;
+        int k;
+
+        if (strncmp(ins->opname, "get_", 4) == 0
+        &&  strstr(ins->opname, "namespace")
+        &&  ins->symreg_count)
+            info->ns_regs[info->n_ns_regs++] = ins->symregs[0];
+
+        for (k = 0; k < res->symreg_count; k++) {
+            SymReg * const r = res->symregs[k];
+
+            if ((r->type & (VTREG | VTIDENTIFIER))
+            && !(r->type & (VTREGKEY | VTPASM | VTCONST))
+            && !(r->usage & U_LEXICAL)
+            &&  r->lhs_use_count == 1
+            &&  instruction_writes(ins, r)) {
+                gvn_def_t * const d = info->defs + info->n_defs++;
+                d->reg       = r;
+                d->def       = ins;
+                d->dominates = 1;
+            }
+        }
+    }
+
+    qsort(info->defs, info->n_defs, sizeof (gvn_def_t), gvn_def_cmp);
+
+    /* a register written twice by the same op */
+    for (i = j = 0; i < info->n_defs; i++)
+        if (!j || info->defs[j - 1].reg != info->defs[i].reg)
+            info->defs[j++] = info->defs[i];
+    info->n_defs = j;
+
+    for (ins = unit->instructions; ins; ins = ins->next) {
+        int k;
+
+        for (k = 0; k < ins->symreg_count; k++) {
+            const SymReg * const r = ins->symregs[k];
+            gvn_def_t          *d;
+
+            if (r->set == 'K') {
+                const SymReg *key;
+
+                for (key = r->nextkey; key; key = key->nextkey) {
+                    if (key->reg && (d = gvn_find_def(info, key->reg)) != NULL) {
+                        d->keyed = 1;
+                        if (!ins_dominates(unit, d->def, ins))
+                            d->dominates = 0;
+                    }
+                }
+            }
+            else if ((d = gvn_find_def(info, r)) != NULL
+                 &&  instruction_reads(ins, r)
+                 && !ins_dominates(unit, d->def, ins))
+                d->dominates = 0;
+        }
+    }
+}
+
+/*
+
+=item C<static gvn_kind_t gvn_candidate(imc_info_t *imcc, IMC_Unit *unit, const
+gvn_info_t *info, const Instruction *ins, int kills)>
+
+Returns the gvn_kind() of C<ins> if its value only depends on its operands
+there: its output register is written by C<ins> alone, which dominates all
+of its reads, every input register is written once before C<ins> on all
+paths, and no op of C<kills> changes the result of a lookup.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+static gvn_kind_t
+gvn_candidate(ARGMOD(imc_info_t *imcc), ARGIN(IMC_Unit *unit),
+        ARGIN(const gvn_info_t *info), ARGIN(const Instruction *ins), int kills)
+{
+    ASSERT_ARGS(gvn_candidate)
+    const gvn_kind_t kind = gvn_kind(imcc, unit, ins);
+    const gvn_def_t *d;
+    int              i;
+
+    if (kind == GVN_NONE
+    || (kind == GVN_GLOBAL && (kills & GVN_KILL_GLOBAL))
+    || (kind == GVN_LEX    && (kills & GVN_KILL_LEX))
+    || (kind == GVN_ATTR   && (kills & GVN_KILL_ATTR)))
+        return GVN_NONE;
+
+    d = gvn_find_def(info, ins->symregs[0]);
+    if (!d || d->def != ins || !d->dominates)
+        return GVN_NONE;
+
+    for (i = 1; i < ins->symreg_count; i++) {
+        const SymReg * const r = ins->symregs[i];
+
+        if (r->type & VTCONST)
+            continue;
+
+        d = gvn_find_def(info, r);
+        if (!d || !d->dominates)
+            return GVN_NONE;
+    }
+
+    return kind;
+}
+
+/*
+
+=item C<static int gvn_ins_cmp(const void *a, const void *b)>
+
+Orders instructions by their op and input operands, for C<qsort>, so that
+ops computing the same value are adjacent.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+static int
+gvn_ins_cmp(ARGIN(const void *a), ARGIN(const void *b))
+{
+    ASSERT_ARGS(gvn_ins_cmp)
+    const Instruction * const ia = *(const Instruction * const *)a;
+    const Instruction * const ib = *(const Instruction * const *)b;
+    int i;
+
+    if (ia->op != ib->op)
+        return ia->op < ib->op ? -1 : 1;
+
+    for (i = 1; i < ia->symreg_count; i++)
+        if (ia->symregs[i] != ib->symregs[i])
+            return ia->symregs[i] < ib->symregs[i] ? -1 : 1;
+
+    return 0;
+}
+
+/*
+
+=item C<static int value_numbering(imc_info_t *imcc, IMC_Unit *unit)>
+
+Deletes ops computing a value which an op dominating them already computed
+into another register, and uses that register instead:
+
+  $I2 = $I0 * $I1             $I2 = $I0 * $I1
+  ...                    =>   ...
+  $I3 = $I0 * $I1
+  $I4 = $I3 + 1               $I4 = $I2 + 1
+
+Only registers written by a single op take part, which makes the value of
+a register the same wherever it is read, like in SSA form. Lookups of a
+global, an outer lexical or an attribute with a constant name are folded
+the same way, as long as the unit doesn't store to them (see gvn_kills()).
+
+=cut
+
+*/
+
+static int
+value_numbering(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit))
+{
+    ASSERT_ARGS(value_numbering)
+    gvn_info_t    info;
+    Instruction **cands;
+    Instruction **dead;
+    Instruction  *ins;
+    unsigned int  n_ins   = 0;
+    unsigned int  n_cands = 0;
+    unsigned int  n_dead  = 0;
+    unsigned int  i, j, a, b;
+    int           kills   = 0;
+
+    if (!unit->n_basic_blocks || has_computed_jumps(unit))
+        return 0;
+
+    IMCC_info(imcc, 2, "\tvalue_numbering\n");
+    gvn_collect(imcc, unit, &info);
+
+    for (ins = unit->instructions; ins; ins = ins->next) {
+        kills |= gvn_kills(&info, ins);
+        n_ins++;
+    }
+
+    cands = mem_gc_allocate_n_zeroed_typed(imcc->interp, n_ins, Instruction *);
+    dead  = mem_gc_allocate_n_zeroed_typed(imcc->interp, n_ins, Instruction *);
+
+    for (ins = unit->instructions; ins; ins = ins->next)
+        if (gvn_candidate(imcc, unit, &info, ins, kills) != GVN_NONE)
+            cands[n_cands++] = ins;
+
+    qsort(cands, n_cands, sizeof (Instruction *), gvn_ins_cmp);
+
+    for (i = 0; i < n_cands; i = j) {
+        for (j = i + 1; j < n_cands; j++)
+            if (gvn_ins_cmp(cands + i, cands + j))
+                break;
+
+        for (a = i; a < j; a++) {
+            Instruction * const cur = cands[a];
+
+            if (gvn_find_def(&info, cur->symregs[0])->keyed)
+                continue;
+
+            for (b = i; b < j; b++) {
+                Instruction * const prev = cands[b];
+
+                if (b == a || !prev || gvn_ins_cmp(&prev, &cur)
+                || !ins_dominates(unit, prev, cur))
+                    continue;
+
+                IMCC_debug(imcc, DEBUG_OPT2, "redundant %d deleted, using %s\n",
+                        cur, prev->symregs[0]->name);
+
+                /* the register keeps the value of prev up to every read
+                 * of the one cur wrote, as prev dominates cur */
+                for (ins = unit->instructions; ins; ins = ins->next) {
+                    int k;
+
+                    if (ins == cur)
+                        continue;
+
+                    for (k = 0; k < ins->symreg_count; k++)
+                        if (ins->symregs[k] == cur->symregs[0])
+                            ins->symregs[k] = prev->symregs[0];
+                }
+
+                dead[n_dead++] = cur;
+                cands[a]       = NULL;
+                break;
+            }
+        }
+    }
+
+    for (i = 0; i < n_dead; i++) {
+        Instruction * const next = delete_ins(unit, dead[i]);
+        UNUSED(next);
+        unit->ostat.deleted_ins++;
+        unit->ostat.redundant++;
+    }
+
+    mem_gc_free(imcc->interp, dead);
+    mem_gc_free(imcc->interp, cands);
+    mem_gc_free(imcc->interp, info.ns_regs);
+    mem_gc_free(imcc->interp, info.defs);
+    return n_dead != 0;
+}
+
+/*
+
+=item C<static int always_executed(const IMC_Unit *unit, const Loop_info *loop,
+int bb)>
+
+Returns true if the block C<bb> of C<loop> runs whenever the loop is entered,
+i.e. it dominates every block leaving the loop.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+static int
+always_executed(ARGIN(const IMC_Unit *unit), ARGIN(const Loop_info *loop), int bb)
+{
+    ASSERT_ARGS(always_executed)
+    unsigned int i;
+
+    for (i = 0; i < unit->n_basic_blocks; i++) {
+        if (set_contains(loop->loop, i)
+        &&  (set_contains(loop->exits, i) || !unit->bb_list[i]->succ_list)
+        && !set_contains(unit->dominators[i], bb))
+            return 0;
+    }
+
+    return 1;
+}
+
+/*
+
+=item C<static int loop_invariants(imc_info_t *imcc, IMC_Unit *unit)>
+
+Moves ops of a loop whose operands are all set before the loop into the
+preheader of the loop, the block which leads into its header. Ops which may
+throw are only moved if they run in every iteration; the exception then
+happens in front of the loop instead of in its first iteration. Loops are
+handled from the innermost one, one loop per call, so that an op moved out
+of an inner loop may move further out later.
+
+=cut
+
+*/
+
+static int
+loop_invariants(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit))
+{
+    ASSERT_ARGS(loop_invariants)
+    gvn_info_t    info;
+    Instruction **hoist   = NULL;
+    unsigned int  n_hoist = 0;
+    unsigned int  size    = 0;
+    int           l;
+
+    if (!unit->n_loops || has_computed_jumps(unit))
+        return 0;
+
+    IMCC_info(imcc, 2, "\tloop_invariants\n");
+    gvn_collect(imcc, unit, &info);
+
+    /* loop_info is sorted by size, the inner loops come last */
+    for (l = unit->n_loops - 1; l >= 0 && !n_hoist; l--) {
+        const Loop_info * const loop = unit->loop_info[l];
+        const unsigned int      pre  = loop->preheader;
+        Instruction            *at;
+        unsigned int            i;
+        int                     kills = 0;
+
+        if (pre >= unit->n_basic_blocks)
+            continue;
+
+        /* insert at the end of the preheader, in front of its branch */
+        at = unit->bb_list[pre]->end;
+        if (at->type & ITBRANCH) {
+            if (!STREQ(at->opname, "branch"))
+                continue;
+            at = at->prev;
+        }
+        else if (at->type & (ITPCCSUB | ITPCCRET | ITPCCYIELD | ITCALL))
+            continue;
+
+        if (!at)
+            continue;
+
+        for (i = 0; i < unit->n_basic_blocks; i++) {
+            Instruction *ins;
+
+            if (!set_contains(loop->loop, i))
+                continue;
+
+            for (ins = unit->bb_list[i]->start; ins; ins = ins->next) {
+                kills |= gvn_kills(&info, ins);
+                if (ins == unit->bb_list[i]->end)
+                    break;
+            }
+        }
+
+        for (i = 0; i < unit->n_basic_blocks; i++) {
+            Instruction *ins;
+
+            if (!set_contains(loop->loop, i))
+                continue;
+
+            for (ins = unit->bb_list[i]->start; ins; ins = ins->next) {
+                const gvn_kind_t kind = gvn_candidate(imcc, unit, &info, ins, kills);
+                int              k;
+
+                if (kind != GVN_NONE
+                && ((kind != GVN_THROWS && kind != GVN_ATTR)
+                   || always_executed(unit, loop, i))) {
+
+                    for (k = 1; k < ins->symreg_count; k++) {
+                        const SymReg    * const r = ins->symregs[k];
+                        const gvn_def_t *d;
+                        int              bb;
+
+                        if (r->type & VTCONST)
+                            continue;
+
+                        d  = gvn_find_def(&info, r);
+                        bb = d->def->bbindex;
+                        if (set_contains(loop->loop, bb)
+                        || (bb != (int)pre
+                           && !set_contains(unit->dominators[pre], bb)))
+                            break;
+                    }
+
+                    if (k == ins->symreg_count) {
+                        if (n_hoist == size) {
+                            size  = size ? 2 * size : 8;
+                            hoist = mem_gc_realloc_n_typed(imcc->interp, hoist,
+                                        size, Instruction *);
+                        }
+                        hoist[n_hoist++] = ins;
+                    }
+                }
+
+                if (ins == unit->bb_list[i]->end)
+                    break;
+            }
+        }
+
+        for (i = 0; i < n_hoist; i++) {
+            IMCC_debug(imcc, DEBUG_OPT2, "loop invariant %d moved to block %d\n",
+                    hoist[i], pre);
+            move_ins(unit, hoist[i], at);
+            at = hoist[i];
+            unit->ostat.invariants_moved++;
+        }
+    }
+
+    if (hoist)
+        mem_gc_free(imcc->interp, hoist);
+    mem_gc_free(imcc->interp, info.ns_regs);
+    mem_gc_free(imcc->interp, info.defs);
+    return n_hoist != 0;
+}
+
+/*
+
+=item C<static SymReg * find_unit_lexical(imc_info_t *imcc, const IMC_Unit
+*unit, const SymReg *name)>
+
+Returns the register the constant lexical C<name> is declared with by
+C<.lex> in C<unit>, or NULL.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+PARROT_CAN_RETURN_NULL
+static SymReg *
+find_unit_lexical(ARGMOD(imc_info_t *imcc), ARGIN(const IMC_Unit *unit),
+        ARGIN(const SymReg *name))
+{
+    ASSERT_ARGS(find_unit_lexical)
+    const SymHash * const hsh      = &unit->hash;
+    STRING        * const lex_name = IMCC_string_from_reg(imcc, name);
+    unsigned int          i;
+
+    for (i = 0; i < hsh->size; i++) {
+        SymReg *r;
+
+        for (r = hsh->data[i]; r; r = r->next) {
+            const SymReg *n;
+
+            if (!(r->usage & U_LEXICAL))
+                continue;
+
+            for (n = r->reg; n; n = n->reg)
+                if (Parrot_str_equal(imcc->interp, lex_name, IMCC_string_from_reg(imcc, n)))
+                    return r;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+
+=item C<static SymReg * find_lexical_slot(imc_info_t *imcc, IMC_Unit *unit,
+SymReg *name, int set, INTVAL *depth, INTVAL *regno)>
+
+Resolves the constant lexical C<name> of register type C<set> by looking in
+C<unit> and then up its chain of C<:outer> subs, the same way
+C<Parrot_sub_find_pad> walks the outer contexts at runtime. Returns the
+lexical's register in C<unit> if it is declared there. Otherwise stores the
+number of outer hops in C<depth> and the register number in C<regno>,
+returning the name register. Returns NULL if the name is unknown, the types
+differ, or the lexical storage is HLL-mapped to something other than
+LexInfo/LexPad; the name based lookup must be kept then.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+PARROT_CAN_RETURN_NULL
+static SymReg *
+find_lexical_slot(ARGMOD(imc_info_t *imcc), ARGIN(IMC_Unit *unit),
+        ARGIN(SymReg *name), int set, ARGOUT(INTVAL *depth), ARGOUT(INTVAL *regno))
+{
+    ASSERT_ARGS(find_lexical_slot)
+    Interp        * const interp   = imcc->interp;
+    STRING        * const lex_name = IMCC_string_from_reg(imcc, name);
+    const INTVAL          reg_type = set == 'I' ? REGNO_INT :
+                                     set == 'N' ? REGNO_NUM :
+                                     set == 'S' ? REGNO_STR :
+                                                  REGNO_PMC;
+    SymReg       *lex;
+    PMC          *outer;
+
+    if (Parrot_hll_get_ctx_HLL_type(interp, enum_class_LexInfo) != enum_class_LexInfo
+    ||  Parrot_hll_get_ctx_HLL_type(interp, enum_class_LexPad)  != enum_class_LexPad)
+        return NULL;
+
+    lex = find_unit_lexical(imcc, unit, name);
+    if (lex) {
+        if (lex->set != set)
+            return NULL;
+
+        *depth = 0;
+        *regno = lex->color;
+        return lex;
+    }
+
+    *depth = 1;
+    for (outer = imcc_pbc_find_outer(imcc, unit); !PMC_IS_NULL(outer); ++*depth) {
+        Parrot_Sub_attributes *sub;
+        PMC_get_sub(interp, outer, sub);
+
+        if (!PMC_IS_NULL(sub->lex_info)) {
+            if (sub->lex_info->vtable->base_type != enum_class_LexInfo)
+                return NULL;
+
+            if (VTABLE_exists_keyed_str(interp, sub->lex_info, lex_name)) {
+                const INTVAL slot =
+                    VTABLE_get_integer_keyed_str(interp, sub->lex_info, lex_name);
+
+                if ((slot & 3) != reg_type)
+                    return NULL;
+
+                *regno = slot >> 2;
+                return name;
+            }
+        }
+
+        outer = sub->outer_sub;
+    }
+
+    return NULL;
+}
+
+/*
+
+=item C<static int lexical_slots(imc_info_t *imcc, IMC_Unit *unit)>
+
+Rewrites lexical access with a constant name to direct register access:
+
+  find_lex Px, 'name'  => set Px, Plex              (lexical of this unit)
+  store_lex 'name', Px => set Plex, Px
+  find_lex Px, 'name'  => find_lex_slot Px, depth, reg   (:outer lexical)
+  store_lex 'name', Px => store_lex_slot depth, reg, Px
+
+The name based ops are kept for lexicals that can't be resolved here, and
+remain the way to do dynamic lookups.
+
+=cut
+
+*/
+
+static int
+lexical_slots(ARGMOD(imc_info_t *imcc), ARGMOD(IMC_Unit *unit))
+{
+    ASSERT_ARGS(lexical_slots)
+    Instruction *ins;
+    int changes = 0;
+    op_lib_t *core_ops = PARROT_GET_CORE_OPLIB(imcc->interp);
+
+    IMCC_info(imcc, 2, "\tlexical_slots\n");
+    for (ins = unit->instructions; ins; ins = ins->next) {
+        SymReg *regs[3], *lex, *val;
+        INTVAL  depth, regno;
+        int     is_store;
+        char    buf[32];
+        Instruction *tmp;
+
+        if (ins->op == &core_ops->op_info_table[PARROT_OP_find_lex_p_sc]
+        ||  ins->op == &core_ops->op_info_table[PARROT_OP_find_lex_s_sc]
+        ||  ins->op == &core_ops->op_info_table[PARROT_OP_find_lex_i_sc]
+        ||  ins->op == &core_ops->op_info_table[PARROT_OP_find_lex_n_sc]) {
+            is_store = 0;
+            val      = ins->symregs[0];
+            lex      = find_lexical_slot(imcc, unit, ins->symregs[1], val->set,
+                            &depth, &regno);
+        }
+        else if (ins->op == &core_ops->op_info_table[PARROT_OP_store_lex_sc_p]
+             ||  ins->op == &core_ops->op_info_table[PARROT_OP_store_lex_sc_s]
+             ||  ins->op == &core_ops->op_info_table[PARROT_OP_store_lex_sc_sc]
+             ||  ins->op == &core_ops->op_info_table[PARROT_OP_store_lex_sc_i]
+             ||  ins->op == &core_ops->op_info_table[PARROT_OP_store_lex_sc_ic]
+             ||  ins->op == &core_ops->op_info_table[PARROT_OP_store_lex_sc_n]
+             ||  ins->op == &core_ops->op_info_table[PARROT_OP_store_lex_sc_nc]) {
+            is_store = 1;
+            val      = ins->symregs[1];
+            lex      = find_lexical_slot(imcc, unit, ins->symregs[0], val->set,
+                            &depth, &regno);
+        }
+        else
+            continue;
+
+        if (!lex)
+            continue;
+
+        IMCC_debug(imcc, DEBUG_OPT1, "opt1 %d => ", ins);
+        if (depth == 0) {
+            regs[0] = is_store ? lex : val;
+            regs[1] = is_store ? val : lex;
+            tmp     = INS(imcc, unit, "set", "", regs, 2, 0, 0);
+        }
+        else {
+            snprintf(buf, sizeof (buf), "%d", (int)depth);
+            regs[is_store ? 0 : 1] = mk_const(imcc, buf, 'I');
+            snprintf(buf, sizeof (buf), "%d", (int)regno);
+            regs[is_store ? 1 : 2] = mk_const(imcc, buf, 'I');
+            regs[is_store ? 2 : 0] = val;
+            tmp = INS(imcc, unit, is_store ? "store_lex_slot" : "find_lex_slot",
+                        "", regs, 3, 0, 0);
+        }
+        IMCC_debug(imcc, DEBUG_OPT1, "%d\n", tmp);
+        subst_ins(unit, ins, tmp, 1);
+        ins = tmp;
+        changes = 1;
+    }
+    return changes;
+}
+
+/*
+
 =back
 
 =cut
@@ -137,42 +137,33 @@ static PMC* create_lexinfo(
         FUNC_MODIFIES(*unit)
         FUNC_MODIFIES(* bc);
 
-PARROT_WARN_UNUSED_RESULT
-PARROT_CAN_RETURN_NULL
-static subs_t * find_global_label(
+static void destroy_sub_indexes(
     ARGMOD(imc_info_t * imcc),
-    ARGIN(const char *name),
-    ARGIN(const subs_t *sym),
-    ARGOUT(int *pc))
+    ARGMOD(code_segment_t *cs))
         __attribute__nonnull__(1)
         __attribute__nonnull__(2)
-        __attribute__nonnull__(3)
-        __attribute__nonnull__(4)
         FUNC_MODIFIES(* imcc)
-        FUNC_MODIFIES(*pc);
+        FUNC_MODIFIES(*cs);
 
 PARROT_WARN_UNUSED_RESULT
 PARROT_CAN_RETURN_NULL
-static PMC* find_outer(
+static subs_t * find_global_label(
     ARGMOD(imc_info_t * imcc),
-    ARGIN(const IMC_Unit *unit))
+    ARGIN(const char *name),
+    ARGIN(const subs_t *sym))
         __attribute__nonnull__(1)
         __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
         FUNC_MODIFIES(* imcc);
 
 PARROT_WARN_UNUSED_RESULT
 PARROT_CAN_RETURN_NULL
 static subs_t * find_sub_by_subid(
     ARGMOD(imc_info_t * imcc),
-    ARGIN(const char *lookup),
-    ARGIN(const subs_t *sym),
-    ARGOUT(int *pc))
+    ARGIN(const char *lookup))
         __attribute__nonnull__(1)
         __attribute__nonnull__(2)
-        __attribute__nonnull__(3)
-        __attribute__nonnull__(4)
-        FUNC_MODIFIES(* imcc)
-        FUNC_MODIFIES(*pc);
+        FUNC_MODIFIES(* imcc);
 
 static void fixup_globals(ARGMOD(imc_info_t * imcc))
         __attribute__nonnull__(1)
@@ -204,6 +195,12 @@ static void imcc_globals_destroy(PARROT_INTERP, int ex, ARGMOD(void *param))
         __attribute__nonnull__(3)
         FUNC_MODIFIES(*param);
 
+static void index_sub(ARGMOD(imc_info_t * imcc), ARGMOD(subs_t *s))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(* imcc)
+        FUNC_MODIFIES(*s);
+
 static void init_fixedintegerarray_from_string(
     ARGMOD(imc_info_t * imcc),
     ARGIN(PMC *p),
@@ -213,6 +210,18 @@ static void init_fixedintegerarray_from_string(
         __attribute__nonnull__(3)
         FUNC_MODIFIES(* imcc);
 
+PARROT_PURE_FUNCTION
+PARROT_WARN_UNUSED_RESULT
+static int is_folded(ARGIN(const SymReg *r))
+        __attribute__nonnull__(1);
+
+PARROT_MALLOC
+PARROT_CANNOT_RETURN_NULL
+static char * make_label_key(
+    ARGIN(const char *name),
+    ARGIN_NULLOK(const SymReg *ns))
+        __attribute__nonnull__(1);
+
 static void make_new_sub(ARGMOD(imc_info_t * imcc), ARGIN(IMC_Unit *unit))
         __attribute__nonnull__(1)
         __attribute__nonnull__(2)
@@ -313,19 +322,16 @@ static void verify_signature(
     , PARROT_ASSERT_ARG(unit) \
     , PARROT_ASSERT_ARG(sub_pmc) \
     , PARROT_ASSERT_ARG(bc))
+#define ASSERT_ARGS_destroy_sub_indexes __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(cs))
 #define ASSERT_ARGS_find_global_label __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc) \
     , PARROT_ASSERT_ARG(name) \
-    , PARROT_ASSERT_ARG(sym) \
-    , PARROT_ASSERT_ARG(pc))
-#define ASSERT_ARGS_find_outer __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
-       PARROT_ASSERT_ARG(imcc) \
-    , PARROT_ASSERT_ARG(unit))
+    , PARROT_ASSERT_ARG(sym))
 #define ASSERT_ARGS_find_sub_by_subid __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc) \
-    , PARROT_ASSERT_ARG(lookup) \
-    , PARROT_ASSERT_ARG(sym) \
-    , PARROT_ASSERT_ARG(pc))
+    , PARROT_ASSERT_ARG(lookup))
 #define ASSERT_ARGS_fixup_globals __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc))
 #define ASSERT_ARGS_get_code_size __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
@@ -338,11 +344,18 @@ static void verify_signature(
     , PARROT_ASSERT_ARG(ins_line))
 #define ASSERT_ARGS_imcc_globals_destroy __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(param))
+#define ASSERT_ARGS_index_sub __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(s))
 #define ASSERT_ARGS_init_fixedintegerarray_from_string \
      __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc) \
     , PARROT_ASSERT_ARG(p) \
     , PARROT_ASSERT_ARG(s))
+#define ASSERT_ARGS_is_folded __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(r))
+#define ASSERT_ARGS_make_label_key __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(name))
 #define ASSERT_ARGS_make_new_sub __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc) \
     , PARROT_ASSERT_ARG(unit))
@@ -400,11 +413,14 @@ imcc_globals_destroy(SHIM_INTERP, SHIM(int ex), ARGMOD(void *param))
             while (s) {
                 subs_t * const prev_s = s->prev;
                 clear_sym_hash(&s->fixup);
+                if (s->label_key)
+                    mem_sys_free(s->label_key);
                 mem_sys_free(s);
                 s = prev_s;
             }
 
             clear_sym_hash(&cs->key_consts);
+            destroy_sub_indexes(imcc, cs);
             mem_sys_free(cs);
             cs = prev_cs;
         }
@@ -429,20 +445,8 @@ add_const_table_pmc(ARGMOD(imc_info_t * imcc), ARGIN(PMC *pmc))
 {
     ASSERT_ARGS(add_const_table_pmc)
     PackFile_ByteCode * const bc = Parrot_pf_get_current_code_segment(imcc->interp);
-    PackFile_ConstTable * const ct = bc->const_table;
 
-    if (!ct->pmc.constants)
-        ct->pmc.constants =
-            mem_gc_allocate_n_zeroed_typed(imcc->interp, 1, PMC *);
-    else
-        ct->pmc.constants =
-            mem_gc_realloc_n_typed_zeroed(imcc->interp, ct->pmc.constants,
-                ct->pmc.const_count + 1, ct->pmc.const_count, PMC *);
-
-
-    ct->pmc.constants[ct->pmc.const_count++] = pmc;
-
-    return ct->pmc.const_count - 1;
+    return PackFile_ConstTable_push_pmc(imcc->interp, bc->const_table, pmc);
 }
 
 
@@ -469,8 +473,10 @@ e_pbc_open(ARGMOD(imc_info_t * imcc))
     if (!imcc->globals)
         imcc->globals = mem_gc_allocate_zeroed_typed(imcc->interp, imcc_globals);
 
-    if (imcc->globals->cs)
+    if (imcc->globals->cs) {
         clear_sym_hash(&imcc->globals->cs->key_consts);
+        destroy_sub_indexes(imcc, imcc->globals->cs);
+    }
     else {
         /* register cleanup code */
         Parrot_x_on_exit(imcc->interp, imcc_globals_destroy, imcc);
@@ -479,6 +485,9 @@ e_pbc_open(ARGMOD(imc_info_t * imcc))
     /* free previous cached key constants if any */
     create_symhash(imcc, &cs->key_consts);
 
+    cs->labels = Parrot_hash_create(imcc->interp, enum_type_ptr, Hash_key_type_cstring);
+    cs->subids = Parrot_hash_create(imcc->interp, enum_type_ptr, Hash_key_type_cstring);
+
     cs->next     = NULL;
     cs->prev     = imcc->globals->cs;
     cs->subs     = NULL;
@@ -547,19 +556,16 @@ get_old_size(ARGMOD(imc_info_t * imcc), ARGIN(PackFile_ByteCode * bc),
         ARGOUT(int *ins_line))
 {
     ASSERT_ARGS(get_old_size)
-    size_t size = 0;
 
     *ins_line   = 0;
 
-    if (imcc->globals->cs && bc->base.data) {
-        const subs_t *s;
-        for (s = imcc->globals->cs->subs; s; s = s->prev) {
-            size      += s->size;
-            *ins_line += s->ins_line;
-        }
-    }
+    if (!imcc->globals->cs || !bc->base.data)
+        return 0;
 
-    return size;
+    /* kept up to date by store_sub_size */
+    *ins_line = imcc->globals->cs->ins_lines;
+
+    return imcc->globals->cs->code_size;
 }
 
 
@@ -578,8 +584,13 @@ static void
 store_sub_size(ARGMOD(imc_info_t * imcc), size_t size, size_t ins_line)
 {
     ASSERT_ARGS(store_sub_size)
-    imcc->globals->cs->subs->size     = size;
-    imcc->globals->cs->subs->ins_line = ins_line;
+    code_segment_t * const cs = imcc->globals->cs;
+
+    cs->code_size += size     - cs->subs->size;
+    cs->ins_lines += ins_line - cs->subs->ins_line;
+
+    cs->subs->size     = size;
+    cs->subs->ins_line = ins_line;
 }
 
 
@@ -824,13 +835,104 @@ bytecode_map_op(ARGMOD(imc_info_t * imcc), op_info_t *info) {
 }
 
 
+/*
+
+=item C<static char * make_label_key(const char *name, const SymReg *ns)>
+
+Returns a newly allocated key for the sub label C<name> in the namespace
+C<ns>, under which it's indexed in the current code segment's C<labels>.
+The length of the namespace name is part of the key, so that names and
+namespaces can't run into each other.
+
+=cut
+
+*/
+
+PARROT_MALLOC
+PARROT_CANNOT_RETURN_NULL
+static char *
+make_label_key(ARGIN(const char *name), ARGIN_NULLOK(const SymReg *ns))
+{
+    ASSERT_ARGS(make_label_key)
+    const size_t ns_len = ns ? strlen(ns->name) : 0;
+    const size_t len    = ns_len + strlen(name) + 24;
+    char * const key    = (char *)mem_sys_allocate(len);
+
+    if (ns)
+        snprintf(key, len, "%lu:%s%s", (unsigned long)ns_len, ns->name, name);
+    else
+        snprintf(key, len, "-%s", name);
+
+    return key;
+}
+
+/*
+
+=item C<static void index_sub(imc_info_t * imcc, subs_t *s)>
+
+Enters the finished sub C<s> into the label and subid indexes of the current
+code segment, unless an earlier sub already has its label (in the same
+namespace) or subid.  The label and subid can't change after the sub is
+emitted.
+
+=cut
+
+*/
+
+static void
+index_sub(ARGMOD(imc_info_t * imcc), ARGMOD(subs_t *s))
+{
+    ASSERT_ARGS(index_sub)
+    code_segment_t * const cs = imcc->globals->cs;
+    SymReg         * const r  = s->unit->instructions->symregs[0];
+
+    if (!r)
+        return;
+
+    if (r->name) {
+        s->label_key = make_label_key(r->name, s->unit->_namespace);
+
+        if (!Parrot_hash_exists(imcc->interp, cs->labels, s->label_key))
+            Parrot_hash_put(imcc->interp, cs->labels, s->label_key, s);
+    }
+
+    if (r->subid && !Parrot_hash_exists(imcc->interp, cs->subids, r->subid->name))
+        Parrot_hash_put(imcc->interp, cs->subids, r->subid->name, s);
+}
+
+/*
+
+=item C<static void destroy_sub_indexes(imc_info_t * imcc, code_segment_t *cs)>
+
+Frees the label and subid indexes of C<cs>, once it's done with.
+
+=cut
+
+*/
+
+static void
+destroy_sub_indexes(ARGMOD(imc_info_t * imcc), ARGMOD(code_segment_t *cs))
+{
+    ASSERT_ARGS(destroy_sub_indexes)
+
+    if (cs->labels) {
+        Parrot_hash_destroy(imcc->interp, cs->labels);
+        cs->labels = NULL;
+    }
+
+    if (cs->subids) {
+        Parrot_hash_destroy(imcc->interp, cs->subids);
+        cs->subids = NULL;
+    }
+}
+
 /*
 
 =item C<static subs_t * find_global_label(imc_info_t * imcc, const char *name,
-const subs_t *sym, int *pc)>
+const subs_t *sym)>
 
-Finds a global label, returning the symreg (and setting the (absolute) pc
-through the out parameter).
+Finds the first sub with the global label C<name> in the namespace of the sub
+C<sym>.
 
 =cut
 
@@ -840,32 +942,21 @@ PARROT_WARN_UNUSED_RESULT
 PARROT_CAN_RETURN_NULL
 static subs_t *
 find_global_label(ARGMOD(imc_info_t * imcc), ARGIN(const char *name),
-    ARGIN(const subs_t *sym), ARGOUT(int *pc))
+    ARGIN(const subs_t *sym))
 {
     ASSERT_ARGS(find_global_label)
-    subs_t *s;
-
-    *pc = 0;
+    char   * const key = make_label_key(name, sym->unit->_namespace);
+    subs_t * const s   = (subs_t *)Parrot_hash_get(imcc->interp,
+                                        imcc->globals->cs->labels, key);
 
-    for (s = imcc->globals->cs->first; s; s = s->next) {
-        const SymReg * const r = s->unit->instructions->symregs[0];
-
-        /* if names and namespaces are matching - ok */
-        if (r && r->name && (strcmp(r->name, name) == 0)
-                && ((sym->unit->_namespace && s->unit->_namespace
-                        && (strcmp(sym->unit->_namespace->name, s->unit->_namespace->name) == 0))
-                    || (!sym->unit->_namespace && !s->unit->_namespace)))
-            return s;
-
-        *pc += s->size;
-    }
-    return NULL;
+    mem_sys_free(key);
+    return s;
 }
 
 /*
 
-=item C<static subs_t * find_sub_by_subid(imc_info_t * imcc, const char *lookup,
-const subs_t *sym, int *pc)>
+=item C<static subs_t * find_sub_by_subid(imc_info_t * imcc, const char
+*lookup)>
 
 Find the first sub in the current code segment with a given subid.
 
@@ -876,25 +967,11 @@ Find the first sub in the current code segment with a given subid.
 PARROT_WARN_UNUSED_RESULT
 PARROT_CAN_RETURN_NULL
 static subs_t *
-find_sub_by_subid(ARGMOD(imc_info_t * imcc), ARGIN(const char *lookup),
-    ARGIN(const subs_t *sym), ARGOUT(int *pc))
+find_sub_by_subid(ARGMOD(imc_info_t * imcc), ARGIN(const char *lookup))
 {
     ASSERT_ARGS(find_sub_by_subid)
-    subs_t *s;
-    UNUSED(sym);
-
-    *pc = 0;
-
-    for (s = imcc->globals->cs->first; s; s = s->next) {
-        const SymReg * const r = s->unit->instructions->symregs[0];
-
-        /* if subid matches - ok */
-        if (r && (r->subid && (strcmp(r->subid->name, lookup) == 0)))
-            return s;
 
-        *pc += s->size;
-    }
-    return NULL;
+    return (subs_t *)Parrot_hash_get(imcc->interp, imcc->globals->cs->subids, lookup);
 }
 
 /*
@@ -924,7 +1001,7 @@ fixup_globals(ARGMOD(imc_info_t * imcc))
             SymReg *fixup;
 
             for (fixup = hsh->data[i]; fixup; fixup = fixup->next) {
-                int pc, pmc_const;
+                int pmc_const;
                 const int addr = jumppc + fixup->color;
                 int subid_lookup = 0;
                 subs_t *s1;
@@ -934,11 +1011,10 @@ fixup_globals(ARGMOD(imc_info_t * imcc))
                     s1 = NULL;
                 else if (fixup->usage & U_SUBID_LOOKUP) {
                     subid_lookup = 1;
-                    /* s1 = find_sub_by_subid(interp, fixup->name, &pc); */
-                    s1 = find_sub_by_subid(imcc, fixup->name, s, &pc);
+                    s1 = find_sub_by_subid(imcc, fixup->name);
                 }
                 else if (fixup->usage & U_LEXINFO_LOOKUP) {
-                    s1 = find_sub_by_subid(imcc, fixup->name, s, &pc);
+                    s1 = find_sub_by_subid(imcc, fixup->name);
                     if (!s1 || s1->pmc_const == -1)
                         IMCC_fataly(imcc, EXCEPTION_INVALID_OPERATION,
                                 "Sub '%s' not found\n", fixup->name);
@@ -956,7 +1032,7 @@ fixup_globals(ARGMOD(imc_info_t * imcc))
                     continue;
                 }
                 else
-                    s1 = find_global_label(imcc, fixup->name, s, &pc);
+                    s1 = find_global_label(imcc, fixup->name, s);
 
                 /*
                  * if failed change opcode:
@@ -1159,25 +1235,19 @@ add_const_str(ARGMOD(imc_info_t * imcc), ARGIN(STRING *s),
     if (i >= 0)
         return i;
 
-
-    if (!ct->str.constants)
-        ct->str.constants = mem_gc_allocate_n_zeroed_typed(imcc->interp, 1, STRING *);
-
-    else
-        ct->str.constants = mem_gc_realloc_n_typed_zeroed(imcc->interp,
-                ct->str.constants, ct->str.const_count + 1, ct->str.const_count, STRING *);
-
     /* initialize rlookup cache */
-    if (!ct->string_hash)
+    if (!ct->string_hash) {
+        opcode_t k;
+
         ct->string_hash = Parrot_hash_create(imcc->interp, enum_type_INTVAL,
                 Hash_key_type_STRING_enc);
 
-    ct->str.constants[ct->str.const_count] = s;
-
-    Parrot_hash_put(imcc->interp, ct->string_hash, s,
-        (void *)ct->str.const_count);
+        for (k = 0; k < ct->str.const_count; k++)
+            Parrot_hash_put(imcc->interp, ct->string_hash, ct->str.constants[k],
+                (void *)k);
+    }
 
-    return ct->str.const_count++;
+    return PackFile_ConstTable_push_str(imcc->interp, ct, s);
 }
 
 
@@ -1198,18 +1268,10 @@ add_const_num(ARGMOD(imc_info_t * imcc), ARGIN_NULLOK(const char *buf),
         ARGMOD(PackFile_ByteCode * bc))
 {
     ASSERT_ARGS(add_const_num)
-    PackFile_ConstTable *ct = bc->const_table;
-    STRING * const s        = Parrot_str_new(imcc->interp, buf, 0);
+    STRING * const s = Parrot_str_new(imcc->interp, buf, 0);
 
-    if (!ct->num.constants)
-        ct->num.constants = mem_gc_allocate_n_zeroed_typed(imcc->interp, 1, FLOATVAL);
-    else
-        ct->num.constants = mem_gc_realloc_n_typed_zeroed(imcc->interp,
-                ct->num.constants, ct->num.const_count + 1, ct->num.const_count, FLOATVAL);
-
-    ct->num.constants[ct->num.const_count] = Parrot_str_to_num(imcc->interp, s);
-
-    return ct->num.const_count++;
+    return PackFile_ConstTable_push_num(imcc->interp, bc->const_table,
+                Parrot_str_to_num(imcc->interp, s));
 }
 
 
@@ -1361,7 +1423,7 @@ create_lexinfo(ARGMOD(imc_info_t * imcc), ARGMOD(IMC_Unit *unit),
 
 /*
 
-=item C<static PMC* find_outer(imc_info_t * imcc, const IMC_Unit *unit)>
+=item C<PMC* imcc_pbc_find_outer(imc_info_t * imcc, const IMC_Unit *unit)>
 
 Returns any :outer sub for the current compilation unit.
 
@@ -1371,10 +1433,10 @@ Returns any :outer sub for the current compilation unit.
 
 PARROT_WARN_UNUSED_RESULT
 PARROT_CAN_RETURN_NULL
-static PMC*
-find_outer(ARGMOD(imc_info_t * imcc), ARGIN(const IMC_Unit *unit))
+PMC*
+imcc_pbc_find_outer(ARGMOD(imc_info_t * imcc), ARGIN(const IMC_Unit *unit))
 {
-    ASSERT_ARGS(find_outer)
+    ASSERT_ARGS(imcc_pbc_find_outer)
     subs_t      *s;
     PMC         *current;
     char        *cur_name_str;
@@ -1396,11 +1458,10 @@ find_outer(ARGMOD(imc_info_t * imcc), ARGIN(const IMC_Unit *unit))
     if (!len)
         return NULL;
 
-    for (s = imcc->globals->cs->first; s; s = s->next) {
-        if (STREQ(s->unit->subid->name, unit->outer->name)) {
-            PObj_get_FLAGS(s->unit->sub_pmc) |= SUB_FLAG_IS_OUTER;
-            return s->unit->sub_pmc;
-        }
+    s = find_sub_by_subid(imcc, unit->outer->name);
+    if (s) {
+        PObj_get_FLAGS(s->unit->sub_pmc) |= SUB_FLAG_IS_OUTER;
+        return s->unit->sub_pmc;
     }
 
     /* could be eval too; check if :outer is the current sub. If not, look
@@ -1580,7 +1641,7 @@ add_const_pmc_sub(ARGMOD(imc_info_t * imcc), ARGMOD(SymReg *r), size_t offs,
 
     sub->lex_info     = create_lexinfo(imcc, unit, sub_pmc,
                                         r->pcc_sub->pragma & P_NEED_LEX, interp_code);
-    sub->outer_sub    = find_outer(imcc, unit);
+    sub->outer_sub    = imcc_pbc_find_outer(imcc, unit);
     sub->vtable_index = -1;
 
     /* check if it's declared multi */
@@ -2130,6 +2191,44 @@ add_1_const(ARGMOD(imc_info_t * imcc), ARGMOD(SymReg *r),
 }
 
 
+/*
+
+=item C<static int is_folded(const SymReg *r)>
+
+Returns whether C<constant_folding> is done with the global symbol C<r>,
+having just passed it to C<add_1_const>: it's in the constant table, or it's a
+kind of symbol (like a label, or the subid of a C<.const 'Sub'>) that is
+resolved later.  Anything else is kept, even if it isn't a constant or not
+used yet, as using the same name as a constant later turns it into one: the
+name of a namespace is also the string constant of a method call.
+
+=cut
+
+*/
+
+PARROT_PURE_FUNCTION
+PARROT_WARN_UNUSED_RESULT
+static int
+is_folded(ARGIN(const SymReg *r))
+{
+    ASSERT_ARGS(is_folded)
+
+    if (r->color >= 0)
+        return 1;
+
+    switch (r->set) {
+      case 'I':
+      case 'S':
+      case 'N':
+      case 'K':
+      case 'P':
+        return 0;
+      default:
+        return 1;
+    }
+}
+
+
 /*
 
 =item C<static void constant_folding(imc_info_t * imcc, const IMC_Unit *unit,
@@ -2146,29 +2245,33 @@ constant_folding(ARGMOD(imc_info_t * imcc), ARGIN(const IMC_Unit *unit),
         ARGMOD(PackFile_ByteCode * bc))
 {
     ASSERT_ARGS(constant_folding)
-    const SymHash *hsh = &imcc->ghash;
+    const SymHash *hsh;
+    SymReg       **link = &imcc->ghash.unfolded;
     unsigned int   i;
 
-    /* go through all consts of current sub */
-    for (i = 0; i < hsh->size; i++) {
-        SymReg *r;
+    /* go through all consts of current sub; normally constants are in
+     * ghash, but only those not folded for an earlier sub need a look */
+    while (*link) {
+        SymReg * const r = *link;
 
-        /* normally constants are in ghash ... */
-        for (r = hsh->data[i]; r; r = r->next) {
-            if (r->type & (VTCONST|VT_CONSTP))
-                add_1_const(imcc, r, bc);
+        if (r->type & (VTCONST|VT_CONSTP))
+            add_1_const(imcc, r, bc);
 
-            if (r->usage & U_LEXICAL) {
-                SymReg *n = r->reg;
+        if (r->usage & U_LEXICAL) {
+            SymReg *n = r->reg;
 
-                /* r->reg is a chain of names for the same lex sym */
-                while (n) {
-                    /* lex_name */
-                    add_1_const(imcc, n, bc);
-                    n = n->reg;
-                }
+            /* r->reg is a chain of names for the same lex sym */
+            while (n) {
+                /* lex_name */
+                add_1_const(imcc, n, bc);
+                n = n->reg;
             }
         }
+
+        if (is_folded(r))
+            *link = r->next_unfolded;
+        else
+            link = &r->next_unfolded;
     }
 
     /* ... but keychains 'K' are in local hash, they may contain
@@ -2232,6 +2335,8 @@ e_pbc_end_sub(ARGMOD(imc_info_t * imcc), SHIM(void *param), ARGIN(IMC_Unit *unit
     if (!ins)
         return;
 
+    index_sub(imcc, imcc->globals->cs->subs);
+
     /*
      * if the sub was marked IMMEDIATE, we run it now
      * This is *dangerous*: all possible global state can be messed
@@ -21,6 +21,10 @@ The following parts are just missing:
  - Renumbering
  - Coalescing
 
+With C<-Or> (implied by C<-O2>) registers are instead allocated by a linear
+scan over live ranges computed from the CFG, so registers whose live ranges
+don't overlap share a parrot register and call frames get smaller.
+
 =head2 Functions
 
 =over 4
@@ -32,12 +36,39 @@ The following parts are just missing:
 #include <string.h>
 #include "imc.h"
 #include "optimizer.h"
+#include "parrot/oplib/core_ops.h"
+
+/* The live range of a register, as the span of instruction indices on which
+ * its value is needed */
+typedef struct _live_range {
+    int     start;
+    int     end;
+    SymReg *reg;
+} Live_range;
+
+/* Units with more basic blocks * symbols than this use the vanilla allocator,
+ * the life analysis needs three sets of that many bits */
+#define LIVE_RANGE_MAX_BITS (1 << 24)
 
 /* HEADERIZER HFILE: compilers/imcc/imc.h */
 
 /* HEADERIZER BEGIN: static */
 /* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
 
+static unsigned int add_ins_reg(
+    ARGMOD(imc_info_t * imcc),
+    ARGIN(SymReg *r),
+    ARGMOD(SymReg ***regs),
+    ARGMOD(unsigned int *size),
+    unsigned int n)
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        __attribute__nonnull__(4)
+        FUNC_MODIFIES(* imcc)
+        FUNC_MODIFIES(*regs)
+        FUNC_MODIFIES(*size);
+
 static void allocate_lexicals(
     ARGMOD(imc_info_t * imcc),
     ARGMOD(IMC_Unit *unit))
@@ -55,21 +86,51 @@ static void allocate_uniq(
         FUNC_MODIFIES(* imcc)
         FUNC_MODIFIES(*unit);
 
+static void build_life_info(
+    ARGMOD(imc_info_t * imcc),
+    ARGMOD(IMC_Unit *unit))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(* imcc)
+        FUNC_MODIFIES(*unit);
+
 static void build_reglist(ARGMOD(imc_info_t * imcc), ARGMOD(IMC_Unit *unit))
         __attribute__nonnull__(1)
         __attribute__nonnull__(2)
         FUNC_MODIFIES(* imcc)
         FUNC_MODIFIES(*unit);
 
+PARROT_WARN_UNUSED_RESULT
+static int can_share_registers(
+    ARGIN(const imc_info_t * imcc),
+    ARGIN(const IMC_Unit *unit))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
 static void compute_du_chain(ARGMOD(IMC_Unit *unit))
         __attribute__nonnull__(1)
         FUNC_MODIFIES(*unit);
 
+static void compute_live_ranges(
+    ARGMOD(imc_info_t * imcc),
+    ARGMOD(IMC_Unit *unit),
+    ARGOUT(Live_range *ranges))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        FUNC_MODIFIES(* imcc)
+        FUNC_MODIFIES(*unit)
+        FUNC_MODIFIES(*ranges);
+
 static void compute_one_du_chain(ARGMOD(SymReg *r), ARGIN(IMC_Unit *unit))
         __attribute__nonnull__(1)
         __attribute__nonnull__(2)
         FUNC_MODIFIES(*r);
 
+static void extend_live_range(ARGMOD(Live_range *range), int index)
+        __attribute__nonnull__(1)
+        FUNC_MODIFIES(*range);
+
 PARROT_WARN_UNUSED_RESULT
 static unsigned int first_avail(
     ARGMOD(imc_info_t * imcc),
@@ -85,6 +146,37 @@ static void imc_stat_init(ARGMOD(IMC_Unit *unit))
         __attribute__nonnull__(1)
         FUNC_MODIFIES(*unit);
 
+static unsigned int ins_regs(
+    ARGMOD(imc_info_t * imcc),
+    ARGIN(const Instruction *ins),
+    ARGMOD(SymReg ***regs),
+    ARGMOD(unsigned int *size))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        __attribute__nonnull__(4)
+        FUNC_MODIFIES(* imcc)
+        FUNC_MODIFIES(*regs)
+        FUNC_MODIFIES(*size);
+
+static void linear_scan_reg_alloc(
+    ARGMOD(imc_info_t * imcc),
+    ARGMOD(IMC_Unit *unit))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(* imcc)
+        FUNC_MODIFIES(*unit);
+
+PARROT_WARN_UNUSED_RESULT
+static int live_range_end_cmp(ARGIN(const void *a), ARGIN(const void *b))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+PARROT_WARN_UNUSED_RESULT
+static int live_range_start_cmp(ARGIN(const void *a), ARGIN(const void *b))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
 static void make_stat(
     ARGMOD(IMC_Unit *unit),
     ARGMOD_NULLOK(int *sets),
@@ -117,25 +209,56 @@ static void vanilla_reg_alloc(
         FUNC_MODIFIES(* imcc)
         FUNC_MODIFIES(*unit);
 
+#define ASSERT_ARGS_add_ins_reg __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(r) \
+    , PARROT_ASSERT_ARG(regs) \
+    , PARROT_ASSERT_ARG(size))
 #define ASSERT_ARGS_allocate_lexicals __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc) \
     , PARROT_ASSERT_ARG(unit))
 #define ASSERT_ARGS_allocate_uniq __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc) \
     , PARROT_ASSERT_ARG(unit))
+#define ASSERT_ARGS_build_life_info __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit))
 #define ASSERT_ARGS_build_reglist __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc) \
     , PARROT_ASSERT_ARG(unit))
+#define ASSERT_ARGS_can_share_registers __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit))
 #define ASSERT_ARGS_compute_du_chain __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(unit))
+#define ASSERT_ARGS_compute_live_ranges __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit) \
+    , PARROT_ASSERT_ARG(ranges))
 #define ASSERT_ARGS_compute_one_du_chain __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(r) \
     , PARROT_ASSERT_ARG(unit))
+#define ASSERT_ARGS_extend_live_range __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(range))
 #define ASSERT_ARGS_first_avail __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc) \
     , PARROT_ASSERT_ARG(unit))
 #define ASSERT_ARGS_imc_stat_init __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(unit))
+#define ASSERT_ARGS_ins_regs __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(ins) \
+    , PARROT_ASSERT_ARG(regs) \
+    , PARROT_ASSERT_ARG(size))
+#define ASSERT_ARGS_linear_scan_reg_alloc __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(unit))
+#define ASSERT_ARGS_live_range_end_cmp __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(a) \
+    , PARROT_ASSERT_ARG(b))
+#define ASSERT_ARGS_live_range_start_cmp __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(a) \
+    , PARROT_ASSERT_ARG(b))
 #define ASSERT_ARGS_make_stat __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(unit))
 #define ASSERT_ARGS_print_stat __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
@@ -167,7 +290,6 @@ void
 imc_reg_alloc(ARGMOD(imc_info_t * imcc), ARGIN_NULLOK(IMC_Unit *unit))
 {
     ASSERT_ARGS(imc_reg_alloc)
-    const char *function;
 
     if (!unit)
         return;
@@ -175,9 +297,37 @@ imc_reg_alloc(ARGMOD(imc_info_t * imcc), ARGIN_NULLOK(IMC_Unit *unit))
     if (!unit->instructions)
         return;
 
+    imc_reg_alloc_prepare(imcc, unit);
+    imc_reg_alloc_registers(imcc, unit);
+    imc_reg_alloc_finish(imcc, unit);
+}
+
+/*
+
+=item C<void imc_reg_alloc_prepare(imc_info_t * imcc, IMC_Unit *unit)>
+
+The first step of imc_reg_alloc(): expands the PCC calls, builds the CFG and
+runs the optimizations. Optimizations which need the life info build it as
+well, otherwise that is left to imc_reg_alloc_registers(). This step calls
+into the interpreter and adds constants, and must not run concurrently with
+any other IMCC work.
+
+=cut
+
+*/
+
+void
+imc_reg_alloc_prepare(ARGMOD(imc_info_t * imcc), ARGMOD(IMC_Unit *unit))
+{
+    ASSERT_ARGS(imc_reg_alloc_prepare)
+    const char *function;
+    int         first;
+
     imc_stat_init(unit);
+    unit->alloc_state = ALLOC_NONE;
+
     if (!(imcc->optimizer_level & (OPT_PRE|OPT_CFG|OPT_PASM)) && unit->pasm_file)
-        goto done;
+        return;
 
     if (unit->instructions->symreg_count)
       function = unit->instructions->symregs[0]->name;
@@ -191,15 +341,15 @@ imc_reg_alloc(ARGMOD(imc_info_t * imcc), ARGIN_NULLOK(IMC_Unit *unit))
     if (imcc->optimizer_level == OPT_PRE && unit->pasm_file) {
         while (pre_optimize(imcc, unit))
             ;
-        goto done;
+        return;
     }
 
     /* all lexicals get a unique register */
     allocate_lexicals(imcc, unit);
 
     /* build CFG and life info, and optimize iteratively */
-    do {
-        int first = 1;
+    first = 1;
+    for (;;) {
         do {
             while (pre_optimize(imcc, unit)) { };
 
@@ -208,27 +358,82 @@ imc_reg_alloc(ARGMOD(imc_info_t * imcc), ARGIN_NULLOK(IMC_Unit *unit))
             first = 0;
         } while (cfg_optimize(imcc, unit));
 
-        compute_dominators(imcc, unit);
-        find_loops(imcc, unit);
+        unit->alloc_state = ALLOC_CFG;
+
+        if (imcc->dont_optimize || !(imcc->optimizer_level & OPT_LIFE))
+            break;
+
+        build_life_info(imcc, unit);
+        unit->alloc_state = ALLOC_LIFE;
+
+        if (!optimize(imcc, unit))
+            break;
+    }
+
+    /* later units may change these, see imc_reg_alloc_registers */
+    unit->optimizer_level = imcc->optimizer_level;
+    unit->dont_optimize   = imcc->dont_optimize;
+}
+
+/*
 
-        if (imcc->optimizer_level)
-            compute_dominance_frontiers(imcc, unit);
+=item C<void imc_reg_alloc_registers(imc_info_t * imcc, IMC_Unit *unit)>
 
-        build_reglist(imcc, unit);
+The second step of imc_reg_alloc(): builds the life info if
+imc_reg_alloc_prepare() didn't and allocates the registers. This only touches
+the unit itself and reads C<imcc>, so different units may be allocated on
+different threads, each with its own copy of C<imcc>.
 
-        allocate_uniq(imcc, unit, 0);
-    } while (!imcc->dont_optimize && optimize(imcc, unit));
+=cut
+
+*/
+
+void
+imc_reg_alloc_registers(ARGMOD(imc_info_t * imcc), ARGMOD(IMC_Unit *unit))
+{
+    ASSERT_ARGS(imc_reg_alloc_registers)
+
+    if (unit->alloc_state == ALLOC_NONE)
+        return;
+
+    if (unit->alloc_state == ALLOC_CFG)
+        build_life_info(imcc, unit);
 
     if (imcc->debug & DEBUG_IMC)
         dump_symreg(unit);
 
-    /* TODO add option for a better allocator */
-    vanilla_reg_alloc(imcc, unit);
+    if (can_share_registers(imcc, unit))
+        linear_scan_reg_alloc(imcc, unit);
+    else
+        vanilla_reg_alloc(imcc, unit);
 
-    if (imcc->debug & DEBUG_IMC)
-        dump_instructions(imcc, unit);
+    unit->alloc_state = ALLOC_DONE;
+}
+
+/*
+
+=item C<void imc_reg_alloc_finish(imc_info_t * imcc, IMC_Unit *unit)>
+
+The last step of imc_reg_alloc(): runs the optimizations which need the
+allocated registers and collects the statistics. Like
+imc_reg_alloc_prepare(), this must not run concurrently with other IMCC work.
+
+=cut
+
+*/
+
+void
+imc_reg_alloc_finish(ARGMOD(imc_info_t * imcc), ARGMOD(IMC_Unit *unit))
+{
+    ASSERT_ARGS(imc_reg_alloc_finish)
+
+    if (unit->alloc_state == ALLOC_DONE) {
+        post_optimize(imcc, unit);
+
+        if (imcc->debug & DEBUG_IMC)
+            dump_instructions(imcc, unit);
+    }
 
-  done:
     if (imcc->verbose  || (imcc->debug & DEBUG_IMC))
         print_stat(imcc, unit);
     else
@@ -237,6 +442,33 @@ imc_reg_alloc(ARGMOD(imc_info_t * imcc), ARGIN_NULLOK(IMC_Unit *unit))
 
 /*
 
+=item C<static void build_life_info(imc_info_t * imcc, IMC_Unit *unit)>
+
+Computes the dominators, loops and register list of the unit from its CFG and
+gives each register a unique color.
+
+=cut
+
+*/
+
+static void
+build_life_info(ARGMOD(imc_info_t * imcc), ARGMOD(IMC_Unit *unit))
+{
+    ASSERT_ARGS(build_life_info)
+
+    compute_dominators(imcc, unit);
+    find_loops(imcc, unit);
+
+    if (imcc->optimizer_level)
+        compute_dominance_frontiers(imcc, unit);
+
+    build_reglist(imcc, unit);
+
+    allocate_uniq(imcc, unit, 0);
+}
+
+/*
+
 =item C<void free_reglist(IMC_Unit *unit)>
 
 Frees the register list associated with a compilation unit.
@@ -376,6 +608,12 @@ print_stat(ARGMOD(imc_info_t * imcc), ARGMOD(IMC_Unit *unit))
               unit->ostat.used_once);
     IMCC_info(imcc, 1, "\t%d invariants_moved\n",
               unit->ostat.invariants_moved);
+    IMCC_info(imcc, 1, "\t%d redundant ops deleted\n",
+              unit->ostat.redundant);
+    IMCC_info(imcc, 1, "\t%d PMC registers unboxed\n",
+              unit->ostat.unboxed);
+    IMCC_info(imcc, 1, "\t%d new sites reusing their PMC\n",
+              unit->ostat.renewed);
     IMCC_info(imcc, 1, "\tregisters needed:\t I%d, N%d, S%d, P%d\n",
             sets[0], sets[1], sets[2], sets[3]);
     IMCC_info(imcc, 1,
@@ -764,6 +1002,453 @@ vanilla_reg_alloc(ARGMOD(imc_info_t * imcc), ARGMOD(IMC_Unit *unit))
 
 /*
 
+=item C<static int can_share_registers(const imc_info_t * imcc, const IMC_Unit
+*unit)>
+
+Returns true if the registers of the unit may be allocated by
+linear_scan_reg_alloc(). This needs C<-Or>, a CFG which follows all control
+flow of the unit and a unit small enough for the life analysis.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+static int
+can_share_registers(ARGIN(const imc_info_t * imcc), ARGIN(const IMC_Unit *unit))
+{
+    ASSERT_ARGS(can_share_registers)
+
+    if (!(imcc->optimizer_level & OPT_REGS)
+    ||  imcc->dont_optimize
+    ||  unit->pasm_file
+    || !unit->n_basic_blocks)
+        return 0;
+
+    if ((UINTVAL)unit->n_basic_blocks * unit->n_symbols > LIVE_RANGE_MAX_BITS)
+        return 0;
+
+    return !has_computed_jumps(unit);
+}
+
+/*
+
+=item C<static unsigned int ins_regs(imc_info_t * imcc, const Instruction *ins,
+SymReg ***regs, unsigned int *size)>
+
+Collects the allocatable registers instruction_reads() or instruction_writes()
+may report for C<ins> into C<*regs>, growing it as needed, and returns their
+count. A sub call also uses the registers of its C<set_args> and
+C<get_results>.
+
+=cut
+
+*/
+
+static unsigned int
+ins_regs(ARGMOD(imc_info_t * imcc), ARGIN(const Instruction *ins),
+        ARGMOD(SymReg ***regs), ARGMOD(unsigned int *size))
+{
+    ASSERT_ARGS(ins_regs)
+    op_lib_t * const   core_ops = PARROT_GET_CORE_OPLIB(imcc->interp);
+    const Instruction *seen[3];
+    unsigned int       n_seen   = 0;
+    unsigned int       n        = 0;
+    unsigned int       k;
+
+    seen[n_seen++] = ins;
+
+    if (ins->type & ITPCCSUB) {
+        const Instruction *call;
+
+        for (call = ins->prev; call; call = call->prev)
+            if (call->op == &core_ops->op_info_table[PARROT_OP_set_args_pc])
+                break;
+
+        if (call)
+            seen[n_seen++] = call;
+
+        for (call = ins->next; call; call = call->next)
+            if (call->op == &core_ops->op_info_table[PARROT_OP_get_results_pc])
+                break;
+
+        if (call)
+            seen[n_seen++] = call;
+    }
+
+    for (k = 0; k < n_seen; k++) {
+        int i;
+
+        for (i = 0; i < seen[k]->symreg_count; i++) {
+            SymReg * const r = seen[k]->symregs[i];
+
+            n = add_ins_reg(imcc, r, regs, size, n);
+
+            if (r->set == 'K') {
+                const SymReg *key;
+
+                for (key = r->nextkey; key; key = key->nextkey)
+                    if (key->reg)
+                        n = add_ins_reg(imcc, key->reg, regs, size, n);
+            }
+        }
+    }
+
+    return n;
+}
+
+/*
+
+=item C<static unsigned int add_ins_reg(imc_info_t * imcc, SymReg *r, SymReg
+***regs, unsigned int *size, unsigned int n)>
+
+Appends C<r> to the C<n> registers collected by ins_regs() if it is on the
+reglist, and returns the new count.
+
+=cut
+
+*/
+
+static unsigned int
+add_ins_reg(ARGMOD(imc_info_t * imcc), ARGIN(SymReg *r), ARGMOD(SymReg ***regs),
+        ARGMOD(unsigned int *size), unsigned int n)
+{
+    ASSERT_ARGS(add_ins_reg)
+
+    if (!REG_NEEDS_ALLOC(r) || r->color < 0)
+        return n;
+
+    if (n == *size) {
+        *size = *size ? 2 * *size : 16;
+        *regs = mem_gc_realloc_n_typed(imcc->interp, *regs, *size, SymReg *);
+    }
+
+    (*regs)[n] = r;
+
+    return n + 1;
+}
+
+/*
+
+=item C<static void extend_live_range(Live_range *range, int index)>
+
+Makes C<range> include the instruction number C<index>.
+
+=cut
+
+*/
+
+static void
+extend_live_range(ARGMOD(Live_range *range), int index)
+{
+    ASSERT_ARGS(extend_live_range)
+    if (index < range->start)
+        range->start = index;
+
+    if (index > range->end)
+        range->end = index;
+}
+
+/*
+
+=item C<static void compute_live_ranges(imc_info_t * imcc, IMC_Unit *unit,
+Live_range *ranges)>
+
+Fills C<ranges> with the live range of each register on the unit's reglist,
+whose colors hold their reglist index meanwhile.
+
+The live-in and live-out sets of the basic blocks are solved by the usual
+backwards data-flow iteration over the CFG. A live range then spans all
+instructions from the first to the last one on which the register is
+referenced, or live at a block boundary. Lexicals, and registers live at a
+label which is only reached through its address (C<push_eh>, C<set_addr>, ...)
+are live throughout the unit.
+
+=cut
+
+*/
+
+static void
+compute_live_ranges(ARGMOD(imc_info_t * imcc), ARGMOD(IMC_Unit *unit),
+        ARGOUT(Live_range *ranges))
+{
+    ASSERT_ARGS(compute_live_ranges)
+    const unsigned int n_syms   = unit->n_symbols;
+    const unsigned int n_blocks = unit->n_basic_blocks;
+    Set      ** const  live_in  = mem_gc_allocate_n_zeroed_typed(imcc->interp, n_blocks, Set *);
+    Set      ** const  live_out = mem_gc_allocate_n_zeroed_typed(imcc->interp, n_blocks, Set *);
+    Set      ** const  through  = mem_gc_allocate_n_zeroed_typed(imcc->interp, n_blocks, Set *);
+    SymReg           **regs     = NULL;
+    unsigned int       size     = 0;
+    unsigned int       b, i;
+    int                n_ins    = 0;
+    int                changed;
+    Instruction       *ins;
+
+    for (ins = unit->instructions; ins; ins = ins->next)
+        ins->index = n_ins++;
+
+    for (i = 0; i < n_syms; i++) {
+        ranges[i].reg   = unit->reglist[i];
+        ranges[i].start = n_ins;
+        ranges[i].end   = -1;
+    }
+
+    /* upward exposed uses and registers not written in each block */
+    for (b = 0; b < n_blocks; b++) {
+        const Basic_block * const bb = unit->bb_list[b];
+
+        live_in[b]  = set_make(imcc, n_syms);
+        live_out[b] = set_make(imcc, n_syms);
+        through[b]  = set_make_full(imcc, n_syms);
+
+        for (ins = bb->end; ins; ins = ins->prev) {
+            const unsigned int n = ins_regs(imcc, ins, &regs, &size);
+            unsigned int       k;
+
+            for (k = 0; k < n; k++) {
+                extend_live_range(&ranges[regs[k]->color], ins->index);
+
+                if (instruction_writes(ins, regs[k])) {
+                    set_remove(live_in[b], regs[k]->color);
+                    set_remove(through[b], regs[k]->color);
+                }
+            }
+
+            for (k = 0; k < n; k++)
+                if (instruction_reads(ins, regs[k]))
+                    set_add(live_in[b], regs[k]->color);
+
+            if (ins == bb->start)
+                break;
+        }
+    }
+
+    do {
+        changed = 0;
+
+        for (b = n_blocks; b-- > 0;) {
+            const Edge *e;
+            int         grown = 0;
+
+            for (e = unit->bb_list[b]->succ_list; e; e = e->succ_next)
+                grown |= set_union_inplace(live_out[b], live_in[e->to->index]);
+
+            if (grown) {
+                Set * const passed = set_intersec(imcc, live_out[b], through[b]);
+                changed |= set_union_inplace(live_in[b], passed);
+                set_free(passed);
+            }
+        }
+    } while (changed);
+
+    for (b = 0; b < n_blocks; b++) {
+        const Basic_block * const bb = unit->bb_list[b];
+
+        for (i = 0; i < n_syms; i++) {
+            if (set_contains(live_in[b], i))
+                extend_live_range(&ranges[i], bb->start->index);
+
+            if (set_contains(live_out[b], i))
+                extend_live_range(&ranges[i], bb->end->index);
+        }
+    }
+
+    for (ins = unit->instructions; ins; ins = ins->next) {
+        const SymReg *label;
+
+        if (!(ins->type & ITBRANCH) || !ins->op || ins->op->jump)
+            continue;
+
+        label = get_branch_reg(ins);
+
+        if (label)
+            label = find_sym(imcc, label->name);
+
+        if (label && (label->type & VTADDRESS) && label->first_ins) {
+            const Set * const live = live_in[label->first_ins->bbindex];
+
+            for (i = 0; i < n_syms; i++) {
+                if (set_contains(live, i)) {
+                    ranges[i].start = 0;
+                    ranges[i].end   = n_ins;
+                }
+            }
+        }
+    }
+
+    for (i = 0; i < n_syms; i++) {
+        if ((ranges[i].reg->usage & U_LEXICAL) || ranges[i].start > ranges[i].end) {
+            ranges[i].start = 0;
+            ranges[i].end   = n_ins;
+        }
+    }
+
+    for (b = 0; b < n_blocks; b++) {
+        set_free(live_in[b]);
+        set_free(live_out[b]);
+        set_free(through[b]);
+    }
+
+    mem_sys_free(live_in);
+    mem_sys_free(live_out);
+    mem_sys_free(through);
+
+    if (regs)
+        mem_sys_free(regs);
+}
+
+/*
+
+=item C<static int live_range_start_cmp(const void *a, const void *b)>
+
+qsort() comparator ordering live ranges by their first instruction.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+static int
+live_range_start_cmp(ARGIN(const void *a), ARGIN(const void *b))
+{
+    ASSERT_ARGS(live_range_start_cmp)
+    const Live_range * const ra = *(const Live_range * const *)a;
+    const Live_range * const rb = *(const Live_range * const *)b;
+
+    return ra->start < rb->start ? -1 : ra->start > rb->start;
+}
+
+/*
+
+=item C<static int live_range_end_cmp(const void *a, const void *b)>
+
+qsort() comparator ordering live ranges by their last instruction.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+static int
+live_range_end_cmp(ARGIN(const void *a), ARGIN(const void *b))
+{
+    ASSERT_ARGS(live_range_end_cmp)
+    const Live_range * const ra = *(const Live_range * const *)a;
+    const Live_range * const rb = *(const Live_range * const *)b;
+
+    return ra->end < rb->end ? -1 : ra->end > rb->end;
+}
+
+/*
+
+=item C<static void linear_scan_reg_alloc(imc_info_t * imcc, IMC_Unit *unit)>
+
+Linear scan register allocator - walk the live ranges of each register kind
+in order of their start, giving each the lowest register not held by a live
+range which is still live. Registers only share a parrot register if their
+live ranges don't touch at all, as an op may write its result before it has
+read all of its arguments.
+
+=cut
+
+*/
+
+static void
+linear_scan_reg_alloc(ARGMOD(imc_info_t * imcc), ARGMOD(IMC_Unit *unit))
+{
+    ASSERT_ARGS(linear_scan_reg_alloc)
+    const char          type[]   = "INSP";
+    const unsigned int  n_syms   = unit->n_symbols;
+    SymHash     * const hsh      = &unit->hash;
+    Live_range  * const ranges   = mem_gc_allocate_n_typed(imcc->interp, n_syms + 1,
+                                        Live_range);
+    Live_range ** const by_start = mem_gc_allocate_n_typed(imcc->interp, n_syms + 1,
+                                        Live_range *);
+    Live_range ** const by_end   = mem_gc_allocate_n_typed(imcc->interp, n_syms + 1,
+                                        Live_range *);
+    unsigned int        i, j;
+
+    /* Clear the pre-assigned colors, the reglist index stands in for them
+     * during the life analysis. */
+    for (i = 0; i < hsh->size; i++) {
+        SymReg *r;
+        for (r = hsh->data[i]; r; r = r->next) {
+            if (REG_NEEDS_ALLOC(r))
+                r->color = -1;
+        }
+    }
+
+    for (i = 0; i < n_syms; i++)
+        unit->reglist[i]->color = (int)i;
+
+    compute_live_ranges(imcc, unit, ranges);
+
+    for (j = 0; j < 4; j++) {
+        Set         *busy;
+        unsigned int n        = 0;
+        unsigned int k        = 0;
+        int          n_colors = 0;
+
+        for (i = 0; i < n_syms; i++) {
+            if (ranges[i].reg->set == type[j]) {
+                by_start[n] = &ranges[i];
+                by_end[n++] = &ranges[i];
+            }
+        }
+
+        qsort(by_start, n, sizeof (Live_range *), live_range_start_cmp);
+        qsort(by_end, n, sizeof (Live_range *), live_range_end_cmp);
+
+        busy = set_make(imcc, n + 1);
+
+        for (i = 0; i < n; i++) {
+            Live_range * const range = by_start[i];
+            unsigned int       color;
+
+            /* ranges ending before this one starts free their register */
+            while (k < i && by_end[k]->end < range->start)
+                set_remove(busy, (unsigned int)by_end[k++]->reg->color);
+
+            color = set_first_zero(busy);
+            set_add(busy, color);
+
+            range->reg->color = (int)color;
+
+            if ((int)color >= n_colors)
+                n_colors = (int)color + 1;
+
+            IMCC_debug(imcc, DEBUG_IMC, "live range %c '%s' %d-%d  color %d\n",
+                    type[j], range->reg->name, range->start, range->end, color);
+        }
+
+        set_free(busy);
+        unit->first_avail[j] = n_colors;
+    }
+
+    /* keys aren't colored, symbols without instructions get a fresh register */
+    for (i = 0; i < hsh->size; i++) {
+        SymReg *r;
+        for (r = hsh->data[i]; r; r = r->next) {
+            const char * const kind = strchr(type, r->set);
+
+            if (!REG_NEEDS_ALLOC(r))
+                continue;
+
+            if (!kind || !r->set)
+                r->color = -1;
+            else if (r->color == -1)
+                r->color = unit->first_avail[kind - type]++;
+        }
+    }
+
+    mem_sys_free(ranges);
+    mem_sys_free(by_start);
+    mem_sys_free(by_end);
+}
+
+/*
+
 =item C<static void allocate_lexicals(imc_info_t * imcc, IMC_Unit *unit)>
 
 Allocate registers for lexical variables. These must have unique registers
@@ -206,6 +206,25 @@ set_add(ARGMOD(Set *s), unsigned int element)
 }
 
 
+/*
+
+=item C<void set_remove(Set *s, unsigned int element)>
+
+Removes the element C<element> from set C<s>.
+
+=cut
+
+*/
+
+void
+set_remove(ARGMOD(Set *s), unsigned int element)
+{
+    ASSERT_ARGS(set_remove)
+    if (BYTE_IN_SET(element) <= BYTE_IN_SET(s->length))
+        s->bmp[BYTE_IN_SET(element)] &= ~BIT_IN_BYTE(element);
+}
+
+
 /*
 
 =item C<unsigned int set_first_zero(const Set *s)>
@@ -296,7 +315,7 @@ set_union(ARGMOD(imc_info_t * imcc), ARGIN(const Set *s1), ARGIN(const Set *s2))
 
     PARROT_ASSERT(s1->length == s2->length);
 
-    for (i = 0; i < BYTE_IN_SET(s1->length); i++) {
+    for (i = 0; i < NUM_BYTES(s1->length); i++) {
         s->bmp[i] = s1->bmp[i] | s2->bmp[i];
     }
 
@@ -304,6 +323,39 @@ set_union(ARGMOD(imc_info_t * imcc), ARGIN(const Set *s1), ARGIN(const Set *s2))
 }
 
 
+/*
+
+=item C<int set_union_inplace(Set *s1, const Set *s2)>
+
+Performs a set union in place -- the first Set argument changes to contain
+the result. Returns true if any element was added to it.
+
+=cut
+
+*/
+
+int
+set_union_inplace(ARGMOD(Set *s1), ARGIN(const Set *s2))
+{
+    ASSERT_ARGS(set_union_inplace)
+    unsigned int i;
+    int          changed = 0;
+
+    PARROT_ASSERT(s1->length == s2->length);
+
+    for (i = 0; i < NUM_BYTES(s1->length); i++) {
+        const unsigned char u = s1->bmp[i] | s2->bmp[i];
+
+        if (u != s1->bmp[i]) {
+            s1->bmp[i] = u;
+            changed    = 1;
+        }
+    }
+
+    return changed;
+}
+
+
 /*
 
 =item C<Set * set_intersec(imc_info_t * imcc, const Set *s1, const Set *s2)>
@@ -327,7 +379,7 @@ set_intersec(ARGMOD(imc_info_t * imcc), ARGIN(const Set *s1),
 
     PARROT_ASSERT(s1->length == s2->length);
 
-    for (i = 0; i < BYTE_IN_SET(s1->length); i++) {
+    for (i = 0; i < NUM_BYTES(s1->length); i++) {
         s->bmp[i] = s1->bmp[i] & s2->bmp[i];
     }
 
@@ -354,7 +406,7 @@ set_intersec_inplace(ARGMOD(Set *s1), ARGIN(const Set *s2))
 
     PARROT_ASSERT(s1->length == s2->length);
 
-    for (i = 0; i < BYTE_IN_SET(s1->length); i++) {
+    for (i = 0; i < NUM_BYTES(s1->length); i++) {
         s1->bmp[i] &= s2->bmp[i];
     }
 }
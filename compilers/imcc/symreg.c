@@ -1296,9 +1296,10 @@ void
 create_symhash(ARGMOD(imc_info_t * imcc), ARGOUT(SymHash *hash))
 {
     ASSERT_ARGS(create_symhash)
-    hash->data    = mem_gc_allocate_n_zeroed_typed(imcc->interp, 16, SymReg *);
-    hash->size    = 16;
-    hash->entries = 0;
+    hash->data     = mem_gc_allocate_n_zeroed_typed(imcc->interp, 16, SymReg *);
+    hash->size     = 16;
+    hash->entries  = 0;
+    hash->unfolded = NULL;
 }
 
 
@@ -1383,6 +1384,12 @@ _store_symreg(ARGMOD(imc_info_t * imcc), ARGMOD(SymHash *hsh),
 
     hsh->entries++;
 
+    /* constant_folding only has to look at global symbols it hasn't seen */
+    if (hsh == &imcc->ghash) {
+        r->next_unfolded = hsh->unfolded;
+        hsh->unfolded    = r;
+    }
+
     if (hsh->entries >= hsh->size)
         resize_symhash(imcc, hsh);
 }
@@ -1555,9 +1562,10 @@ clear_sym_hash(ARGMOD(SymHash *hsh))
 
     mem_sys_free(hsh->data);
 
-    hsh->data    = NULL;
-    hsh->entries = 0;
-    hsh->size    = 0;
+    hsh->data     = NULL;
+    hsh->entries  = 0;
+    hsh->size     = 0;
+    hsh->unfolded = NULL;
 }
 
 
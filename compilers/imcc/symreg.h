@@ -49,6 +49,7 @@ typedef struct _SymReg {
     struct pcc_sub_t    *pcc_sub;       /* PCC subroutine */
     struct _SymReg      *used;          /* used register in invoke */
     struct _SymReg      *next;          /* used in the symbols hash */
+    struct _SymReg      *next_unfolded; /* see SymHash.unfolded */
     struct _Instruction *first_ins;     /* first and last instruction */
     struct _Instruction *last_ins;      /* this symbol is in */
     INTVAL               type;          /* Variable type */
@@ -67,6 +68,8 @@ typedef struct _SymHash {
     SymReg     **data;
     unsigned int size;
     unsigned int entries;
+    SymReg      *unfolded;      /* global symbols that may still need a
+                                 * constant table entry, newest first */
 } SymHash;
 
 /* namespaces */
@@ -17,6 +17,17 @@ typedef enum {
     IMC_HAS_SELF    = 0x10
 } IMC_Unit_Type;
 
+/*
+ * How far imc_reg_alloc_prepare() and imc_reg_alloc_registers() got with a
+ * unit.
+ */
+typedef enum {
+    ALLOC_NONE,         /* no registers to allocate, e.g. unoptimized PASM */
+    ALLOC_CFG,          /* CFG built, life info and registers pending */
+    ALLOC_LIFE,         /* life info built, registers pending */
+    ALLOC_DONE          /* registers allocated */
+} IMC_Alloc_State;
+
 /*
  * Optimization statistics -- we track the number of times each of these
  * optimizations is performed.
@@ -29,6 +40,9 @@ struct imcc_ostat {
     int invariants_moved;
     int deleted_ins;
     int used_once;
+    int unboxed;
+    int renewed;
+    int redundant;
 } ;
 
 struct IMC_Unit {
@@ -72,6 +86,11 @@ struct IMC_Unit {
     INTVAL            hll_id;           /* HLL ID for this sub */
     SymReg           *subid;            /* Unique subroutine id */
 
+    IMC_Alloc_State   alloc_state;
+    int               deferred;         /* 1 if left to imc_compile_deferred_units */
+    int               optimizer_level;  /* imcc flags as of imc_reg_alloc_prepare */
+    int               dont_optimize;
+
     struct            imcc_ostat ostat;
 };
 
@@ -0,0 +1,64 @@
+# Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+examples/benchmarks/suite/calls_args.pir - argument passing
+
+=head1 SYNOPSIS
+
+    % ./parrot examples/benchmarks/suite/calls_args.pir
+
+=head1 DESCRIPTION
+
+Calls subs with optional, named and slurpy parameters, which exercise the
+slower paths of argument binding.
+
+Part of the suite run by C<make bench>; see F<tools/dev/bench_suite.pl>.
+
+=cut
+
+.sub main :main
+    .local int i, sum
+    i = 0
+    sum = 0
+  loop:
+    $I0 = 'optional'(i)
+    sum += $I0
+    $I0 = 'named'('y' => i, 'x' => 1)
+    sum += $I0
+    $I0 = 'slurpy'(1, 2, i)
+    sum += $I0
+    inc i
+    if i < 60000 goto loop
+    say sum
+.end
+
+.sub 'optional'
+    .param int a
+    .param int b :optional
+    .param int has_b :opt_flag
+    if has_b goto done
+    b = 2
+  done:
+    $I0 = a + b
+    .return ($I0)
+.end
+
+.sub 'named'
+    .param int x :named('x')
+    .param int y :named('y')
+    $I0 = x + y
+    .return ($I0)
+.end
+
+.sub 'slurpy'
+    .param pmc rest :slurpy
+    $I0 = elements rest
+    .return ($I0)
+.end
+
+# Local Variables:
+#   mode: pir
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4 ft=pir:
@@ -0,0 +1,42 @@
+# Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+examples/benchmarks/suite/calls_fib.pir - recursive sub calls
+
+=head1 SYNOPSIS
+
+    % ./parrot examples/benchmarks/suite/calls_fib.pir
+
+=head1 DESCRIPTION
+
+Computes a Fibonacci number recursively, which is dominated by sub calls
+and returns with a couple of integer arguments.
+
+Part of the suite run by C<make bench>; see F<tools/dev/bench_suite.pl>.
+
+=cut
+
+.sub main :main
+    $I0 = 'fib'(25)
+    say $I0
+.end
+
+.sub 'fib'
+    .param int n
+    if n >= 2 goto rec
+    .return (n)
+  rec:
+    $I0 = n - 1
+    $I1 = 'fib'($I0)
+    $I0 = n - 2
+    $I2 = 'fib'($I0)
+    $I0 = $I1 + $I2
+    .return ($I0)
+.end
+
+# Local Variables:
+#   mode: pir
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4 ft=pir:
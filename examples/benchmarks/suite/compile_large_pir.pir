@@ -0,0 +1,102 @@
+# Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+examples/benchmarks/suite/compile_large_pir.pir - compiling a very large PIR file
+
+=head1 SYNOPSIS
+
+    % ./parrot examples/benchmarks/suite/compile_large_pir.pir [subs]
+
+=head1 DESCRIPTION
+
+Generates about half a million lines of PIR, the way a compiler targeting
+Parrot would, and compiles it with the PIR compiler.  The generated code has
+40000 subs in 400 namespaces; each sub has its own string and number
+constants, calls the previous sub by name and refers to it by C<:subid>, so
+the backend has to resolve one label and one subid per sub.
+
+Compile time should grow linearly with the number of subs, which can be
+given as an argument to check this by hand.
+
+Part of the suite run by C<make bench>; see F<tools/dev/bench_suite.pl>.
+
+=cut
+
+.sub main :main
+    .param pmc argv :optional
+    .param int has_argv :opt_flag
+    .local int subs, i, prev
+    .local pmc src, args, compiler, code
+    .local string ns
+
+    subs = 40000
+    unless has_argv goto generate
+    $I0 = elements argv
+    if $I0 < 2 goto generate
+    $S0 = argv[1]
+    subs = $S0
+
+  generate:
+    src  = new ['StringBuilder']
+    args = new ['ResizablePMCArray']
+    i = 0
+  next_sub:
+    $I1 = i % 100
+    if $I1 goto same_namespace
+    $I0 = i / 100
+    ns = $I0
+    push src, ".namespace ['Generated'; 'N"
+    push src, ns
+    push src, "']\n"
+  same_namespace:
+    prev = i - 1
+    if $I1 goto have_prev
+    prev = i
+  have_prev:
+    args = 0
+    push args, i
+    push args, i
+    push args, i
+    push args, i
+    push args, prev
+    push args, prev
+    $S0 = sprintf <<'END_SUB', args
+.sub 'f%d' :subid('gen_%d')
+    .param int n
+    .local pmc callee
+    $S0 = 'string constant %d'
+    $N0 = %d.25
+    if n > 0 goto call
+    .return ($N0)
+  call:
+    $P0 = 'f%d'(0)
+    .const 'Sub' callee = 'gen_%d'
+    .return ($S0)
+.end
+
+END_SUB
+    push src, $S0
+    inc i
+    if i < subs goto next_sub
+
+    compiler = compreg 'PIR'
+    $S0  = src
+    code = compiler.'compile'($S0)
+
+    dec i
+    $I0  = i / 100
+    $S0  = $I0
+    ns   = concat 'N', $S0
+    $S0  = i
+    $S0  = concat 'f', $S0
+    $P0  = get_hll_global ['Generated'; ns], $S0
+    $S0  = $P0(1)
+    say $S0
+.end
+
+# Local Variables:
+#   mode: pir
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4 ft=pir:
@@ -0,0 +1,39 @@
+# Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+examples/benchmarks/suite/dispatch_int_loop.pir - integer op dispatch
+
+=head1 SYNOPSIS
+
+    % ./parrot examples/benchmarks/suite/dispatch_int_loop.pir
+
+=head1 DESCRIPTION
+
+Runs a tight loop of integer register arithmetic and branches, so that
+almost all of the time goes into dispatching simple ops.
+
+Part of the suite run by C<make bench>; see F<tools/dev/bench_suite.pl>.
+
+=cut
+
+.sub main :main
+    .local int i, a, b
+    i = 0
+    a = 0
+    b = 1
+  loop:
+    a += i
+    b = a - b
+    b = b * 3
+    b = b % 1000
+    inc i
+    if i < 3000000 goto loop
+    say a
+.end
+
+# Local Variables:
+#   mode: pir
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4 ft=pir:
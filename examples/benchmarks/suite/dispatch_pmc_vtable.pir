@@ -0,0 +1,42 @@
+# Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+examples/benchmarks/suite/dispatch_pmc_vtable.pir - PMC vtable dispatch
+
+=head1 SYNOPSIS
+
+    % ./parrot examples/benchmarks/suite/dispatch_pmc_vtable.pir
+
+=head1 DESCRIPTION
+
+Does arithmetic and comparisons on Integer and Float PMCs, measuring op
+dispatch plus vtable calls on the core scalar types.
+
+Part of the suite run by C<make bench>; see F<tools/dev/bench_suite.pl>.
+
+=cut
+
+.sub main :main
+    .local pmc a, b, f
+    .local int i
+    a = new ['Integer']
+    b = new ['Integer']
+    f = new ['Float']
+    b = 3
+    i = 0
+  loop:
+    a += b
+    f += 0.5
+    a = a % 1000
+    inc i
+    if i < 1000000 goto loop
+    say a
+    say f
+.end
+
+# Local Variables:
+#   mode: pir
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4 ft=pir:
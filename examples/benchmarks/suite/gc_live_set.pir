@@ -0,0 +1,49 @@
+# Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+examples/benchmarks/suite/gc_live_set.pir - collection with a large live set
+
+=head1 SYNOPSIS
+
+    % ./parrot examples/benchmarks/suite/gc_live_set.pir
+
+=head1 DESCRIPTION
+
+Keeps a large array of live objects while replacing a fraction of them, so
+that each collection has to mark a big heap.
+
+Part of the suite run by C<make bench>; see F<tools/dev/bench_suite.pl>.
+
+=cut
+
+.sub main :main
+    .local pmc live
+    .local int i, slot
+    live = new ['ResizablePMCArray']
+    i = 0
+  fill:
+    $P0 = new ['Hash']
+    $P0['n'] = i
+    push live, $P0
+    inc i
+    if i < 50000 goto fill
+
+    i = 0
+  churn:
+    slot = i * 7919
+    slot = slot % 50000
+    $P0 = new ['Hash']
+    $P0['n'] = i
+    live[slot] = $P0
+    inc i
+    if i < 200000 goto churn
+    $I0 = elements live
+    say $I0
+.end
+
+# Local Variables:
+#   mode: pir
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4 ft=pir:
@@ -0,0 +1,38 @@
+# Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+examples/benchmarks/suite/gc_short_lived.pir - short-lived garbage
+
+=head1 SYNOPSIS
+
+    % ./parrot examples/benchmarks/suite/gc_short_lived.pir
+
+=head1 DESCRIPTION
+
+Allocates PMCs and strings that die immediately, so that the time goes into
+allocation and collecting garbage.
+
+Part of the suite run by C<make bench>; see F<tools/dev/bench_suite.pl>.
+
+=cut
+
+.sub main :main
+    .local int i
+    i = 0
+  loop:
+    $P0 = new ['ResizablePMCArray']
+    $P1 = box i
+    push $P0, $P1
+    $S0 = i
+    push $P0, $S0
+    inc i
+    if i < 300000 goto loop
+    say i
+.end
+
+# Local Variables:
+#   mode: pir
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4 ft=pir:
@@ -0,0 +1,49 @@
+# Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+examples/benchmarks/suite/hashes_int_keys.pir - hash iteration and integer keys
+
+=head1 SYNOPSIS
+
+    % ./parrot examples/benchmarks/suite/hashes_int_keys.pir
+
+=head1 DESCRIPTION
+
+Uses a Hash keyed by integers and iterates over it repeatedly.
+
+Part of the suite run by C<make bench>; see F<tools/dev/bench_suite.pl>.
+
+=cut
+
+.sub main :main
+    .local pmc h, it
+    .local int i, sum, pass
+    h = new ['Hash']
+    i = 0
+  fill:
+    h[i] = i
+    inc i
+    if i < 20000 goto fill
+
+    sum = 0
+    pass = 0
+  again:
+    it = iter h
+  each:
+    unless it goto next_pass
+    $S0 = shift it
+    $I0 = h[$S0]
+    sum += $I0
+    goto each
+  next_pass:
+    inc pass
+    if pass < 50 goto again
+    say sum
+.end
+
+# Local Variables:
+#   mode: pir
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4 ft=pir:
@@ -0,0 +1,58 @@
+# Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+examples/benchmarks/suite/hashes_string_keys.pir - hash insertion, lookup and deletion
+
+=head1 SYNOPSIS
+
+    % ./parrot examples/benchmarks/suite/hashes_string_keys.pir
+
+=head1 DESCRIPTION
+
+Fills a Hash with string keys, looks every key up again and deletes them.
+
+Part of the suite run by C<make bench>; see F<tools/dev/bench_suite.pl>.
+
+=cut
+
+.sub main :main
+    .local pmc h
+    .local int i, sum
+    h = new ['Hash']
+    i = 0
+  fill:
+    $S0 = i
+    $S0 = concat 'key', $S0
+    h[$S0] = i
+    inc i
+    if i < 100000 goto fill
+
+    i = 0
+    sum = 0
+  lookup:
+    $S0 = i
+    $S0 = concat 'key', $S0
+    $I0 = h[$S0]
+    sum += $I0
+    inc i
+    if i < 100000 goto lookup
+
+    i = 0
+  remove:
+    $S0 = i
+    $S0 = concat 'key', $S0
+    delete h[$S0]
+    inc i
+    if i < 100000 goto remove
+
+    $I0 = elements h
+    say $I0
+    say sum
+.end
+
+# Local Variables:
+#   mode: pir
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4 ft=pir:
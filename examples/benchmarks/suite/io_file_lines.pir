@@ -0,0 +1,61 @@
+# Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+examples/benchmarks/suite/io_file_lines.pir - file output and line input
+
+=head1 SYNOPSIS
+
+    % ./parrot examples/benchmarks/suite/io_file_lines.pir
+
+=head1 DESCRIPTION
+
+Writes lines to a temporary file, reads them back line by line and removes
+the file.
+
+Part of the suite run by C<make bench>; see F<tools/dev/bench_suite.pl>.
+
+=cut
+
+.sub main :main
+    .local pmc fh, os
+    .local string file
+    .local int i, total
+    os = new ['OS']
+    $N0 = time
+    $N0 *= 1000
+    $I0 = $N0
+    $S0 = $I0
+    file = concat 'bench_io_', $S0
+    file .= '.tmp'
+
+    fh = new ['FileHandle']
+    fh.'open'(file, 'w')
+    i = 0
+  write:
+    print fh, 'line number '
+    print fh, i
+    print fh, "\n"
+    inc i
+    if i < 100000 goto write
+    fh.'close'()
+
+    total = 0
+    fh.'open'(file, 'r')
+  read:
+    $S0 = fh.'readline'()
+    if $S0 == '' goto done
+    $I0 = length $S0
+    total += $I0
+    goto read
+  done:
+    fh.'close'()
+    os.'rm'(file)
+    say total
+.end
+
+# Local Variables:
+#   mode: pir
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4 ft=pir:
@@ -0,0 +1,40 @@
+# Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+examples/benchmarks/suite/nci_libc_calls.pir - native calls
+
+=head1 SYNOPSIS
+
+    % ./parrot examples/benchmarks/suite/nci_libc_calls.pir
+
+=head1 DESCRIPTION
+
+Calls a C library function through NCI, measuring the cost of crossing from
+Parrot into native code and back.
+
+Part of the suite run by C<make bench>; see F<tools/dev/bench_suite.pl>.
+
+=cut
+
+.sub main :main
+    .local pmc lib, c_abs
+    .local int i, sum
+    null lib
+    c_abs = dlfunc lib, 'abs', 'ii'
+    i = 0
+    sum = 0
+  loop:
+    $I0 = - i
+    $I0 = c_abs($I0)
+    sum += $I0
+    inc i
+    if i < 200000 goto loop
+    say sum
+.end
+
+# Local Variables:
+#   mode: pir
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4 ft=pir:
@@ -0,0 +1,43 @@
+# Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+examples/benchmarks/suite/oo_create.pir - object construction
+
+=head1 SYNOPSIS
+
+    % ./parrot examples/benchmarks/suite/oo_create.pir
+
+=head1 DESCRIPTION
+
+Instantiates objects of a class with a parent class and several attributes,
+and discards them.
+
+Part of the suite run by C<make bench>; see F<tools/dev/bench_suite.pl>.
+
+=cut
+
+.sub main :main
+    .local pmc base, derived
+    .local int i
+    base = newclass 'Shape'
+    addattribute base, 'x'
+    addattribute base, 'y'
+    derived = subclass base, 'Circle'
+    addattribute derived, 'r'
+    i = 0
+  loop:
+    $P0 = new 'Circle'
+    $P1 = box i
+    setattribute $P0, 'r', $P1
+    inc i
+    if i < 300000 goto loop
+    $P1 = getattribute $P0, 'r'
+    say $P1
+.end
+
+# Local Variables:
+#   mode: pir
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4 ft=pir:
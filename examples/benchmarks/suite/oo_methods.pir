@@ -0,0 +1,57 @@
+# Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+examples/benchmarks/suite/oo_methods.pir - method calls and attributes
+
+=head1 SYNOPSIS
+
+    % ./parrot examples/benchmarks/suite/oo_methods.pir
+
+=head1 DESCRIPTION
+
+Calls methods on instances of a PIR class that read and update attributes.
+
+Part of the suite run by C<make bench>; see F<tools/dev/bench_suite.pl>.
+
+=cut
+
+.sub main :main
+    .local pmc cls, obj
+    .local int i
+    cls = newclass 'Counter'
+    addattribute cls, 'count'
+    addattribute cls, 'step'
+    obj = new 'Counter'
+    obj.'init_counter'(3)
+    i = 0
+  loop:
+    obj.'bump'()
+    inc i
+    if i < 100000 goto loop
+    $P0 = getattribute obj, 'count'
+    say $P0
+.end
+
+.namespace ['Counter']
+
+.sub 'init_counter' :method
+    .param int step
+    $P0 = box 0
+    setattribute self, 'count', $P0
+    $P0 = box step
+    setattribute self, 'step', $P0
+.end
+
+.sub 'bump' :method
+    $P0 = getattribute self, 'count'
+    $P1 = getattribute self, 'step'
+    $P2 = add $P0, $P1
+    setattribute self, 'count', $P2
+.end
+
+# Local Variables:
+#   mode: pir
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4 ft=pir:
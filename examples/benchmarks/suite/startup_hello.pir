@@ -0,0 +1,28 @@
+# Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+examples/benchmarks/suite/startup_hello.pir - interpreter startup
+
+=head1 SYNOPSIS
+
+    % ./parrot examples/benchmarks/suite/startup_hello.pir
+
+=head1 DESCRIPTION
+
+Prints one line and exits.  Startup benchmarks are timed as whole processes,
+so this measures starting and tearing down the interpreter.
+
+Part of the suite run by C<make bench>; see F<tools/dev/bench_suite.pl>.
+
+=cut
+
+.sub main :main
+    say 'hello'
+.end
+
+# Local Variables:
+#   mode: pir
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4 ft=pir:
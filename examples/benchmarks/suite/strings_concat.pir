@@ -0,0 +1,44 @@
+# Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+examples/benchmarks/suite/strings_concat.pir - string building
+
+=head1 SYNOPSIS
+
+    % ./parrot examples/benchmarks/suite/strings_concat.pir
+
+=head1 DESCRIPTION
+
+Builds strings by concatenation and repetition, and converts numbers to
+strings.
+
+Part of the suite run by C<make bench>; see F<tools/dev/bench_suite.pl>.
+
+=cut
+
+.sub main :main
+    .local string s, line
+    .local int i
+    i = 0
+    s = ''
+  loop:
+    line = i
+    line = concat 'item ', line
+    line .= "\n"
+    s .= line
+    $I0 = i % 1000
+    if $I0 goto next
+    s = ''
+  next:
+    inc i
+    if i < 300000 goto loop
+    $I0 = length s
+    say $I0
+.end
+
+# Local Variables:
+#   mode: pir
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4 ft=pir:
@@ -0,0 +1,43 @@
+# Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+examples/benchmarks/suite/strings_search.pir - string searching and splitting
+
+=head1 SYNOPSIS
+
+    % ./parrot examples/benchmarks/suite/strings_search.pir
+
+=head1 DESCRIPTION
+
+Searches, slices, splits and joins a medium-sized string.
+
+Part of the suite run by C<make bench>; see F<tools/dev/bench_suite.pl>.
+
+=cut
+
+.sub main :main
+    .local string text, word
+    .local int i, found
+    text = repeat 'the quick brown fox jumps over the lazy dog ', 50
+    i = 0
+    found = 0
+  loop:
+    $I0 = index text, 'lazy', i
+    found += $I0
+    word = substr text, 4, 5
+    $P0 = split ' ', text
+    $S0 = join ',', $P0
+    $I1 = length $S0
+    found += $I1
+    inc i
+    if i < 3000 goto loop
+    say found
+    say word
+.end
+
+# Local Variables:
+#   mode: pir
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4 ft=pir:
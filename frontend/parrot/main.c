@@ -36,6 +36,7 @@ struct init_args_t {
     Parrot_Int have_pasm_file;
     Parrot_Int turn_gc_off;
     Parrot_Int preprocess_only;
+    const char *optimize;
 };
 
 extern int Parrot_set_config_hash(Parrot_PMC interp_pmc);
@@ -263,6 +264,13 @@ run_imcc(Parrot_PMC interp, Parrot_String sourcefile, ARGIN(struct init_args_t *
         const Parrot_PMC compiler = pasm_mode ? pasm_compiler : pir_compiler;
         Parrot_PMC pbc;
 
+        if (flags->optimize) {
+            Parrot_String opts;
+            if (!(Parrot_api_string_import(interp, flags->optimize, &opts)
+            &&    imcc_set_optimization_api(interp, compiler, opts)))
+                show_last_error_and_exit(interp);
+        }
+
         if (!imcc_compile_file_api(interp, compiler, sourcefile, &pbc))
             show_last_error_and_exit(interp);
         return pbc;
@@ -515,7 +523,7 @@ help(void)
     "    -X --dynext add path to dynamic extension search\n"
     "   <Run core options>\n"
     "    -R --runcore slow|bounds|fast\n"
-    "    -R --runcore trace|profiling|gcdebug\n"
+    "    -R --runcore trace|profiling|sampling|gcdebug\n"
     "    -t --trace [flags]\n"
     "   <VM options>\n"
     "    -D --parrot-debug[=HEXFLAGS]\n"
@@ -746,6 +754,7 @@ parseflags(Parrot_PMC interp, int argc, ARGIN(const char *argv[]),
     args->outfile = NULL;
     args->sourcefile = NULL;
     args->preprocess_only = 0;
+    args->optimize = NULL;
 
     if (argc == 1) {
         usage(stderr);
@@ -830,6 +839,9 @@ parseflags(Parrot_PMC interp, int argc, ARGIN(const char *argv[]),
           case 'c':
             args->have_pbc_file = 1;
             break;
+          case 'O':
+            args->optimize = opt.opt_arg ? opt.opt_arg : "1";
+            break;
           case OPT_GC_DEBUG:
           /*
 #if DISABLE_GC_DEBUG
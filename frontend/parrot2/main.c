@@ -346,7 +346,7 @@ usage(ARGMOD(FILE *fp))
     ASSERT_ARGS(usage)
     fprintf(fp,
             "parrot -[acEGhrtVwy.] [-D [FLAGS]]"
-            "[-R runcore] [-o FILE] <file>\n");
+            "[-O [level]] [-R runcore] [-o FILE] <file>\n");
 }
 
 /*
@@ -409,6 +409,7 @@ Parrot_cmd_options(void)
         { '\0', OPT_HASH_SEED, OPTION_required_FLAG, { "--hash-seed" } },
         { 'I', 'I', OPTION_required_FLAG, { "--include" } },
         { 'L', 'L', OPTION_required_FLAG, { "--library" } },
+        { 'O', 'O', OPTION_optional_FLAG, { "--optimize" } },
         { 'R', 'R', OPTION_required_FLAG, { "--runcore" } },
         { 'g', 'g', OPTION_required_FLAG, { "--gc" } },
         { '\0', OPT_GC_NURSERY_SIZE, OPTION_required_FLAG, { "--gc-nursery-size" } },
@@ -419,6 +420,7 @@ Parrot_cmd_options(void)
         { 'X', 'X', OPTION_required_FLAG, { "--dynext" } },
         { '\0', OPT_DESTROY_FLAG, (OPTION_flags)0,
                                      { "--leak-test", "--destroy-at-end" } },
+        { '\0', OPT_LAZY_CONSTANTS, (OPTION_flags)0, { "--lazy-constants" } },
         { 'o', 'o', OPTION_required_FLAG, { "--output" } },
         { '\0', OPT_PBC_OUTPUT, (OPTION_flags)0, { "--output-pbc" } },
         { 'a', 'a', (OPTION_flags)0, { "--pasm" } },
@@ -618,6 +620,10 @@ parseflags(Parrot_PMC interp, int argc, ARGIN(const char *argv[]),
           case 'c':
             pargs[nargs++] = "-c";
             break;
+          case 'O':
+            pargs[nargs++] = "-O";
+            pargs[nargs++] = opt.opt_arg ? opt.opt_arg : "1";
+            break;
           case OPT_GC_DEBUG:
           /*
 #if DISABLE_GC_DEBUG
@@ -633,6 +639,10 @@ parseflags(Parrot_PMC interp, int argc, ARGIN(const char *argv[]),
             /* Parrot_api_flag(interp, PARROT_DESTROY_FLAG, 1); */
             result = Parrot_api_flag(interp, 0x200, 1);
             break;
+          case OPT_LAZY_CONSTANTS:
+            /* Parrot_api_flag(interp, PARROT_LAZY_CONSTS_FLAG, 1); */
+            result = Parrot_api_flag(interp, 0x20, 1);
+            break;
 
             /* TODO: Can we do these in prt0.pir? */
           case 'I':
@@ -90,7 +90,7 @@ PackFile_ConstTable_dump(PARROT_INTERP, ARGIN(const PackFile_ConstTable *self))
 
     for (i = 0; i < self->pmc.const_count; i++) {
         Parrot_io_printf(interp, "    # %x:\n", (long)i);
-        PackFile_Constant_dump_pmc(interp, self, self->pmc.constants[i]);
+        PackFile_Constant_dump_pmc(interp, self, PackFile_ConstTable_get_pmc(interp, self, i));
     }
 }
 
@@ -0,0 +1,1055 @@
+/*
+Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+pprof_summary - Summarize a binary profile written by the profiling runcore
+
+=head1 SYNOPSIS
+
+ PARROT_PROFILING_OUTPUT=binary parrot -R profiling foo.pir
+ pprof_summary [-n 20] [-s inclusive|exclusive|ops] parrot.pprof.1234
+
+=head1 DESCRIPTION
+
+Reads a profile written by the profiling runcore with
+C<PARROT_PROFILING_OUTPUT=binary> and prints the total time of the run,
+followed by the subs and the source lines that took the most time.
+
+For each sub and line, I<exclusive> time is the time spent executing its own
+ops, and I<inclusive> time additionally counts everything it called.  A sub
+that appears several times on the call stack, as in recursion, has its time
+counted once.  Call stacks are reconstructed from the context switches in the
+profile the same way F<tools/dev/pprof2cg.pl> does.
+
+The profile is processed in a single streaming pass, in time proportional to
+its size, so it's practical on profiles that are too large for
+F<tools/dev/pprof2cg.pl>.
+
+=head2 Command-Line Options
+
+=over 4
+
+=item C<-n N>, C<--top N>
+
+Print the N most expensive subs and lines.  The default is 20; 0 prints all of
+them.
+
+=item C<-s key>, C<--sort key>
+
+Order the report by C<inclusive> (the default) time, C<exclusive> time or the
+number of C<ops> executed.
+
+=back
+
+=head2 Functions
+
+=over 4
+
+=cut
+
+*/
+
+#define PARROT_IN_EXTENSION
+
+#include "parrot/parrot.h"
+#include "parrot/longopt.h"
+#include "parrot/runcore_profiling.h"
+
+/* how much of the profile is read at once */
+#define PPROF_READ_SIZE 65536
+
+/* what to order the report by */
+typedef enum pprof_sort_key {
+    PPROF_SORT_INCLUSIVE,
+    PPROF_SORT_EXCLUSIVE,
+    PPROF_SORT_OPS
+} pprof_sort_key;
+
+/* a buffered profile being read */
+typedef struct pprof_reader {
+    FILE          *fh;
+    const char    *filename;
+    unsigned char  buf[PPROF_READ_SIZE];
+    size_t         pos;
+    size_t         len;
+} pprof_reader;
+
+/* costs of a sub or of a line.  A sub or line is active while it's on the
+ * call stack; inclusive time is accumulated when it stops being active. */
+typedef struct pprof_cost {
+    UHUGEINTVAL ops;
+    UHUGEINTVAL exclusive;
+    UHUGEINTVAL inclusive;
+    UHUGEINTVAL since;      /* clock when it last became active */
+    UINTVAL     active;     /* how many stack frames it's active in */
+} pprof_cost;
+
+typedef struct pprof_sub {
+    UINTVAL     ns_id;
+    UINTVAL     file_id;
+    INTVAL      next_same_ns;   /* next sub with this ns id, or -1 */
+    pprof_cost  cost;
+    pprof_cost *lines;          /* indexed by line number */
+    UINTVAL     lines_size;
+} pprof_sub;
+
+typedef struct pprof_frame {
+    UINTVAL     sub;            /* index into the sub table */
+    PPROF_DATA  sub_addr;
+    PPROF_DATA  ctx_addr;
+    INTVAL      line;           /* the line being executed, or -1 */
+} pprof_frame;
+
+/* everything known about the profile */
+typedef struct pprof_state {
+    Hash        *ctx_depth;     /* ctx address -> stack depth + 1 */
+    char       **strings;       /* indexed by string id */
+    UINTVAL      strings_size;
+    INTVAL      *subs_by_ns;    /* first sub for each ns id, or -1 */
+    pprof_sub   *subs;
+    UINTVAL      num_subs;
+    UINTVAL      subs_size;
+    pprof_frame *stack;
+    UINTVAL      depth;
+    UINTVAL      stack_size;
+    UHUGEINTVAL  clock;         /* total time of all ops so far */
+    UHUGEINTVAL  total_ops;
+    char        *cli;
+} pprof_state;
+
+/* an entry of the report, for sorting */
+typedef struct pprof_row {
+    UHUGEINTVAL       key;
+    const pprof_sub  *sub;
+    const pprof_cost *cost;
+    UINTVAL           line;
+} pprof_row;
+
+/* HEADERIZER HFILE: none */
+
+/* HEADERIZER BEGIN: static */
+/* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
+
+static void activate(ARGMOD(pprof_cost *cost), UHUGEINTVAL clock)
+        __attribute__nonnull__(1)
+        FUNC_MODIFIES(*cost);
+
+static int compare_rows(ARGIN(const void *a), ARGIN(const void *b))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+static void context_switch(PARROT_INTERP,
+    ARGMOD(pprof_state *st),
+    UINTVAL sub_index,
+    PPROF_DATA sub_addr,
+    PPROF_DATA ctx_addr)
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(*st);
+
+static void deactivate(ARGMOD(pprof_cost *cost), UHUGEINTVAL clock)
+        __attribute__nonnull__(1)
+        FUNC_MODIFIES(*cost);
+
+PARROT_DOES_NOT_RETURN
+static void fail(ARGIN(const pprof_reader *in), ARGIN(const char *message))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+PARROT_CANNOT_RETURN_NULL
+static pprof_cost * find_line(ARGMOD(pprof_sub *sub), UINTVAL line)
+        __attribute__nonnull__(1)
+        FUNC_MODIFIES(*sub);
+
+static UINTVAL find_sub(
+    ARGMOD(pprof_state *st),
+    UINTVAL ns_id,
+    UINTVAL file_id)
+        __attribute__nonnull__(1)
+        FUNC_MODIFIES(*st);
+
+PARROT_DOES_NOT_RETURN
+static void help(void);
+
+static void leave_frame(ARGMOD(pprof_state *st), ARGMOD(pprof_frame *frame))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(*st)
+        FUNC_MODIFIES(*frame);
+
+static void pop_frames(PARROT_INTERP,
+    ARGMOD(pprof_state *st),
+    UINTVAL depth)
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(*st);
+
+static void print_report(
+    ARGIN(const pprof_state *st),
+    UINTVAL top,
+    pprof_sort_key sort)
+        __attribute__nonnull__(1);
+
+static void print_row(
+    ARGIN(const pprof_state *st),
+    ARGIN(const pprof_row *row))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+static int read_byte(ARGMOD(pprof_reader *in))
+        __attribute__nonnull__(1)
+        FUNC_MODIFIES(*in);
+
+static HUGEINTVAL read_delta(ARGMOD(pprof_reader *in))
+        __attribute__nonnull__(1)
+        FUNC_MODIFIES(*in);
+
+static void read_profile(PARROT_INTERP,
+    ARGMOD(pprof_reader *in),
+    ARGMOD(pprof_state *st))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        FUNC_MODIFIES(*in)
+        FUNC_MODIFIES(*st);
+
+static void read_string(ARGMOD(pprof_reader *in), ARGMOD(pprof_state *st))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(*in)
+        FUNC_MODIFIES(*st);
+
+static UHUGEINTVAL read_varint(ARGMOD(pprof_reader *in))
+        __attribute__nonnull__(1)
+        FUNC_MODIFIES(*in);
+
+static void record_op(
+    ARGMOD(pprof_state *st),
+    UINTVAL line,
+    UHUGEINTVAL time)
+        __attribute__nonnull__(1)
+        FUNC_MODIFIES(*st);
+
+static UHUGEINTVAL sort_key(
+    ARGIN(const pprof_cost *cost),
+    pprof_sort_key sort)
+        __attribute__nonnull__(1);
+
+PARROT_CANNOT_RETURN_NULL
+static const char * string_at(
+    ARGIN(const pprof_reader *in),
+    ARGIN(const pprof_state *st),
+    UHUGEINTVAL id)
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+#define ASSERT_ARGS_activate __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(cost))
+#define ASSERT_ARGS_compare_rows __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(a) \
+    , PARROT_ASSERT_ARG(b))
+#define ASSERT_ARGS_context_switch __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(st))
+#define ASSERT_ARGS_deactivate __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(cost))
+#define ASSERT_ARGS_fail __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(in) \
+    , PARROT_ASSERT_ARG(message))
+#define ASSERT_ARGS_find_line __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(sub))
+#define ASSERT_ARGS_find_sub __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(st))
+#define ASSERT_ARGS_help __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
+#define ASSERT_ARGS_leave_frame __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(st) \
+    , PARROT_ASSERT_ARG(frame))
+#define ASSERT_ARGS_pop_frames __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(st))
+#define ASSERT_ARGS_print_report __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(st))
+#define ASSERT_ARGS_print_row __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(st) \
+    , PARROT_ASSERT_ARG(row))
+#define ASSERT_ARGS_read_byte __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(in))
+#define ASSERT_ARGS_read_delta __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(in))
+#define ASSERT_ARGS_read_profile __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(in) \
+    , PARROT_ASSERT_ARG(st))
+#define ASSERT_ARGS_read_string __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(in) \
+    , PARROT_ASSERT_ARG(st))
+#define ASSERT_ARGS_read_varint __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(in))
+#define ASSERT_ARGS_record_op __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(st))
+#define ASSERT_ARGS_sort_key __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(cost))
+#define ASSERT_ARGS_string_at __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(in) \
+    , PARROT_ASSERT_ARG(st))
+/* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
+/* HEADERIZER END: static */
+
+/*
+
+=item C<static void help(void)>
+
+Print out the user help info.
+
+=cut
+
+*/
+
+PARROT_DOES_NOT_RETURN
+static void
+help(void)
+{
+    ASSERT_ARGS(help)
+
+    printf("pprof_summary - summarize a binary profile from the profiling runcore\n");
+    printf("Usage:\n");
+    printf("   pprof_summary [-n N] [-s inclusive|exclusive|ops] parrot.pprof.1234\n\n");
+    exit(0);
+}
+
+/*
+
+=item C<static void fail(const pprof_reader *in, const char *message)>
+
+Report a malformed profile and exit.
+
+=cut
+
+*/
+
+PARROT_DOES_NOT_RETURN
+static void
+fail(ARGIN(const pprof_reader *in), ARGIN(const char *message))
+{
+    ASSERT_ARGS(fail)
+
+    fprintf(stderr, "pprof_summary: %s: %s\n", in->filename, message);
+    exit(1);
+}
+
+/*
+
+=item C<static int read_byte(pprof_reader *in)>
+
+Return the next byte of the profile, or -1 at the end of the file.
+
+=cut
+
+*/
+
+static int
+read_byte(ARGMOD(pprof_reader *in))
+{
+    ASSERT_ARGS(read_byte)
+
+    if (in->pos == in->len) {
+        in->len = fread(in->buf, 1, PPROF_READ_SIZE, in->fh);
+        in->pos = 0;
+        if (in->len == 0)
+            return -1;
+    }
+    return in->buf[in->pos++];
+}
+
+/*
+
+=item C<static UHUGEINTVAL read_varint(pprof_reader *in)>
+
+Read an unsigned LEB128 varint.
+
+=cut
+
+*/
+
+static UHUGEINTVAL
+read_varint(ARGMOD(pprof_reader *in))
+{
+    ASSERT_ARGS(read_varint)
+
+    UHUGEINTVAL value = 0;
+    unsigned    shift = 0;
+
+    while (1) {
+        const int byte = read_byte(in);
+
+        if (byte < 0)
+            fail(in, "truncated record");
+        if (shift >= 8 * sizeof (UHUGEINTVAL))
+            fail(in, "malformed number");
+
+        value |= (UHUGEINTVAL) (byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return value;
+        shift += 7;
+    }
+}
+
+/*
+
+=item C<static HUGEINTVAL read_delta(pprof_reader *in)>
+
+Read a zigzag-encoded signed varint.
+
+=cut
+
+*/
+
+static HUGEINTVAL
+read_delta(ARGMOD(pprof_reader *in))
+{
+    ASSERT_ARGS(read_delta)
+
+    const UHUGEINTVAL value = read_varint(in);
+
+    return (HUGEINTVAL) (value >> 1) ^ -(HUGEINTVAL) (value & 1);
+}
+
+/*
+
+=item C<static const char * string_at(const pprof_reader *in, const pprof_state
+*st, UHUGEINTVAL id)>
+
+Return the string with the given id.
+
+=cut
+
+*/
+
+PARROT_CANNOT_RETURN_NULL
+static const char *
+string_at(ARGIN(const pprof_reader *in), ARGIN(const pprof_state *st), UHUGEINTVAL id)
+{
+    ASSERT_ARGS(string_at)
+
+    if (id == 0 || id >= st->strings_size || !st->strings[id])
+        fail(in, "reference to an undefined string");
+    return st->strings[id];
+}
+
+/*
+
+=item C<static void read_string(pprof_reader *in, pprof_state *st)>
+
+Read a string definition and add it to the string table.  Ids are handed out
+in order, so the table is a plain array.
+
+=cut
+
+*/
+
+static void
+read_string(ARGMOD(pprof_reader *in), ARGMOD(pprof_state *st))
+{
+    ASSERT_ARGS(read_string)
+
+    const UHUGEINTVAL id  = read_varint(in);
+    const UHUGEINTVAL len = read_varint(in);
+    char             *str;
+    UHUGEINTVAL       i;
+
+    if (id == 0 || id > st->strings_size + 1024 * 1024)
+        fail(in, "malformed string record");
+
+    while (id >= st->strings_size) {
+        const UINTVAL old_size = st->strings_size;
+        st->strings_size = old_size ? old_size * 2 : 256;
+        st->strings      = (char **) mem_sys_realloc_zeroed(st->strings,
+                st->strings_size * sizeof (char *), old_size * sizeof (char *));
+        st->subs_by_ns   = (INTVAL *) mem_sys_realloc(st->subs_by_ns,
+                st->strings_size * sizeof (INTVAL));
+        for (i = old_size; i < st->strings_size; ++i)
+            st->subs_by_ns[i] = -1;
+    }
+
+    str = (char *) mem_sys_allocate(len + 1);
+    for (i = 0; i < len; ++i) {
+        const int byte = read_byte(in);
+        if (byte < 0)
+            fail(in, "truncated string");
+        str[i] = (char) byte;
+    }
+    str[len] = '\0';
+
+    if (st->strings[id])
+        mem_sys_free(st->strings[id]);
+    st->strings[id] = str;
+}
+
+/*
+
+=item C<static UINTVAL find_sub(pprof_state *st, UINTVAL ns_id, UINTVAL
+file_id)>
+
+Return the index of the sub with the given namespace and file, adding it to
+the sub table if this is the first time it's been seen.
+
+=cut
+
+*/
+
+static UINTVAL
+find_sub(ARGMOD(pprof_state *st), UINTVAL ns_id, UINTVAL file_id)
+{
+    ASSERT_ARGS(find_sub)
+
+    INTVAL     i;
+    pprof_sub *sub;
+
+    for (i = st->subs_by_ns[ns_id]; i >= 0; i = st->subs[i].next_same_ns)
+        if (st->subs[i].file_id == file_id)
+            return i;
+
+    if (st->num_subs == st->subs_size) {
+        st->subs_size = st->subs_size ? st->subs_size * 2 : 64;
+        st->subs      = (pprof_sub *) mem_sys_realloc(st->subs,
+                st->subs_size * sizeof (pprof_sub));
+    }
+
+    sub = &st->subs[st->num_subs];
+    memset(sub, 0, sizeof (pprof_sub));
+    sub->ns_id          = ns_id;
+    sub->file_id        = file_id;
+    sub->next_same_ns   = st->subs_by_ns[ns_id];
+    st->subs_by_ns[ns_id] = st->num_subs;
+
+    return st->num_subs++;
+}
+
+/*
+
+=item C<static pprof_cost * find_line(pprof_sub *sub, UINTVAL line)>
+
+Return the costs of a line of C<sub>.
+
+=cut
+
+*/
+
+PARROT_CANNOT_RETURN_NULL
+static pprof_cost *
+find_line(ARGMOD(pprof_sub *sub), UINTVAL line)
+{
+    ASSERT_ARGS(find_line)
+
+    if (line >= sub->lines_size) {
+        UINTVAL new_size = sub->lines_size ? sub->lines_size : 64;
+        while (line >= new_size)
+            new_size *= 2;
+        sub->lines      = (pprof_cost *) mem_sys_realloc_zeroed(sub->lines,
+                new_size * sizeof (pprof_cost), sub->lines_size * sizeof (pprof_cost));
+        sub->lines_size = new_size;
+    }
+    return &sub->lines[line];
+}
+
+/*
+
+=item C<static void activate(pprof_cost *cost, UHUGEINTVAL clock)>
+
+Note that a sub or line has been entered by another stack frame.
+
+=cut
+
+*/
+
+static void
+activate(ARGMOD(pprof_cost *cost), UHUGEINTVAL clock)
+{
+    ASSERT_ARGS(activate)
+
+    if (cost->active++ == 0)
+        cost->since = clock;
+}
+
+/*
+
+=item C<static void deactivate(pprof_cost *cost, UHUGEINTVAL clock)>
+
+Note that a stack frame has left a sub or line.  Once no frame is left in it,
+the time since it was entered is added to its inclusive time.
+
+=cut
+
+*/
+
+static void
+deactivate(ARGMOD(pprof_cost *cost), UHUGEINTVAL clock)
+{
+    ASSERT_ARGS(deactivate)
+
+    if (--cost->active == 0)
+        cost->inclusive += clock - cost->since;
+}
+
+/*
+
+=item C<static void leave_frame(pprof_state *st, pprof_frame *frame)>
+
+Deactivate the sub and the line of a frame that's being popped or reused.
+
+=cut
+
+*/
+
+static void
+leave_frame(ARGMOD(pprof_state *st), ARGMOD(pprof_frame *frame))
+{
+    ASSERT_ARGS(leave_frame)
+
+    pprof_sub * const sub = &st->subs[frame->sub];
+
+    if (frame->line >= 0)
+        deactivate(&sub->lines[frame->line], st->clock);
+    deactivate(&sub->cost, st->clock);
+    frame->line = -1;
+}
+
+/*
+
+=item C<static void pop_frames(PARROT_INTERP, pprof_state *st, UINTVAL depth)>
+
+Pop frames off the call stack until C<depth> are left.
+
+=cut
+
+*/
+
+static void
+pop_frames(PARROT_INTERP, ARGMOD(pprof_state *st), UINTVAL depth)
+{
+    ASSERT_ARGS(pop_frames)
+
+    while (st->depth > depth) {
+        pprof_frame * const frame = &st->stack[--st->depth];
+        leave_frame(st, frame);
+        Parrot_hash_delete(interp, st->ctx_depth, (void *) frame->ctx_addr);
+    }
+}
+
+/*
+
+=item C<static void context_switch(PARROT_INTERP, pprof_state *st, UINTVAL
+sub_index, PPROF_DATA sub_addr, PPROF_DATA ctx_addr)>
+
+Update the call stack for a context switch.  A context that isn't on the stack
+is a call; one that is already on it is a return to that frame; a different sub
+in the current context replaces the current frame.
+
+=cut
+
+*/
+
+static void
+context_switch(PARROT_INTERP, ARGMOD(pprof_state *st), UINTVAL sub_index,
+        PPROF_DATA sub_addr, PPROF_DATA ctx_addr)
+{
+    ASSERT_ARGS(context_switch)
+
+    pprof_frame *frame;
+    UINTVAL      depth;
+
+    if (st->depth) {
+        frame = &st->stack[st->depth - 1];
+        if (frame->ctx_addr == ctx_addr) {
+            if (frame->sub_addr != sub_addr) {
+                leave_frame(st, frame);
+                frame->sub      = sub_index;
+                frame->sub_addr = sub_addr;
+                activate(&st->subs[sub_index].cost, st->clock);
+            }
+            return;
+        }
+
+        depth = (UINTVAL) Parrot_hash_get(interp, st->ctx_depth, (void *) ctx_addr);
+        if (depth) {
+            pop_frames(interp, st, depth);
+            return;
+        }
+    }
+
+    if (st->depth == st->stack_size) {
+        st->stack_size = st->stack_size ? st->stack_size * 2 : 64;
+        st->stack      = (pprof_frame *) mem_sys_realloc(st->stack,
+                st->stack_size * sizeof (pprof_frame));
+    }
+
+    frame           = &st->stack[st->depth++];
+    frame->sub      = sub_index;
+    frame->sub_addr = sub_addr;
+    frame->ctx_addr = ctx_addr;
+    frame->line     = -1;
+    activate(&st->subs[sub_index].cost, st->clock);
+    Parrot_hash_put(interp, st->ctx_depth, (void *) ctx_addr, (void *) st->depth);
+}
+
+/*
+
+=item C<static void record_op(pprof_state *st, UINTVAL line, UHUGEINTVAL time)>
+
+Charge an op to the sub and line at the top of the call stack.
+
+=cut
+
+*/
+
+static void
+record_op(ARGMOD(pprof_state *st), UINTVAL line, UHUGEINTVAL time)
+{
+    ASSERT_ARGS(record_op)
+
+    pprof_frame * const frame = &st->stack[st->depth - 1];
+    pprof_sub   * const sub   = &st->subs[frame->sub];
+    pprof_cost         *cost;
+
+    if (frame->line != (INTVAL) line) {
+        if (frame->line >= 0)
+            deactivate(&sub->lines[frame->line], st->clock);
+        cost        = find_line(sub, line);
+        frame->line = line;
+        activate(cost, st->clock);
+    }
+    else
+        cost = &sub->lines[line];
+
+    ++cost->ops;
+    cost->exclusive += time;
+    ++sub->cost.ops;
+    sub->cost.exclusive += time;
+
+    ++st->total_ops;
+    st->clock += time;
+}
+
+/*
+
+=item C<static void read_profile(PARROT_INTERP, pprof_reader *in, pprof_state
+*st)>
+
+Read the whole profile, accumulating the costs of each sub and line.
+
+=cut
+
+*/
+
+static void
+read_profile(PARROT_INTERP, ARGMOD(pprof_reader *in), ARGMOD(pprof_state *st))
+{
+    ASSERT_ARGS(read_profile)
+
+    PPROF_DATA last_line = 0;
+    PPROF_DATA last_sub  = 0;
+    PPROF_DATA last_ctx  = 0;
+    int        tag;
+    size_t     i;
+
+    for (i = 0; i < PPROF_BINARY_MAGIC_LEN; ++i)
+        if (read_byte(in) != PPROF_BINARY_MAGIC[i])
+            fail(in, "not a binary profile");
+    if (read_varint(in) != PPROF_BINARY_VERSION)
+        fail(in, "profile was written in an incompatible format version");
+
+    while ((tag = read_byte(in)) >= 0) {
+        switch (tag) {
+          case PPROF_BIN_STRING:
+            read_string(in, st);
+            break;
+
+          case PPROF_BIN_VERSION:
+            (void) read_varint(in);
+            break;
+
+          case PPROF_BIN_CLI:
+            st->cli = mem_sys_strdup(string_at(in, st, read_varint(in)));
+            break;
+
+          case PPROF_BIN_CONTEXT_SWITCH:
+            {
+                const UHUGEINTVAL ns_id   = read_varint(in);
+                const UHUGEINTVAL file_id = read_varint(in);
+
+                (void) string_at(in, st, ns_id);
+                (void) string_at(in, st, file_id);
+                last_sub += read_delta(in);
+                last_ctx += read_delta(in);
+                context_switch(interp, st, find_sub(st, ns_id, file_id), last_sub, last_ctx);
+            }
+            break;
+
+          case PPROF_BIN_OP:
+            {
+                UHUGEINTVAL time;
+
+                (void) string_at(in, st, read_varint(in));
+                last_line += read_delta(in);
+                time       = read_varint(in);
+
+                if (!st->depth)
+                    fail(in, "op recorded outside of any context");
+                if (last_line < 0)
+                    fail(in, "negative line number");
+                record_op(st, last_line, time);
+            }
+            break;
+
+          case PPROF_BIN_ANNOTATION:
+            (void) string_at(in, st, read_varint(in));
+            (void) string_at(in, st, read_varint(in));
+            break;
+
+          case PPROF_BIN_END_OF_RUNLOOP:
+            pop_frames(interp, st, 0);
+            break;
+
+          default:
+            fail(in, "unknown record type");
+        }
+    }
+
+    pop_frames(interp, st, 0);
+}
+
+/*
+
+=item C<static int compare_rows(const void *a, const void *b)>
+
+C<qsort> comparison function that puts the most expensive rows first.
+
+=cut
+
+*/
+
+static int
+compare_rows(ARGIN(const void *a), ARGIN(const void *b))
+{
+    ASSERT_ARGS(compare_rows)
+
+    const pprof_row * const row_a = (const pprof_row *) a;
+    const pprof_row * const row_b = (const pprof_row *) b;
+
+    if (row_a->key != row_b->key)
+        return row_a->key < row_b->key ? 1 : -1;
+    return 0;
+}
+
+/*
+
+=item C<static UHUGEINTVAL sort_key(const pprof_cost *cost, pprof_sort_key
+sort)>
+
+Return the value of C<cost> that the report is sorted by.
+
+=cut
+
+*/
+
+static UHUGEINTVAL
+sort_key(ARGIN(const pprof_cost *cost), pprof_sort_key sort)
+{
+    ASSERT_ARGS(sort_key)
+
+    switch (sort) {
+      case PPROF_SORT_EXCLUSIVE:
+        return cost->exclusive;
+      case PPROF_SORT_OPS:
+        return cost->ops;
+      default:
+        return cost->inclusive;
+    }
+}
+
+/*
+
+=item C<static void print_row(const pprof_state *st, const pprof_row *row)>
+
+Print one line of the report.
+
+=cut
+
+*/
+
+static void
+print_row(ARGIN(const pprof_state *st), ARGIN(const pprof_row *row))
+{
+    ASSERT_ARGS(print_row)
+
+    const FLOATVAL total = st->clock ? (FLOATVAL) st->clock : 1.0;
+
+    printf("%14.0f %6.2f%% %14.0f %6.2f%% %12.0f  ",
+            (FLOATVAL) row->cost->inclusive, 100.0 * row->cost->inclusive / total,
+            (FLOATVAL) row->cost->exclusive, 100.0 * row->cost->exclusive / total,
+            (FLOATVAL) row->cost->ops);
+
+    if (row->cost == &row->sub->cost)
+        printf("%s (%s)\n", st->strings[row->sub->ns_id], st->strings[row->sub->file_id]);
+    else
+        printf("%s:%lu (%s)\n", st->strings[row->sub->file_id],
+                (unsigned long) row->line, st->strings[row->sub->ns_id]);
+}
+
+/*
+
+=item C<static void print_report(const pprof_state *st, UINTVAL top,
+pprof_sort_key sort)>
+
+Print the totals, then the C<top> most expensive subs and lines.
+
+=cut
+
+*/
+
+static void
+print_report(ARGIN(const pprof_state *st), UINTVAL top, pprof_sort_key sort)
+{
+    ASSERT_ARGS(print_report)
+
+    pprof_row *rows;
+    UINTVAL    num_rows = 0;
+    UINTVAL    num_lines;
+    UINTVAL    i, j;
+
+    if (st->cli)
+        printf("command: %s\n", st->cli);
+    printf("total time: %.0f\ntotal ops: %.0f\n",
+            (FLOATVAL) st->clock, (FLOATVAL) st->total_ops);
+
+    rows = (pprof_row *) mem_sys_allocate(st->num_subs * sizeof (pprof_row));
+    for (i = 0; i < st->num_subs; ++i) {
+        rows[num_rows].sub  = &st->subs[i];
+        rows[num_rows].cost = &st->subs[i].cost;
+        rows[num_rows].line = 0;
+        rows[num_rows].key  = sort_key(rows[num_rows].cost, sort);
+        ++num_rows;
+    }
+    qsort(rows, num_rows, sizeof (pprof_row), compare_rows);
+
+    printf("\nsubs:\n%14s %7s %14s %7s %12s  %s\n",
+            "inclusive", "", "exclusive", "", "ops", "sub (file)");
+    for (i = 0; i < num_rows && (top == 0 || i < top); ++i)
+        print_row(st, &rows[i]);
+
+    num_lines = 0;
+    for (i = 0; i < st->num_subs; ++i)
+        for (j = 0; j < st->subs[i].lines_size; ++j)
+            if (st->subs[i].lines[j].ops)
+                ++num_lines;
+
+    mem_sys_free(rows);
+    rows     = (pprof_row *) mem_sys_allocate((num_lines + 1) * sizeof (pprof_row));
+    num_rows = 0;
+    for (i = 0; i < st->num_subs; ++i) {
+        for (j = 0; j < st->subs[i].lines_size; ++j) {
+            if (st->subs[i].lines[j].ops) {
+                rows[num_rows].sub  = &st->subs[i];
+                rows[num_rows].cost = &st->subs[i].lines[j];
+                rows[num_rows].line = j;
+                rows[num_rows].key  = sort_key(rows[num_rows].cost, sort);
+                ++num_rows;
+            }
+        }
+    }
+    qsort(rows, num_rows, sizeof (pprof_row), compare_rows);
+
+    printf("\nlines:\n%14s %7s %14s %7s %12s  %s\n",
+            "inclusive", "", "exclusive", "", "ops", "file:line (sub)");
+    for (i = 0; i < num_rows && (top == 0 || i < top); ++i)
+        print_row(st, &rows[i]);
+
+    mem_sys_free(rows);
+}
+
+/*
+
+=item C<int main(int argc, const char **argv)>
+
+Parse the options, read the profile and print the report.
+
+=cut
+
+*/
+
+static struct longopt_opt_decl options[] = {
+    { 'n', 'n', OPTION_required_FLAG, { "--top" } },
+    { 's', 's', OPTION_required_FLAG, { "--sort" } },
+    { 'h', 'h', OPTION_optional_FLAG, { "--help" } },
+    {  0 ,  0 , OPTION_optional_FLAG, { NULL    } }
+};
+
+int
+main(int argc, const char **argv)
+{
+    int                     status;
+    UINTVAL                 top  = 20;
+    pprof_sort_key          sort = PPROF_SORT_INCLUSIVE;
+    struct longopt_opt_info opt  = LONGOPT_OPT_INFO_INIT;
+    Interp * const          interp = Parrot_interp_new(NULL);
+    pprof_reader           *in;
+    pprof_state             st;
+
+    Parrot_block_GC_mark(interp);
+
+    while ((status = longopt_get(argc, argv, options, &opt)) > 0) {
+        switch (opt.opt_id) {
+          case 'n':
+            top = strtoul(opt.opt_arg, NULL, 10);
+            break;
+          case 's':
+            if (STREQ(opt.opt_arg, "inclusive"))
+                sort = PPROF_SORT_INCLUSIVE;
+            else if (STREQ(opt.opt_arg, "exclusive"))
+                sort = PPROF_SORT_EXCLUSIVE;
+            else if (STREQ(opt.opt_arg, "ops"))
+                sort = PPROF_SORT_OPS;
+            else
+                help();
+            break;
+          default:
+            help();
+        }
+    }
+    if (status == -1 || opt.opt_index != argc - 1)
+        help();
+
+    in           = (pprof_reader *) mem_sys_allocate_zeroed(sizeof (pprof_reader));
+    in->filename = argv[opt.opt_index];
+    in->fh       = fopen(in->filename, "rb");
+    if (!in->fh) {
+        fprintf(stderr, "pprof_summary: couldn't open %s\n", in->filename);
+        exit(1);
+    }
+
+    memset(&st, 0, sizeof (pprof_state));
+    st.ctx_depth = Parrot_hash_new_pointer_hash(interp);
+
+    read_profile(interp, in, &st);
+    fclose(in->fh);
+
+    print_report(&st, top, sort);
+
+    exit(0);
+}
+
+/*
+
+=back
+
+=cut
+
+*/
+
+/*
+ * Local variables:
+ *   c-file-style: "parrot"
+ * End:
+ * vim: expandtab shiftwidth=4 cinoptions='\:2=2' :
+ */
@@ -44,6 +44,13 @@ Parrot_Int imcc_preprocess_file_api(
     Parrot_PMC compiler,
     Parrot_String file);
 
+PARROT_EXPORT
+PARROT_WARN_UNUSED_RESULT
+Parrot_Int imcc_set_optimization_api(
+    Parrot_PMC interp_pmc,
+    Parrot_PMC compiler,
+    Parrot_String opts);
+
 #define ASSERT_ARGS_imcc_compile_file_api __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(pbc))
 #define ASSERT_ARGS_imcc_get_pasm_compreg_api __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
@@ -51,6 +58,7 @@ Parrot_Int imcc_preprocess_file_api(
 #define ASSERT_ARGS_imcc_get_pir_compreg_api __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(compiler))
 #define ASSERT_ARGS_imcc_preprocess_file_api __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
+#define ASSERT_ARGS_imcc_set_optimization_api __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
 /* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
 /* HEADERIZER END: compilers/imcc/api.c */
 
@@ -29,6 +29,11 @@ PMC * imcc_compile_file(
         __attribute__nonnull__(2)
         FUNC_MODIFIES(*imcc);
 
+PARROT_EXPORT
+PARROT_PURE_FUNCTION
+INTVAL imcc_get_optimization_level(ARGIN(const imc_info_t *imcc))
+        __attribute__nonnull__(1);
+
 PARROT_EXPORT
 INTVAL imcc_last_error_code(ARGIN(imc_info_t *imcc))
         __attribute__nonnull__(1);
@@ -64,6 +69,12 @@ void imcc_set_debug_mode(
         __attribute__nonnull__(1)
         FUNC_MODIFIES(*imcc);
 
+PARROT_EXPORT
+void imcc_set_included_files(ARGMOD(imc_info_t *imcc), ARGIN(PMC *files))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(*imcc);
+
 PARROT_EXPORT
 void imcc_set_optimization_level(
     ARGMOD(imc_info_t *imcc),
@@ -98,6 +109,8 @@ void imcc_destroy(ARGFREE(imc_info_t * imcc));
 #define ASSERT_ARGS_imcc_compile_file __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc) \
     , PARROT_ASSERT_ARG(fullname))
+#define ASSERT_ARGS_imcc_get_optimization_level __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc))
 #define ASSERT_ARGS_imcc_last_error_code __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc))
 #define ASSERT_ARGS_imcc_last_error_message __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
@@ -111,6 +124,9 @@ void imcc_destroy(ARGFREE(imc_info_t * imcc));
        PARROT_ASSERT_ARG(imcc))
 #define ASSERT_ARGS_imcc_set_debug_mode __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc))
+#define ASSERT_ARGS_imcc_set_included_files __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(imcc) \
+    , PARROT_ASSERT_ARG(files))
 #define ASSERT_ARGS_imcc_set_optimization_level __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(imcc) \
     , PARROT_ASSERT_ARG(opts))
@@ -121,6 +121,13 @@ Parrot_Int Parrot_api_flag(
     Parrot_Int flags,
     Parrot_Int set);
 
+PARROT_API
+Parrot_Int Parrot_api_gc_telemetry(
+    Parrot_PMC interp_pmc,
+    ARGOUT(Parrot_PMC *telemetry))
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(*telemetry);
+
 PARROT_API
 Parrot_Int Parrot_api_get_compiler(
     Parrot_PMC interp_pmc,
@@ -257,6 +264,8 @@ Parrot_Int Parrot_api_wrap_pointer(
 #define ASSERT_ARGS_Parrot_api_destroy_interpreter \
      __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
 #define ASSERT_ARGS_Parrot_api_flag __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
+#define ASSERT_ARGS_Parrot_api_gc_telemetry __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(telemetry))
 #define ASSERT_ARGS_Parrot_api_get_compiler __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(type) \
     , PARROT_ASSERT_ARG(compiler))
@@ -75,6 +75,69 @@ typedef void (*alloc_objects_fn_type)(PARROT_INTERP, struct Memory_Pools *, stru
 typedef void (*gc_object_fn_type)(PARROT_INTERP, ARGMOD(struct Memory_Pools *),
                 ARGIN(struct Fixed_Size_Pool *), ARGMOD(PObj *));
 
+/* GC telemetry: the phases of a collection that are timed separately */
+typedef enum {
+    PARROT_GC_PHASE_ROOTS = 0,  /* tracing the root set */
+    PARROT_GC_PHASE_DIRTY,      /* processing the list of old objects written to */
+    PARROT_GC_PHASE_MARK,       /* marking everything reachable */
+    PARROT_GC_PHASE_SWEEP,      /* freeing dead objects, promoting live ones */
+    PARROT_GC_PHASE_COMPACT,    /* compacting string storage */
+    PARROT_GC_PHASE_MAX
+} Parrot_gc_phase_enum;
+
+/* Collections are counted per generation; older ones are counted in the last */
+#define PARROT_GC_TELEMETRY_GENERATIONS 4
+
+/* Bucket 0 counts pauses under 1us, bucket n those from 2^(n-1)us up to
+ * 2^n us, and the last bucket everything longer. */
+#define PARROT_GC_HISTOGRAM_BUCKETS     24
+
+typedef struct Parrot_GC_Histogram {
+    UINTVAL     count;
+    UHUGEINTVAL total_ns;
+    UHUGEINTVAL max_ns;
+    UINTVAL     buckets[PARROT_GC_HISTOGRAM_BUCKETS];
+} Parrot_GC_Histogram;
+
+/* What happened in one collection */
+typedef struct Parrot_GC_Collection {
+    UINTVAL     number;             /* collections before this one */
+    INTVAL      generation;         /* oldest generation collected */
+    UHUGEINTVAL pause_ns;
+    UHUGEINTVAL phase_ns[PARROT_GC_PHASE_MAX];
+    UINTVAL     phases_run;         /* bit (1 << phase) set for each phase that ran */
+    size_t      bytes_allocated;    /* since the end of the previous collection */
+    size_t      bytes_promoted;     /* moved into an older generation */
+    size_t      objects_survived;
+    size_t      objects_freed;
+    FLOATVAL    allocation_rate;    /* bytes per second between collections */
+} Parrot_GC_Collection;
+
+/* Called at the end of every collection. It runs inside the collector, so it
+ * must not allocate GC-managed objects or call into Parrot. */
+typedef void (*Parrot_gc_telemetry_fn)(PARROT_INTERP,
+                ARGIN(const Parrot_GC_Collection *collection), ARGIN_NULLOK(void *data));
+
+typedef struct Parrot_GC_Telemetry {
+    UINTVAL              collections;
+    UHUGEINTVAL          bytes_allocated;
+    UHUGEINTVAL          bytes_promoted;
+    UHUGEINTVAL          objects_survived;
+    UHUGEINTVAL          objects_freed;
+    UHUGEINTVAL          mutator_time;      /* between collections, in ns */
+    UINTVAL              generation_runs[PARROT_GC_TELEMETRY_GENERATIONS];
+    Parrot_GC_Histogram  pauses[PARROT_GC_TELEMETRY_GENERATIONS];
+    Parrot_GC_Histogram  phases[PARROT_GC_TELEMETRY_GENERATIONS][PARROT_GC_PHASE_MAX];
+    Parrot_GC_Collection current;           /* the collection in progress */
+    Parrot_GC_Collection last;              /* the last one finished */
+    UHUGEINTVAL          start_time;        /* of the collection in progress */
+    UHUGEINTVAL          phase_time;        /* end of its last timed phase */
+    UHUGEINTVAL          last_end_time;
+    size_t               used_after_last;   /* memory in use after the last collection */
+    Parrot_gc_telemetry_fn callback;
+    void                *callback_data;
+} Parrot_GC_Telemetry;
+
 
 /* &gen_from_enum(interpinfo.pasm) prefix(INTERPINFO_) */
 
@@ -532,6 +595,52 @@ void Parrot_unblock_GC_sweep(PARROT_INTERP)
 /* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
 /* HEADERIZER END: src/gc/api.c */
 
+/* HEADERIZER BEGIN: src/gc/telemetry.c */
+/* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
+
+PARROT_EXPORT
+void Parrot_gc_set_telemetry_callback(PARROT_INTERP,
+    ARGIN_NULLOK(Parrot_gc_telemetry_fn callback),
+    ARGIN_NULLOK(void *data))
+        __attribute__nonnull__(1);
+
+PARROT_EXPORT
+PARROT_PURE_FUNCTION
+PARROT_CANNOT_RETURN_NULL
+const Parrot_GC_Telemetry * Parrot_gc_telemetry(PARROT_INTERP)
+        __attribute__nonnull__(1);
+
+PARROT_EXPORT
+PARROT_WARN_UNUSED_RESULT
+PARROT_CANNOT_RETURN_NULL
+PMC * Parrot_gc_telemetry_hash(PARROT_INTERP)
+        __attribute__nonnull__(1);
+
+void Parrot_gc_telemetry_begin(PARROT_INTERP, INTVAL generation)
+        __attribute__nonnull__(1);
+
+void Parrot_gc_telemetry_end(PARROT_INTERP)
+        __attribute__nonnull__(1);
+
+void Parrot_gc_telemetry_phase(PARROT_INTERP, Parrot_gc_phase_enum phase)
+        __attribute__nonnull__(1);
+
+#define ASSERT_ARGS_Parrot_gc_set_telemetry_callback \
+     __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp))
+#define ASSERT_ARGS_Parrot_gc_telemetry __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp))
+#define ASSERT_ARGS_Parrot_gc_telemetry_hash __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp))
+#define ASSERT_ARGS_Parrot_gc_telemetry_begin __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp))
+#define ASSERT_ARGS_Parrot_gc_telemetry_end __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp))
+#define ASSERT_ARGS_Parrot_gc_telemetry_phase __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp))
+/* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
+/* HEADERIZER END: src/gc/telemetry.c */
+
 # define Parrot_gc_mark_STRING_alive(interp, obj) Parrot_gc_mark_STRING_alive_fun((interp), (obj))
 
 #if defined(PARROT_IN_CORE)
@@ -17,6 +17,27 @@
 /* preallocate freeze image for aggregates with this estimation */
 #define FREEZE_BYTES_PER_ITEM 9
 
+/* streamed images, written to and read from a handle; the format is described
+ * in docs/dev/pmc_freeze.pod */
+#define IMAGEIO_STREAM_MAGIC       "PRTFRZ\r\n"
+#define IMAGEIO_STREAM_MAGIC_LEN   8
+#define IMAGEIO_STREAM_VERSION     1
+
+/* bytes buffered between the visitor and the handle, and the longest chunk */
+#define IMAGEIO_STREAM_BUFFER_SIZE 65536
+
+/* longest varint encoding of a UINTVAL */
+#define IMAGEIO_VARINT_MAX         ((sizeof (UINTVAL) * 8 + 6) / 7)
+
+/* map small negative integers to small unsigned ones and back */
+#define IMAGEIO_ZIGZAG(v)   (((UINTVAL)(v) << 1) ^ ((v) < 0 ? ~(UINTVAL)0 : 0))
+#define IMAGEIO_UNZIGZAG(u) ((INTVAL)((u) >> 1) ^ -(INTVAL)((u) & 1))
+
+/* stream string headers: 0 for a NULL string, else 1 + the encoding number
+ * shifted left by two, with these flags in the low bits */
+#define IMAGEIO_STRING_CONSTANT    0x1
+#define IMAGEIO_STRING_PRIVATE7    0x2
+
 enum {
     enum_PackID_normal      = 0,
     enum_PackID_seen        = 1,
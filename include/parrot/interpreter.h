@@ -16,6 +16,7 @@ typedef enum {
     PARROT_BOUNDS_FLAG      = 0x04,  /* We're tracking byte code bounds */
     PARROT_PROFILE_FLAG     = 0x08,  /* gathering profile information */
     PARROT_GC_DEBUG_FLAG    = 0x10,  /* debugging memory management */
+    PARROT_LAZY_CONSTS_FLAG = 0x20,  /* thaw PBC constants on first use */
 
     PARROT_EXTERN_CODE_FLAG = 0x100, /* reusing another interp's code */
     PARROT_DESTROY_FLAG     = 0x200, /* the last interpreter shall cleanup */
@@ -63,7 +64,8 @@ typedef enum {
     PARROT_PROFILING_CORE   = 0x160,        /* used by parrot debugger */
     PARROT_SUBPROF_SUB_CORE = 0x200,        /* sub profiler core, sub mode */
     PARROT_SUBPROF_HLL_CORE = 0x201,        /* sub profiler core, hll mode */
-    PARROT_SUBPROF_OPS_CORE = 0x202         /* sub profiler core, ops mode */
+    PARROT_SUBPROF_OPS_CORE = 0x202,        /* sub profiler core, ops mode */
+    PARROT_SAMPLING_CORE    = 0x300         /* sampling profiler core */
 } Parrot_Run_core_t;
 /* &end_gen */
 
@@ -143,6 +145,7 @@ typedef struct warnings_t {
 } *Warnings;
 
 struct _Caches;         /* caches .h */
+struct _ns_global_cache_entry;  /* namespace.h */
 
 /* Get Context from interpreter */
 #define CONTEXT(interp)         Parrot_pcc_get_context_struct((interp), (interp)->ctx)
@@ -226,6 +229,8 @@ struct parrot_interp_t {
     PMC *HLL_entries;
 
     PMC *root_namespace;                      /* namespace hash */
+    UINTVAL ns_epoch;                         /* bumped on namespace changes */
+    struct _ns_global_cache_entry *ns_global_cache; /* see namespace.h */
     PMC *scheduler;                           /* concurrency scheduler */
     PMC *cur_task;
 
@@ -283,6 +288,7 @@ typedef enum {
     IGLOBALS_PBC_LIBS,          /* Hash of load_bytecode cde */
     IGLOBALS_EXECUTABLE,        /* How Parrot was invoked (from argv[0]) */
     IGLOBALS_LOADED_PBCS,       /* Hash of .pbc file -> PackfileView */
+    IGLOBALS_LIB_PATH_CACHE,    /* files found in the search paths */
 
     IGLOBALS_SIZE
 } iglobals_enum;
@@ -90,8 +90,8 @@ PARROT_CONST_FUNCTION
 PARROT_WARN_UNUSED_RESULT
 INTVAL Parrot_util_intval_mod(INTVAL i2, INTVAL i3);
 
-void Parrot_util_quicksort(PARROT_INTERP,
-    ARGMOD(void **data),
+void Parrot_util_sort(PARROT_INTERP,
+    ARGMOD(void *data),
     UINTVAL n,
     ARGIN(PMC *cmp),
     ARGIN(const char * cmp_signature))
@@ -117,7 +117,7 @@ void Parrot_util_quicksort(PARROT_INTERP,
 #define ASSERT_ARGS_Parrot_util_uint_rand __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
 #define ASSERT_ARGS_Parrot_util_floatval_mod __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
 #define ASSERT_ARGS_Parrot_util_intval_mod __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
-#define ASSERT_ARGS_Parrot_util_quicksort __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+#define ASSERT_ARGS_Parrot_util_sort __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(data) \
     , PARROT_ASSERT_ARG(cmp) \
@@ -11,6 +11,24 @@
 #ifndef PARROT_GLOBAL_H_GUARD
 #define PARROT_GLOBAL_H_GUARD
 
+/*
+ * Cache of global lookups done by the get_*global ops.  Each op selects a
+ * slot from its own address in the bytecode; an entry is valid as long as
+ * the interpreter's namespace epoch hasn't moved since it was filled.
+ */
+#define NS_GLOBAL_CACHE_SIZE 256
+
+typedef struct _ns_global_cache_entry {
+    UINTVAL  epoch;     /* interp->ns_epoch when the entry was filled */
+    PMC     *ns;        /* namespace the lookup started from */
+    PMC     *key;       /* constant namespace key, or NULL */
+    STRING  *name;      /* name of the global */
+    PMC     *value;     /* the global found, or PMCNULL */
+} Ns_global_cache_entry;
+
+/* Every store into or delete from a namespace invalidates cached lookups */
+#define PARROT_NS_EPOCH_BUMP(interp) ((interp)->ns_epoch++)
+
 /* HEADERIZER BEGIN: src/namespace.c */
 /* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
 
@@ -21,6 +39,18 @@ PMC * Parrot_ns_find_current_namespace_global(PARROT_INTERP,
     ARGIN_NULLOK(STRING *globalname))
         __attribute__nonnull__(1);
 
+PARROT_EXPORT
+PARROT_WARN_UNUSED_RESULT
+PARROT_CANNOT_RETURN_NULL
+PMC * Parrot_ns_find_global_cached(PARROT_INTERP,
+    ARGIN_NULLOK(PMC *base_ns),
+    ARGIN_NULLOK(PMC *key),
+    ARGIN_NULLOK(STRING *globalname),
+    ARGIN(const opcode_t *site),
+    ARGIN_NULLOK(void *next))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(5);
+
 PARROT_EXPORT
 PARROT_WARN_UNUSED_RESULT
 PARROT_CANNOT_RETURN_NULL
@@ -135,9 +165,18 @@ void Parrot_ns_store_sub(PARROT_INTERP, ARGIN(PMC *sub_pmc))
         __attribute__nonnull__(1)
         __attribute__nonnull__(2);
 
+void Parrot_ns_destroy_global_cache(PARROT_INTERP)
+        __attribute__nonnull__(1);
+
+void Parrot_ns_mark_global_cache(PARROT_INTERP)
+        __attribute__nonnull__(1);
+
 #define ASSERT_ARGS_Parrot_ns_find_current_namespace_global \
      __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp))
+#define ASSERT_ARGS_Parrot_ns_find_global_cached __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(site))
 #define ASSERT_ARGS_Parrot_ns_find_global_from_op __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(ns))
@@ -185,6 +224,11 @@ void Parrot_ns_store_sub(PARROT_INTERP, ARGIN(PMC *sub_pmc))
 #define ASSERT_ARGS_Parrot_ns_store_sub __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(sub_pmc))
+#define ASSERT_ARGS_Parrot_ns_destroy_global_cache \
+     __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp))
+#define ASSERT_ARGS_Parrot_ns_mark_global_cache __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp))
 /* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
 /* HEADERIZER END: src/namespace.c */
 
@@ -1146,6 +1146,22 @@ op_lib_t *Parrot_DynOp_core_4_9_0(PARROT_INTERP, long init);
  opcode_t * Parrot_wait_p(opcode_t *, PARROT_INTERP);
  opcode_t * Parrot_wait_pc(opcode_t *, PARROT_INTERP);
  opcode_t * Parrot_pass(opcode_t *, PARROT_INTERP);
+ opcode_t * Parrot_find_lex_slot_p_ic_ic(opcode_t *, PARROT_INTERP);
+ opcode_t * Parrot_find_lex_slot_s_ic_ic(opcode_t *, PARROT_INTERP);
+ opcode_t * Parrot_find_lex_slot_i_ic_ic(opcode_t *, PARROT_INTERP);
+ opcode_t * Parrot_find_lex_slot_n_ic_ic(opcode_t *, PARROT_INTERP);
+ opcode_t * Parrot_store_lex_slot_ic_ic_p(opcode_t *, PARROT_INTERP);
+ opcode_t * Parrot_store_lex_slot_ic_ic_s(opcode_t *, PARROT_INTERP);
+ opcode_t * Parrot_store_lex_slot_ic_ic_sc(opcode_t *, PARROT_INTERP);
+ opcode_t * Parrot_store_lex_slot_ic_ic_i(opcode_t *, PARROT_INTERP);
+ opcode_t * Parrot_store_lex_slot_ic_ic_ic(opcode_t *, PARROT_INTERP);
+ opcode_t * Parrot_store_lex_slot_ic_ic_n(opcode_t *, PARROT_INTERP);
+ opcode_t * Parrot_store_lex_slot_ic_ic_nc(opcode_t *, PARROT_INTERP);
+ opcode_t * Parrot_renew_p_sc(opcode_t *, PARROT_INTERP);
+ opcode_t * Parrot_throw_control_i(opcode_t *, PARROT_INTERP);
+ opcode_t * Parrot_throw_control_ic(opcode_t *, PARROT_INTERP);
+ opcode_t * Parrot_throw_control_i_p(opcode_t *, PARROT_INTERP);
+ opcode_t * Parrot_throw_control_ic_p(opcode_t *, PARROT_INTERP);
 
 
 #endif /* PARROT_OPLIB_CORE_OPS_H_GUARD */
@@ -1139,7 +1139,23 @@ typedef enum {
     PARROT_OP_receive_p,                       /* 1121 */
     PARROT_OP_wait_p,                          /* 1122 */
     PARROT_OP_wait_pc,                         /* 1123 */
-    PARROT_OP_pass                             /* 1124 */
+    PARROT_OP_pass,                            /* 1124 */
+    PARROT_OP_find_lex_slot_p_ic_ic,           /* 1125 */
+    PARROT_OP_find_lex_slot_s_ic_ic,           /* 1126 */
+    PARROT_OP_find_lex_slot_i_ic_ic,           /* 1127 */
+    PARROT_OP_find_lex_slot_n_ic_ic,           /* 1128 */
+    PARROT_OP_store_lex_slot_ic_ic_p,          /* 1129 */
+    PARROT_OP_store_lex_slot_ic_ic_s,          /* 1130 */
+    PARROT_OP_store_lex_slot_ic_ic_sc,         /* 1131 */
+    PARROT_OP_store_lex_slot_ic_ic_i,          /* 1132 */
+    PARROT_OP_store_lex_slot_ic_ic_ic,         /* 1133 */
+    PARROT_OP_store_lex_slot_ic_ic_n,          /* 1134 */
+    PARROT_OP_store_lex_slot_ic_ic_nc,         /* 1135 */
+    PARROT_OP_renew_p_sc,                      /* 1136 */
+    PARROT_OP_throw_control_i,                 /* 1137 */
+    PARROT_OP_throw_control_ic,                /* 1138 */
+    PARROT_OP_throw_control_i_p,               /* 1139 */
+    PARROT_OP_throw_control_ic_p               /* 1140 */
 
 } parrot_opcode_enums;
 
@@ -1139,6 +1139,22 @@ enum OPS_ENUM {
     enum_ops_wait_p                        = 1122,
     enum_ops_wait_pc                       = 1123,
     enum_ops_pass                          = 1124,
+    enum_ops_find_lex_slot_p_ic_ic         = 1125,
+    enum_ops_find_lex_slot_s_ic_ic         = 1126,
+    enum_ops_find_lex_slot_i_ic_ic         = 1127,
+    enum_ops_find_lex_slot_n_ic_ic         = 1128,
+    enum_ops_store_lex_slot_ic_ic_p        = 1129,
+    enum_ops_store_lex_slot_ic_ic_s        = 1130,
+    enum_ops_store_lex_slot_ic_ic_sc       = 1131,
+    enum_ops_store_lex_slot_ic_ic_i        = 1132,
+    enum_ops_store_lex_slot_ic_ic_ic       = 1133,
+    enum_ops_store_lex_slot_ic_ic_n        = 1134,
+    enum_ops_store_lex_slot_ic_ic_nc       = 1135,
+    enum_ops_renew_p_sc                    = 1136,
+    enum_ops_throw_control_i               = 1137,
+    enum_ops_throw_control_ic              = 1138,
+    enum_ops_throw_control_i_p             = 1139,
+    enum_ops_throw_control_ic_p            = 1140,
 };
 
 
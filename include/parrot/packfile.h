@@ -44,11 +44,14 @@
 **   parrot, pbc_merge, parrot_debugger use 0
 **   pbc_dump, pbc_disassemble use 1 to skip the version check
 **   pbc_dump -h requires 2
+**   PFOPT_LAZY_CONSTS leaves non-Sub PMC constants frozen until first use;
+**   the packed image must outlive the PackFile
 */
 #define PFOPT_NONE            0
 #define PFOPT_UTILS           1
 #define PFOPT_HEADERONLY      2
 #define PFOPT_PMC_FREEZE_ONLY 4
+#define PFOPT_LAZY_CONSTS     8
 
 /*
 ** Enumerated constants
@@ -177,15 +180,20 @@ typedef struct PackFile_ConstTable {
     PackFile_Segment           base;
     struct {
         opcode_t        const_count;
+        opcode_t        const_alloc;    /* allocated slots, if more than counted */
         FLOATVAL       *constants;
     } num;
     struct {
         opcode_t        const_count;
+        opcode_t        const_alloc;
         STRING        **constants;
     } str;
     struct {
         opcode_t        const_count;
+        opcode_t        const_alloc;
         PMC           **constants;
+        const opcode_t **images;    /* frozen images of lazy constants */
+        PMC           **olists;     /* thawed object lists, for backrefs */
     } pmc;
     PackFile_ByteCode     *code;        /* where this segment belongs to */
     Hash                  *string_hash; /* Hash for lookup of string indices */
@@ -194,6 +202,12 @@ typedef struct PackFile_ConstTable {
     opcode_t               ntags;       /* Number of tags */
 } PackFile_ConstTable;
 
+/* Fetch a PMC constant, thawing it first if it was loaded lazily */
+#define PackFile_ConstTable_get_pmc(interp, ct, idx) \
+    ((ct)->pmc.constants[(idx)] \
+        ? (ct)->pmc.constants[(idx)] \
+        : PackFile_ConstTable_thaw_pmc((interp), (ct), (idx)))
+
 typedef struct PackFile_ByteCode_OpMappingEntry {
     op_lib_t *lib;       /* library for this entry */
     opcode_t  n_ops;     /* number of ops used */
@@ -279,6 +293,7 @@ typedef struct PackFile {
     const opcode_t      *src;         /* possible mmap()ed start of the PF */
     size_t               size;        /* size in bytes */
     INTVAL               is_mmap_ped; /* don't free it, munmap it at destroy */
+    INTVAL               is_src_owned; /* src was read into memory we free */
 
     PackFile_Header     *header;
 
@@ -298,6 +313,11 @@ typedef struct PackFile {
     packfile_fetch_nv_t  fetch_nv;
 } PackFile;
 
+/* Segment data can point straight into the loaded image */
+#define PackFile_shares_src(pf) \
+    (((pf)->is_mmap_ped || (pf)->is_src_owned) \
+    && !(pf)->need_endianize && !(pf)->need_wordsize)
+
 
 typedef enum {
     PBC_MAIN   = 1,
@@ -385,6 +405,13 @@ PARROT_CONST_FUNCTION
 PARROT_WARN_UNUSED_RESULT
 size_t PF_size_strlen(const UINTVAL len);
 
+PARROT_WARN_UNUSED_RESULT
+PARROT_CANNOT_RETURN_NULL
+const opcode_t * PF_skip_buf(
+    ARGIN_NULLOK(const PackFile *pf),
+    ARGIN(const opcode_t *cursor))
+        __attribute__nonnull__(2);
+
 PARROT_WARN_UNUSED_RESULT
 PARROT_CANNOT_RETURN_NULL
 opcode_t* PF_store_buf(ARGOUT(opcode_t *cursor), ARGIN(const STRING *s))
@@ -456,6 +483,8 @@ opcode_t* PF_store_string(ARGOUT(opcode_t *cursor), ARGIN(const STRING *s))
 #define ASSERT_ARGS_PF_size_string __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(s))
 #define ASSERT_ARGS_PF_size_strlen __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
+#define ASSERT_ARGS_PF_skip_buf __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(cursor))
 #define ASSERT_ARGS_PF_store_buf __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(cursor) \
     , PARROT_ASSERT_ARG(s))
@@ -1040,6 +1069,56 @@ void PackFile_ConstTable_clear(PARROT_INTERP,
         __attribute__nonnull__(2)
         FUNC_MODIFIES(*self);
 
+PARROT_EXPORT
+PARROT_CANNOT_RETURN_NULL
+PMC * PackFile_ConstTable_get_olist(PARROT_INTERP,
+    ARGMOD(PackFile_ConstTable *self),
+    opcode_t idx)
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(*self);
+
+PARROT_EXPORT
+PARROT_IGNORABLE_RESULT
+opcode_t /*@alt void@*/
+PackFile_ConstTable_push_num(PARROT_INTERP,
+    ARGMOD(PackFile_ConstTable *self),
+    FLOATVAL n)
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(*self);
+
+PARROT_EXPORT
+PARROT_IGNORABLE_RESULT
+opcode_t /*@alt void@*/
+PackFile_ConstTable_push_pmc(PARROT_INTERP,
+    ARGMOD(PackFile_ConstTable *self),
+    ARGIN(PMC *pmc))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        FUNC_MODIFIES(*self);
+
+PARROT_EXPORT
+PARROT_IGNORABLE_RESULT
+opcode_t /*@alt void@*/
+PackFile_ConstTable_push_str(PARROT_INTERP,
+    ARGMOD(PackFile_ConstTable *self),
+    ARGIN(STRING *s))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        FUNC_MODIFIES(*self);
+
+PARROT_EXPORT
+PARROT_CANNOT_RETURN_NULL
+PMC * PackFile_ConstTable_thaw_pmc(PARROT_INTERP,
+    ARGMOD(PackFile_ConstTable *self),
+    opcode_t idx)
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(*self);
+
 PARROT_EXPORT
 PARROT_WARN_UNUSED_RESULT
 PARROT_CAN_RETURN_NULL
@@ -1167,6 +1246,23 @@ void pf_register_standard_funcs(PARROT_INTERP, ARGMOD(PackFile *pf))
 #define ASSERT_ARGS_PackFile_ConstTable_clear __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(self))
+#define ASSERT_ARGS_PackFile_ConstTable_get_olist __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(self))
+#define ASSERT_ARGS_PackFile_ConstTable_push_num __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(self))
+#define ASSERT_ARGS_PackFile_ConstTable_push_pmc __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(self) \
+    , PARROT_ASSERT_ARG(pmc))
+#define ASSERT_ARGS_PackFile_ConstTable_push_str __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(self) \
+    , PARROT_ASSERT_ARG(s))
+#define ASSERT_ARGS_PackFile_ConstTable_thaw_pmc __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(self))
 #define ASSERT_ARGS_PackFile_ConstTable_unpack __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(seg) \
@@ -142,6 +142,15 @@ INTVAL Parrot_pmc_register_new_type(PARROT_INTERP, ARGIN(STRING *name))
         __attribute__nonnull__(1)
         __attribute__nonnull__(2);
 
+PARROT_EXPORT
+PARROT_CANNOT_RETURN_NULL
+PARROT_WARN_UNUSED_RESULT
+PMC * Parrot_pmc_renew(PARROT_INTERP,
+    ARGMOD_NULLOK(PMC *pmc),
+    INTVAL base_type)
+        __attribute__nonnull__(1)
+        FUNC_MODIFIES(*pmc);
+
 PARROT_EXPORT
 PARROT_CANNOT_RETURN_NULL
 PARROT_IGNORABLE_RESULT
@@ -259,6 +268,8 @@ INTVAL Parrot_pmc_type_does(PARROT_INTERP,
 #define ASSERT_ARGS_Parrot_pmc_register_new_type __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(name))
+#define ASSERT_ARGS_Parrot_pmc_renew __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp))
 #define ASSERT_ARGS_Parrot_pmc_reuse __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(pmc))
@@ -292,6 +303,12 @@ INTVAL Parrot_pmc_type_does(PARROT_INTERP,
 #define PMC_IS_TYPE(p, t) ((p)->vtable->base_type == enum_class_ ## t)
 #define PMC_IS_TYPE_ENUM(p, e) ((p)->vtable->base_type == (e))
 
+/* True if p is exactly the core type t, not a read-only variant or a
+ * subclass, so that its attributes may be used without going through
+ * the vtable. */
+#define PMC_IS_EXACTLY(interp, p, t) \
+    ((p)->vtable == (interp)->vtables[enum_class_ ## t])
+
 #endif /* PARROT_PMC_H_GUARD */
 
 /*
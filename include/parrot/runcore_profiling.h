@@ -38,6 +38,28 @@ typedef enum Parrot_profiling_line {
     PPROF_LINE_END_OF_RUNLOOP
 } Parrot_profiling_line;
 
+/* Binary profile format.  A file starts with PPROF_BINARY_MAGIC and the
+ * format version as a varint, followed by records.  Each record is a tag
+ * byte and its fields, all unsigned LEB128 varints; signed deltas are
+ * zigzag-encoded first.  Strings are interned: a PPROF_BIN_STRING record
+ * defines the next id before its first use.  See docs/dev/profiling.pod. */
+#define PPROF_BINARY_MAGIC      "PPROFBIN"
+#define PPROF_BINARY_MAGIC_LEN  8
+#define PPROF_BINARY_VERSION    1
+
+/* size of the binary writer's buffer */
+#define PPROF_BINARY_BUFFER_SIZE (4 * 1024 * 1024)
+
+typedef enum Parrot_profiling_binary_tag {
+    PPROF_BIN_STRING         = 1,   /* id, length, bytes */
+    PPROF_BIN_VERSION        = 2,   /* pprof version */
+    PPROF_BIN_CLI            = 3,   /* string id */
+    PPROF_BIN_CONTEXT_SWITCH = 4,   /* ns id, file id, sub delta, ctx delta */
+    PPROF_BIN_OP             = 5,   /* op name id, line delta, time */
+    PPROF_BIN_ANNOTATION     = 6,   /* name id, value id */
+    PPROF_BIN_END_OF_RUNLOOP = 7
+} Parrot_profiling_binary_tag;
+
 typedef void (*profiling_store_fn)  (PARROT_INTERP, ARGIN(Parrot_profiling_runcore_t*), ARGIN(PPROF_DATA*), ARGIN_NULLOK(Parrot_profiling_line));
 typedef void (*profiling_init_fn)   (PARROT_INTERP, ARGIN(Parrot_profiling_runcore_t*));
 typedef void (*profiling_destroy_fn)(PARROT_INTERP, ARGIN(Parrot_profiling_runcore_t*));
@@ -100,6 +122,16 @@ struct profiling_runcore_t {
     UINTVAL         time_size;  /* how big is the following array */
     UHUGEINTVAL    *time;       /* time spent between DO_OP and start/end of a runcore */
     Hash           *line_cache; /* hash for caching pc -> line mapping */
+
+    /* binary output */
+    unsigned char  *bin_buf;        /* pending output */
+    size_t          bin_len;
+    Hash           *bin_strings;    /* interned string -> id */
+    Hash           *bin_opnames;    /* op name pointer -> id */
+    UINTVAL         bin_next_id;
+    PPROF_DATA      bin_last_line;  /* previous values, for delta encoding */
+    PPROF_DATA      bin_last_sub;
+    PPROF_DATA      bin_last_ctx;
 };
 
 #define Profiling_flag_SET(runcore, flag) \
@@ -0,0 +1,110 @@
+/* runcore_sampling.h
+ *  Copyright (C) 2012, Parrot Foundation.
+ *  Overview:
+ *     Data structures used by the sampling profiler runcore.
+ */
+
+#ifndef PARROT_RUNCORE_SAMPLING_H_GUARD
+#define PARROT_RUNCORE_SAMPLING_H_GUARD
+
+#include "parrot/parrot.h"
+#include "parrot/runcore_api.h"
+
+/* number of samples buffered before they are symbolized */
+#define SAMPLING_RING_SIZE  64
+
+/* maximum number of frames recorded per sample, innermost first */
+#define SAMPLING_MAX_DEPTH  128
+
+/* distinct call chains written out before the rest are lumped together */
+#define SAMPLING_MAX_STACKS 65536
+
+/* default sampling frequency, in samples per second of CPU time */
+#define SAMPLING_DEFAULT_HZ 100
+
+typedef struct sampling_frame         sampling_frame;
+typedef struct sampling_record        sampling_record;
+typedef struct sampling_label         sampling_label;
+typedef struct sampling_stack         sampling_stack;
+typedef struct sampling_runcore_t     Parrot_sampling_runcore_t;
+
+/* one frame of a raw sample: the sub and the op being executed in it */
+struct sampling_frame {
+    PMC      *sub;
+    opcode_t *pc;
+};
+
+/* a raw sample, as copied out of the context chain */
+struct sampling_record {
+    UINTVAL         weight;     /* timer ticks this sample stands for */
+    UINTVAL         depth;
+    int             truncated;  /* the chain was deeper than SAMPLING_MAX_DEPTH */
+    sampling_frame  frames[SAMPLING_MAX_DEPTH];
+};
+
+/* the symbolized name of a frame, cached per pc */
+struct sampling_label {
+    PMC            *sub;
+    char           *text;
+};
+
+/* one line of folded output */
+struct sampling_stack {
+    char           *folded;
+    UINTVAL         count;
+};
+
+struct sampling_runcore_t {
+    STRING                      *name;
+    int                          id;
+    oplib_init_f                 opinit;
+    Parrot_runcore_runops_fn_t   runops;
+    Parrot_runcore_destroy_fn_t  destroy;
+    Parrot_runcore_prepare_fn_t  prepare_run;
+    INTVAL                       flags;
+
+    /* samples waiting to be symbolized; head and tail only ever grow */
+    sampling_record             *ring;
+    UINTVAL                      ring_head;
+    UINTVAL                      ring_tail;
+
+    /* the value of the tick counter when the last sample was taken */
+    int                          ticks_seen;
+    UINTVAL                      hz;
+    UINTVAL                      samples;
+
+    /* every sub in a buffered sample is kept alive until symbolized */
+    Hash                        *seen_subs;
+    PMC                         *markpmcs;
+
+    /* maps pc -> sampling_label */
+    Hash                        *labels;
+    /* maps folded stack -> sampling_stack */
+    Hash                        *stacks;
+
+    char                        *buf;
+    size_t                       buf_size;
+
+    char                        *filename;
+};
+
+
+/* HEADERIZER BEGIN: src/runcore/sampling.c */
+/* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
+
+void Parrot_runcore_sampling_init(PARROT_INTERP)
+        __attribute__nonnull__(1);
+
+#define ASSERT_ARGS_Parrot_runcore_sampling_init __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp))
+/* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
+/* HEADERIZER END: src/runcore/sampling.c */
+
+#endif /* PARROT_RUNCORE_SAMPLING_H_GUARD */
+
+/*
+ * Local variables:
+ *   c-file-style: "parrot"
+ * End:
+ * vim: expandtab shiftwidth=4 cinoptions='\:2=2' :
+ */
@@ -161,6 +161,13 @@ static FLOATVAL* numval_param_from_op(PARROT_INTERP,
         __attribute__nonnull__(1)
         __attribute__nonnull__(2);
 
+PARROT_WARN_UNUSED_RESULT
+PARROT_CANNOT_RETURN_NULL
+static void* param_from_c_ptrs(PARROT_INTERP,
+    ARGIN(void **params),
+    INTVAL param_index)
+        __attribute__nonnull__(2);
+
 static void parse_signature_string(PARROT_INTERP,
     ARGIN(const char *signature),
     ARGMOD(PMC **arg_flags))
@@ -280,6 +287,8 @@ static STRING** string_param_from_op(PARROT_INTERP,
 #define ASSERT_ARGS_numval_param_from_op __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(raw_params))
+#define ASSERT_ARGS_param_from_c_ptrs __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(params))
 #define ASSERT_ARGS_parse_signature_string __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(signature) \
@@ -1408,6 +1417,98 @@ Parrot_pcc_fill_params_from_varargs(PARROT_INTERP, ARGMOD_NULLOK(PMC *call_objec
 
 /*
 
+=item C<void Parrot_pcc_fill_params_from_c_ptrs(PARROT_INTERP, PMC *call_object,
+PMC *raw_sig, void **params)>
+
+Gets args for the current function call and puts them into position, like
+C<Parrot_pcc_fill_params_from_c_args>. The signature has already been parsed
+into C<raw_sig> (see C<Parrot_pcc_parse_signature_string>) and C<params>
+holds one destination pointer per element of C<raw_sig>, so callers making
+the same call many times can set both up once.
+
+=cut
+
+*/
+
+PARROT_EXPORT
+void
+Parrot_pcc_fill_params_from_c_ptrs(PARROT_INTERP, ARGMOD(PMC *call_object),
+        ARGIN(PMC *raw_sig), ARGIN(void **params))
+{
+    ASSERT_ARGS(Parrot_pcc_fill_params_from_c_ptrs)
+    static const pcc_funcs_ptr function_pointers = {
+        (intval_ptr_func_t)param_from_c_ptrs,
+        (numval_ptr_func_t)param_from_c_ptrs,
+        (string_ptr_func_t)param_from_c_ptrs,
+        (pmc_ptr_func_t)param_from_c_ptrs,
+
+        (intval_func_t)intval_constant_from_varargs,
+        (numval_func_t)numval_constant_from_varargs,
+        (string_func_t)string_constant_from_varargs,
+        (pmc_func_t)pmc_constant_from_varargs,
+    };
+
+    if (VTABLE_elements(interp, raw_sig) == 0)
+        return;
+
+    fill_params(interp, call_object, raw_sig, params,
+            &function_pointers, PARROT_ERRORS_PARAM_COUNT_FLAG);
+}
+
+/*
+
+=item C<void Parrot_pcc_set_call_from_c_ptrs(PARROT_INTERP, PMC *signature, PMC
+*raw_sig, void **args)>
+
+Converts an array of pointers to C values into an existent CallContext PMC,
+like C<Parrot_pcc_set_call_from_c_args>. C<raw_sig> is a parsed signature
+of plain C<I>, C<N>, C<S> and C<P> arguments (see
+C<Parrot_pcc_parse_signature_string>); it is shared, not copied, so it must
+not be modified afterwards.
+
+=cut
+
+*/
+
+PARROT_EXPORT
+void
+Parrot_pcc_set_call_from_c_ptrs(PARROT_INTERP, ARGIN(PMC *signature),
+        ARGIN(PMC *raw_sig), ARGIN(void **args))
+{
+    ASSERT_ARGS(Parrot_pcc_set_call_from_c_ptrs)
+    const INTVAL count = VTABLE_elements(interp, raw_sig);
+    INTVAL       i;
+
+    PARROT_ASSERT(PMCNULL != signature);
+    VTABLE_morph(interp, signature, PMCNULL);
+    SETATTR_CallContext_arg_flags(interp, signature, raw_sig);
+
+    for (i = 0; i < count; ++i) {
+        const INTVAL flags = VTABLE_get_integer_keyed_int(interp, raw_sig, i);
+
+        switch (PARROT_ARG_TYPE_MASK_MASK(flags)) {
+          case PARROT_ARG_INTVAL:
+            VTABLE_push_integer(interp, signature, *(INTVAL *)args[i]);
+            break;
+          case PARROT_ARG_FLOATVAL:
+            VTABLE_push_float(interp, signature, *(FLOATVAL *)args[i]);
+            break;
+          case PARROT_ARG_STRING:
+            VTABLE_push_string(interp, signature, *(STRING **)args[i]);
+            break;
+          case PARROT_ARG_PMC:
+            VTABLE_push_pmc(interp, signature, *(PMC **)args[i]);
+            break;
+          default:
+            Parrot_ex_throw_from_c_args(interp, NULL,
+                    EXCEPTION_INVALID_OPERATION,
+                    "Dispatch: invalid argument type %d!", flags);
+        }
+    }
+}
+
+/*
+
 =item C<void Parrot_pcc_split_signature_string(const char *signature, const char
 **arg_sig, const char **return_sig)>
 
@@ -1670,6 +1771,12 @@ INTVAL param_index)>
 =item C<static PMC** pmc_param_from_c_args(PARROT_INTERP, va_list *args, INTVAL
 param_index)>
 
+=item C<static void* param_from_c_ptrs(PARROT_INTERP, void **params, INTVAL
+param_index)>
+
+Get the parameter pointer for C<param_index> from an array of pointers. The
+pointer is returned untyped and cast by the caller's accessor table.
+
 Parrot constants cannot be passed from varargs, so these functions are dummies
 that throw exceptions.
 
@@ -1805,6 +1912,15 @@ pmc_param_from_c_args(SHIM_INTERP, ARGIN(va_list *args), SHIM(INTVAL param_index
     return va_arg(*args, PMC**);
 }
 
+PARROT_WARN_UNUSED_RESULT
+PARROT_CANNOT_RETURN_NULL
+static void*
+param_from_c_ptrs(SHIM_INTERP, ARGIN(void **params), INTVAL param_index)
+{
+    ASSERT_ARGS(param_from_c_ptrs)
+    return params[param_index];
+}
+
 PARROT_WARN_UNUSED_RESULT
 static INTVAL
 intval_constant_from_varargs(SHIM_INTERP, ARGIN(SHIM(void *data)), SHIM(INTVAL index))
@@ -14,6 +14,7 @@ Parrot_Context functions.
 */
 
 #include "parrot/parrot.h"
+#include "pmc/pmc_sub.h"
 
 /* HEADERIZER HFILE: include/parrot/context.h */
 
@@ -695,7 +696,8 @@ INTVAL idx)>
 =item C<PMC* Parrot_pcc_get_pmc_constant_func(PARROT_INTERP, const PMC *ctx,
 INTVAL idx)>
 
-Get typed constant from context.
+Get typed constant from context. PMC constants of a lazily loaded PackFile
+are thawed on first access.
 
 =cut
 
@@ -724,14 +726,34 @@ Parrot_pcc_get_string_constant_func(SHIM_INTERP, ARGIN(const PMC *ctx), INTVAL i
 }
 
 PARROT_EXPORT
-PARROT_PURE_FUNCTION
 PARROT_CAN_RETURN_NULL
 PMC*
-Parrot_pcc_get_pmc_constant_func(SHIM_INTERP, ARGIN(const PMC *ctx), INTVAL idx)
+Parrot_pcc_get_pmc_constant_func(PARROT_INTERP, ARGIN(const PMC *ctx), INTVAL idx)
 {
     ASSERT_ARGS(Parrot_pcc_get_pmc_constant_func)
+    PMC ** const constants = CONTEXT_STRUCT(ctx)->pmc_constants;
     PARROT_ASSERT(ctx->vtable->base_type == enum_class_CallContext);
-    return CONTEXT_STRUCT(ctx)->pmc_constants[idx];
+
+    if (!constants[idx]) {
+        /* lazily loaded constant; thaw it from the owning table */
+        PackFile_ConstTable *ct = interp->code ? interp->code->const_table : NULL;
+
+        if (!ct || ct->pmc.constants != constants) {
+            PMC * const sub_pmc = Parrot_pcc_get_sub(interp, ctx);
+            Parrot_Sub_attributes *sub;
+
+            if (PMC_IS_NULL(sub_pmc))
+                Parrot_ex_throw_from_c_args(interp, NULL, EXCEPTION_MALFORMED_PACKFILE,
+                    "PMC constant %d has no constant table", (int)idx);
+
+            PMC_get_sub(interp, sub_pmc, sub);
+            ct = sub->seg->const_table;
+        }
+
+        return PackFile_ConstTable_thaw_pmc(interp, ct, idx);
+    }
+
+    return constants[idx];
 }
 
 /*
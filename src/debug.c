@@ -2710,7 +2710,8 @@ PDB_disassemble_op(PARROT_INTERP, ARGOUT(char *dest), size_t space,
             break;
           case PARROT_ARG_KC:
             {
-                PMC * k = interp->code->const_table->pmc.constants[op[j]];
+                PMC * k = PackFile_ConstTable_get_pmc(interp,
+                                interp->code->const_table, op[j]);
                 dest[size - 1] = '[';
                 while (k) {
                     switch (PObj_get_FLAGS(k)) {
@@ -2802,7 +2803,8 @@ PDB_disassemble_op(PARROT_INTERP, ARGOUT(char *dest), size_t space,
 
     if (specialop > 0) {
         char buf[1000];
-        PMC * const sig = interp->code->const_table->pmc.constants[op[1]];
+        PMC * const sig = PackFile_ConstTable_get_pmc(interp,
+                                interp->code->const_table, op[1]);
         const int n_values = VTABLE_elements(interp, sig);
         /* The flag_names strings come from Call_bits_enum_t (with which it
            should probably be colocated); they name the bits from LSB to MSB.
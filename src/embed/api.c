@@ -200,6 +200,8 @@ Parrot_api_set_runcore(Parrot_PMC interp_pmc, ARGIN(const char * corename),
             Parrot_runcore_switch(interp, Parrot_str_new_constant(interp, "slow"));
         else if (STREQ(corename, "profiling"))
             Parrot_runcore_switch(interp, Parrot_str_new_constant(interp, "profiling"));
+        else if (STREQ(corename, "sampling"))
+            Parrot_runcore_switch(interp, Parrot_str_new_constant(interp, "sampling"));
         else if (STREQ(corename, "gcdebug"))
             Parrot_runcore_switch(interp, Parrot_str_new_constant(interp, "gcdebug"));
         else
@@ -608,6 +610,30 @@ Parrot_api_toggle_gc(Parrot_PMC interp_pmc, Parrot_Int on)
 
 /*
 
+=item C<Parrot_Int Parrot_api_gc_telemetry(Parrot_PMC interp_pmc, Parrot_PMC
+*telemetry)>
+
+Stores in C<telemetry> a Hash of the garbage collector's pause-time
+histograms per generation and phase, bytes promoted, survivor rate and
+allocation rate, laid out as described in F<src/gc/telemetry.c>. This function
+returns a true value if this call is successful and false value otherwise.
+
+=cut
+
+*/
+
+PARROT_API
+Parrot_Int
+Parrot_api_gc_telemetry(Parrot_PMC interp_pmc, ARGOUT(Parrot_PMC *telemetry))
+{
+    ASSERT_ARGS(Parrot_api_gc_telemetry)
+    EMBED_API_CALLIN(interp_pmc, interp)
+    *telemetry = Parrot_gc_telemetry_hash(interp);
+    EMBED_API_CALLOUT(interp_pmc, interp)
+}
+
+/*
+
 =item C<Parrot_Int Parrot_api_reset_call_signature(Parrot_PMC interp_pmc,
 Parrot_PMC ctx)>
 
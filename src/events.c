@@ -289,10 +289,19 @@ Parrot_cx_find_handler_local(PARROT_INTERP, ARGIN(PMC *task))
     STRING * const  handler_str       = CONST_STRING(interp, "handler");
     STRING * const  handlers_left_str = CONST_STRING(interp, "handlers_left");
     STRING * const  exception_str     = CONST_STRING(interp, "Exception");
+    STRING * const  can_handle_str    = CONST_STRING(interp, "can_handle");
     const Parrot_Int is_exception = (task->vtable->base_type == enum_class_Exception)
                                     || VTABLE_does(interp, task, exception_str);
     PMC            *handlers;
     INTVAL          pos, elements;
+    INTVAL          type = 0, severity = 0;
+
+    /* plain exceptions are matched against plain handlers in C, without
+     * calling can_handle; this is what keeps control exceptions cheap */
+    if (task->vtable->base_type == enum_class_Exception) {
+        GETATTR_Exception_type(interp, task, type);
+        GETATTR_Exception_severity(interp, task, severity);
+    }
 
     if (already_doing) {
         Parrot_io_eprintf(interp,
@@ -353,8 +362,13 @@ Parrot_cx_find_handler_local(PARROT_INTERP, ARGIN(PMC *task))
 
             if (!PMC_IS_NULL(handler)) {
                 INTVAL valid_handler = 0;
-                Parrot_pcc_invoke_method_from_c_args(interp, handler, CONST_STRING(interp, "can_handle"),
-                        "P->I", task, &valid_handler);
+
+                if (task->vtable->base_type == enum_class_Exception
+                &&  handler->vtable->base_type == enum_class_ExceptionHandler)
+                    valid_handler = Parrot_ex_handler_accepts(interp, handler, type, severity);
+                else
+                    Parrot_pcc_invoke_method_from_c_args(interp, handler, can_handle_str,
+                            "P->I", task, &valid_handler);
 
                 if (valid_handler) {
                     if (is_exception) {
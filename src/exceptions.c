@@ -21,6 +21,7 @@ Define the core subsystem for exceptions.
 #include "exceptions.str"
 #include "pmc/pmc_continuation.h"
 #include "pmc/pmc_exception.h"
+#include "pmc/pmc_exceptionhandler.h"
 #include "parrot/exceptions.h"
 #include "parrot/events.h"
 
@@ -92,6 +93,36 @@ Parrot_ex_build_exception(PARROT_INTERP, INTVAL severity,
 
 /*
 
+=item C<PMC * Parrot_ex_build_control_exception(PARROT_INTERP, INTVAL type, PMC
+*payload)>
+
+Returns a new control exception of C<type> carrying C<payload>, for
+C<throw_control>.  Unlike C<throw>, it gets no resume continuation, as
+control exceptions are not resumed.
+
+=cut
+
+*/
+
+PARROT_EXPORT
+PARROT_CANNOT_RETURN_NULL
+PMC *
+Parrot_ex_build_control_exception(PARROT_INTERP, INTVAL type, ARGIN(PMC *payload))
+{
+    ASSERT_ARGS(Parrot_ex_build_control_exception)
+    const int   exception_type_id = Parrot_hll_get_ctx_HLL_type(interp, enum_class_Exception);
+    PMC * const exception         = Parrot_pmc_new_init_int(interp, exception_type_id, type);
+
+    if (exception_type_id == enum_class_Exception)
+        SETATTR_Exception_payload(interp, exception, payload);
+    else
+        VTABLE_set_attr_str(interp, exception, CONST_STRING(interp, "payload"), payload);
+
+    return exception;
+}
+
+/*
+
 =item C<void die_from_exception(PARROT_INTERP, PMC *exception)>
 
 Print a stack trace for C<exception>, a message if there is one, and then exit.
@@ -202,7 +233,11 @@ Parrot_ex_throw_from_op(PARROT_INTERP, ARGIN(PMC *exception), ARGIN_NULLOK(void
     PMC        *handler;
 
     /* Note the thrower. */
-    VTABLE_set_attr_str(interp, exception, CONST_STRING(interp, "thrower"), CURRENT_CONTEXT(interp));
+    if (exception->vtable->base_type == enum_class_Exception)
+        SETATTR_Exception_thrower(interp, exception, CURRENT_CONTEXT(interp));
+    else
+        VTABLE_set_attr_str(interp, exception, CONST_STRING(interp, "thrower"),
+                CURRENT_CONTEXT(interp));
 
     /* Locate the handler, if there is one. */
     handler = Parrot_cx_find_handler_local(interp, exception);
@@ -505,6 +540,70 @@ Parrot_ex_mark_unhandled(PARROT_INTERP, ARGIN(PMC *exception))
 
 /*
 
+=item C<INTVAL Parrot_ex_handler_accepts(PARROT_INTERP, PMC *handler, INTVAL
+type, INTVAL severity)>
+
+Report whether the ExceptionHandler C<handler> takes exceptions of C<type> and
+C<severity>.  This is the test behind the handler's C<can_handle> method; the
+handler search calls it directly for plain handlers and exceptions, so that
+throwing a control exception doesn't cost a method call per handler.
+
+=cut
+
+*/
+
+PARROT_EXPORT
+PARROT_WARN_UNUSED_RESULT
+INTVAL
+Parrot_ex_handler_accepts(PARROT_INTERP, ARGIN(PMC *handler), INTVAL type, INTVAL severity)
+{
+    ASSERT_ARGS(Parrot_ex_handler_accepts)
+    const Parrot_ExceptionHandler_attributes * const attrs = PARROT_EXCEPTIONHANDLER(handler);
+    PMC * const handled_types = attrs->handled_types;
+
+    if (severity < attrs->min_severity)
+        return 0;
+    if (attrs->max_severity > 0 && severity > attrs->max_severity)
+        return 0;
+
+    if (!PMC_IS_NULL(handled_types)) {
+        if (handled_types->vtable->base_type == enum_class_Key) {
+            PMC *key;
+            for (key = handled_types; key; key = Parrot_key_next(interp, key)) {
+                const INTVAL handled_type = Parrot_key_integer(interp, key);
+                if (handled_type == type || handled_type == (type | EXCEPTION_TYPE_ALL_MASK))
+                    return 1;
+            }
+        }
+        else {
+            const INTVAL elems = VTABLE_elements(interp, handled_types);
+            INTVAL i;
+            for (i = 0; i < elems; ++i) {
+                const INTVAL handled_type =
+                    VTABLE_get_integer_keyed_int(interp, handled_types, i);
+                if (handled_type == type || handled_type == (type | EXCEPTION_TYPE_ALL_MASK))
+                    return 1;
+            }
+        }
+        return 0;
+    }
+
+    if (!PMC_IS_NULL(attrs->handled_types_except)) {
+        PMC * const except = attrs->handled_types_except;
+        const INTVAL elems = VTABLE_elements(interp, except);
+        INTVAL i;
+        for (i = 0; i < elems; ++i) {
+            const INTVAL handled_type = VTABLE_get_integer_keyed_int(interp, except, i);
+            if (handled_type == type || handled_type == (type | EXCEPTION_TYPE_ALL_MASK))
+                return 0;
+        }
+    }
+
+    return 1;
+}
+
+/*
+
 =item C<PMC * Parrot_ex_get_current_handler(PARROT_INTERP, PMC *expmc)>
 
 Get the current exception handler from expmc.
@@ -788,6 +788,7 @@ gc_gms_mark_and_sweep(PARROT_INTERP, UINTVAL flags)
     will be collected. Remember K in C<self->gen_to_collect>.
     */
     self->gen_to_collect = gen = gc_gms_select_generation_to_collect(interp);
+    Parrot_gc_telemetry_begin(interp, gen);
 
     /*
     3. Move all objects from collections younger K from dirty_list
@@ -796,6 +797,7 @@ gc_gms_mark_and_sweep(PARROT_INTERP, UINTVAL flags)
     "dirty_list".
     */
     gc_gms_cleanup_dirty_list(interp, self, self->dirty_list);
+    Parrot_gc_telemetry_phase(interp, PARROT_GC_PHASE_DIRTY);
     gc_gms_print_stats(interp, "After cleanup");
 
     /*
@@ -808,6 +810,7 @@ gc_gms_mark_and_sweep(PARROT_INTERP, UINTVAL flags)
     if (interp->pdb && interp->pdb->debugger)
         Parrot_gc_trace_root(interp->pdb->debugger, NULL, GC_TRACE_FULL);
 
+    Parrot_gc_telemetry_phase(interp, PARROT_GC_PHASE_ROOTS);
     gc_gms_print_stats(interp, "After trace_roots");
     gc_gms_check_sanity(interp);
 
@@ -816,6 +819,7 @@ gc_gms_mark_and_sweep(PARROT_INTERP, UINTVAL flags)
     children into "work_list".
     */
     gc_gms_process_dirty_list(interp, self, self->dirty_list);
+    Parrot_gc_telemetry_phase(interp, PARROT_GC_PHASE_DIRTY);
     gc_gms_print_stats(interp, "After dirty_list");
     gc_gms_check_sanity(interp);
 
@@ -823,6 +827,7 @@ gc_gms_mark_and_sweep(PARROT_INTERP, UINTVAL flags)
     6. Iterate over "work_list" calling VTABLE_mark on it.
     */
     gc_gms_process_work_list(interp, self, self->work_list);
+    Parrot_gc_telemetry_phase(interp, PARROT_GC_PHASE_MARK);
     gc_gms_print_stats(interp, "After work_list");
     gc_gms_check_sanity(interp);
 
@@ -833,6 +838,7 @@ gc_gms_mark_and_sweep(PARROT_INTERP, UINTVAL flags)
         - Paint them white.
     */
     gc_gms_sweep_pools(interp, self);
+    Parrot_gc_telemetry_phase(interp, PARROT_GC_PHASE_SWEEP);
     gc_gms_check_sanity(interp);
 
     /* Update some stats */
@@ -845,8 +851,12 @@ gc_gms_mark_and_sweep(PARROT_INTERP, UINTVAL flags)
     self->num_early_gc_PMCs                      = 0;
 
     /* Don't compact after nursery collection */
-    if (gen)
+    if (gen) {
         gc_gms_compact_memory_pool(interp);
+        Parrot_gc_telemetry_phase(interp, PARROT_GC_PHASE_COMPACT);
+    }
+
+    Parrot_gc_telemetry_end(interp);
 
     gc_gms_check_sanity(interp);
 
@@ -1049,6 +1059,7 @@ gc_gms_sweep_pools(PARROT_INTERP, ARGMOD(MarkSweep_GC *self))
 {
     ASSERT_ARGS(gc_gms_sweep_pools)
 
+    Parrot_GC_Collection * const telemetry = &interp->gc_sys->telemetry.current;
     INTVAL i;
 
     for (i = self->gen_to_collect; i >= 0; i--) {
@@ -1064,9 +1075,11 @@ gc_gms_sweep_pools(PARROT_INTERP, ARGMOD(MarkSweep_GC *self))
             /* Paint live objects white */
             if (PObj_live_TEST(pmc) || PObj_constant_TEST(pmc)) {
                 PObj_live_CLEAR(pmc);
+                telemetry->objects_survived++;
 
                 if (move_to_old) {
                     SET_GEN_FLAGS(pmc, i + 1);
+                    telemetry->bytes_promoted += sizeof (PMC) + pmc->vtable->attr_size;
 
                     Parrot_pa_remove(interp, self->objects[i], item->ptr);
                     /* If this was freshly allocated object in C stack - move it to dirty list */
@@ -1083,6 +1096,7 @@ gc_gms_sweep_pools(PARROT_INTERP, ARGMOD(MarkSweep_GC *self))
             }
             else {
                 Parrot_pa_remove(interp, self->objects[i], item->ptr);
+                telemetry->objects_freed++;
 
                 interp->gc_sys->stats.memory_used -= sizeof (PMC);
 
@@ -1109,7 +1123,9 @@ gc_gms_sweep_pools(PARROT_INTERP, ARGMOD(MarkSweep_GC *self))
             /* Paint live objects white */
             if (PObj_live_TEST(str) || PObj_constant_TEST(str)) {
                 PObj_live_CLEAR(str);
+                telemetry->objects_survived++;
                 if (move_to_old) {
+                    telemetry->bytes_promoted += sizeof (STRING) + Buffer_buflen(str);
                     Parrot_pa_remove(interp, self->strings[i], item->ptr);
                     item->ptr = Parrot_pa_insert(self->strings[i + 1], item);
                     SET_GEN_FLAGS(str, i + 1);
@@ -1118,6 +1134,7 @@ gc_gms_sweep_pools(PARROT_INTERP, ARGMOD(MarkSweep_GC *self))
 
             else {
                 Parrot_pa_remove(interp, self->strings[i], item->ptr);
+                telemetry->objects_freed++;
                 if (Buffer_bufstart(str) && !PObj_external_TEST(str))
                     Parrot_gc_str_free_buffer_storage(
                         interp, &self->string_gc, (Parrot_Buffer*)str);
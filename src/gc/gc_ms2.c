@@ -1026,6 +1026,8 @@ gc_ms2_mark_live_objects(PARROT_INTERP, ARGIN(MarkSweep_GC *self),
                 (Parrot_gc_trace_type)0);
     }
 
+    Parrot_gc_telemetry_phase(interp, PARROT_GC_PHASE_ROOTS);
+
     /* new_objects are "gray" until fully marked */
     /* Additional gray objects will append to new_objects list */
     /* So, iterate over them in one go */
@@ -1039,6 +1041,8 @@ gc_ms2_mark_live_objects(PARROT_INTERP, ARGIN(MarkSweep_GC *self),
 
         if (PMC_metadata(pmc))
             Parrot_gc_mark_PMC_alive(interp, PMC_metadata(pmc)););
+
+    Parrot_gc_telemetry_phase(interp, PARROT_GC_PHASE_MARK);
 }
 
 static void
@@ -1058,6 +1062,7 @@ gc_ms2_mark_and_sweep(PARROT_INTERP, UINTVAL flags)
         return;
 
     ++self->gc_mark_block_level;
+    Parrot_gc_telemetry_begin(interp, 0);
     gc_ms2_mark_live_objects(interp, self, flags);
 
     /* At this point of time new_objects contains only live PMCs */
@@ -1067,6 +1072,7 @@ gc_ms2_mark_and_sweep(PARROT_INTERP, UINTVAL flags)
     gc_ms2_sweep_pmc_pool(interp, self->pmc_allocator, self->new_objects);
     gc_ms2_sweep_pmc_pool(interp, self->pmc_allocator, self->objects);
     gc_ms2_sweep_string_pool(interp, self->string_allocator, self->strings);
+    Parrot_gc_telemetry_phase(interp, PARROT_GC_PHASE_SWEEP);
 
     /* destroy the rest */
     if (flags & GC_finish_FLAG) {
@@ -1083,6 +1089,7 @@ gc_ms2_mark_and_sweep(PARROT_INTERP, UINTVAL flags)
 
     /* We swept all dead objects */
     gc_ms2_compact_memory_pool(interp);
+    Parrot_gc_telemetry_phase(interp, PARROT_GC_PHASE_COMPACT);
 
     stats = &interp->gc_sys->stats;
     stats->mem_used_last_collect = stats->memory_used;
@@ -1098,6 +1105,8 @@ gc_ms2_mark_and_sweep(PARROT_INTERP, UINTVAL flags)
 
     self->gc_threshold = stats->mem_used_last_collect + threshold;
 
+    Parrot_gc_telemetry_end(interp);
+
     self->gc_mark_block_level--;
     self->num_early_gc_PMCs = 0;
 }
@@ -1142,16 +1151,19 @@ gc_ms2_sweep_pmc_pool(PARROT_INTERP,
         ARGIN(Parrot_Pointer_Array *list))
 {
     ASSERT_ARGS(gc_ms2_sweep_pmc_pool)
+    Parrot_GC_Collection * const telemetry = &interp->gc_sys->telemetry.current;
 
     POINTER_ARRAY_ITER(list,
         PMC *pmc = &(((pmc_alloc_struct *)ptr)->pmc);
 
         /* Paint live objects white */
-        if (PObj_live_TEST(pmc))
+        if (PObj_live_TEST(pmc)) {
             PObj_live_CLEAR(pmc);
-
+            telemetry->objects_survived++;
+        }
         else if (!PObj_constant_TEST(pmc)) {
             Parrot_pa_remove(interp, list, PMC2PAC(pmc)->ptr);
+            telemetry->objects_freed++;
 
             /* this is manual inlining of Parrot_pmc_destroy() */
             if (PObj_custom_destroy_TEST(pmc))
@@ -1217,7 +1229,8 @@ gc_ms2_sweep_string_pool(PARROT_INTERP,
 {
     ASSERT_ARGS(gc_ms2_sweep_string_pool)
 
-    MarkSweep_GC * const self = (MarkSweep_GC *)interp->gc_sys->gc_private;
+    MarkSweep_GC         * const self      = (MarkSweep_GC *)interp->gc_sys->gc_private;
+    Parrot_GC_Collection * const telemetry = &interp->gc_sys->telemetry.current;
 
     POINTER_ARRAY_ITER(list,
         STRING * const obj = &(((string_alloc_struct*)ptr)->str);
@@ -1225,11 +1238,13 @@ gc_ms2_sweep_string_pool(PARROT_INTERP,
         PARROT_ASSERT(!PObj_on_free_list_TEST(obj));
 
         /* Paint live objects white */
-        if (PObj_live_TEST(obj))
+        if (PObj_live_TEST(obj)) {
             PObj_live_CLEAR(obj);
-
+            telemetry->objects_survived++;
+        }
         else if (!PObj_constant_TEST(obj)) {
             Parrot_pa_remove(interp, list, STR2PAC(obj)->ptr);
+            telemetry->objects_freed++;
             if (Buffer_bufstart(obj) && !PObj_external_TEST(obj))
                 Parrot_gc_str_free_buffer_storage(interp, &self->string_gc, (Parrot_Buffer*)obj);
 
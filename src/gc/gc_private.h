@@ -203,6 +203,9 @@ typedef struct GC_Subsystem {
     /* Statistic for GC */
     struct GC_Statistics stats;
 
+    /* Timings and survival of collections; see src/gc/telemetry.c */
+    Parrot_GC_Telemetry telemetry;
+
     /* Holds system-specific data structures */
     void * gc_private;
 } GC_Subsystem;
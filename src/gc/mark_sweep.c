@@ -234,6 +234,7 @@ mark_interp(PARROT_INTERP)
 
     /* mark caches and freelists */
     mark_object_cache(interp);
+    Parrot_ns_mark_global_cache(interp);
 
     /* Now mark the class hash */
     Parrot_gc_mark_PMC_alive(interp, interp->class_hash);
@@ -287,6 +288,10 @@ mark_code_segment(PARROT_INTERP)
             Parrot_gc_mark_PMC_alive(interp, ct->pmc.constants[i]);
         }
 
+        if (ct->pmc.olists)
+            for (i = 0; i < ct->pmc.const_count; i++)
+                Parrot_gc_mark_PMC_alive(interp, ct->pmc.olists[i]);
+
         for (i = 0; i < ct->str.const_count; i++) {
             Parrot_gc_mark_STRING_alive(interp, ct->str.constants[i]);
         }
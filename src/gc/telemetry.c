@@ -0,0 +1,459 @@
+/*
+Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+src/gc/telemetry.c - Timings and survival statistics of collections
+
+=head1 DESCRIPTION
+
+The collectors report each collection here: they call
+C<Parrot_gc_telemetry_begin> when it starts, C<Parrot_gc_telemetry_phase> as
+each phase finishes and C<Parrot_gc_telemetry_end> when it is over, and count
+the objects they free, keep and promote in C<current> as they sweep.
+
+From that this keeps, for every generation, a histogram of pause times and
+one for each phase, along with totals of bytes allocated and promoted and
+objects kept and freed.  The allocation rate is the memory allocated between
+two collections over the time between them.
+
+The figures are read with C<Parrot_gc_telemetry>, or as a Hash with
+C<Parrot_gc_telemetry_hash>, which is what PIR gets from the C<gc_telemetry>
+method of the interpreter and embedders from C<Parrot_api_gc_telemetry>.  A
+callback set with C<Parrot_gc_set_telemetry_callback> is told about every
+collection as it finishes.
+
+The GMS and MS2 collectors report their collections; the others don't, and
+their telemetry stays empty.
+
+=head2 Functions
+
+=over 4
+
+=cut
+
+*/
+
+#include "parrot/parrot.h"
+#include "gc_private.h"
+
+/* HEADERIZER HFILE: include/parrot/gc_api.h */
+
+/* HEADERIZER BEGIN: static */
+/* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
+
+PARROT_WARN_UNUSED_RESULT
+PARROT_CANNOT_RETURN_NULL
+static PMC * collection_hash(PARROT_INTERP,
+    ARGIN(const Parrot_GC_Collection *c))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+static void histogram_add(ARGMOD(Parrot_GC_Histogram *h), UHUGEINTVAL ns)
+        __attribute__nonnull__(1)
+        FUNC_MODIFIES(*h);
+
+PARROT_WARN_UNUSED_RESULT
+PARROT_CANNOT_RETURN_NULL
+static PMC * histogram_hash(PARROT_INTERP,
+    ARGIN(const Parrot_GC_Histogram *h))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+static void set_int(PARROT_INTERP,
+    ARGMOD(PMC *hash),
+    ARGIN(const char *key),
+    UHUGEINTVAL value)
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        FUNC_MODIFIES(*hash);
+
+#define ASSERT_ARGS_collection_hash __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(c))
+#define ASSERT_ARGS_histogram_add __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(h))
+#define ASSERT_ARGS_histogram_hash __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(h))
+#define ASSERT_ARGS_set_int __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(hash) \
+    , PARROT_ASSERT_ARG(key))
+/* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
+/* HEADERIZER END: static */
+
+static const char * const phase_names[PARROT_GC_PHASE_MAX] = {
+    "roots", "dirty", "mark", "sweep", "compact"
+};
+
+/*
+
+=item C<void Parrot_gc_telemetry_begin(PARROT_INTERP, INTVAL generation)>
+
+Start timing a collection of the generations up to C<generation>.
+
+=cut
+
+*/
+
+void
+Parrot_gc_telemetry_begin(PARROT_INTERP, INTVAL generation)
+{
+    ASSERT_ARGS(Parrot_gc_telemetry_begin)
+    Parrot_GC_Telemetry * const t    = &interp->gc_sys->telemetry;
+    const size_t                used = interp->gc_sys->stats.memory_used;
+    const UHUGEINTVAL           now  = Parrot_hires_get_time();
+
+    memset(&t->current, 0, sizeof (Parrot_GC_Collection));
+    t->current.number     = t->collections;
+    t->current.generation = generation;
+
+    if (used > t->used_after_last)
+        t->current.bytes_allocated = used - t->used_after_last;
+
+    if (t->last_end_time && now > t->last_end_time) {
+        const UHUGEINTVAL mutator = now - t->last_end_time;
+        t->current.allocation_rate =
+            (FLOATVAL)t->current.bytes_allocated * 1e9 / (FLOATVAL)mutator;
+        t->mutator_time += mutator;
+    }
+
+    t->start_time = t->phase_time = now;
+}
+
+/*
+
+=item C<void Parrot_gc_telemetry_phase(PARROT_INTERP, Parrot_gc_phase_enum
+phase)>
+
+Charge the time since the last phase ended to C<phase>.  A phase that runs in
+several steps is charged for each of them.
+
+=cut
+
+*/
+
+void
+Parrot_gc_telemetry_phase(PARROT_INTERP, Parrot_gc_phase_enum phase)
+{
+    ASSERT_ARGS(Parrot_gc_telemetry_phase)
+    Parrot_GC_Telemetry * const t   = &interp->gc_sys->telemetry;
+    const UHUGEINTVAL           now = Parrot_hires_get_time();
+
+    t->current.phase_ns[phase] += now - t->phase_time;
+    t->current.phases_run      |= 1 << phase;
+    t->phase_time               = now;
+}
+
+/*
+
+=item C<void Parrot_gc_telemetry_end(PARROT_INTERP)>
+
+Finish timing the collection, add it to the histograms and totals and call
+the callback, if there is one.  Only the phases the collection went through
+are added to the phase histograms.
+
+=cut
+
+*/
+
+void
+Parrot_gc_telemetry_end(PARROT_INTERP)
+{
+    ASSERT_ARGS(Parrot_gc_telemetry_end)
+    Parrot_GC_Telemetry  * const t   = &interp->gc_sys->telemetry;
+    Parrot_GC_Collection * const c   = &t->current;
+    const UHUGEINTVAL            now = Parrot_hires_get_time();
+    INTVAL gen = c->generation;
+    int    i;
+
+    if (gen < 0)
+        gen = 0;
+    else if (gen >= PARROT_GC_TELEMETRY_GENERATIONS)
+        gen = PARROT_GC_TELEMETRY_GENERATIONS - 1;
+
+    c->pause_ns = now - t->start_time;
+    histogram_add(&t->pauses[gen], c->pause_ns);
+    for (i = 0; i < PARROT_GC_PHASE_MAX; ++i)
+        if (c->phases_run & (1 << i))
+            histogram_add(&t->phases[gen][i], c->phase_ns[i]);
+
+    t->collections++;
+    t->generation_runs[gen]++;
+    t->bytes_allocated  += c->bytes_allocated;
+    t->bytes_promoted   += c->bytes_promoted;
+    t->objects_survived += c->objects_survived;
+    t->objects_freed    += c->objects_freed;
+
+    t->last            = *c;
+    t->used_after_last = interp->gc_sys->stats.memory_used;
+    t->last_end_time   = now;
+
+    if (t->callback)
+        (t->callback)(interp, &t->last, t->callback_data);
+}
+
+/*
+
+=item C<static void histogram_add(Parrot_GC_Histogram *h, UHUGEINTVAL ns)>
+
+Count a time of C<ns> nanoseconds in the histogram C<h>.
+
+=cut
+
+*/
+
+static void
+histogram_add(ARGMOD(Parrot_GC_Histogram *h), UHUGEINTVAL ns)
+{
+    ASSERT_ARGS(histogram_add)
+    UHUGEINTVAL us     = ns / 1000;
+    int         bucket = 0;
+
+    while (us && bucket < PARROT_GC_HISTOGRAM_BUCKETS - 1) {
+        us >>= 1;
+        ++bucket;
+    }
+
+    h->buckets[bucket]++;
+    h->count++;
+    h->total_ns += ns;
+    if (ns > h->max_ns)
+        h->max_ns = ns;
+}
+
+/*
+
+=item C<const Parrot_GC_Telemetry * Parrot_gc_telemetry(PARROT_INTERP)>
+
+Return the telemetry of the interpreter's collector.  It changes with every
+collection, so copy what must stay put.
+
+=cut
+
+*/
+
+PARROT_EXPORT
+PARROT_PURE_FUNCTION
+PARROT_CANNOT_RETURN_NULL
+const Parrot_GC_Telemetry *
+Parrot_gc_telemetry(PARROT_INTERP)
+{
+    ASSERT_ARGS(Parrot_gc_telemetry)
+    return &interp->gc_sys->telemetry;
+}
+
+/*
+
+=item C<void Parrot_gc_set_telemetry_callback(PARROT_INTERP,
+Parrot_gc_telemetry_fn callback, void *data)>
+
+Call C<callback> with C<data> at the end of every collection; a NULL
+C<callback> turns that off.  The callback runs inside the collector and so must
+not allocate GC-managed objects or call back into Parrot.
+
+=cut
+
+*/
+
+PARROT_EXPORT
+void
+Parrot_gc_set_telemetry_callback(PARROT_INTERP,
+        ARGIN_NULLOK(Parrot_gc_telemetry_fn callback), ARGIN_NULLOK(void *data))
+{
+    ASSERT_ARGS(Parrot_gc_set_telemetry_callback)
+    interp->gc_sys->telemetry.callback      = callback;
+    interp->gc_sys->telemetry.callback_data = data;
+}
+
+/*
+
+=item C<PMC * Parrot_gc_telemetry_hash(PARROT_INTERP)>
+
+Return the telemetry as a Hash:
+
+    collections, bytes_allocated, bytes_promoted,
+    objects_survived, objects_freed     totals over all collections
+    survivor_rate                       objects kept / objects swept
+    allocation_rate                     bytes allocated per second
+    generations                         an array with a Hash per generation:
+        collections                     collections of it
+        pause                           histogram of pause times
+        phases                          Hash of a histogram per phase:
+                                        roots, dirty, mark, sweep, compact
+    last                                Hash describing the last collection
+
+A histogram is a Hash of C<count>, C<total_ns>, C<max_ns> and C<buckets>, a
+FixedIntegerArray laid out as described in F<include/parrot/gc_api.h>.
+
+=cut
+
+*/
+
+PARROT_EXPORT
+PARROT_WARN_UNUSED_RESULT
+PARROT_CANNOT_RETURN_NULL
+PMC *
+Parrot_gc_telemetry_hash(PARROT_INTERP)
+{
+    ASSERT_ARGS(Parrot_gc_telemetry_hash)
+    const Parrot_GC_Telemetry * const t     = &interp->gc_sys->telemetry;
+    const UHUGEINTVAL                 swept = t->objects_survived + t->objects_freed;
+    PMC *hash, *gens;
+    int  i, j;
+
+    /* Keep the figures still while they are copied */
+    Parrot_block_GC_mark(interp);
+    hash = Parrot_pmc_new(interp, enum_class_Hash);
+    gens = Parrot_pmc_new(interp, enum_class_ResizablePMCArray);
+
+    set_int(interp, hash, "collections",      t->collections);
+    set_int(interp, hash, "bytes_allocated",  t->bytes_allocated);
+    set_int(interp, hash, "bytes_promoted",   t->bytes_promoted);
+    set_int(interp, hash, "objects_survived", t->objects_survived);
+    set_int(interp, hash, "objects_freed",    t->objects_freed);
+    VTABLE_set_number_keyed_str(interp, hash,
+        Parrot_str_new_constant(interp, "survivor_rate"),
+        swept ? (FLOATVAL)t->objects_survived / (FLOATVAL)swept : 0.0);
+    VTABLE_set_number_keyed_str(interp, hash,
+        Parrot_str_new_constant(interp, "allocation_rate"),
+        t->mutator_time ? (FLOATVAL)t->bytes_allocated * 1e9 / (FLOATVAL)t->mutator_time : 0.0);
+
+    for (i = 0; i < PARROT_GC_TELEMETRY_GENERATIONS; ++i) {
+        PMC * const gen    = Parrot_pmc_new(interp, enum_class_Hash);
+        PMC * const phases = Parrot_pmc_new(interp, enum_class_Hash);
+
+        set_int(interp, gen, "collections", t->generation_runs[i]);
+        VTABLE_set_pmc_keyed_str(interp, gen, Parrot_str_new_constant(interp, "pause"),
+            histogram_hash(interp, &t->pauses[i]));
+        for (j = 0; j < PARROT_GC_PHASE_MAX; ++j)
+            VTABLE_set_pmc_keyed_str(interp, phases,
+                Parrot_str_new_constant(interp, phase_names[j]),
+                histogram_hash(interp, &t->phases[i][j]));
+        VTABLE_set_pmc_keyed_str(interp, gen, Parrot_str_new_constant(interp, "phases"), phases);
+        VTABLE_push_pmc(interp, gens, gen);
+    }
+    VTABLE_set_pmc_keyed_str(interp, hash, Parrot_str_new_constant(interp, "generations"), gens);
+
+    if (t->collections)
+        VTABLE_set_pmc_keyed_str(interp, hash, Parrot_str_new_constant(interp, "last"),
+            collection_hash(interp, &t->last));
+
+    Parrot_unblock_GC_mark(interp);
+
+    return hash;
+}
+
+/*
+
+=item C<static PMC * histogram_hash(PARROT_INTERP, const Parrot_GC_Histogram
+*h)>
+
+Return the histogram C<h> as a Hash.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+PARROT_CANNOT_RETURN_NULL
+static PMC *
+histogram_hash(PARROT_INTERP, ARGIN(const Parrot_GC_Histogram *h))
+{
+    ASSERT_ARGS(histogram_hash)
+    PMC * const hash    = Parrot_pmc_new(interp, enum_class_Hash);
+    PMC * const buckets = Parrot_pmc_new_init_int(interp, enum_class_FixedIntegerArray,
+                                PARROT_GC_HISTOGRAM_BUCKETS);
+    int i;
+
+    for (i = 0; i < PARROT_GC_HISTOGRAM_BUCKETS; ++i)
+        VTABLE_set_integer_keyed_int(interp, buckets, i, h->buckets[i]);
+
+    set_int(interp, hash, "count",    h->count);
+    set_int(interp, hash, "total_ns", h->total_ns);
+    set_int(interp, hash, "max_ns",   h->max_ns);
+    VTABLE_set_pmc_keyed_str(interp, hash, Parrot_str_new_constant(interp, "buckets"), buckets);
+
+    return hash;
+}
+
+/*
+
+=item C<static PMC * collection_hash(PARROT_INTERP, const Parrot_GC_Collection
+*c)>
+
+Return the description of a collection as a Hash with the fields of
+C<Parrot_GC_Collection>; C<phases> holds the time of each phase that ran in
+nanoseconds.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+PARROT_CANNOT_RETURN_NULL
+static PMC *
+collection_hash(PARROT_INTERP, ARGIN(const Parrot_GC_Collection *c))
+{
+    ASSERT_ARGS(collection_hash)
+    PMC * const hash   = Parrot_pmc_new(interp, enum_class_Hash);
+    PMC * const phases = Parrot_pmc_new(interp, enum_class_Hash);
+    int i;
+
+    set_int(interp, hash, "number",           c->number);
+    set_int(interp, hash, "generation",       c->generation);
+    set_int(interp, hash, "pause_ns",         c->pause_ns);
+    set_int(interp, hash, "bytes_allocated",  c->bytes_allocated);
+    set_int(interp, hash, "bytes_promoted",   c->bytes_promoted);
+    set_int(interp, hash, "objects_survived", c->objects_survived);
+    set_int(interp, hash, "objects_freed",    c->objects_freed);
+    VTABLE_set_number_keyed_str(interp, hash,
+        Parrot_str_new_constant(interp, "allocation_rate"), c->allocation_rate);
+
+    for (i = 0; i < PARROT_GC_PHASE_MAX; ++i)
+        if (c->phases_run & (1 << i))
+            set_int(interp, phases, phase_names[i], c->phase_ns[i]);
+    VTABLE_set_pmc_keyed_str(interp, hash, Parrot_str_new_constant(interp, "phases"), phases);
+
+    return hash;
+}
+
+/*
+
+=item C<static void set_int(PARROT_INTERP, PMC *hash, const char *key,
+UHUGEINTVAL value)>
+
+Store C<value> in C<hash> under C<key>.
+
+=cut
+
+*/
+
+static void
+set_int(PARROT_INTERP, ARGMOD(PMC *hash), ARGIN(const char *key), UHUGEINTVAL value)
+{
+    ASSERT_ARGS(set_int)
+    VTABLE_set_integer_keyed_str(interp, hash,
+        Parrot_str_new_constant(interp, key), (INTVAL)value);
+}
+
+/*
+
+=back
+
+=head1 SEE ALSO
+
+F<include/parrot/gc_api.h>, F<src/gc/gc_gms.c>, F<src/gc/gc_ms2.c>
+
+=cut
+
+*/
+
+/*
+ * Local variables:
+ *   c-file-style: "parrot"
+ * End:
+ * vim: expandtab shiftwidth=4 cinoptions='\:2=2' :
+ */
@@ -457,6 +457,7 @@ Parrot_interp_really_destroy(PARROT_INTERP, int exit_code, SHIM(void *arg))
 
     /* cache structure */
     destroy_object_cache(interp);
+    Parrot_ns_destroy_global_cache(interp);
 
     if (interp->evc_func_table) {
         mem_gc_free(interp, interp->evc_func_table);
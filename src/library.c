@@ -35,6 +35,13 @@ static STRING * cnv_to_win32_filesep(PARROT_INTERP,
         __attribute__nonnull__(1)
         __attribute__nonnull__(2);
 
+PARROT_CANNOT_RETURN_NULL
+static PMC * get_path_cache(PARROT_INTERP,
+    enum_lib_paths which,
+    ARGIN(PMC *paths))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(3);
+
 PARROT_WARN_UNUSED_RESULT
 PARROT_CANNOT_RETURN_NULL
 static PMC* get_search_paths(PARROT_INTERP, enum_lib_paths which)
@@ -76,6 +83,9 @@ static STRING* try_load_path(PARROT_INTERP, ARGIN(STRING* path))
 #define ASSERT_ARGS_cnv_to_win32_filesep __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(path))
+#define ASSERT_ARGS_get_path_cache __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(paths))
 #define ASSERT_ARGS_get_search_paths __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp))
 #define ASSERT_ARGS_is_abs_path __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
@@ -144,6 +154,11 @@ parrot_init_library_paths(PARROT_INTERP)
     VTABLE_set_pmc_keyed_int(interp, iglobals,
             IGLOBALS_LIB_PATHS, lib_paths);
 
+    /* and the cache of files found in them, see get_path_cache */
+    VTABLE_set_pmc_keyed_int(interp, iglobals, IGLOBALS_LIB_PATH_CACHE,
+            Parrot_pmc_new_init_int(interp, enum_class_FixedPMCArray,
+                2 * PARROT_LIB_PATH_SIZE));
+
     /* each is an array of strings */
     /* define include paths */
     paths = Parrot_pmc_new(interp, enum_class_ResizableStringArray);
@@ -328,6 +343,57 @@ static const int win32_path_separator = '\\';
 
 /*
 
+=item C<static PMC * get_path_cache(PARROT_INTERP, enum_lib_paths which, PMC
+*paths)>
+
+Returns the Hash of the files already found in the search paths C<paths> of
+type C<which>. It maps each working directory to a Hash of the names asked
+for there and the names found for them, as relative search paths find
+different files from different directories. The cache is emptied when the search
+paths change: C<Parrot_lib_add_path> empties it, and search paths changed in
+any other way (say, from PIR through the interpreter's globals) are noticed
+by comparing them with a copy taken when the cache was filled.
+
+=cut
+
+*/
+
+PARROT_CANNOT_RETURN_NULL
+static PMC *
+get_path_cache(PARROT_INTERP, enum_lib_paths which, ARGIN(PMC *paths))
+{
+    ASSERT_ARGS(get_path_cache)
+    PMC * const cache = VTABLE_get_pmc_keyed_int(interp, interp->iglobals,
+            IGLOBALS_LIB_PATH_CACHE);
+    PMC * const found = VTABLE_get_pmc_keyed_int(interp, cache, which);
+    PMC * const seen  = VTABLE_get_pmc_keyed_int(interp, cache,
+            PARROT_LIB_PATH_SIZE + which);
+    const INTVAL n    = VTABLE_elements(interp, paths);
+
+    if (!PMC_IS_NULL(found) && VTABLE_elements(interp, seen) == n) {
+        INTVAL i;
+
+        for (i = 0; i < n; ++i)
+            if (!STRING_equal(interp, VTABLE_get_string_keyed_int(interp, paths, i),
+                        VTABLE_get_string_keyed_int(interp, seen, i)))
+                break;
+
+        if (i == n)
+            return found;
+    }
+
+    {
+        PMC * const new_found = Parrot_pmc_new(interp, enum_class_Hash);
+
+        VTABLE_set_pmc_keyed_int(interp, cache, which, new_found);
+        VTABLE_set_pmc_keyed_int(interp, cache, PARROT_LIB_PATH_SIZE + which,
+                VTABLE_clone(interp, paths));
+        return new_found;
+    }
+}
+
+/*
+
 =item C<static int is_abs_path(PARROT_INTERP, const STRING *file)>
 
 Determines whether a file name given by a fixed-8 or utf8 C<STRING> is an
@@ -604,7 +670,13 @@ Parrot_lib_add_path(PARROT_INTERP,
     PMC * const lib_paths = VTABLE_get_pmc_keyed_int(interp, iglobals,
         IGLOBALS_LIB_PATHS);
     PMC * const paths = VTABLE_get_pmc_keyed_int(interp, lib_paths, which);
+    PMC * const cache = VTABLE_get_pmc_keyed_int(interp, iglobals,
+        IGLOBALS_LIB_PATH_CACHE);
+
     VTABLE_unshift_string(interp, paths, path_str);
+
+    /* a file may be found elsewhere now */
+    VTABLE_set_pmc_keyed_int(interp, cache, which, PMCNULL);
 }
 
 /*
@@ -639,6 +711,11 @@ Locate the full path for C<file_name> and the given file type(s).
 The C<enum_runtime_ft type> is one or more of the types defined in
 F<include/parrot/library.h>.
 
+Files found are remembered, per working directory, until the search paths
+change (see C<get_path_cache>). A remembered file is checked again before it is
+returned, and searched for anew if it has gone. Files not found are looked for
+again every time, as they may have been created since.
+
 =cut
 
 */
@@ -653,21 +730,41 @@ Parrot_locate_runtime_file_str(PARROT_INTERP, ARGIN(STRING *file),
     ASSERT_ARGS(Parrot_locate_runtime_file_str)
     STRING *prefix;
     STRING *full_name;
-    PMC    *paths;
+    STRING *cwd;
+    PMC    *paths, *cache, *found;
     INTVAL  i, n;
+    enum_lib_paths which;
 
     /* if this is an absolute path return it as is */
     if (is_abs_path(interp, file))
         return file;
 
     if (type & PARROT_RUNTIME_FT_LANG)
-        paths = get_search_paths(interp, PARROT_LIB_PATH_LANG);
+        which = PARROT_LIB_PATH_LANG;
     else if (type & PARROT_RUNTIME_FT_DYNEXT)
-        paths = get_search_paths(interp, PARROT_LIB_PATH_DYNEXT);
+        which = PARROT_LIB_PATH_DYNEXT;
     else if (type & (PARROT_RUNTIME_FT_PBC | PARROT_RUNTIME_FT_SOURCE))
-        paths = get_search_paths(interp, PARROT_LIB_PATH_LIBRARY);
+        which = PARROT_LIB_PATH_LIBRARY;
     else
-        paths = get_search_paths(interp, PARROT_LIB_PATH_INCLUDE);
+        which = PARROT_LIB_PATH_INCLUDE;
+
+    paths = get_search_paths(interp, which);
+    cache = get_path_cache(interp, which, paths);
+    cwd   = Parrot_file_getcwd(interp);
+    found = VTABLE_get_pmc_keyed_str(interp, cache, cwd);
+
+    if (PMC_IS_NULL(found)) {
+        found = Parrot_pmc_new(interp, enum_class_Hash);
+        VTABLE_set_pmc_keyed_str(interp, cache, cwd, found);
+    }
+
+    full_name = VTABLE_get_string_keyed_str(interp, found, file);
+    if (!STRING_IS_EMPTY(full_name)) {
+        if (Parrot_file_stat_intval(interp, full_name, STAT_EXISTS))
+            return full_name;
+
+        VTABLE_delete_keyed_str(interp, found, file);
+    }
 
     prefix = Parrot_get_runtime_path(interp);
     n = VTABLE_elements(interp, paths);
@@ -683,19 +780,18 @@ Parrot_locate_runtime_file_str(PARROT_INTERP, ARGIN(STRING *file),
                 ? try_load_path(interp, full_name)
                 : try_bytecode_extensions(interp, full_name);
 
-        if (found_name)
-            return found_name;
-
-        if (STRING_length(prefix) && !is_abs_path(interp, path)) {
+        if (!found_name && STRING_length(prefix) && !is_abs_path(interp, path)) {
             full_name = path_concat(interp, prefix, full_name);
 
             found_name =
                 (type & PARROT_RUNTIME_FT_DYNEXT)
                     ? try_load_path(interp, full_name)
                     : try_bytecode_extensions(interp, full_name);
+        }
 
-            if (found_name)
-                return found_name;
+        if (found_name) {
+            VTABLE_set_string_keyed_str(interp, found, file, found_name);
+            return found_name;
         }
     }
 
@@ -704,6 +800,9 @@ Parrot_locate_runtime_file_str(PARROT_INTERP, ARGIN(STRING *file),
             ? try_load_path(interp, file)
             : try_bytecode_extensions(interp, file);
 
+    if (full_name)
+        VTABLE_set_string_keyed_str(interp, found, file, full_name);
+
     return full_name;
 }
 
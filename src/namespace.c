@@ -541,6 +541,7 @@ Parrot_ns_set_global(PARROT_INTERP, ARGIN(PMC *ns),
         ARGIN_NULLOK(STRING *globalname), ARGIN_NULLOK(PMC *val))
 {
     ASSERT_ARGS(Parrot_ns_set_global)
+    PARROT_NS_EPOCH_BUMP(interp);
     VTABLE_set_pmc_keyed_str(interp, ns, globalname, val);
 }
 
@@ -630,6 +631,7 @@ Parrot_ns_store_global(PARROT_INTERP, ARGIN_NULLOK(PMC *ns),
     if (PMC_IS_NULL(ns))
         return;
 
+    PARROT_NS_EPOCH_BUMP(interp);
     VTABLE_set_pmc_keyed_str(interp, ns, globalname, val);
 }
 
@@ -663,6 +665,140 @@ Parrot_ns_find_global_from_op(PARROT_INTERP, ARGIN(PMC *ns),
 }
 
 
+/*
+
+=item C<PMC * Parrot_ns_find_global_cached(PARROT_INTERP, PMC *base_ns, PMC
+*key, STRING *globalname, const opcode_t *site, void *next)>
+
+Like C<Parrot_ns_find_global_from_op>, but looks in the namespace denoted by
+the optional constant C<key> relative to C<base_ns>, and remembers the result
+in the interpreter's global lookup cache.  C<site> is the address of the
+calling op; it selects the cache slot.  A cached result is reused while the
+namespace epoch is unchanged and the same namespace, key and name are asked
+for again.  Missing globals are cached as PMCNULL as well.
+
+=cut
+
+*/
+
+PARROT_EXPORT
+PARROT_WARN_UNUSED_RESULT
+PARROT_CANNOT_RETURN_NULL
+PMC *
+Parrot_ns_find_global_cached(PARROT_INTERP, ARGIN_NULLOK(PMC *base_ns),
+        ARGIN_NULLOK(PMC *key), ARGIN_NULLOK(STRING *globalname),
+        ARGIN(const opcode_t *site), ARGIN_NULLOK(void *next))
+{
+    ASSERT_ARGS(Parrot_ns_find_global_cached)
+    Ns_global_cache_entry *entry;
+    PMC                   *ns;
+    PMC                   *res;
+
+    if (key && PMC_IS_NULL(base_ns))
+        return PMCNULL;
+
+    /* only lookups starting at a real NameSpace with a constant key bump
+     * the epoch reliably on every change, so leave anything else alone */
+    if (STRING_IS_NULL(globalname)
+    ||  PMC_IS_NULL(base_ns)
+    ||  base_ns->vtable->base_type != enum_class_NameSpace
+    ||  (key && !PObj_constant_TEST(key))) {
+        ns = key ? Parrot_ns_get_namespace_keyed(interp, base_ns, key) : base_ns;
+        if (key && PMC_IS_NULL(ns))
+            return PMCNULL;
+        return Parrot_ns_find_global_from_op(interp, ns, globalname, next);
+    }
+
+    if (!interp->ns_global_cache)
+        interp->ns_global_cache = mem_internal_allocate_n_zeroed_typed(
+                NS_GLOBAL_CACHE_SIZE, Ns_global_cache_entry);
+
+    entry = interp->ns_global_cache
+          + (((UINTVAL)site / sizeof (opcode_t)) & (NS_GLOBAL_CACHE_SIZE - 1));
+
+    if (entry->epoch == interp->ns_epoch
+    &&  entry->name  == globalname
+    &&  entry->ns    == base_ns
+    &&  entry->key   == key)
+        return entry->value;
+
+    ns  = key ? Parrot_ns_get_namespace_keyed(interp, base_ns, key) : base_ns;
+    res = PMC_IS_NULL(ns)
+        ? PMCNULL
+        : Parrot_ns_find_namespace_global(interp, ns, globalname);
+
+    if (PMC_IS_NULL(ns) || ns->vtable->base_type == enum_class_NameSpace) {
+        entry->epoch = interp->ns_epoch;
+        entry->ns    = base_ns;
+        entry->key   = key;
+        entry->name  = globalname;
+        entry->value = res;
+    }
+
+    return res;
+}
+
+/*
+
+=item C<void Parrot_ns_mark_global_cache(PARROT_INTERP)>
+
+Mark the PMCs and STRINGs held by valid global lookup cache entries; entries
+left over from an earlier namespace epoch are cleared instead.
+
+=cut
+
+*/
+
+void
+Parrot_ns_mark_global_cache(PARROT_INTERP)
+{
+    ASSERT_ARGS(Parrot_ns_mark_global_cache)
+    Ns_global_cache_entry * const cache = interp->ns_global_cache;
+    UINTVAL i;
+
+    if (!cache)
+        return;
+
+    for (i = 0; i < NS_GLOBAL_CACHE_SIZE; ++i) {
+        Ns_global_cache_entry * const entry = cache + i;
+
+        if (!entry->name)
+            continue;
+
+        if (entry->epoch != interp->ns_epoch) {
+            memset(entry, 0, sizeof (Ns_global_cache_entry));
+            continue;
+        }
+
+        Parrot_gc_mark_PMC_alive(interp, entry->ns);
+        Parrot_gc_mark_PMC_alive(interp, entry->key);
+        Parrot_gc_mark_STRING_alive(interp, entry->name);
+        Parrot_gc_mark_PMC_alive(interp, entry->value);
+    }
+}
+
+/*
+
+=item C<void Parrot_ns_destroy_global_cache(PARROT_INTERP)>
+
+Free the global lookup cache.
+
+=cut
+
+*/
+
+void
+Parrot_ns_destroy_global_cache(PARROT_INTERP)
+{
+    ASSERT_ARGS(Parrot_ns_destroy_global_cache)
+
+    if (interp->ns_global_cache) {
+        mem_internal_free(interp->ns_global_cache);
+        interp->ns_global_cache = NULL;
+    }
+}
+
+
 /*
 
 =item C<PMC * Parrot_ns_find_named_item(PARROT_INTERP, STRING *name, void
@@ -731,6 +867,7 @@ Parrot_ns_store_sub(PARROT_INTERP, ARGIN(PMC *sub_pmc))
     Parrot_pcc_set_HLL(interp, CURRENT_CONTEXT(interp), sub->HLL_id);
 
     ns = get_namespace_pmc(interp, sub_pmc);
+    PARROT_NS_EPOCH_BUMP(interp);
 
     /* attach a namespace to the sub for lookups */
     sub->namespace_stash = ns;
@@ -56,15 +56,18 @@ This file implements a native call frame (thunk) factory using libffi.
 #  endif
 #endif
 
-typedef struct ffi_thunk_t {
-    ffi_cif    cif;
-    ffi_type **arg_types;
+/* Calls with up to this many (6) arguments use scratch space on the C stack;
+ * calls with more allocate their argument frame */
+#define NCI_FRAME_STATIC_ARGS 6
 
-    ffi_cif    pcc_arg_cif;
-    ffi_type **pcc_arg_types;
+typedef struct ffi_thunk_t {
+    ffi_cif           cif;
+    ffi_type        **arg_types;
 
-    ffi_cif    pcc_ret_cif;
-    ffi_type **pcc_ret_types;
+    INTVAL            argc;      /* number of native arguments */
+    PARROT_DATA_TYPE  ret_type;  /* native return type */
+    PARROT_DATA_TYPE *nci_types; /* native argument types, with ref flags */
+    INTVAL            pcc_retc;  /* number of PCC return values */
 } ffi_thunk_t;
 
 typedef union parrot_var_t {
@@ -88,6 +91,14 @@ typedef union nci_var_t {
     INTVAL  I; FLOATVAL N; STRING *S; PMC *P;
 } nci_var_t;
 
+/* Per-argument scratch of one call. C<pcc> holds the PCC argument on the way
+ * in and is reused for a PCC return value on the way out. */
+typedef struct nci_slot_t {
+    nci_var_t     nci;  /* value of the nci argument */
+    parrot_var_t  pcc;  /* value of the pcc argument or return */
+    void         *ref;  /* pointer for a pass-by-ref argument */
+} nci_slot_t;
+
 
 /* HEADERIZER HFILE: include/parrot/nci.h */
 /* HEADERIZER BEGIN: static */
@@ -210,7 +221,8 @@ init_thunk_pmc(PARROT_INTERP, ARGMOD(ffi_thunk_t *thunk_data))
 
 =item C<static PMC * build_ffi_thunk(PARROT_INTERP, PMC *user_data, PMC *sig)>
 
-Build a C<ManagedStruct>-encapsulated C<ffi_thunk_t> from C<sig_str>.
+Build a C<ManagedStruct>-encapsulated C<ffi_thunk_t> from C<sig>, recording
+everything derivable from the signature for C<call_ffi_thunk>.
 Suitable for use as C<IGLOBALS_NCI_FB_CB>.
 
 =cut
@@ -228,74 +240,28 @@ build_ffi_thunk(PARROT_INTERP, SHIM(PMC *user_data), ARGIN(PMC *sig))
     STRING *pcc_ret_sig, *pcc_params_sig;
     Parrot_nci_sig_to_pcc(interp, sig, &pcc_params_sig, &pcc_ret_sig);
 
-    /* generate Parrot_pcc_fill_params_from_c_args dynamic call infrastructure */
-    {
-        INTVAL     argc  = Parrot_str_length(interp, pcc_params_sig) + 3;
-        ffi_type **arg_t =  thunk_data->pcc_arg_types =
-                            mem_gc_allocate_n_zeroed_typed(interp, argc, ffi_type *);
-        int        i;
-
-        arg_t[0] = &ffi_type_pointer; /* interp */
-        arg_t[1] = &ffi_type_pointer; /* call object */
-        arg_t[2] = &ffi_type_pointer; /* pcc signature */
-        for (i = 3; i < argc; i++)
-            arg_t[i] = &ffi_type_pointer; /* INSP pointer */
-
-        if (ffi_prep_cif(&thunk_data->pcc_arg_cif, FFI_DEFAULT_ABI, argc, &ffi_type_void, arg_t) !=
-            FFI_OK)
-            Parrot_ex_throw_from_c_args(interp, NULL, EXCEPTION_JIT_ERROR,
-                                        "invalid ffi signature");
-    }
+    thunk_data->pcc_retc = Parrot_str_length(interp, pcc_ret_sig);
 
     /* generate target function dynamic call infrastructure */
     {
         INTVAL     argc  = VTABLE_elements(interp, sig) - 1;
-        ffi_type  *ret_t = nci_to_ffi_type(interp,
-                                (PARROT_DATA_TYPE)VTABLE_get_integer_keyed_int(interp, sig, 0));
+        ffi_type  *ret_t;
         ffi_type **arg_t =  thunk_data->arg_types =
                             mem_gc_allocate_n_zeroed_typed(interp, argc, ffi_type *);
         int        i;
 
-        for (i = 0; i < argc; i++)
-            arg_t[i] = nci_to_ffi_type(interp,
-                            (PARROT_DATA_TYPE)VTABLE_get_integer_keyed_int(interp, sig, i + 1));
+        thunk_data->argc      = argc;
+        thunk_data->ret_type  = (PARROT_DATA_TYPE)VTABLE_get_integer_keyed_int(interp, sig, 0);
+        thunk_data->nci_types = mem_gc_allocate_n_zeroed_typed(interp, argc, PARROT_DATA_TYPE);
+        ret_t                 = nci_to_ffi_type(interp, thunk_data->ret_type);
 
-        if (ffi_prep_cif(&thunk_data->cif, FFI_DEFAULT_ABI, argc, ret_t, arg_t) != FFI_OK)
-            Parrot_ex_throw_from_c_args(interp, NULL, EXCEPTION_JIT_ERROR,
-                                        "invalid ffi signature");
-    }
-
-    /* generate Parrot_pcc_build_call_from_c_args dynamic call infrastructure */
-    {
-        INTVAL     retc  = Parrot_str_length(interp, pcc_ret_sig) + 3;
-        ffi_type **ret_t =  thunk_data->pcc_ret_types =
-                            mem_gc_allocate_n_zeroed_typed(interp, retc, ffi_type *);
-        int i = 0;
-
-        ret_t[0] = &ffi_type_pointer; /* interp */
-        ret_t[1] = &ffi_type_pointer; /* callsig object */
-        ret_t[2] = &ffi_type_pointer; /* pcc signature */
-
-        for (i = 3; i < retc; i++) {
-            switch ((char)Parrot_str_indexed(interp, pcc_ret_sig, i - 3)) {
-              case 'I':
-                ret_t[i] = &ffi_type_parrot_intval;
-                break;
-              case 'N':
-                ret_t[i] = &ffi_type_parrot_numval;
-                break;
-              case 'S':
-              case 'P':
-                ret_t[i] = &ffi_type_pointer;
-                break;
-              default:
-                Parrot_ex_throw_from_c_args(interp, NULL, EXCEPTION_JIT_ERROR,
-                                            "invalid pcc signature");
-            }
+        for (i = 0; i < argc; i++) {
+            thunk_data->nci_types[i] = (PARROT_DATA_TYPE)
+                            VTABLE_get_integer_keyed_int(interp, sig, i + 1);
+            arg_t[i] = nci_to_ffi_type(interp, thunk_data->nci_types[i]);
         }
 
-        if (FFI_OK != ffi_prep_cif(&thunk_data->pcc_ret_cif, FFI_DEFAULT_ABI,
-                                    retc, &ffi_type_pointer, ret_t))
+        if (ffi_prep_cif(&thunk_data->cif, FFI_DEFAULT_ABI, argc, ret_t, arg_t) != FFI_OK)
             Parrot_ex_throw_from_c_args(interp, NULL, EXCEPTION_JIT_ERROR,
                                         "invalid ffi signature");
     }
@@ -462,7 +428,9 @@ prep_pcc_ret_arg(PARROT_INTERP, PARROT_DATA_TYPE t, parrot_var_t *pv, void **rv,
 =item C<static void call_ffi_thunk(PARROT_INTERP, PMC *nci_pmc, PMC *self)>
 
 Call the native function described in C<nci_pmc> using the precomputed
-thunk contained in C<self>.
+thunk contained in C<self>. Argument types come from the thunk and the parsed
+PCC signatures from C<nci_pmc>, so nothing is parsed per call, and calls with
+up to C<NCI_FRAME_STATIC_ARGS> arguments use scratch space on the C stack.
 
 =cut
 
@@ -477,13 +445,17 @@ call_ffi_thunk(PARROT_INTERP, ARGMOD(PMC *nci_pmc), ARGMOD(PMC *self))
 
     PMC *call_object = Parrot_pcc_get_signature(interp, CURRENT_CONTEXT(interp));
 
-    parrot_var_t  *pcc_arg;     /* values of pcc arguments */
-    nci_var_t     *nci_val;     /* values of nci arguments */
-    void         **nci_arg;     /* pointers for pass-by-ref arguments */
-    void         **nci_arg_ptr = NULL; /* pointers to arguments for libffi */
+    /* scratch space for common arities */
+    nci_slot_t    slot_buf[NCI_FRAME_STATIC_ARGS + 1];
+    void         *ptr_buf[2 * NCI_FRAME_STATIC_ARGS + 1];
 
-    void *return_data; /* Holds return data from FFI call */
-    int i;
+    nci_slot_t    *slot;        /* per-argument values */
+    void         **pcc_arg_ptr; /* pointers to pcc arguments, then returns */
+    void         **nci_arg_ptr; /* pointers to arguments for libffi */
+
+    nci_var_t return_data; /* Holds return data from FFI call */
+    INTVAL    argc;
+    int       i;
 
     {
         void *v;
@@ -491,207 +463,149 @@ call_ffi_thunk(PARROT_INTERP, ARGMOD(PMC *nci_pmc), ARGMOD(PMC *self))
         thunk = (ffi_thunk_t *)v;
     }
 
-    /* dynamic call to Parrot_pcc_fill_params_from_c_args */
-    {
-        INTVAL  pcc_argc = Parrot_str_length(interp, nci->pcc_params_signature);
-        char   *pcc_sig  = Parrot_str_to_cstring(interp, nci->pcc_params_signature);
-
-        void **pcc_arg_ptr, **call_arg;
-
-        ffi_arg ffi_ret_dummy;
-
-        pcc_arg     = mem_gc_allocate_n_zeroed_typed(interp, pcc_argc, parrot_var_t);
-        pcc_arg_ptr = mem_gc_allocate_n_zeroed_typed(interp, pcc_argc, void *);
-        call_arg    = mem_gc_allocate_n_zeroed_typed(interp, pcc_argc + 3, void*);
-
-        /* setup Parrot_pcc_fill_params_from_c_args required arguments */
-        call_arg[0] = &interp;
-        call_arg[1] = &call_object;
-        call_arg[2] = &pcc_sig;
-
-        /* TODO: eliminate PCC signature parsing somehow */
-        for (i = 0; i < pcc_argc; i++) {
-            switch (pcc_sig[i]) {
-                case 'I':
-                    pcc_arg_ptr[i] = &pcc_arg[i].i;
-                    break;
-                case 'N':
-                    pcc_arg_ptr[i] = &pcc_arg[i].n;
-                    break;
-                case 'S':
-                    pcc_arg_ptr[i] = &pcc_arg[i].s;
-                    break;
-                case 'P':
-                    pcc_arg_ptr[i] = &pcc_arg[i].p;
-                    break;
-                default:
-                    PARROT_ASSERT(!"Impossible PCC signature");
-                    break;
-            }
-
-            call_arg[i + 3] = &pcc_arg_ptr[i];
-        }
-
-        ffi_call(&thunk->pcc_arg_cif, FFI_FN(Parrot_pcc_fill_params_from_c_args),
-                &ffi_ret_dummy, call_arg);
+    argc = thunk->argc;
 
-        mem_gc_free(interp, call_arg);
-        mem_gc_free(interp, pcc_arg_ptr);
-        Parrot_str_free_cstring(pcc_sig);
+    if (argc <= NCI_FRAME_STATIC_ARGS) {
+        slot        = slot_buf;
+        pcc_arg_ptr = ptr_buf;
     }
-
-    if (nci->arity) {
-        nci_val     = mem_gc_allocate_n_zeroed_typed(interp, nci->arity, nci_var_t);
-        nci_arg     = mem_gc_allocate_n_zeroed_typed(interp, nci->arity, void *);
-        nci_arg_ptr = mem_gc_allocate_n_zeroed_typed(interp, nci->arity, void *);
-
-        for (i = 0; i < nci->arity; i++) {
-            PARROT_DATA_TYPE t = (PARROT_DATA_TYPE)
-                                    VTABLE_get_integer_keyed_int(interp, nci->signature, i + 1);
-            switch (t & ~enum_type_ref_flag) {
-              case enum_type_char:
-                nci_val[i].c   = pcc_arg[i].i;
-                nci_arg_ptr[i] = &nci_val[i].c;
-                break;
-              case enum_type_short:
-                nci_val[i].s   = pcc_arg[i].i;
-                nci_arg_ptr[i] = &nci_val[i].s;
-                break;
-              case enum_type_int:
-                nci_val[i].i   = pcc_arg[i].i;
-                nci_arg_ptr[i] = &nci_val[i].i;
-                break;
-              case enum_type_long:
-                nci_val[i].l   = pcc_arg[i].i;
-                nci_arg_ptr[i] = &nci_val[i].l;
-                break;
+    else {
+        slot        = mem_gc_allocate_n_zeroed_typed(interp, argc + 1, nci_slot_t);
+        pcc_arg_ptr = mem_gc_allocate_n_zeroed_typed(interp, 2 * argc + 1, void *);
+    }
+    nci_arg_ptr = pcc_arg_ptr + argc + 1;
+
+    /* every PCC parameter is a plain I, N, S or P, so its destination is
+     * simply the matching slot */
+    for (i = 0; i < argc; i++)
+        pcc_arg_ptr[i] = &slot[i].pcc;
+
+    Parrot_pcc_fill_params_from_c_ptrs(interp, call_object, nci->pcc_params_flags, pcc_arg_ptr);
+
+    for (i = 0; i < argc; i++) {
+        const PARROT_DATA_TYPE t = thunk->nci_types[i];
+        switch (t & ~enum_type_ref_flag) {
+          case enum_type_char:
+            slot[i].nci.c  = slot[i].pcc.i;
+            nci_arg_ptr[i] = &slot[i].nci.c;
+            break;
+          case enum_type_short:
+            slot[i].nci.s  = slot[i].pcc.i;
+            nci_arg_ptr[i] = &slot[i].nci.s;
+            break;
+          case enum_type_int:
+            slot[i].nci.i  = slot[i].pcc.i;
+            nci_arg_ptr[i] = &slot[i].nci.i;
+            break;
+          case enum_type_long:
+            slot[i].nci.l  = slot[i].pcc.i;
+            nci_arg_ptr[i] = &slot[i].nci.l;
+            break;
 #if PARROT_HAS_LONGLONG
-              case enum_type_longlong:
-                nci_val[i].ll  = pcc_arg[i].i;
-                nci_arg_ptr[i] = &nci_val[i].ll;
-                break;
+          case enum_type_longlong:
+            slot[i].nci.ll = slot[i].pcc.i;
+            nci_arg_ptr[i] = &slot[i].nci.ll;
+            break;
 #endif
-              case enum_type_int8:
-                nci_val[i].i8  = pcc_arg[i].i;
-                nci_arg_ptr[i] = &nci_val[i].i8;
-                break;
-              case enum_type_int16:
-                nci_val[i].i16 = pcc_arg[i].i;
-                nci_arg_ptr[i] = &nci_val[i].i16;
-                break;
-              case enum_type_int32:
-                nci_val[i].i32 = pcc_arg[i].i;
-                nci_arg_ptr[i] = &nci_val[i].i32;
-                break;
+          case enum_type_int8:
+            slot[i].nci.i8 = slot[i].pcc.i;
+            nci_arg_ptr[i] = &slot[i].nci.i8;
+            break;
+          case enum_type_int16:
+            slot[i].nci.i16= slot[i].pcc.i;
+            nci_arg_ptr[i] = &slot[i].nci.i16;
+            break;
+          case enum_type_int32:
+            slot[i].nci.i32= slot[i].pcc.i;
+            nci_arg_ptr[i] = &slot[i].nci.i32;
+            break;
 #if PARROT_HAS_INT64
-              case enum_type_int64:
-                nci_val[i].i64 = pcc_arg[i].i;
-                nci_arg_ptr[i] = &nci_val[i].i64;
-                break;
+          case enum_type_int64:
+            slot[i].nci.i64= slot[i].pcc.i;
+            nci_arg_ptr[i] = &slot[i].nci.i64;
+            break;
 #endif
-              case enum_type_INTVAL:
-                nci_val[i].I   = pcc_arg[i].i;
-                nci_arg_ptr[i] = &nci_val[i].I;
-                break;
-
-              case enum_type_float:
-                nci_val[i].f   = pcc_arg[i].n;
-                nci_arg_ptr[i] = &nci_val[i].f;
-                break;
-              case enum_type_double:
-                nci_val[i].d   = pcc_arg[i].n;
-                nci_arg_ptr[i] = &nci_val[i].d;
-                break;
-              case enum_type_longdouble:
-                nci_val[i].ld  = pcc_arg[i].n;
-                nci_arg_ptr[i] = &nci_val[i].ld;
-                break;
-              case enum_type_FLOATVAL:
-                nci_val[i].N   = pcc_arg[i].n;
-                nci_arg_ptr[i] = &nci_val[i].N;
-                break;
-
-              case enum_type_STRING:
-                nci_val[i].S   = pcc_arg[i].s;
-                nci_arg_ptr[i] = &nci_val[i].S;
-                break;
-              case enum_type_PMC:
-                nci_val[i].P   = pcc_arg[i].p;
-                nci_arg_ptr[i] = &nci_val[i].P;
-                break;
-              case enum_type_ptr:
-                nci_val[i].p   = PMC_IS_NULL(pcc_arg[i].p) ?
-                                    NULL :
-                                    VTABLE_get_pointer(interp, pcc_arg[i].p);
-                nci_arg_ptr[i] = &nci_val[i].p;
-                break;
-
-              default:
-                PARROT_ASSERT("Unhandled NCI signature");
-                break;
-            }
+          case enum_type_INTVAL:
+            slot[i].nci.I  = slot[i].pcc.i;
+            nci_arg_ptr[i] = &slot[i].nci.I;
+            break;
+
+          case enum_type_float:
+            slot[i].nci.f  = slot[i].pcc.n;
+            nci_arg_ptr[i] = &slot[i].nci.f;
+            break;
+          case enum_type_double:
+            slot[i].nci.d  = slot[i].pcc.n;
+            nci_arg_ptr[i] = &slot[i].nci.d;
+            break;
+          case enum_type_longdouble:
+            slot[i].nci.ld = slot[i].pcc.n;
+            nci_arg_ptr[i] = &slot[i].nci.ld;
+            break;
+          case enum_type_FLOATVAL:
+            slot[i].nci.N  = slot[i].pcc.n;
+            nci_arg_ptr[i] = &slot[i].nci.N;
+            break;
+
+          case enum_type_STRING:
+            slot[i].nci.S  = slot[i].pcc.s;
+            nci_arg_ptr[i] = &slot[i].nci.S;
+            break;
+          case enum_type_PMC:
+            slot[i].nci.P  = slot[i].pcc.p;
+            nci_arg_ptr[i] = &slot[i].nci.P;
+            break;
+          case enum_type_ptr:
+            slot[i].nci.p   = PMC_IS_NULL(slot[i].pcc.p) ?
+                                NULL :
+                                VTABLE_get_pointer(interp, slot[i].pcc.p);
+            nci_arg_ptr[i] = &slot[i].nci.p;
+            break;
+
+          default:
+            PARROT_ASSERT("Unhandled NCI signature");
+            break;
+        }
 
-            if (t & enum_type_ref_flag) {
-                nci_arg[i]     = nci_arg_ptr[i];
-                nci_arg_ptr[i] = &nci_arg[i];
-            }
+        if (t & enum_type_ref_flag) {
+            slot[i].ref    = nci_arg_ptr[i];
+            nci_arg_ptr[i] = &slot[i].ref;
         }
     }
 
-    mem_gc_free(interp, pcc_arg);
+    ffi_call(&thunk->cif, FFI_FN(nci->orig_func), &return_data, nci_arg_ptr);
 
-    return_data = mem_sys_allocate(thunk->cif.rtype->size);
+    /* pass back the return value and call-by-reference arguments (if any);
+     * the PCC argument values and their pointers are no longer needed, so
+     * their slots hold the returns */
+    if (thunk->pcc_retc) {
+        int j;
 
-    ffi_call(&thunk->cif, FFI_FN(nci->orig_func), return_data, nci_arg_ptr);
-
-    /* dynamic call to Parrot_pcc_build_call_from_c_args */
-    if (thunk->pcc_ret_cif.nargs > 3) {
-        PMC           *ffi_ret_unused;
-        INTVAL         pcc_retc    = Parrot_str_length(interp, nci->pcc_return_signature);
-        char          *pcc_ret_sig = Parrot_str_to_cstring(interp, nci->pcc_return_signature);
-        void         **call_arg    = mem_gc_allocate_n_zeroed_typed(interp, pcc_retc + 3, void *);
-        parrot_var_t  *pcc_retv    = mem_gc_allocate_n_zeroed_typed(interp, pcc_retc, parrot_var_t);
-
-        PARROT_DATA_TYPE arg_t;
-        int              i = 0;
-        int              j;
-
-        call_arg[0] = &interp;
-        call_arg[1] = &call_object;
-        call_arg[2] = &pcc_ret_sig;
+        i = 0;
 
         /* populate return slot (non-existent if void) */
-        if (enum_type_void !=
-            (arg_t = (PARROT_DATA_TYPE)VTABLE_get_integer_keyed_int(interp, nci->signature, 0))) {
-            prep_pcc_ret_arg(interp, arg_t, &pcc_retv[i], &call_arg[i + 3], return_data);
+        if (thunk->ret_type != enum_type_void) {
+            prep_pcc_ret_arg(interp, thunk->ret_type, &slot[i].pcc, &pcc_arg_ptr[i],
+                                &return_data);
             i++;
         }
 
-        /* also return call-by-reference arguments (if any) */
-        for (j = 1; i < pcc_retc; j++) {
-            arg_t = (PARROT_DATA_TYPE)VTABLE_get_integer_keyed_int(interp, nci->signature, j);
-            if (arg_t & enum_type_ref_flag) {
-                prep_pcc_ret_arg(interp, (PARROT_DATA_TYPE)(arg_t & ~enum_type_ref_flag),
-                                    &pcc_retv[i], &call_arg[i + 3], nci_arg[j - 1]);
+        for (j = 0; i < thunk->pcc_retc; j++) {
+            const PARROT_DATA_TYPE t = thunk->nci_types[j];
+            if (t & enum_type_ref_flag) {
+                prep_pcc_ret_arg(interp, (PARROT_DATA_TYPE)(t & ~enum_type_ref_flag),
+                                    &slot[i].pcc, &pcc_arg_ptr[i], slot[j].ref);
                 i++;
             }
         }
 
-        ffi_call(&thunk->pcc_ret_cif, FFI_FN(Parrot_pcc_build_call_from_c_args),
-                &ffi_ret_unused, call_arg);
-
-        Parrot_str_free_cstring(pcc_ret_sig);
-        mem_gc_free(interp, call_arg);
-        mem_gc_free(interp, pcc_retv);
+        Parrot_pcc_set_call_from_c_ptrs(interp, call_object, nci->pcc_return_flags, pcc_arg_ptr);
     }
 
-    if (nci->arity) {
-        mem_gc_free(interp, nci_val);
-        mem_gc_free(interp, nci_arg);
-        mem_gc_free(interp, nci_arg_ptr);
+    if (argc > NCI_FRAME_STATIC_ARGS) {
+        mem_gc_free(interp, slot);
+        mem_gc_free(interp, pcc_arg_ptr);
     }
-
-    mem_gc_free(interp, return_data);
 }
 
 
@@ -718,15 +632,18 @@ clone_ffi_thunk(PARROT_INTERP, ARGIN(PMC *thunk), ARGIN(void *_thunk_data))
 
     memcpy(clone_data, thunk_data, sizeof (ffi_thunk_t));
 
-    clone_data->pcc_arg_types = mem_gc_allocate_n_zeroed_typed(interp,
-                                    thunk_data->pcc_arg_cif.nargs, ffi_type *);
-    mem_copy_n_typed(clone_data->pcc_arg_types, thunk_data->pcc_arg_types,
-                        thunk_data->pcc_arg_cif.nargs, ffi_type *);
-
     clone_data->arg_types     = mem_gc_allocate_n_zeroed_typed(interp,
-                                    thunk_data->cif.nargs, ffi_type *);
+                                    thunk_data->argc, ffi_type *);
     mem_copy_n_typed(clone_data->arg_types, thunk_data->arg_types,
-                        thunk_data->cif.nargs, ffi_type *);
+                        thunk_data->argc, ffi_type *);
+
+    clone_data->nci_types     = mem_gc_allocate_n_zeroed_typed(interp,
+                                    thunk_data->argc, PARROT_DATA_TYPE);
+    mem_copy_n_typed(clone_data->nci_types, thunk_data->nci_types,
+                        thunk_data->argc, PARROT_DATA_TYPE);
+
+    /* the cif refers to its argument type array; point it at our copy */
+    clone_data->cif.arg_types = clone_data->arg_types;
 
     return clone;
 }
@@ -752,8 +669,8 @@ free_ffi_thunk(PARROT_INTERP, SHIM(void *thunk_func), ARGFREE(void *thunk_data))
     if (thunk->arg_types)
         mem_gc_free(interp, thunk->arg_types);
 
-    if (thunk->pcc_arg_types)
-        mem_gc_free(interp, thunk->pcc_arg_types);
+    if (thunk->nci_types)
+        mem_gc_free(interp, thunk->nci_types);
 
     mem_gc_free(interp, thunk);
 }
@@ -80,6 +80,7 @@ PARROT_DYNEXT_EXPORT float  nci_fff(float, float);
 PARROT_DYNEXT_EXPORT int    nci_i(void);
 PARROT_DYNEXT_EXPORT int    nci_ib(int *);
 PARROT_DYNEXT_EXPORT int    nci_iiii(int, int, int);
+PARROT_DYNEXT_EXPORT int    nci_isum10(int, int, int, int, int, int, int, int, int, int);
 PARROT_DYNEXT_EXPORT int    nci_ip(void *);
 PARROT_DYNEXT_EXPORT int    nci_isc(short, char);
 PARROT_DYNEXT_EXPORT long   nci_l(void);
@@ -401,6 +402,27 @@ nci_iiii(int i1, int i2, int i3)
 
 /*
 
+=item C<PARROT_DYNEXT_EXPORT int nci_isum10(int i1, int i2, int i3, int i4, int
+i5, int i6, int i7, int i8, int i9, int i10)>
+
+Returns the sum of ten integers, each weighted by its position, so that
+misordered arguments are noticed.
+
+=cut
+
+*/
+
+PARROT_DYNEXT_EXPORT
+int
+nci_isum10(int i1, int i2, int i3, int i4, int i5,
+           int i6, int i7, int i8, int i9, int i10)
+{
+    return i1 + 2 * i2 + 3 * i3 + 4 * i4 + 5 * i5
+         + 6 * i6 + 7 * i7 + 8 * i8 + 9 * i9 + 10 * i10;
+}
+
+/*
+
 =item C<PARROT_DYNEXT_EXPORT int call_back(PARROT_INTERP, char *cstr)>
 
 writes the string C<str> to stdout and returns the value 4711.
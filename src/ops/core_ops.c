@@ -26,7 +26,7 @@
 #define NCONST(i) Parrot_pcc_get_num_constants(interp, interp->ctx)[cur_opcode[i]]
 #define SCONST(i) Parrot_pcc_get_str_constants(interp, interp->ctx)[cur_opcode[i]]
 #undef  PCONST
-#define PCONST(i) Parrot_pcc_get_pmc_constants(interp, interp->ctx)[cur_opcode[i]]
+#define PCONST(i) Parrot_pcc_get_pmc_constant(interp, interp->ctx, cur_opcode[i])
 
 static int get_op(PARROT_INTERP, const char * name, int full);
 
@@ -63,9 +63,224 @@ extern op_lib_t core_op_lib;
      : 0)
 
 
+
+#include "pmc/pmc_integer.h"
+#include "pmc/pmc_float.h"
+
+/*
+ * PMC comparisons with plain Integer and Float operands are done on the
+ * attributes instead of through vtable and MMD dispatch, with the same
+ * results as integer.pmc and float.pmc.  Comparing such a PMC against an
+ * integer also no longer needs a temporary Integer PMC.
+ */
+
+PARROT_INLINE
+static INTVAL
+pmc_is_equal(PARROT_INTERP, ARGIN(PMC *l), ARGIN(PMC *r))
+{
+    if (PMC_IS_EXACTLY(interp, l, Integer) && PMC_IS_EXACTLY(interp, r, Integer))
+        return PARROT_INTEGER(l)->iv == PARROT_INTEGER(r)->iv;
+    if (PMC_IS_EXACTLY(interp, l, Float) && PMC_IS_EXACTLY(interp, r, Float))
+        return PARROT_FLOAT(l)->fv == PARROT_FLOAT(r)->fv;
+    return VTABLE_is_equal(interp, l, r);
+}
+
+PARROT_INLINE
+static INTVAL
+pmc_cmp(PARROT_INTERP, ARGIN(PMC *l), ARGIN(PMC *r))
+{
+    if (PMC_IS_EXACTLY(interp, l, Integer) && PMC_IS_EXACTLY(interp, r, Integer)) {
+        const INTVAL a = PARROT_INTEGER(l)->iv;
+        const INTVAL b = PARROT_INTEGER(r)->iv;
+        return a > b ? 1 : a < b ? -1 : 0;
+    }
+    if (PMC_IS_EXACTLY(interp, l, Float) && PMC_IS_EXACTLY(interp, r, Float)) {
+        const FLOATVAL diff = PARROT_FLOAT(l)->fv - PARROT_FLOAT(r)->fv;
+        return diff > 0 ? 1 : diff < 0 ? -1 : 0;
+    }
+    return VTABLE_cmp(interp, l, r);
+}
+
+PARROT_INLINE
+static INTVAL
+pmc_is_equal_int(PARROT_INTERP, ARGIN(PMC *l), INTVAL b)
+{
+    if (PMC_IS_EXACTLY(interp, l, Integer))
+        return PARROT_INTEGER(l)->iv == b;
+    else if (PMC_IS_EXACTLY(interp, l, Float))
+        return PARROT_FLOAT(l)->fv == (FLOATVAL)b;
+    else {
+        PMC * const temp = Parrot_pmc_new_temporary(interp, enum_class_Integer);
+        INTVAL result;
+        VTABLE_set_integer_native(interp, temp, b);
+        result = VTABLE_is_equal(interp, l, temp);
+        Parrot_pmc_free_temporary(interp, temp);
+        return result;
+    }
+}
+
+PARROT_INLINE
+static INTVAL
+pmc_cmp_int(PARROT_INTERP, ARGIN(PMC *l), INTVAL b)
+{
+    if (PMC_IS_EXACTLY(interp, l, Integer)) {
+        const INTVAL a = PARROT_INTEGER(l)->iv;
+        return a > b ? 1 : a < b ? -1 : 0;
+    }
+    else if (PMC_IS_EXACTLY(interp, l, Float)) {
+        const FLOATVAL diff = PARROT_FLOAT(l)->fv - (FLOATVAL)b;
+        return diff > 0 ? 1 : diff < 0 ? -1 : 0;
+    }
+    else {
+        PMC * const temp = Parrot_pmc_new_temporary(interp, enum_class_Integer);
+        INTVAL result;
+        VTABLE_set_integer_native(interp, temp, b);
+        result = VTABLE_cmp(interp, l, temp);
+        Parrot_pmc_free_temporary(interp, temp);
+        return result;
+    }
+}
+
+
 #include "../io/io_private.h"
 
 
+#include "pmc/pmc_integer.h"
+#include "pmc/pmc_float.h"
+
+/*
+ * Plain Integer and Float PMCs are the most common operands of the PMC
+ * arithmetic ops.  When both operands are exactly one of those types the
+ * helpers below do the arithmetic on the attributes instead of going
+ * through vtable and MMD dispatch, with the same results as integer.pmc
+ * and scalar.pmc.  They return 0 (or NULL) for any other operands, or if
+ * an Integer result would overflow, and the op then takes the vtable path
+ * which handles the upgrade to BigInt.
+ */
+
+PARROT_INLINE
+static int
+int_arith(char op, INTVAL a, INTVAL b, ARGOUT(INTVAL *c))
+{
+    switch (op) {
+      case '+':
+        *c = a + b;
+        return (*c ^ a) >= 0 || (*c ^ b) >= 0;
+      case '-':
+        *c = a - b;
+        return (*c ^ a) >= 0 || (*c ^ ~b) >= 0;
+      default:
+        *c = a * b;
+        return (double)*c == (double)a * (double)b;
+    }
+}
+
+PARROT_INLINE
+static FLOATVAL
+num_arith(char op, FLOATVAL a, FLOATVAL b)
+{
+    switch (op) {
+      case '+':
+        return a + b;
+      case '-':
+        return a - b;
+      default:
+        return a * b;
+    }
+}
+
+PARROT_INLINE
+static int
+plain_i_arith_int(PARROT_INTERP, char op, ARGMOD(PMC *l), INTVAL b)
+{
+    if (PMC_IS_EXACTLY(interp, l, Integer)) {
+        INTVAL c;
+        if (!int_arith(op, PARROT_INTEGER(l)->iv, b, &c))
+            return 0;
+        PARROT_INTEGER(l)->iv = c;
+        return 1;
+    }
+    if (PMC_IS_EXACTLY(interp, l, Float)) {
+        PARROT_FLOAT(l)->fv = num_arith(op, PARROT_FLOAT(l)->fv, (FLOATVAL)b);
+        return 1;
+    }
+    return 0;
+}
+
+PARROT_INLINE
+static int
+plain_i_arith(PARROT_INTERP, char op, ARGMOD(PMC *l), ARGIN(PMC *r))
+{
+    if (PMC_IS_EXACTLY(interp, l, Integer) && PMC_IS_EXACTLY(interp, r, Integer))
+        return plain_i_arith_int(interp, op, l, PARROT_INTEGER(r)->iv);
+    if (PMC_IS_EXACTLY(interp, l, Float) && PMC_IS_EXACTLY(interp, r, Float)) {
+        PARROT_FLOAT(l)->fv = num_arith(op, PARROT_FLOAT(l)->fv, PARROT_FLOAT(r)->fv);
+        return 1;
+    }
+    return 0;
+}
+
+PARROT_INLINE
+static int
+plain_i_arith_num(PARROT_INTERP, char op, ARGMOD(PMC *l), FLOATVAL b)
+{
+    if (PMC_IS_EXACTLY(interp, l, Float)) {
+        PARROT_FLOAT(l)->fv = num_arith(op, PARROT_FLOAT(l)->fv, b);
+        return 1;
+    }
+    return 0;
+}
+
+PARROT_INLINE
+PARROT_CANNOT_RETURN_NULL
+static PMC *
+plain_float(PARROT_INTERP, FLOATVAL value)
+{
+    PMC * const result = Parrot_pmc_new(interp, enum_class_Float);
+    PARROT_FLOAT(result)->fv = value;
+    return result;
+}
+
+PARROT_INLINE
+PARROT_CAN_RETURN_NULL
+static PMC *
+plain_arith_int(PARROT_INTERP, char op, ARGIN(PMC *l), INTVAL b)
+{
+    if (PMC_IS_EXACTLY(interp, l, Integer)) {
+        INTVAL c;
+        if (!int_arith(op, PARROT_INTEGER(l)->iv, b, &c))
+            return NULL;
+        return Parrot_pmc_new_init_int(interp, enum_class_Integer, c);
+    }
+    if (PMC_IS_EXACTLY(interp, l, Float))
+        return plain_float(interp, num_arith(op, PARROT_FLOAT(l)->fv, (FLOATVAL)b));
+    return NULL;
+}
+
+PARROT_INLINE
+PARROT_CAN_RETURN_NULL
+static PMC *
+plain_arith(PARROT_INTERP, char op, ARGIN(PMC *l), ARGIN(PMC *r))
+{
+    if (PMC_IS_EXACTLY(interp, l, Integer) && PMC_IS_EXACTLY(interp, r, Integer))
+        return plain_arith_int(interp, op, l, PARROT_INTEGER(r)->iv);
+    if (PMC_IS_EXACTLY(interp, l, Float) && PMC_IS_EXACTLY(interp, r, Float))
+        return plain_float(interp, num_arith(op, PARROT_FLOAT(l)->fv, PARROT_FLOAT(r)->fv));
+    return NULL;
+}
+
+PARROT_INLINE
+PARROT_CAN_RETURN_NULL
+static PMC *
+plain_arith_num(PARROT_INTERP, char op, ARGIN(PMC *l), FLOATVAL b)
+{
+    if (PMC_IS_EXACTLY(interp, l, Float))
+        return plain_float(interp, num_arith(op, PARROT_FLOAT(l)->fv, b));
+    return NULL;
+}
+
+
+
 #if PARROT_HAS_ICU
 #  include <unicode/uchar.h>
 #endif
@@ -77,13 +292,13 @@ extern op_lib_t core_op_lib;
 
 
 
-INTVAL core_numops = 1126;
+INTVAL core_numops = 1142;
 
 /*
 ** Op Function Table:
 */
 
-static op_func_t core_op_func_table[1126] = {
+static op_func_t core_op_func_table[1142] = {
   Parrot_end,                                        /*      0 */
   Parrot_noop,                                       /*      1 */
   Parrot_check_events,                               /*      2 */
@@ -1209,6 +1424,22 @@ static op_func_t core_op_func_table[1126] = {
   Parrot_wait_p,                                     /*   1122 */
   Parrot_wait_pc,                                    /*   1123 */
   Parrot_pass,                                       /*   1124 */
+  Parrot_find_lex_slot_p_ic_ic,                      /*   1125 */
+  Parrot_find_lex_slot_s_ic_ic,                      /*   1126 */
+  Parrot_find_lex_slot_i_ic_ic,                      /*   1127 */
+  Parrot_find_lex_slot_n_ic_ic,                      /*   1128 */
+  Parrot_store_lex_slot_ic_ic_p,                     /*   1129 */
+  Parrot_store_lex_slot_ic_ic_s,                     /*   1130 */
+  Parrot_store_lex_slot_ic_ic_sc,                    /*   1131 */
+  Parrot_store_lex_slot_ic_ic_i,                     /*   1132 */
+  Parrot_store_lex_slot_ic_ic_ic,                    /*   1133 */
+  Parrot_store_lex_slot_ic_ic_n,                     /*   1134 */
+  Parrot_store_lex_slot_ic_ic_nc,                    /*   1135 */
+  Parrot_renew_p_sc,                                 /*   1136 */
+  Parrot_throw_control_i,                            /*   1137 */
+  Parrot_throw_control_ic,                           /*   1138 */
+  Parrot_throw_control_i_p,                          /*   1139 */
+  Parrot_throw_control_ic_p,                         /*   1140 */
 
   NULL /* NULL function pointer */
 };
@@ -1219,7 +1450,7 @@ static op_func_t core_op_func_table[1126] = {
 ** Op Info Table:
 */
 
-static op_info_t core_op_info_table[1126] = {
+static op_info_t core_op_info_table[1142] = {
   { /* 0 */
     "end",
     "end",
@@ -13595,6 +13826,182 @@ static op_info_t core_op_info_table[1126] = {
     { 0 },
     &core_op_lib
   },
+  { /* 1125 */
+    "find_lex_slot",
+    "find_lex_slot_p_ic_ic",
+    "Parrot_find_lex_slot_p_ic_ic",
+    0,
+    4,
+    { PARROT_ARG_P, PARROT_ARG_IC, PARROT_ARG_IC },
+    { PARROT_ARGDIR_OUT, PARROT_ARGDIR_IN, PARROT_ARGDIR_IN },
+    { 0, 0, 0 },
+    &core_op_lib
+  },
+  { /* 1126 */
+    "find_lex_slot",
+    "find_lex_slot_s_ic_ic",
+    "Parrot_find_lex_slot_s_ic_ic",
+    0,
+    4,
+    { PARROT_ARG_S, PARROT_ARG_IC, PARROT_ARG_IC },
+    { PARROT_ARGDIR_OUT, PARROT_ARGDIR_IN, PARROT_ARGDIR_IN },
+    { 0, 0, 0 },
+    &core_op_lib
+  },
+  { /* 1127 */
+    "find_lex_slot",
+    "find_lex_slot_i_ic_ic",
+    "Parrot_find_lex_slot_i_ic_ic",
+    0,
+    4,
+    { PARROT_ARG_I, PARROT_ARG_IC, PARROT_ARG_IC },
+    { PARROT_ARGDIR_OUT, PARROT_ARGDIR_IN, PARROT_ARGDIR_IN },
+    { 0, 0, 0 },
+    &core_op_lib
+  },
+  { /* 1128 */
+    "find_lex_slot",
+    "find_lex_slot_n_ic_ic",
+    "Parrot_find_lex_slot_n_ic_ic",
+    0,
+    4,
+    { PARROT_ARG_N, PARROT_ARG_IC, PARROT_ARG_IC },
+    { PARROT_ARGDIR_OUT, PARROT_ARGDIR_IN, PARROT_ARGDIR_IN },
+    { 0, 0, 0 },
+    &core_op_lib
+  },
+  { /* 1129 */
+    "store_lex_slot",
+    "store_lex_slot_ic_ic_p",
+    "Parrot_store_lex_slot_ic_ic_p",
+    0,
+    4,
+    { PARROT_ARG_IC, PARROT_ARG_IC, PARROT_ARG_P },
+    { PARROT_ARGDIR_IN, PARROT_ARGDIR_IN, PARROT_ARGDIR_IN },
+    { 0, 0, 0 },
+    &core_op_lib
+  },
+  { /* 1130 */
+    "store_lex_slot",
+    "store_lex_slot_ic_ic_s",
+    "Parrot_store_lex_slot_ic_ic_s",
+    0,
+    4,
+    { PARROT_ARG_IC, PARROT_ARG_IC, PARROT_ARG_S },
+    { PARROT_ARGDIR_IN, PARROT_ARGDIR_IN, PARROT_ARGDIR_IN },
+    { 0, 0, 0 },
+    &core_op_lib
+  },
+  { /* 1131 */
+    "store_lex_slot",
+    "store_lex_slot_ic_ic_sc",
+    "Parrot_store_lex_slot_ic_ic_sc",
+    0,
+    4,
+    { PARROT_ARG_IC, PARROT_ARG_IC, PARROT_ARG_SC },
+    { PARROT_ARGDIR_IN, PARROT_ARGDIR_IN, PARROT_ARGDIR_IN },
+    { 0, 0, 0 },
+    &core_op_lib
+  },
+  { /* 1132 */
+    "store_lex_slot",
+    "store_lex_slot_ic_ic_i",
+    "Parrot_store_lex_slot_ic_ic_i",
+    0,
+    4,
+    { PARROT_ARG_IC, PARROT_ARG_IC, PARROT_ARG_I },
+    { PARROT_ARGDIR_IN, PARROT_ARGDIR_IN, PARROT_ARGDIR_IN },
+    { 0, 0, 0 },
+    &core_op_lib
+  },
+  { /* 1133 */
+    "store_lex_slot",
+    "store_lex_slot_ic_ic_ic",
+    "Parrot_store_lex_slot_ic_ic_ic",
+    0,
+    4,
+    { PARROT_ARG_IC, PARROT_ARG_IC, PARROT_ARG_IC },
+    { PARROT_ARGDIR_IN, PARROT_ARGDIR_IN, PARROT_ARGDIR_IN },
+    { 0, 0, 0 },
+    &core_op_lib
+  },
+  { /* 1134 */
+    "store_lex_slot",
+    "store_lex_slot_ic_ic_n",
+    "Parrot_store_lex_slot_ic_ic_n",
+    0,
+    4,
+    { PARROT_ARG_IC, PARROT_ARG_IC, PARROT_ARG_N },
+    { PARROT_ARGDIR_IN, PARROT_ARGDIR_IN, PARROT_ARGDIR_IN },
+    { 0, 0, 0 },
+    &core_op_lib
+  },
+  { /* 1135 */
+    "store_lex_slot",
+    "store_lex_slot_ic_ic_nc",
+    "Parrot_store_lex_slot_ic_ic_nc",
+    0,
+    4,
+    { PARROT_ARG_IC, PARROT_ARG_IC, PARROT_ARG_NC },
+    { PARROT_ARGDIR_IN, PARROT_ARGDIR_IN, PARROT_ARGDIR_IN },
+    { 0, 0, 0 },
+    &core_op_lib
+  },
+  { /* 1136 */
+    "renew",
+    "renew_p_sc",
+    "Parrot_renew_p_sc",
+    0,
+    3,
+    { PARROT_ARG_P, PARROT_ARG_SC },
+    { PARROT_ARGDIR_INOUT, PARROT_ARGDIR_IN },
+    { 0, 0 },
+    &core_op_lib
+  },
+  { /* 1137 */
+    "throw_control",
+    "throw_control_i",
+    "Parrot_throw_control_i",
+    0,
+    2,
+    { PARROT_ARG_I },
+    { PARROT_ARGDIR_IN },
+    { 0 },
+    &core_op_lib
+  },
+  { /* 1138 */
+    "throw_control",
+    "throw_control_ic",
+    "Parrot_throw_control_ic",
+    0,
+    2,
+    { PARROT_ARG_IC },
+    { PARROT_ARGDIR_IN },
+    { 0 },
+    &core_op_lib
+  },
+  { /* 1139 */
+    "throw_control",
+    "throw_control_i_p",
+    "Parrot_throw_control_i_p",
+    0,
+    3,
+    { PARROT_ARG_I, PARROT_ARG_P },
+    { PARROT_ARGDIR_IN, PARROT_ARGDIR_IN },
+    { 0, 0 },
+    &core_op_lib
+  },
+  { /* 1140 */
+    "throw_control",
+    "throw_control_ic_p",
+    "Parrot_throw_control_ic_p",
+    0,
+    3,
+    { PARROT_ARG_IC, PARROT_ARG_P },
+    { PARROT_ARGDIR_IN, PARROT_ARGDIR_IN },
+    { 0, 0 },
+    &core_op_lib
+  },
 
 };
 
@@ -14061,11 +14468,17 @@ Parrot_throw_p(opcode_t *cur_opcode, PARROT_INTERP) {
     STRING  * const  exception_str = Parrot_str_new_constant(interp, "Exception");
 
     VTABLE_set_pointer(interp, resume, ret);
-    if ((PMC_IS_NULL(except) || (!VTABLE_does(interp, except, exception_str)))) {
+    if ((PMC_IS_NULL(except) || (((except->vtable->base_type != enum_class_Exception) && (!VTABLE_does(interp, except, exception_str)))))) {
         except = Parrot_ex_build_exception(interp, EXCEPT_fatal, EXCEPTION_UNIMPLEMENTED, Parrot_str_new_constant(interp, "Not a throwable object"));
     }
 
-    VTABLE_set_attr_str(interp, except, Parrot_str_new_constant(interp, "resume"), resume);
+    if ((except->vtable->base_type == enum_class_Exception)) {
+        SETATTR_Exception_resume(interp, except, resume);
+    }
+    else {
+        VTABLE_set_attr_str(interp, except, Parrot_str_new_constant(interp, "resume"), resume);
+    }
+
     dest = Parrot_ex_throw_from_op(interp, except, ret);
     return (opcode_t *)dest;
 }
@@ -15312,7 +15725,7 @@ Parrot_eq_s_sc_ic(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_eq_p_p_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    if (VTABLE_is_equal(interp, PREG(1), PREG(2))) {
+    if (pmc_is_equal(interp, PREG(1), PREG(2))) {
         return cur_opcode + ICONST(3);
     }
 
@@ -15321,29 +15734,19 @@ Parrot_eq_p_p_ic(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_eq_p_i_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    PMC  * const  temp = Parrot_pmc_new_temporary(interp, enum_class_Integer);
-
-    VTABLE_set_integer_native(interp, temp, IREG(2));
-    if (VTABLE_is_equal(interp, PREG(1), temp)) {
-        Parrot_pmc_free_temporary(interp, temp);
+    if (pmc_is_equal_int(interp, PREG(1), IREG(2))) {
         return cur_opcode + ICONST(3);
     }
 
-    Parrot_pmc_free_temporary(interp, temp);
     return cur_opcode + 4;
 }
 
 opcode_t *
 Parrot_eq_p_ic_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    PMC  * const  temp = Parrot_pmc_new_temporary(interp, enum_class_Integer);
-
-    VTABLE_set_integer_native(interp, temp, ICONST(2));
-    if (VTABLE_is_equal(interp, PREG(1), temp)) {
-        Parrot_pmc_free_temporary(interp, temp);
+    if (pmc_is_equal_int(interp, PREG(1), ICONST(2))) {
         return cur_opcode + ICONST(3);
     }
 
-    Parrot_pmc_free_temporary(interp, temp);
     return cur_opcode + 4;
 }
 
@@ -15529,7 +15932,7 @@ Parrot_ne_s_sc_ic(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_ne_p_p_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    if ((!VTABLE_is_equal(interp, PREG(1), PREG(2)))) {
+    if ((!pmc_is_equal(interp, PREG(1), PREG(2)))) {
         return cur_opcode + ICONST(3);
     }
 
@@ -15538,29 +15941,19 @@ Parrot_ne_p_p_ic(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_ne_p_i_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    PMC  * const  temp = Parrot_pmc_new_temporary(interp, enum_class_Integer);
-
-    VTABLE_set_integer_native(interp, temp, IREG(2));
-    if ((!VTABLE_is_equal(interp, PREG(1), temp))) {
-        Parrot_pmc_free_temporary(interp, temp);
+    if ((!pmc_is_equal_int(interp, PREG(1), IREG(2)))) {
         return cur_opcode + ICONST(3);
     }
 
-    Parrot_pmc_free_temporary(interp, temp);
     return cur_opcode + 4;
 }
 
 opcode_t *
 Parrot_ne_p_ic_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    PMC  * const  temp = Parrot_pmc_new_temporary(interp, enum_class_Integer);
-
-    VTABLE_set_integer_native(interp, temp, ICONST(2));
-    if ((!VTABLE_is_equal(interp, PREG(1), temp))) {
-        Parrot_pmc_free_temporary(interp, temp);
+    if ((!pmc_is_equal_int(interp, PREG(1), ICONST(2)))) {
         return cur_opcode + ICONST(3);
     }
 
-    Parrot_pmc_free_temporary(interp, temp);
     return cur_opcode + 4;
 }
 
@@ -15746,7 +16139,7 @@ Parrot_lt_s_sc_ic(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_lt_p_p_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    if ((VTABLE_cmp(interp, PREG(1), PREG(2)) < 0)) {
+    if ((pmc_cmp(interp, PREG(1), PREG(2)) < 0)) {
         return cur_opcode + ICONST(3);
     }
 
@@ -15755,29 +16148,19 @@ Parrot_lt_p_p_ic(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_lt_p_i_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    PMC  * const  temp = Parrot_pmc_new_temporary(interp, enum_class_Integer);
-
-    VTABLE_set_integer_native(interp, temp, IREG(2));
-    if ((VTABLE_cmp(interp, PREG(1), temp) < 0)) {
-        Parrot_pmc_free_temporary(interp, temp);
+    if ((pmc_cmp_int(interp, PREG(1), IREG(2)) < 0)) {
         return cur_opcode + ICONST(3);
     }
 
-    Parrot_pmc_free_temporary(interp, temp);
     return cur_opcode + 4;
 }
 
 opcode_t *
 Parrot_lt_p_ic_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    PMC  * const  temp = Parrot_pmc_new_temporary(interp, enum_class_Integer);
-
-    VTABLE_set_integer_native(interp, temp, ICONST(2));
-    if ((VTABLE_cmp(interp, PREG(1), temp) < 0)) {
-        Parrot_pmc_free_temporary(interp, temp);
+    if ((pmc_cmp_int(interp, PREG(1), ICONST(2)) < 0)) {
         return cur_opcode + ICONST(3);
     }
 
-    Parrot_pmc_free_temporary(interp, temp);
     return cur_opcode + 4;
 }
 
@@ -15918,7 +16301,7 @@ Parrot_le_s_sc_ic(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_le_p_p_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    if ((VTABLE_cmp(interp, PREG(1), PREG(2)) <= 0)) {
+    if ((pmc_cmp(interp, PREG(1), PREG(2)) <= 0)) {
         return cur_opcode + ICONST(3);
     }
 
@@ -15927,29 +16310,19 @@ Parrot_le_p_p_ic(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_le_p_i_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    PMC  * const  temp = Parrot_pmc_new_temporary(interp, enum_class_Integer);
-
-    VTABLE_set_integer_native(interp, temp, IREG(2));
-    if ((VTABLE_cmp(interp, PREG(1), temp) <= 0)) {
-        Parrot_pmc_free_temporary(interp, temp);
+    if ((pmc_cmp_int(interp, PREG(1), IREG(2)) <= 0)) {
         return cur_opcode + ICONST(3);
     }
 
-    Parrot_pmc_free_temporary(interp, temp);
     return cur_opcode + 4;
 }
 
 opcode_t *
 Parrot_le_p_ic_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    PMC  * const  temp = Parrot_pmc_new_temporary(interp, enum_class_Integer);
-
-    VTABLE_set_integer_native(interp, temp, ICONST(2));
-    if ((VTABLE_cmp(interp, PREG(1), temp) <= 0)) {
-        Parrot_pmc_free_temporary(interp, temp);
+    if ((pmc_cmp_int(interp, PREG(1), ICONST(2)) <= 0)) {
         return cur_opcode + ICONST(3);
     }
 
-    Parrot_pmc_free_temporary(interp, temp);
     return cur_opcode + 4;
 }
 
@@ -16009,7 +16382,7 @@ Parrot_le_num_p_p_ic(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_gt_p_p_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    if ((VTABLE_cmp(interp, PREG(1), PREG(2)) > 0)) {
+    if ((pmc_cmp(interp, PREG(1), PREG(2)) > 0)) {
         return cur_opcode + ICONST(3);
     }
 
@@ -16018,29 +16391,19 @@ Parrot_gt_p_p_ic(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_gt_p_i_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    PMC  * const  temp = Parrot_pmc_new_temporary(interp, enum_class_Integer);
-
-    VTABLE_set_integer_native(interp, temp, IREG(2));
-    if ((VTABLE_cmp(interp, PREG(1), temp) > 0)) {
-        Parrot_pmc_free_temporary(interp, temp);
+    if ((pmc_cmp_int(interp, PREG(1), IREG(2)) > 0)) {
         return cur_opcode + ICONST(3);
     }
 
-    Parrot_pmc_free_temporary(interp, temp);
     return cur_opcode + 4;
 }
 
 opcode_t *
 Parrot_gt_p_ic_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    PMC  * const  temp = Parrot_pmc_new_temporary(interp, enum_class_Integer);
-
-    VTABLE_set_integer_native(interp, temp, ICONST(2));
-    if ((VTABLE_cmp(interp, PREG(1), temp) > 0)) {
-        Parrot_pmc_free_temporary(interp, temp);
+    if ((pmc_cmp_int(interp, PREG(1), ICONST(2)) > 0)) {
         return cur_opcode + ICONST(3);
     }
 
-    Parrot_pmc_free_temporary(interp, temp);
     return cur_opcode + 4;
 }
 
@@ -16100,7 +16463,7 @@ Parrot_gt_num_p_p_ic(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_ge_p_p_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    if ((VTABLE_cmp(interp, PREG(1), PREG(2)) >= 0)) {
+    if ((pmc_cmp(interp, PREG(1), PREG(2)) >= 0)) {
         return cur_opcode + ICONST(3);
     }
 
@@ -16109,29 +16472,19 @@ Parrot_ge_p_p_ic(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_ge_p_i_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    PMC  * const  temp = Parrot_pmc_new_temporary(interp, enum_class_Integer);
-
-    VTABLE_set_integer_native(interp, temp, IREG(2));
-    if ((VTABLE_cmp(interp, PREG(1), temp) >= 0)) {
-        Parrot_pmc_free_temporary(interp, temp);
+    if ((pmc_cmp_int(interp, PREG(1), IREG(2)) >= 0)) {
         return cur_opcode + ICONST(3);
     }
 
-    Parrot_pmc_free_temporary(interp, temp);
     return cur_opcode + 4;
 }
 
 opcode_t *
 Parrot_ge_p_ic_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    PMC  * const  temp = Parrot_pmc_new_temporary(interp, enum_class_Integer);
-
-    VTABLE_set_integer_native(interp, temp, ICONST(2));
-    if ((VTABLE_cmp(interp, PREG(1), temp) >= 0)) {
-        Parrot_pmc_free_temporary(interp, temp);
+    if ((pmc_cmp_int(interp, PREG(1), ICONST(2)) >= 0)) {
         return cur_opcode + ICONST(3);
     }
 
-    Parrot_pmc_free_temporary(interp, temp);
     return cur_opcode + 4;
 }
 
@@ -16281,7 +16634,7 @@ Parrot_cmp_i_s_sc(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_cmp_i_p_p(opcode_t *cur_opcode, PARROT_INTERP) {
-    IREG(1) = VTABLE_cmp(interp, PREG(2), PREG(3));
+    IREG(1) = pmc_cmp(interp, PREG(2), PREG(3));
     return cur_opcode + 4;
 }
 
@@ -16462,13 +16815,13 @@ Parrot_isnull_i_sc(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_isgt_i_p_p(opcode_t *cur_opcode, PARROT_INTERP) {
-    IREG(1) = ((VTABLE_cmp(interp, PREG(2), PREG(3)) > 0));
+    IREG(1) = ((pmc_cmp(interp, PREG(2), PREG(3)) > 0));
     return cur_opcode + 4;
 }
 
 opcode_t *
 Parrot_isge_i_p_p(opcode_t *cur_opcode, PARROT_INTERP) {
-    IREG(1) = ((VTABLE_cmp(interp, PREG(2), PREG(3)) >= 0));
+    IREG(1) = ((pmc_cmp(interp, PREG(2), PREG(3)) >= 0));
     return cur_opcode + 4;
 }
 
@@ -16528,7 +16881,7 @@ Parrot_isle_i_s_sc(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_isle_i_p_p(opcode_t *cur_opcode, PARROT_INTERP) {
-    IREG(1) = ((VTABLE_cmp(interp, PREG(2), PREG(3)) <= 0));
+    IREG(1) = ((pmc_cmp(interp, PREG(2), PREG(3)) <= 0));
     return cur_opcode + 4;
 }
 
@@ -16588,7 +16941,7 @@ Parrot_islt_i_s_sc(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_islt_i_p_p(opcode_t *cur_opcode, PARROT_INTERP) {
-    IREG(1) = ((VTABLE_cmp(interp, PREG(2), PREG(3)) < 0));
+    IREG(1) = ((pmc_cmp(interp, PREG(2), PREG(3)) < 0));
     return cur_opcode + 4;
 }
 
@@ -16652,7 +17005,7 @@ Parrot_iseq_i_p_p(opcode_t *cur_opcode, PARROT_INTERP) {
         IREG(1) = 1;
     }
     else {
-        IREG(1) = VTABLE_is_equal(interp, PREG(2), PREG(3));
+        IREG(1) = pmc_is_equal(interp, PREG(2), PREG(3));
     }
 
     return cur_opcode + 4;
@@ -16718,7 +17071,7 @@ Parrot_isne_i_p_p(opcode_t *cur_opcode, PARROT_INTERP) {
         IREG(1) = 0;
     }
     else {
-        IREG(1) = (!VTABLE_is_equal(interp, PREG(2), PREG(3)));
+        IREG(1) = (!pmc_is_equal(interp, PREG(2), PREG(3)));
     }
 
     return cur_opcode + 4;
@@ -17176,31 +17529,46 @@ Parrot_add_n_nc(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_add_p_p(opcode_t *cur_opcode, PARROT_INTERP) {
-    VTABLE_i_add(interp, PREG(1), PREG(2));
+    if ((!plain_i_arith(interp, '+', PREG(1), PREG(2)))) {
+        VTABLE_i_add(interp, PREG(1), PREG(2));
+    }
+
     return cur_opcode + 3;
 }
 
 opcode_t *
 Parrot_add_p_i(opcode_t *cur_opcode, PARROT_INTERP) {
-    VTABLE_i_add_int(interp, PREG(1), IREG(2));
+    if ((!plain_i_arith_int(interp, '+', PREG(1), IREG(2)))) {
+        VTABLE_i_add_int(interp, PREG(1), IREG(2));
+    }
+
     return cur_opcode + 3;
 }
 
 opcode_t *
 Parrot_add_p_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    VTABLE_i_add_int(interp, PREG(1), ICONST(2));
+    if ((!plain_i_arith_int(interp, '+', PREG(1), ICONST(2)))) {
+        VTABLE_i_add_int(interp, PREG(1), ICONST(2));
+    }
+
     return cur_opcode + 3;
 }
 
 opcode_t *
 Parrot_add_p_n(opcode_t *cur_opcode, PARROT_INTERP) {
-    VTABLE_i_add_float(interp, PREG(1), NREG(2));
+    if ((!plain_i_arith_num(interp, '+', PREG(1), NREG(2)))) {
+        VTABLE_i_add_float(interp, PREG(1), NREG(2));
+    }
+
     return cur_opcode + 3;
 }
 
 opcode_t *
 Parrot_add_p_nc(opcode_t *cur_opcode, PARROT_INTERP) {
-    VTABLE_i_add_float(interp, PREG(1), NCONST(2));
+    if ((!plain_i_arith_num(interp, '+', PREG(1), NCONST(2)))) {
+        VTABLE_i_add_float(interp, PREG(1), NCONST(2));
+    }
+
     return cur_opcode + 3;
 }
 
@@ -17242,31 +17610,41 @@ Parrot_add_n_n_nc(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_add_p_p_p(opcode_t *cur_opcode, PARROT_INTERP) {
-    PREG(1) = VTABLE_add(interp, PREG(2), PREG(3), PREG(1));
+    PMC  * const  result = plain_arith(interp, '+', PREG(2), PREG(3));
+
+    PREG(1) = result ? result : VTABLE_add(interp, PREG(2), PREG(3), PREG(1));
     return cur_opcode + 4;
 }
 
 opcode_t *
 Parrot_add_p_p_i(opcode_t *cur_opcode, PARROT_INTERP) {
-    PREG(1) = VTABLE_add_int(interp, PREG(2), IREG(3), PREG(1));
+    PMC  * const  result = plain_arith_int(interp, '+', PREG(2), IREG(3));
+
+    PREG(1) = result ? result : VTABLE_add_int(interp, PREG(2), IREG(3), PREG(1));
     return cur_opcode + 4;
 }
 
 opcode_t *
 Parrot_add_p_p_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    PREG(1) = VTABLE_add_int(interp, PREG(2), ICONST(3), PREG(1));
+    PMC  * const  result = plain_arith_int(interp, '+', PREG(2), ICONST(3));
+
+    PREG(1) = result ? result : VTABLE_add_int(interp, PREG(2), ICONST(3), PREG(1));
     return cur_opcode + 4;
 }
 
 opcode_t *
 Parrot_add_p_p_n(opcode_t *cur_opcode, PARROT_INTERP) {
-    PREG(1) = VTABLE_add_float(interp, PREG(2), NREG(3), PREG(1));
+    PMC  * const  result = plain_arith_num(interp, '+', PREG(2), NREG(3));
+
+    PREG(1) = result ? result : VTABLE_add_float(interp, PREG(2), NREG(3), PREG(1));
     return cur_opcode + 4;
 }
 
 opcode_t *
 Parrot_add_p_p_nc(opcode_t *cur_opcode, PARROT_INTERP) {
-    PREG(1) = VTABLE_add_float(interp, PREG(2), NCONST(3), PREG(1));
+    PMC  * const  result = plain_arith_num(interp, '+', PREG(2), NCONST(3));
+
+    PREG(1) = result ? result : VTABLE_add_float(interp, PREG(2), NCONST(3), PREG(1));
     return cur_opcode + 4;
 }
 
@@ -17284,7 +17662,10 @@ Parrot_dec_n(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_dec_p(opcode_t *cur_opcode, PARROT_INTERP) {
-    VTABLE_decrement(interp, PREG(1));
+    if ((!plain_i_arith_int(interp, '-', PREG(1), 1))) {
+        VTABLE_decrement(interp, PREG(1));
+    }
+
     return cur_opcode + 2;
 }
 
@@ -17780,7 +18161,10 @@ Parrot_inc_n(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_inc_p(opcode_t *cur_opcode, PARROT_INTERP) {
-    VTABLE_increment(interp, PREG(1));
+    if ((!plain_i_arith_int(interp, '+', PREG(1), 1))) {
+        VTABLE_increment(interp, PREG(1));
+    }
+
     return cur_opcode + 2;
 }
 
@@ -17930,31 +18314,46 @@ Parrot_mul_n_nc(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_mul_p_p(opcode_t *cur_opcode, PARROT_INTERP) {
-    VTABLE_i_multiply(interp, PREG(1), PREG(2));
+    if ((!plain_i_arith(interp, '*', PREG(1), PREG(2)))) {
+        VTABLE_i_multiply(interp, PREG(1), PREG(2));
+    }
+
     return cur_opcode + 3;
 }
 
 opcode_t *
 Parrot_mul_p_i(opcode_t *cur_opcode, PARROT_INTERP) {
-    VTABLE_i_multiply_int(interp, PREG(1), IREG(2));
+    if ((!plain_i_arith_int(interp, '*', PREG(1), IREG(2)))) {
+        VTABLE_i_multiply_int(interp, PREG(1), IREG(2));
+    }
+
     return cur_opcode + 3;
 }
 
 opcode_t *
 Parrot_mul_p_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    VTABLE_i_multiply_int(interp, PREG(1), ICONST(2));
+    if ((!plain_i_arith_int(interp, '*', PREG(1), ICONST(2)))) {
+        VTABLE_i_multiply_int(interp, PREG(1), ICONST(2));
+    }
+
     return cur_opcode + 3;
 }
 
 opcode_t *
 Parrot_mul_p_n(opcode_t *cur_opcode, PARROT_INTERP) {
-    VTABLE_i_multiply_float(interp, PREG(1), NREG(2));
+    if ((!plain_i_arith_num(interp, '*', PREG(1), NREG(2)))) {
+        VTABLE_i_multiply_float(interp, PREG(1), NREG(2));
+    }
+
     return cur_opcode + 3;
 }
 
 opcode_t *
 Parrot_mul_p_nc(opcode_t *cur_opcode, PARROT_INTERP) {
-    VTABLE_i_multiply_float(interp, PREG(1), NCONST(2));
+    if ((!plain_i_arith_num(interp, '*', PREG(1), NCONST(2)))) {
+        VTABLE_i_multiply_float(interp, PREG(1), NCONST(2));
+    }
+
     return cur_opcode + 3;
 }
 
@@ -17996,31 +18395,41 @@ Parrot_mul_n_n_nc(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_mul_p_p_p(opcode_t *cur_opcode, PARROT_INTERP) {
-    PREG(1) = VTABLE_multiply(interp, PREG(2), PREG(3), PREG(1));
+    PMC  * const  result = plain_arith(interp, '*', PREG(2), PREG(3));
+
+    PREG(1) = result ? result : VTABLE_multiply(interp, PREG(2), PREG(3), PREG(1));
     return cur_opcode + 4;
 }
 
 opcode_t *
 Parrot_mul_p_p_i(opcode_t *cur_opcode, PARROT_INTERP) {
-    PREG(1) = VTABLE_multiply_int(interp, PREG(2), IREG(3), PREG(1));
+    PMC  * const  result = plain_arith_int(interp, '*', PREG(2), IREG(3));
+
+    PREG(1) = result ? result : VTABLE_multiply_int(interp, PREG(2), IREG(3), PREG(1));
     return cur_opcode + 4;
 }
 
 opcode_t *
 Parrot_mul_p_p_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    PREG(1) = VTABLE_multiply_int(interp, PREG(2), ICONST(3), PREG(1));
+    PMC  * const  result = plain_arith_int(interp, '*', PREG(2), ICONST(3));
+
+    PREG(1) = result ? result : VTABLE_multiply_int(interp, PREG(2), ICONST(3), PREG(1));
     return cur_opcode + 4;
 }
 
 opcode_t *
 Parrot_mul_p_p_n(opcode_t *cur_opcode, PARROT_INTERP) {
-    PREG(1) = VTABLE_multiply_float(interp, PREG(2), NREG(3), PREG(1));
+    PMC  * const  result = plain_arith_num(interp, '*', PREG(2), NREG(3));
+
+    PREG(1) = result ? result : VTABLE_multiply_float(interp, PREG(2), NREG(3), PREG(1));
     return cur_opcode + 4;
 }
 
 opcode_t *
 Parrot_mul_p_p_nc(opcode_t *cur_opcode, PARROT_INTERP) {
-    PREG(1) = VTABLE_multiply_float(interp, PREG(2), NCONST(3), PREG(1));
+    PMC  * const  result = plain_arith_num(interp, '*', PREG(2), NCONST(3));
+
+    PREG(1) = result ? result : VTABLE_multiply_float(interp, PREG(2), NCONST(3), PREG(1));
     return cur_opcode + 4;
 }
 
@@ -18087,31 +18496,46 @@ Parrot_sub_n_nc(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_sub_p_p(opcode_t *cur_opcode, PARROT_INTERP) {
-    VTABLE_i_subtract(interp, PREG(1), PREG(2));
+    if ((!plain_i_arith(interp, '-', PREG(1), PREG(2)))) {
+        VTABLE_i_subtract(interp, PREG(1), PREG(2));
+    }
+
     return cur_opcode + 3;
 }
 
 opcode_t *
 Parrot_sub_p_i(opcode_t *cur_opcode, PARROT_INTERP) {
-    VTABLE_i_subtract_int(interp, PREG(1), IREG(2));
+    if ((!plain_i_arith_int(interp, '-', PREG(1), IREG(2)))) {
+        VTABLE_i_subtract_int(interp, PREG(1), IREG(2));
+    }
+
     return cur_opcode + 3;
 }
 
 opcode_t *
 Parrot_sub_p_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    VTABLE_i_subtract_int(interp, PREG(1), ICONST(2));
+    if ((!plain_i_arith_int(interp, '-', PREG(1), ICONST(2)))) {
+        VTABLE_i_subtract_int(interp, PREG(1), ICONST(2));
+    }
+
     return cur_opcode + 3;
 }
 
 opcode_t *
 Parrot_sub_p_n(opcode_t *cur_opcode, PARROT_INTERP) {
-    VTABLE_i_subtract_float(interp, PREG(1), NREG(2));
+    if ((!plain_i_arith_num(interp, '-', PREG(1), NREG(2)))) {
+        VTABLE_i_subtract_float(interp, PREG(1), NREG(2));
+    }
+
     return cur_opcode + 3;
 }
 
 opcode_t *
 Parrot_sub_p_nc(opcode_t *cur_opcode, PARROT_INTERP) {
-    VTABLE_i_subtract_float(interp, PREG(1), NCONST(2));
+    if ((!plain_i_arith_num(interp, '-', PREG(1), NCONST(2)))) {
+        VTABLE_i_subtract_float(interp, PREG(1), NCONST(2));
+    }
+
     return cur_opcode + 3;
 }
 
@@ -18153,31 +18577,41 @@ Parrot_sub_n_n_nc(opcode_t *cur_opcode, PARROT_INTERP) {
 
 opcode_t *
 Parrot_sub_p_p_p(opcode_t *cur_opcode, PARROT_INTERP) {
-    PREG(1) = VTABLE_subtract(interp, PREG(2), PREG(3), PREG(1));
+    PMC  * const  result = plain_arith(interp, '-', PREG(2), PREG(3));
+
+    PREG(1) = result ? result : VTABLE_subtract(interp, PREG(2), PREG(3), PREG(1));
     return cur_opcode + 4;
 }
 
 opcode_t *
 Parrot_sub_p_p_i(opcode_t *cur_opcode, PARROT_INTERP) {
-    PREG(1) = VTABLE_subtract_int(interp, PREG(2), IREG(3), PREG(1));
+    PMC  * const  result = plain_arith_int(interp, '-', PREG(2), IREG(3));
+
+    PREG(1) = result ? result : VTABLE_subtract_int(interp, PREG(2), IREG(3), PREG(1));
     return cur_opcode + 4;
 }
 
 opcode_t *
 Parrot_sub_p_p_ic(opcode_t *cur_opcode, PARROT_INTERP) {
-    PREG(1) = VTABLE_subtract_int(interp, PREG(2), ICONST(3), PREG(1));
+    PMC  * const  result = plain_arith_int(interp, '-', PREG(2), ICONST(3));
+
+    PREG(1) = result ? result : VTABLE_subtract_int(interp, PREG(2), ICONST(3), PREG(1));
     return cur_opcode + 4;
 }
 
 opcode_t *
 Parrot_sub_p_p_n(opcode_t *cur_opcode, PARROT_INTERP) {
-    PREG(1) = VTABLE_subtract_float(interp, PREG(2), NREG(3), PREG(1));
+    PMC  * const  result = plain_arith_num(interp, '-', PREG(2), NREG(3));
+
+    PREG(1) = result ? result : VTABLE_subtract_float(interp, PREG(2), NREG(3), PREG(1));
     return cur_opcode + 4;
 }
 
 opcode_t *
 Parrot_sub_p_p_nc(opcode_t *cur_opcode, PARROT_INTERP) {
-    PREG(1) = VTABLE_subtract_float(interp, PREG(2), NCONST(3), PREG(1));
+    PMC  * const  result = plain_arith_num(interp, '-', PREG(2), NCONST(3));
+
+    PREG(1) = result ? result : VTABLE_subtract_float(interp, PREG(2), NCONST(3), PREG(1));
     return cur_opcode + 4;
 }
 
@@ -22686,7 +23120,7 @@ opcode_t *
 Parrot_get_global_p_s(opcode_t *cur_opcode, PARROT_INTERP) {
     PMC  * const  cur_ns = Parrot_pcc_get_namespace(interp, CURRENT_CONTEXT(interp));
 
-    PREG(1) = Parrot_ns_find_global_from_op(interp, cur_ns, SREG(2),  cur_opcode + 3);
+    PREG(1) = Parrot_ns_find_global_cached(interp, cur_ns, NULL, SREG(2), cur_opcode,  cur_opcode + 3);
     PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
     return cur_opcode + 3;
 }
@@ -22695,7 +23129,7 @@ opcode_t *
 Parrot_get_global_p_sc(opcode_t *cur_opcode, PARROT_INTERP) {
     PMC  * const  cur_ns = Parrot_pcc_get_namespace(interp, CURRENT_CONTEXT(interp));
 
-    PREG(1) = Parrot_ns_find_global_from_op(interp, cur_ns, SCONST(2),  cur_opcode + 3);
+    PREG(1) = Parrot_ns_find_global_cached(interp, cur_ns, NULL, SCONST(2), cur_opcode,  cur_opcode + 3);
     PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
     return cur_opcode + 3;
 }
@@ -22704,21 +23138,7 @@ opcode_t *
 Parrot_get_global_p_p_s(opcode_t *cur_opcode, PARROT_INTERP) {
     PMC  * const  cur_ns = Parrot_pcc_get_namespace(interp, CURRENT_CONTEXT(interp));
 
-    if (PMC_IS_NULL(cur_ns)) {
-        PREG(1) = PMCNULL;
-    }
-    else {
-        PMC  * const  ns = Parrot_ns_get_namespace_keyed(interp, cur_ns, PREG(2));
-
-        if (PMC_IS_NULL(ns)) {
-            PREG(1) = PMCNULL;
-        }
-        else {
-            PREG(1) = Parrot_ns_find_global_from_op(interp, ns, SREG(3),  cur_opcode + 4);
-        }
-
-    }
-
+    PREG(1) = Parrot_ns_find_global_cached(interp, cur_ns, PREG(2), SREG(3), cur_opcode,  cur_opcode + 4);
     PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
     return cur_opcode + 4;
 }
@@ -22727,21 +23147,7 @@ opcode_t *
 Parrot_get_global_p_pc_s(opcode_t *cur_opcode, PARROT_INTERP) {
     PMC  * const  cur_ns = Parrot_pcc_get_namespace(interp, CURRENT_CONTEXT(interp));
 
-    if (PMC_IS_NULL(cur_ns)) {
-        PREG(1) = PMCNULL;
-    }
-    else {
-        PMC  * const  ns = Parrot_ns_get_namespace_keyed(interp, cur_ns, PCONST(2));
-
-        if (PMC_IS_NULL(ns)) {
-            PREG(1) = PMCNULL;
-        }
-        else {
-            PREG(1) = Parrot_ns_find_global_from_op(interp, ns, SREG(3),  cur_opcode + 4);
-        }
-
-    }
-
+    PREG(1) = Parrot_ns_find_global_cached(interp, cur_ns, PCONST(2), SREG(3), cur_opcode,  cur_opcode + 4);
     PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
     return cur_opcode + 4;
 }
@@ -22750,21 +23156,7 @@ opcode_t *
 Parrot_get_global_p_p_sc(opcode_t *cur_opcode, PARROT_INTERP) {
     PMC  * const  cur_ns = Parrot_pcc_get_namespace(interp, CURRENT_CONTEXT(interp));
 
-    if (PMC_IS_NULL(cur_ns)) {
-        PREG(1) = PMCNULL;
-    }
-    else {
-        PMC  * const  ns = Parrot_ns_get_namespace_keyed(interp, cur_ns, PREG(2));
-
-        if (PMC_IS_NULL(ns)) {
-            PREG(1) = PMCNULL;
-        }
-        else {
-            PREG(1) = Parrot_ns_find_global_from_op(interp, ns, SCONST(3),  cur_opcode + 4);
-        }
-
-    }
-
+    PREG(1) = Parrot_ns_find_global_cached(interp, cur_ns, PREG(2), SCONST(3), cur_opcode,  cur_opcode + 4);
     PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
     return cur_opcode + 4;
 }
@@ -22773,21 +23165,7 @@ opcode_t *
 Parrot_get_global_p_pc_sc(opcode_t *cur_opcode, PARROT_INTERP) {
     PMC  * const  cur_ns = Parrot_pcc_get_namespace(interp, CURRENT_CONTEXT(interp));
 
-    if (PMC_IS_NULL(cur_ns)) {
-        PREG(1) = PMCNULL;
-    }
-    else {
-        PMC  * const  ns = Parrot_ns_get_namespace_keyed(interp, cur_ns, PCONST(2));
-
-        if (PMC_IS_NULL(ns)) {
-            PREG(1) = PMCNULL;
-        }
-        else {
-            PREG(1) = Parrot_ns_find_global_from_op(interp, ns, SCONST(3),  cur_opcode + 4);
-        }
-
-    }
-
+    PREG(1) = Parrot_ns_find_global_cached(interp, cur_ns, PCONST(2), SCONST(3), cur_opcode,  cur_opcode + 4);
     PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
     return cur_opcode + 4;
 }
@@ -22796,7 +23174,7 @@ opcode_t *
 Parrot_get_hll_global_p_s(opcode_t *cur_opcode, PARROT_INTERP) {
     PMC  * const  hll_ns = Parrot_hll_get_ctx_HLL_namespace(interp);
 
-    PREG(1) = Parrot_ns_find_global_from_op(interp, hll_ns, SREG(2),  cur_opcode + 3);
+    PREG(1) = Parrot_ns_find_global_cached(interp, hll_ns, NULL, SREG(2), cur_opcode,  cur_opcode + 3);
     PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
     return cur_opcode + 3;
 }
@@ -22805,7 +23183,7 @@ opcode_t *
 Parrot_get_hll_global_p_sc(opcode_t *cur_opcode, PARROT_INTERP) {
     PMC  * const  hll_ns = Parrot_hll_get_ctx_HLL_namespace(interp);
 
-    PREG(1) = Parrot_ns_find_global_from_op(interp, hll_ns, SCONST(2),  cur_opcode + 3);
+    PREG(1) = Parrot_ns_find_global_cached(interp, hll_ns, NULL, SCONST(2), cur_opcode,  cur_opcode + 3);
     PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
     return cur_opcode + 3;
 }
@@ -22814,21 +23192,7 @@ opcode_t *
 Parrot_get_hll_global_p_p_s(opcode_t *cur_opcode, PARROT_INTERP) {
     PMC  * const  hll_ns = Parrot_hll_get_ctx_HLL_namespace(interp);
 
-    if (PMC_IS_NULL(hll_ns)) {
-        PREG(1) = hll_ns;
-    }
-    else {
-        PMC  * const  ns = Parrot_ns_get_namespace_keyed(interp, hll_ns, PREG(2));
-
-        if (PMC_IS_NULL(ns)) {
-            PREG(1) = PMCNULL;
-        }
-        else {
-            PREG(1) = Parrot_ns_find_global_from_op(interp, ns, SREG(3),  cur_opcode + 4);
-        }
-
-    }
-
+    PREG(1) = Parrot_ns_find_global_cached(interp, hll_ns, PREG(2), SREG(3), cur_opcode,  cur_opcode + 4);
     PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
     return cur_opcode + 4;
 }
@@ -22837,21 +23201,7 @@ opcode_t *
 Parrot_get_hll_global_p_pc_s(opcode_t *cur_opcode, PARROT_INTERP) {
     PMC  * const  hll_ns = Parrot_hll_get_ctx_HLL_namespace(interp);
 
-    if (PMC_IS_NULL(hll_ns)) {
-        PREG(1) = hll_ns;
-    }
-    else {
-        PMC  * const  ns = Parrot_ns_get_namespace_keyed(interp, hll_ns, PCONST(2));
-
-        if (PMC_IS_NULL(ns)) {
-            PREG(1) = PMCNULL;
-        }
-        else {
-            PREG(1) = Parrot_ns_find_global_from_op(interp, ns, SREG(3),  cur_opcode + 4);
-        }
-
-    }
-
+    PREG(1) = Parrot_ns_find_global_cached(interp, hll_ns, PCONST(2), SREG(3), cur_opcode,  cur_opcode + 4);
     PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
     return cur_opcode + 4;
 }
@@ -22860,21 +23210,7 @@ opcode_t *
 Parrot_get_hll_global_p_p_sc(opcode_t *cur_opcode, PARROT_INTERP) {
     PMC  * const  hll_ns = Parrot_hll_get_ctx_HLL_namespace(interp);
 
-    if (PMC_IS_NULL(hll_ns)) {
-        PREG(1) = hll_ns;
-    }
-    else {
-        PMC  * const  ns = Parrot_ns_get_namespace_keyed(interp, hll_ns, PREG(2));
-
-        if (PMC_IS_NULL(ns)) {
-            PREG(1) = PMCNULL;
-        }
-        else {
-            PREG(1) = Parrot_ns_find_global_from_op(interp, ns, SCONST(3),  cur_opcode + 4);
-        }
-
-    }
-
+    PREG(1) = Parrot_ns_find_global_cached(interp, hll_ns, PREG(2), SCONST(3), cur_opcode,  cur_opcode + 4);
     PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
     return cur_opcode + 4;
 }
@@ -22883,21 +23219,7 @@ opcode_t *
 Parrot_get_hll_global_p_pc_sc(opcode_t *cur_opcode, PARROT_INTERP) {
     PMC  * const  hll_ns = Parrot_hll_get_ctx_HLL_namespace(interp);
 
-    if (PMC_IS_NULL(hll_ns)) {
-        PREG(1) = hll_ns;
-    }
-    else {
-        PMC  * const  ns = Parrot_ns_get_namespace_keyed(interp, hll_ns, PCONST(2));
-
-        if (PMC_IS_NULL(ns)) {
-            PREG(1) = PMCNULL;
-        }
-        else {
-            PREG(1) = Parrot_ns_find_global_from_op(interp, ns, SCONST(3),  cur_opcode + 4);
-        }
-
-    }
-
+    PREG(1) = Parrot_ns_find_global_cached(interp, hll_ns, PCONST(2), SCONST(3), cur_opcode,  cur_opcode + 4);
     PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
     return cur_opcode + 4;
 }
@@ -22906,7 +23228,7 @@ opcode_t *
 Parrot_get_root_global_p_s(opcode_t *cur_opcode, PARROT_INTERP) {
     PMC  * const  root_ns = interp->root_namespace;
 
-    PREG(1) = Parrot_ns_find_global_from_op(interp, root_ns, SREG(2),  cur_opcode + 3);
+    PREG(1) = Parrot_ns_find_global_cached(interp, root_ns, NULL, SREG(2), cur_opcode,  cur_opcode + 3);
     PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
     return cur_opcode + 3;
 }
@@ -22915,7 +23237,7 @@ opcode_t *
 Parrot_get_root_global_p_sc(opcode_t *cur_opcode, PARROT_INTERP) {
     PMC  * const  root_ns = interp->root_namespace;
 
-    PREG(1) = Parrot_ns_find_global_from_op(interp, root_ns, SCONST(2),  cur_opcode + 3);
+    PREG(1) = Parrot_ns_find_global_cached(interp, root_ns, NULL, SCONST(2), cur_opcode,  cur_opcode + 3);
     PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
     return cur_opcode + 3;
 }
@@ -22924,21 +23246,7 @@ opcode_t *
 Parrot_get_root_global_p_p_s(opcode_t *cur_opcode, PARROT_INTERP) {
     PMC  * const  root_ns = interp->root_namespace;
 
-    if (PMC_IS_NULL(root_ns)) {
-        PREG(1) = PMCNULL;
-    }
-    else {
-        PMC  * const  ns = Parrot_ns_get_namespace_keyed(interp, root_ns, PREG(2));
-
-        if (PMC_IS_NULL(ns)) {
-            PREG(1) = PMCNULL;
-        }
-        else {
-            PREG(1) = Parrot_ns_find_global_from_op(interp, ns, SREG(3),  cur_opcode + 4);
-        }
-
-    }
-
+    PREG(1) = Parrot_ns_find_global_cached(interp, root_ns, PREG(2), SREG(3), cur_opcode,  cur_opcode + 4);
     PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
     return cur_opcode + 4;
 }
@@ -22947,21 +23255,7 @@ opcode_t *
 Parrot_get_root_global_p_pc_s(opcode_t *cur_opcode, PARROT_INTERP) {
     PMC  * const  root_ns = interp->root_namespace;
 
-    if (PMC_IS_NULL(root_ns)) {
-        PREG(1) = PMCNULL;
-    }
-    else {
-        PMC  * const  ns = Parrot_ns_get_namespace_keyed(interp, root_ns, PCONST(2));
-
-        if (PMC_IS_NULL(ns)) {
-            PREG(1) = PMCNULL;
-        }
-        else {
-            PREG(1) = Parrot_ns_find_global_from_op(interp, ns, SREG(3),  cur_opcode + 4);
-        }
-
-    }
-
+    PREG(1) = Parrot_ns_find_global_cached(interp, root_ns, PCONST(2), SREG(3), cur_opcode,  cur_opcode + 4);
     PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
     return cur_opcode + 4;
 }
@@ -22970,21 +23264,7 @@ opcode_t *
 Parrot_get_root_global_p_p_sc(opcode_t *cur_opcode, PARROT_INTERP) {
     PMC  * const  root_ns = interp->root_namespace;
 
-    if (PMC_IS_NULL(root_ns)) {
-        PREG(1) = PMCNULL;
-    }
-    else {
-        PMC  * const  ns = Parrot_ns_get_namespace_keyed(interp, root_ns, PREG(2));
-
-        if (PMC_IS_NULL(ns)) {
-            PREG(1) = PMCNULL;
-        }
-        else {
-            PREG(1) = Parrot_ns_find_global_from_op(interp, ns, SCONST(3),  cur_opcode + 4);
-        }
-
-    }
-
+    PREG(1) = Parrot_ns_find_global_cached(interp, root_ns, PREG(2), SCONST(3), cur_opcode,  cur_opcode + 4);
     PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
     return cur_opcode + 4;
 }
@@ -22993,21 +23273,7 @@ opcode_t *
 Parrot_get_root_global_p_pc_sc(opcode_t *cur_opcode, PARROT_INTERP) {
     PMC  * const  root_ns = interp->root_namespace;
 
-    if (PMC_IS_NULL(root_ns)) {
-        PREG(1) = PMCNULL;
-    }
-    else {
-        PMC  * const  ns = Parrot_ns_get_namespace_keyed(interp, root_ns, PCONST(2));
-
-        if (PMC_IS_NULL(ns)) {
-            PREG(1) = PMCNULL;
-        }
-        else {
-            PREG(1) = Parrot_ns_find_global_from_op(interp, ns, SCONST(3),  cur_opcode + 4);
-        }
-
-    }
-
+    PREG(1) = Parrot_ns_find_global_cached(interp, root_ns, PCONST(2), SCONST(3), cur_opcode,  cur_opcode + 4);
     PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
     return cur_opcode + 4;
 }
@@ -24429,6 +24695,198 @@ Parrot_pass(opcode_t *cur_opcode, PARROT_INTERP) {
     return cur_opcode + 1;
 }
 
+opcode_t *
+Parrot_find_lex_slot_p_ic_ic(opcode_t *cur_opcode, PARROT_INTERP) {
+    PMC  * const  ctx = Parrot_sub_find_lex_ctx(interp, CURRENT_CONTEXT(interp), ICONST(2), ICONST(3), REGNO_PMC);
+
+    PREG(1) = PMC_IS_NULL(ctx) ? PMCNULL : CTX_REG_PMC(interp, ctx, ICONST(3));
+    PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
+    return cur_opcode + 4;
+}
+
+opcode_t *
+Parrot_find_lex_slot_s_ic_ic(opcode_t *cur_opcode, PARROT_INTERP) {
+    PMC  * const  ctx = Parrot_sub_find_lex_ctx(interp, CURRENT_CONTEXT(interp), ICONST(2), ICONST(3), REGNO_STR);
+
+    SREG(1) = PMC_IS_NULL(ctx) ? STRINGNULL : CTX_REG_STR(interp, ctx, ICONST(3));
+    PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
+    return cur_opcode + 4;
+}
+
+opcode_t *
+Parrot_find_lex_slot_i_ic_ic(opcode_t *cur_opcode, PARROT_INTERP) {
+    PMC  * const  ctx = Parrot_sub_find_lex_ctx(interp, CURRENT_CONTEXT(interp), ICONST(2), ICONST(3), REGNO_INT);
+
+    IREG(1) = PMC_IS_NULL(ctx) ? 0 : CTX_REG_INT(interp, ctx, ICONST(3));
+    return cur_opcode + 4;
+}
+
+opcode_t *
+Parrot_find_lex_slot_n_ic_ic(opcode_t *cur_opcode, PARROT_INTERP) {
+    PMC  * const  ctx = Parrot_sub_find_lex_ctx(interp, CURRENT_CONTEXT(interp), ICONST(2), ICONST(3), REGNO_NUM);
+
+    NREG(1) = PMC_IS_NULL(ctx) ? 0.0 : CTX_REG_NUM(interp, ctx, ICONST(3));
+    return cur_opcode + 4;
+}
+
+opcode_t *
+Parrot_store_lex_slot_ic_ic_p(opcode_t *cur_opcode, PARROT_INTERP) {
+    PMC  * const  ctx = Parrot_sub_find_lex_ctx(interp, CURRENT_CONTEXT(interp), ICONST(1), ICONST(2), REGNO_PMC);
+
+    if (PMC_IS_NULL(ctx)) {
+        opcode_t  * const  handler = Parrot_ex_throw_from_op_args(interp, NULL, EXCEPTION_LEX_NOT_FOUND, "Lexical slot %d at depth %d not found", ICONST(2), ICONST(1));
+
+        return (opcode_t *)handler;
+    }
+
+    CTX_REG_PMC(interp, ctx, ICONST(2)) = PREG(3);
+    PARROT_GC_WRITE_BARRIER(interp, ctx);
+    return cur_opcode + 4;
+}
+
+opcode_t *
+Parrot_store_lex_slot_ic_ic_s(opcode_t *cur_opcode, PARROT_INTERP) {
+    PMC  * const  ctx = Parrot_sub_find_lex_ctx(interp, CURRENT_CONTEXT(interp), ICONST(1), ICONST(2), REGNO_STR);
+
+    if (PMC_IS_NULL(ctx)) {
+        opcode_t  * const  handler = Parrot_ex_throw_from_op_args(interp, NULL, EXCEPTION_LEX_NOT_FOUND, "Lexical slot %d at depth %d not found", ICONST(2), ICONST(1));
+
+        return (opcode_t *)handler;
+    }
+
+    CTX_REG_STR(interp, ctx, ICONST(2)) = SREG(3);
+    PARROT_GC_WRITE_BARRIER(interp, ctx);
+    return cur_opcode + 4;
+}
+
+opcode_t *
+Parrot_store_lex_slot_ic_ic_sc(opcode_t *cur_opcode, PARROT_INTERP) {
+    PMC  * const  ctx = Parrot_sub_find_lex_ctx(interp, CURRENT_CONTEXT(interp), ICONST(1), ICONST(2), REGNO_STR);
+
+    if (PMC_IS_NULL(ctx)) {
+        opcode_t  * const  handler = Parrot_ex_throw_from_op_args(interp, NULL, EXCEPTION_LEX_NOT_FOUND, "Lexical slot %d at depth %d not found", ICONST(2), ICONST(1));
+
+        return (opcode_t *)handler;
+    }
+
+    CTX_REG_STR(interp, ctx, ICONST(2)) = SCONST(3);
+    PARROT_GC_WRITE_BARRIER(interp, ctx);
+    return cur_opcode + 4;
+}
+
+opcode_t *
+Parrot_store_lex_slot_ic_ic_i(opcode_t *cur_opcode, PARROT_INTERP) {
+    PMC  * const  ctx = Parrot_sub_find_lex_ctx(interp, CURRENT_CONTEXT(interp), ICONST(1), ICONST(2), REGNO_INT);
+
+    if (PMC_IS_NULL(ctx)) {
+        opcode_t  * const  handler = Parrot_ex_throw_from_op_args(interp, NULL, EXCEPTION_LEX_NOT_FOUND, "Lexical slot %d at depth %d not found", ICONST(2), ICONST(1));
+
+        return (opcode_t *)handler;
+    }
+
+    CTX_REG_INT(interp, ctx, ICONST(2)) = IREG(3);
+    return cur_opcode + 4;
+}
+
+opcode_t *
+Parrot_store_lex_slot_ic_ic_ic(opcode_t *cur_opcode, PARROT_INTERP) {
+    PMC  * const  ctx = Parrot_sub_find_lex_ctx(interp, CURRENT_CONTEXT(interp), ICONST(1), ICONST(2), REGNO_INT);
+
+    if (PMC_IS_NULL(ctx)) {
+        opcode_t  * const  handler = Parrot_ex_throw_from_op_args(interp, NULL, EXCEPTION_LEX_NOT_FOUND, "Lexical slot %d at depth %d not found", ICONST(2), ICONST(1));
+
+        return (opcode_t *)handler;
+    }
+
+    CTX_REG_INT(interp, ctx, ICONST(2)) = ICONST(3);
+    return cur_opcode + 4;
+}
+
+opcode_t *
+Parrot_store_lex_slot_ic_ic_n(opcode_t *cur_opcode, PARROT_INTERP) {
+    PMC  * const  ctx = Parrot_sub_find_lex_ctx(interp, CURRENT_CONTEXT(interp), ICONST(1), ICONST(2), REGNO_NUM);
+
+    if (PMC_IS_NULL(ctx)) {
+        opcode_t  * const  handler = Parrot_ex_throw_from_op_args(interp, NULL, EXCEPTION_LEX_NOT_FOUND, "Lexical slot %d at depth %d not found", ICONST(2), ICONST(1));
+
+        return (opcode_t *)handler;
+    }
+
+    CTX_REG_NUM(interp, ctx, ICONST(2)) = NREG(3);
+    return cur_opcode + 4;
+}
+
+opcode_t *
+Parrot_store_lex_slot_ic_ic_nc(opcode_t *cur_opcode, PARROT_INTERP) {
+    PMC  * const  ctx = Parrot_sub_find_lex_ctx(interp, CURRENT_CONTEXT(interp), ICONST(1), ICONST(2), REGNO_NUM);
+
+    if (PMC_IS_NULL(ctx)) {
+        opcode_t  * const  handler = Parrot_ex_throw_from_op_args(interp, NULL, EXCEPTION_LEX_NOT_FOUND, "Lexical slot %d at depth %d not found", ICONST(2), ICONST(1));
+
+        return (opcode_t *)handler;
+    }
+
+    CTX_REG_NUM(interp, ctx, ICONST(2)) = NCONST(3);
+    return cur_opcode + 4;
+}
+
+opcode_t *
+Parrot_renew_p_sc(opcode_t *cur_opcode, PARROT_INTERP) {
+    STRING  * const  name = SCONST(2);
+    PMC     * const  _class = Parrot_pcc_get_HLL(interp, CURRENT_CONTEXT(interp)) ? Parrot_oo_get_class_str(interp, name) : PMCNULL;
+
+    if ((!PMC_IS_NULL(_class))) {
+        PREG(1) = VTABLE_instantiate(interp, _class, PMCNULL);
+    }
+    else {
+        const INTVAL   type = Parrot_pmc_get_type_str(interp, name);
+
+        if ((type <= 0)) {
+            opcode_t  * const  dest = Parrot_ex_throw_from_op_args(interp,  cur_opcode + 3, EXCEPTION_NO_CLASS, "Class '%Ss' not found", name);
+
+            PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
+            return (opcode_t *)dest;
+        }
+
+        PREG(1) = Parrot_pmc_renew(interp, PREG(1), type);
+    }
+
+    PARROT_GC_WRITE_BARRIER(interp, CURRENT_CONTEXT(interp));
+    return cur_opcode + 3;
+}
+
+opcode_t *
+Parrot_throw_control_i(opcode_t *cur_opcode, PARROT_INTERP) {
+    PMC       * const  except = Parrot_ex_build_control_exception(interp, IREG(1), PMCNULL);
+    opcode_t  * const  dest = Parrot_ex_throw_from_op(interp, except,  cur_opcode + 2);
+
+    return (opcode_t *)dest;
+}
+
+opcode_t *
+Parrot_throw_control_ic(opcode_t *cur_opcode, PARROT_INTERP) {
+    PMC       * const  except = Parrot_ex_build_control_exception(interp, ICONST(1), PMCNULL);
+    opcode_t  * const  dest = Parrot_ex_throw_from_op(interp, except,  cur_opcode + 2);
+
+    return (opcode_t *)dest;
+}
+
+opcode_t *
+Parrot_throw_control_i_p(opcode_t *cur_opcode, PARROT_INTERP) {
+    PMC       * const  except = Parrot_ex_build_control_exception(interp, IREG(1), PREG(2));
+    opcode_t  * const  dest = Parrot_ex_throw_from_op(interp, except,  cur_opcode + 3);
+
+    return (opcode_t *)dest;
+}
+
+opcode_t *
+Parrot_throw_control_ic_p(opcode_t *cur_opcode, PARROT_INTERP) {
+    PMC       * const  except = Parrot_ex_build_control_exception(interp, ICONST(1), PREG(2));
+    opcode_t  * const  dest = Parrot_ex_throw_from_op(interp, except,  cur_opcode + 3);
+
+    return (opcode_t *)dest;
+}
+
 
 /*
 ** op lib descriptor:
@@ -24443,7 +24901,7 @@ op_lib_t core_op_lib = {
   4,    /* major_version */
   9,    /* minor_version */
   0,    /* patch_version */
-  1125,             /* op_count */
+  1141,             /* op_count */
   core_op_info_table,       /* op_info_table */
   core_op_func_table,       /* op_func_table */
   get_op          /* op_code() */ 
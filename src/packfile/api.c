@@ -30,16 +30,38 @@ format of bytecode.
 #include "api.str"
 #include "pmc/pmc_sub.h"
 #include "pmc/pmc_packfileview.h"
+#include "imcc/embed.h"
+
+/* Passed through Parrot_ext_try() by compile_file() */
+typedef struct source_compile_t {
+    PMC    *compiler;
+    STRING *path;
+    PMC    *pf_pmc;
+    PMC    *exception;
+} source_compile_t;
+
+/* Passed through Parrot_ext_try() by source_cache_load() */
+typedef struct source_cache_read_t {
+    STRING   *cache_name;
+    PackFile *pf;
+} source_cache_read_t;
 
 /* HEADERIZER HFILE: include/parrot/packfile.h */
 
 /* HEADERIZER BEGIN: static */
 /* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
 
+static void catch_source_exception(PARROT_INTERP,
+    ARGIN_NULLOK(PMC *exception),
+    ARGIN_NULLOK(void *data));
+
 static void compile_file(PARROT_INTERP, ARGIN(STRING *path), INTVAL is_pasm)
         __attribute__nonnull__(1)
         __attribute__nonnull__(2);
 
+static void compile_source(PARROT_INTERP, ARGIN_NULLOK(void *data))
+        __attribute__nonnull__(1);
+
 PARROT_WARN_UNUSED_RESULT
 PARROT_CANNOT_RETURN_NULL
 static PackFile_Segment * create_seg(PARROT_INTERP,
@@ -83,6 +105,13 @@ static void load_file(PARROT_INTERP, ARGIN(STRING *path))
         __attribute__nonnull__(1)
         __attribute__nonnull__(2);
 
+static void load_packfile(PARROT_INTERP,
+    ARGIN(PackFile *pf),
+    ARGIN(STRING *path))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3);
+
 static void mark_1_bc_seg(PARROT_INTERP, ARGMOD(PackFile_ByteCode *bc))
         __attribute__nonnull__(1)
         __attribute__nonnull__(2)
@@ -127,16 +156,41 @@ static void PackFile_set_header(ARGOUT(PackFile_Header *header))
         __attribute__nonnull__(1)
         FUNC_MODIFIES(*header);
 
+PARROT_CANNOT_RETURN_NULL
+static STRING * pbc_cache_name(PARROT_INTERP,
+    ARGIN(STRING *fullname),
+    INTVAL program_size)
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+static void pbc_cache_store(PARROT_INTERP,
+    ARGMOD(PackFile *pf),
+    ARGIN(STRING *cache_name))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        FUNC_MODIFIES(*pf);
+
+static void pbc_cache_write(PARROT_INTERP,
+    ARGMOD(PackFile *pf),
+    ARGIN(STRING *cache_name))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        FUNC_MODIFIES(*pf);
+
 static void push_context(PARROT_INTERP)
         __attribute__nonnull__(1);
 
-PARROT_CAN_RETURN_NULL
+PARROT_CANNOT_RETURN_NULL
 static char * read_pbc_file_bytes_handle(PARROT_INTERP,
     PIOHANDLE io,
-    INTVAL program_size)
-        __attribute__nonnull__(1);
+    ARGMOD(INTVAL *program_size))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(3)
+        FUNC_MODIFIES(*program_size);
 
-PARROT_CAN_RETURN_NULL
+PARROT_CANNOT_RETURN_NULL
 static PackFile * read_pbc_file_packfile(PARROT_INTERP,
     ARGIN(STRING * const fullname),
     INTVAL program_size)
@@ -155,15 +209,73 @@ PARROT_CANNOT_RETURN_NULL
 static PMC* set_current_sub(PARROT_INTERP)
         __attribute__nonnull__(1);
 
+static int source_cache_hash_file(PARROT_INTERP,
+    ARGIN(STRING *path),
+    ARGMOD(size_t *hash))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        FUNC_MODIFIES(*hash);
+
+PARROT_CANNOT_RETURN_NULL
+static STRING * source_cache_key(PARROT_INTERP,
+    ARGIN(STRING *path),
+    INTVAL flags)
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+PARROT_CAN_RETURN_NULL
+static PackFile * source_cache_load(PARROT_INTERP,
+    ARGIN(STRING *cache_name))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+PARROT_CANNOT_RETURN_NULL
+static STRING * source_cache_name(PARROT_INTERP,
+    ARGIN(STRING *cache_key),
+    ARGIN(STRING *path),
+    ARGIN(PMC *files),
+    INTVAL is_pasm)
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        __attribute__nonnull__(4);
+
+PARROT_CANNOT_RETURN_NULL
+static STRING * source_cache_path(PARROT_INTERP, ARGIN(STRING *path))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+static void source_cache_read(PARROT_INTERP, ARGIN_NULLOK(void *data))
+        __attribute__nonnull__(1);
+
+PARROT_CANNOT_RETURN_NULL
+static PMC * source_cache_read_index(PARROT_INTERP,
+    ARGIN(STRING *cache_key),
+    INTVAL is_pasm)
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+static void source_cache_write_index(PARROT_INTERP,
+    ARGIN(STRING *cache_key),
+    INTVAL is_pasm,
+    ARGIN(PMC *files))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(4);
+
 static int sub_pragma(PARROT_INTERP,
     pbc_action_enum_t action,
     ARGIN(const PMC *sub_pmc))
         __attribute__nonnull__(1)
         __attribute__nonnull__(3);
 
+#define ASSERT_ARGS_catch_source_exception __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
 #define ASSERT_ARGS_compile_file __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(path))
+#define ASSERT_ARGS_compile_source __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp))
 #define ASSERT_ARGS_create_seg __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(dir) \
@@ -181,6 +293,10 @@ static int sub_pragma(PARROT_INTERP,
 #define ASSERT_ARGS_load_file __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(path))
+#define ASSERT_ARGS_load_packfile __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(pf) \
+    , PARROT_ASSERT_ARG(path))
 #define ASSERT_ARGS_mark_1_bc_seg __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(bc))
@@ -202,10 +318,22 @@ static int sub_pragma(PARROT_INTERP,
        PARROT_ASSERT_ARG(bc))
 #define ASSERT_ARGS_PackFile_set_header __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(header))
+#define ASSERT_ARGS_pbc_cache_name __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(fullname))
+#define ASSERT_ARGS_pbc_cache_store __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(pf) \
+    , PARROT_ASSERT_ARG(cache_name))
+#define ASSERT_ARGS_pbc_cache_write __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(pf) \
+    , PARROT_ASSERT_ARG(cache_name))
 #define ASSERT_ARGS_push_context __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp))
 #define ASSERT_ARGS_read_pbc_file_bytes_handle __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
-       PARROT_ASSERT_ARG(interp))
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(program_size))
 #define ASSERT_ARGS_read_pbc_file_packfile __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(fullname))
@@ -214,6 +342,33 @@ static int sub_pragma(PARROT_INTERP,
     , PARROT_ASSERT_ARG(fullname))
 #define ASSERT_ARGS_set_current_sub __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp))
+#define ASSERT_ARGS_source_cache_hash_file __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(path) \
+    , PARROT_ASSERT_ARG(hash))
+#define ASSERT_ARGS_source_cache_key __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(path))
+#define ASSERT_ARGS_source_cache_load __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(cache_name))
+#define ASSERT_ARGS_source_cache_name __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(cache_key) \
+    , PARROT_ASSERT_ARG(path) \
+    , PARROT_ASSERT_ARG(files))
+#define ASSERT_ARGS_source_cache_path __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(path))
+#define ASSERT_ARGS_source_cache_read __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp))
+#define ASSERT_ARGS_source_cache_read_index __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(cache_key))
+#define ASSERT_ARGS_source_cache_write_index __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(cache_key) \
+    , PARROT_ASSERT_ARG(files))
 #define ASSERT_ARGS_sub_pragma __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(sub_pmc))
@@ -261,6 +416,12 @@ Parrot_pf_destroy(PARROT_INTERP, ARGMOD(PackFile *pf))
     mem_gc_free(interp, pf->dirp);
     pf->dirp   = NULL;
     PackFile_Segment_destroy(interp, &pf->directory.base);
+
+    if (pf->is_src_owned) {
+        DECL_CONST_CAST;
+        mem_gc_free(interp, PARROT_const_cast(opcode_t *, pf->src));
+        pf->src = NULL;
+    }
     return;
 }
 
@@ -475,7 +636,8 @@ Parrot_pf_subs_by_tag(PARROT_INTERP, ARGIN(PMC * pfpmc), ARGIN(STRING * flag))
 
       done_find_bounds:
         for (i = bottom_lo; i < top_hi; i++)
-            VTABLE_push_pmc(interp, subs, ct->pmc.constants[ct->tag_map[i].const_idx]);
+            VTABLE_push_pmc(interp, subs,
+                PackFile_ConstTable_get_pmc(interp, ct, ct->tag_map[i].const_idx));
     }
 
     /* Backwards compatibility. :load is equivalent to "load" tag. :init is
@@ -491,7 +653,8 @@ Parrot_pf_subs_by_tag(PARROT_INTERP, ARGIN(PMC * pfpmc), ARGIN(STRING * flag))
             Parrot_Sub_attributes *sub;
             int pragmas;
 
-            if (!VTABLE_isa(interp, sub_pmc, SUB))
+            /* lazily loaded constants are never Subs */
+            if (!sub_pmc || !VTABLE_isa(interp, sub_pmc, SUB))
                 continue;
             PMC_get_sub(interp, sub_pmc, sub);
             pragmas = PObj_get_FLAGS(sub_pmc) & SUB_FLAG_PF_MASK & ~SUB_FLAG_IS_OUTER;
@@ -581,7 +744,8 @@ Parrot_pf_all_tagged_pmcs(PARROT_INTERP, ARGIN(PMC * pfpmc))
                 VTABLE_set_pmc_keyed_str(interp, taghash, cur_tag_str, cur_tag_list);
                 last_seen = cur_tag;
             }
-            VTABLE_push_pmc(interp, cur_tag_list, ct->pmc.constants[ct->tag_map[i].const_idx]);
+            VTABLE_push_pmc(interp, cur_tag_list,
+                PackFile_ConstTable_get_pmc(interp, ct, ct->tag_map[i].const_idx));
         }
     }
     return taghash;
@@ -615,7 +779,7 @@ Parrot_pf_all_subs(PARROT_INTERP, ARGIN(PMC *pfpmc))
         STRING * const SUB = CONST_STRING(interp, "Sub");
         for (i = 0; i < ct->pmc.const_count; ++i) {
             PMC * const x = ct->pmc.constants[i];
-            if (VTABLE_isa(interp, x, SUB))
+            if (x && VTABLE_isa(interp, x, SUB))
                 VTABLE_push_pmc(interp, array, x);
         }
         return array;
@@ -786,6 +950,10 @@ mark_1_ct_seg(PARROT_INTERP, ARGMOD(PackFile_ConstTable *ct))
 
     for (i = 0; i < ct->pmc.const_count; i++)
         Parrot_gc_mark_PMC_alive(interp, ct->pmc.constants[i]);
+
+    if (ct->pmc.olists)
+        for (i = 0; i < ct->pmc.const_count; i++)
+            Parrot_gc_mark_PMC_alive(interp, ct->pmc.olists[i]);
 }
 
 
@@ -950,7 +1118,7 @@ do_sub_pragmas(PARROT_INTERP, ARGIN(PMC *pfpmc),
         STRING * const SUB = CONST_STRING(interp, "Sub");
         PMC * const sub_pmc = ct->pmc.constants[i];
 
-        if (VTABLE_isa(interp, sub_pmc, SUB)) {
+        if (sub_pmc && VTABLE_isa(interp, sub_pmc, SUB)) {
             Parrot_Sub_attributes *sub;
 
             PMC_get_sub(interp, sub_pmc, sub);
@@ -1759,30 +1927,16 @@ Parrot_debug_add_mapping(PARROT_INTERP, ARGMOD(PackFile_Debug *debug),
     {
         /* Set up new entry and insert it. */
         PackFile_DebugFilenameMapping *mapping = debug->mappings + insert_pos;
-        size_t count = ct->str.const_count;
-        size_t i;
-
-        mapping->offset = offset;
 
         /* Check if there is already a constant with this filename */
-        for (i= 0; i < count; ++i) {
-            if (STRING_equal(interp, filename, ct->str.constants[i]))
-                break;
-        }
-        if (i < count) {
-            /* There is one, use it */
-            count = i;
-       }
-       else {
-            /* Not found, create a new one */
-            ct->str.const_count++;
-            ct->str.constants = mem_gc_realloc_n_typed_zeroed(interp, ct->str.constants,
-                    ct->str.const_count, ct->str.const_count - 1, STRING *);
-            ct->str.constants[ct->str.const_count - 1] = filename;
-        }
+        const int i = PackFile_ConstTable_rlookup_str(interp, ct, filename);
 
-        /* Set the mapped value */
-        mapping->filename = count;
+        mapping->offset = offset;
+
+        /* Use it if there is one, else create a new one */
+        mapping->filename = i >= 0
+                          ? i
+                          : PackFile_ConstTable_push_str(interp, ct, filename);
         debug->num_mappings         = debug->num_mappings + 1;
     }
 }
@@ -2078,7 +2232,7 @@ PackFile_Annotations_lookup(PARROT_INTERP, ARGIN(PackFile_Annotations *self),
           case PF_ANNOTATION_KEY_TYPE_STR:
             return Parrot_pmc_box_string(interp, self->code->const_table->str.constants[val]);
           case PF_ANNOTATION_KEY_TYPE_PMC:
-            return self->code->const_table->pmc.constants[val];
+            return PackFile_ConstTable_get_pmc(interp, self->code->const_table, val);
           default:
             Parrot_warn(interp, PARROT_WARNINGS_ALL_FLAG, "unexpected annotation type found");
             return PMCNULL;
@@ -2149,6 +2303,11 @@ push_context(PARROT_INTERP)
 
 Compile a PIR or PASM file from source.
 
+If C<PARROT_PBC_CACHE> names a cache directory, the bytecode compiled from
+the file is kept there, and later loads of a file with the same contents load
+it from there instead of compiling it again (see C<source_cache_name>). A kept
+file which fails to load is compiled again.
+
 Deprecate: Do not use this. The packfile subsystem should not be in the
 business of compiling things, and should absolutely not default to any one
 particular compiler object (which might not exist). Use compreg opcode to get
@@ -2163,22 +2322,66 @@ compile_file(PARROT_INTERP, ARGIN(STRING *path), INTVAL is_pasm)
 {
     ASSERT_ARGS(compile_file)
     PackFile_ByteCode * const cur_code = interp->code;
-    PMC * compiler;
-    if (is_pasm)
-        compiler = Parrot_interp_get_compiler(interp, CONST_STRING(interp, "PASM"));
-    else
-        compiler = Parrot_interp_get_compiler(interp, CONST_STRING(interp, "PIR"));
+    STRING     * const pasm      = CONST_STRING(interp, "PASM");
+    STRING     * const pir       = CONST_STRING(interp, "PIR");
+    PMC        * const compiler  = Parrot_interp_get_compiler(interp, is_pasm ? pasm : pir);
+    imc_info_t * const imcc      = (imc_info_t *)VTABLE_get_pointer(interp, compiler);
+    STRING     * const cache_key = source_cache_key(interp, path,
+                                        imcc_get_optimization_level(imcc));
+    PMC        * const included  = Parrot_pmc_new(interp, enum_class_ResizableStringArray);
+    source_compile_t   run;
+
+    if (!STRING_IS_NULL(cache_key)) {
+        PMC    * const files      = source_cache_read_index(interp, cache_key, is_pasm);
+        STRING * const cache_name = source_cache_name(interp, cache_key, path, files,
+                                        is_pasm);
+
+        if (!STRING_IS_NULL(cache_name)
+        &&   Parrot_file_stat_intval(interp, cache_name, STAT_EXISTS)) {
+            PackFile * const pf = source_cache_load(interp, cache_name);
+
+            if (pf) {
+                load_packfile(interp, pf, path);
+                return;
+            }
+        }
+    }
+
+    run.compiler  = compiler;
+    run.path      = path;
+    run.pf_pmc    = PMCNULL;
+    run.exception = PMCNULL;
+
+    /* the included files make up the cache key too */
+    imcc_set_included_files(imcc, included);
+    Parrot_ext_try(interp, compile_source, catch_source_exception, &run);
+    imcc_set_included_files(imcc, PMCNULL);
+
+    if (!PMC_IS_NULL(run.exception))
+        Parrot_ex_rethrow_from_c(interp, run.exception);
+
     {
-        PMC * const pf_pmc = Parrot_interp_compile_file(interp, compiler, path);
         PMC * const pbc_cache = VTABLE_get_pmc_keyed_int(interp,
             interp->iglobals, IGLOBALS_LOADED_PBCS);
-        PackFile * const pf = (PackFile*) VTABLE_get_pointer(interp, pf_pmc);
+        PackFile * const pf = (PackFile*) VTABLE_get_pointer(interp, run.pf_pmc);
         PackFile_ByteCode * const cs = pf->cur_cs;
 
         if (cs) {
             interp->code = cur_code;
-            VTABLE_set_pmc_keyed_str(interp, pbc_cache, path, pf_pmc);
-            do_sub_pragmas(interp, pf_pmc, PBC_LOADED, NULL);
+            VTABLE_set_pmc_keyed_str(interp, pbc_cache, path, run.pf_pmc);
+
+            /* before :load subs run, which clears their flag */
+            if (!STRING_IS_NULL(cache_key)) {
+                STRING * const cache_name = source_cache_name(interp, cache_key, path,
+                                                included, is_pasm);
+
+                if (!STRING_IS_NULL(cache_name)) {
+                    source_cache_write_index(interp, cache_key, is_pasm, included);
+                    pbc_cache_write(interp, pf, cache_name);
+                }
+            }
+
+            do_sub_pragmas(interp, run.pf_pmc, PBC_LOADED, NULL);
         }
         else {
             interp->code = cur_code;
@@ -2188,6 +2391,46 @@ compile_file(PARROT_INTERP, ARGIN(STRING *path), INTVAL is_pasm)
     }
 }
 
+/*
+
+=item C<static void compile_source(PARROT_INTERP, void *data)>
+
+Compiles the file of the C<source_compile_t> C<data> for C<compile_file>,
+under C<Parrot_ext_try>.
+
+=cut
+
+*/
+
+static void
+compile_source(PARROT_INTERP, ARGIN_NULLOK(void *data))
+{
+    ASSERT_ARGS(compile_source)
+    source_compile_t * const run = (source_compile_t *)data;
+
+    run->pf_pmc = Parrot_interp_compile_file(interp, run->compiler, run->path);
+}
+
+/*
+
+=item C<static void catch_source_exception(PARROT_INTERP, PMC *exception, void
+*data)>
+
+Keeps the exception thrown while compiling, so that C<compile_file> can stop
+recording included files before rethrowing it.
+
+=cut
+
+*/
+
+static void
+catch_source_exception(SHIM_INTERP, ARGIN_NULLOK(PMC *exception), ARGIN_NULLOK(void *data))
+{
+    ASSERT_ARGS(catch_source_exception)
+    source_compile_t * const run = (source_compile_t *)data;
+
+    run->exception = exception;
+}
 
 /*
 
@@ -2204,7 +2447,25 @@ load_file(PARROT_INTERP, ARGIN(STRING *path))
 {
     ASSERT_ARGS(load_file)
 
-    PackFile * const pf = Parrot_pf_read_pbc_file(interp, path);
+    load_packfile(interp, Parrot_pf_read_pbc_file(interp, path), path);
+}
+
+/*
+
+=item C<static void load_packfile(PARROT_INTERP, PackFile *pf, STRING *path)>
+
+Append the PackFile C<pf>, read from the bytecode file for C<path>, to the
+current packfile directory and run its C<:load> subs.
+
+=cut
+
+*/
+
+static void
+load_packfile(PARROT_INTERP, ARGIN(PackFile *pf), ARGIN(STRING *path))
+{
+    ASSERT_ARGS(load_packfile)
+
     PMC * const pf_pmc = Parrot_pf_get_packfile_pmc(interp, pf, path);
 
     if (!pf_pmc)
@@ -2514,7 +2775,9 @@ Take a Packfile or PackfileView PMC and write its contents out as a .pbc file
 =item C<PackFile * Parrot_pf_read_pbc_file(PARROT_INTERP, STRING * const
 fullname)>
 
-Read a .pbc file with the given C<fullname> into a PackFile structure.
+Read a .pbc file with the given C<fullname> into a PackFile structure. An
+empty or NULL C<fullname> reads standard input; a file redirected to it is read
+in one piece, a pipe until it is exhausted.
 
 =cut
 
@@ -2561,9 +2824,19 @@ Parrot_pf_read_pbc_file(PARROT_INTERP, ARGIN_NULLOK(STRING * const fullname))
     if (fullname == NULL || STRING_length(fullname) == 0) {
         PIOHANDLE stdin_h = Parrot_io_get_standard_piohandle(interp, PIO_STDIN_FILENO);
         STRING * const hname = CONST_STRING(interp, "standard input");
-        pf = read_pbc_file_packfile_handle(interp, hname, stdin_h, 0);
+        const PIOOFF_T here  = Parrot_io_internal_tell(interp, stdin_h);
+        const PIOOFF_T end   = here < 0 ? here
+                             : Parrot_io_internal_seek(interp, stdin_h, 0, SEEK_END);
+
+        program_size = 0;
+        if (end > here && Parrot_io_internal_seek(interp, stdin_h, here, SEEK_SET) == here)
+            program_size = (INTVAL)(end - here);
+
+        pf = read_pbc_file_packfile_handle(interp, hname, stdin_h, program_size);
     }
     else {
+        STRING *cache_name;
+
         /* can't read a file that doesn't exist */
         if (!Parrot_file_stat_intval(interp, fullname, STAT_EXISTS))
             Parrot_ex_throw_from_c_args(interp, NULL, EXCEPTION_INVALID_OPERATION,
@@ -2580,7 +2853,21 @@ Parrot_pf_read_pbc_file(PARROT_INTERP, ARGIN_NULLOK(STRING * const fullname))
                 "Trying to open a NULL filename");
 
         program_size = Parrot_file_stat_intval(interp, fullname, STAT_FILESIZE);
-        pf = read_pbc_file_packfile(interp, fullname, program_size);
+        cache_name   = pbc_cache_name(interp, fullname, program_size);
+
+        /* a native copy of a foreign-format file can be mapped directly */
+        if (!STRING_IS_NULL(cache_name)
+        &&   Parrot_file_stat_intval(interp, cache_name, STAT_EXISTS)) {
+            pf = read_pbc_file_packfile(interp, cache_name,
+                    Parrot_file_stat_intval(interp, cache_name, STAT_FILESIZE));
+        }
+        else {
+            pf = read_pbc_file_packfile(interp, fullname, program_size);
+
+            if (!STRING_IS_NULL(cache_name)
+            && (pf->need_endianize || pf->need_wordsize || pf->fetch_nv))
+                pbc_cache_store(interp, pf, cache_name);
+        }
     }
 
     return pf;
@@ -2592,7 +2879,8 @@ Parrot_pf_read_pbc_file(PARROT_INTERP, ARGIN_NULLOK(STRING * const fullname))
 =item C<static PackFile* read_pbc_file_packfile_handle(PARROT_INTERP, STRING *
 const fullname, PIOHANDLE io, INTVAL program_size)>
 
-Read a PackFile in from an open PIOHANDLE.
+Read a PackFile in from an open PIOHANDLE. The bytes read are owned by the
+PackFile, so segments that need no transforms point straight into them.
 
 =cut
 
@@ -2604,9 +2892,11 @@ read_pbc_file_packfile_handle(PARROT_INTERP, ARGIN(STRING * const fullname),
         PIOHANDLE io, INTVAL program_size)
 {
     ASSERT_ARGS(read_pbc_file_packfile_handle)
-    char * const program_code = read_pbc_file_bytes_handle(interp, io, program_size);
+    char * const program_code = read_pbc_file_bytes_handle(interp, io, &program_size);
     PackFile * const pf = PackFile_new(interp, 0);
-    pf->options = 0;
+    pf->is_src_owned = 1;
+    pf->options = Interp_flags_TEST(interp, PARROT_LAZY_CONSTS_FLAG)
+                ? PFOPT_LAZY_CONSTS : PFOPT_NONE;
 
     if (!PackFile_unpack(interp, pf, (opcode_t *)program_code, (size_t)program_size))
         Parrot_ex_throw_from_c_args(interp, NULL, EXCEPTION_INVALID_OPERATION,
@@ -2617,46 +2907,48 @@ read_pbc_file_packfile_handle(PARROT_INTERP, ARGIN(STRING * const fullname),
 /*
 
 =item C<static char * read_pbc_file_bytes_handle(PARROT_INTERP, PIOHANDLE io,
-INTVAL program_size)>
+INTVAL *program_size)>
 
 Read in the raw bytes of the packfile into a buffer. The buffer is allocated
-with C<mem_gc_realloc_n_typed>, so needs to be freed by the caller.
+with C<mem_gc_allocate_n_typed>, so needs to be freed by the caller.
+
+If C<*program_size> is known, the whole file is read into a buffer of exactly
+that size. Otherwise the buffer grows geometrically until the handle is
+exhausted. On return C<*program_size> holds the number of bytes read.
 
 =cut
 
 */
 
-PARROT_CAN_RETURN_NULL
+PARROT_CANNOT_RETURN_NULL
 static char *
-read_pbc_file_bytes_handle(PARROT_INTERP, PIOHANDLE io, INTVAL program_size)
+read_pbc_file_bytes_handle(PARROT_INTERP, PIOHANDLE io, ARGMOD(INTVAL *program_size))
 {
     ASSERT_ARGS(read_pbc_file_bytes_handle)
-    size_t chunk_size   = program_size > 0 ? program_size : 1024;
-    INTVAL wanted       = program_size;
-    size_t read_result;
-    char  *program_code = mem_gc_allocate_n_typed(interp, chunk_size, char);
-    char  *cursor       = program_code;
-    program_size        = 0;
+    const INTVAL wanted   = *program_size;
+    size_t       capacity = wanted > 0 ? (size_t)wanted : 4096;
+    size_t       got      = 0;
+    char        *program_code = mem_gc_allocate_n_typed(interp, capacity, char);
 
-    while ((read_result = Parrot_io_internal_read(interp, io, cursor, chunk_size)) > 0) {
-        program_size += read_result;
+    for (;;) {
+        const size_t read_result = Parrot_io_internal_read(interp, io,
+                program_code + got, capacity - got);
 
-        if (program_size == wanted)
+        if (read_result == 0 || read_result == (size_t)-1)
             break;
 
-        chunk_size   = 1024;
-        program_code = mem_gc_realloc_n_typed(interp, program_code,
-                program_size + chunk_size, char);
+        got += read_result;
 
-        if (!program_code) {
-            Parrot_io_internal_close(interp, io);
-            Parrot_ex_throw_from_c_args(interp, NULL, EXCEPTION_INVALID_OPERATION,
-                    "Could not reallocate buffer while reading packfile from PIO.\n");
-        }
+        if (wanted > 0 && got == (size_t)wanted)
+            break;
 
-        cursor = program_code + program_size;
+        if (got == capacity) {
+            capacity    *= 2;
+            program_code = mem_gc_realloc_n_typed(interp, program_code, capacity, char);
+        }
     }
 
+    *program_size = (INTVAL)got;
     return program_code;
 }
 
@@ -2665,14 +2957,17 @@ read_pbc_file_bytes_handle(PARROT_INTERP, PIOHANDLE io, INTVAL program_size)
 =item C<static PackFile * read_pbc_file_packfile(PARROT_INTERP, STRING * const
 fullname, INTVAL program_size)>
 
-Read a pbc file into a PackFile*. May use mmap if available or direct reads
-from the file.
+Read a pbc file into a PackFile*. The file is mapped read-only where mmap is
+available, so segments of a native-format file point straight into the
+mapping: pages are faulted in only as the code is executed and are shared
+between processes running the same file. Otherwise, or if mapping fails, the
+file is read with a single sized read.
 
 =cut
 
 */
 
-PARROT_CAN_RETURN_NULL
+PARROT_CANNOT_RETURN_NULL
 static PackFile *
 read_pbc_file_packfile(PARROT_INTERP, ARGIN(STRING * const fullname),
         INTVAL program_size)
@@ -2687,46 +2982,436 @@ read_pbc_file_packfile(PARROT_INTERP, ARGIN(STRING * const fullname),
         Parrot_ex_throw_from_c_args(interp, NULL, EXCEPTION_INVALID_OPERATION,
                 "Can't open %Ss, code %i.\n", fullname, errno);
 
-    /* TODO: Who frees program_code? We don't do it here (And don't need to
-             if we've mmapped it. Figure out where this is handled and
-             document it here.
-    */
-
-#ifndef PARROT_HAS_HEADER_SYSMAN
-
-    program_code = read_pbc_file_bytes_handle(interp, io, program_size);
-
-#else
+#ifdef PARROT_HAS_HEADER_SYSMMAN
 
-    program_code = (char *)mmap(NULL, (size_t)program_size,
-                    PROT_READ, MAP_SHARED, io, (off_t)0);
+    if (program_size > 0) {
+        void * const mapped = mmap(NULL, (size_t)program_size,
+                        PROT_READ, MAP_SHARED, io, (off_t)0);
 
-    /* If mmap fails, fall back and try to read the file from the handle
-       directly.
-    */
-    if (program_code == (void *)MAP_FAILED) {
-        Parrot_warn(interp, PARROT_WARNINGS_IO_FLAG,
-                "Can't mmap file %s, code %i.\n", fullname, errno);
-        program_code = read_pbc_file_bytes_handle(interp, fullname, io, program_size);
+        /* If mmap fails, fall back and read the file from the handle. */
+        if (mapped == MAP_FAILED)
+            Parrot_warn(interp, PARROT_WARNINGS_IO_FLAG,
+                    "Can't mmap file %Ss, code %i.\n", fullname, errno);
+        else {
+            program_code = (char *)mapped;
+            is_mapped    = 1;
+        }
     }
-    else
-        is_mapped = 1;
 
 #endif
 
+    if (!is_mapped)
+        program_code = read_pbc_file_bytes_handle(interp, io, &program_size);
+
+    Parrot_io_internal_close(interp, io);
+
     pf = PackFile_new(interp, is_mapped);
-    pf->options = 0;
+    pf->is_src_owned = !is_mapped;
+    pf->options = Interp_flags_TEST(interp, PARROT_LAZY_CONSTS_FLAG)
+                ? PFOPT_LAZY_CONSTS : PFOPT_NONE;
 
     if (!PackFile_unpack(interp, pf, (opcode_t *)program_code, (size_t)program_size))
         Parrot_ex_throw_from_c_args(interp, NULL, EXCEPTION_INVALID_OPERATION,
                 "Can't unpack packfile %Ss.\n", fullname);
 
-    Parrot_io_internal_close(interp, io);
     return pf;
 }
 
 /*
 
+=item C<static STRING * pbc_cache_name(PARROT_INTERP, STRING *fullname, INTVAL
+program_size)>
+
+Returns the name under which a native-format copy of the bytecode file
+C<fullname> is kept, or STRINGNULL if the C<PARROT_PBC_CACHE> environment
+variable does not name a cache directory. The name is derived from the
+absolute path, size and modification time of the file, so a changed file
+never hits a stale entry.
+
+=cut
+
+*/
+
+PARROT_CANNOT_RETURN_NULL
+static STRING *
+pbc_cache_name(PARROT_INTERP, ARGIN(STRING *fullname), INTVAL program_size)
+{
+    ASSERT_ARGS(pbc_cache_name)
+    STRING * const dir = Parrot_getenv(interp, CONST_STRING(interp, "PARROT_PBC_CACHE"));
+    STRING        *path = fullname;
+    INTVAL         mtime;
+
+    if (STRING_IS_NULL(dir) || STRING_IS_EMPTY(dir))
+        return STRINGNULL;
+
+    if (STRING_ord(interp, path, 0) != '/')
+        path = Parrot_sprintf_c(interp, "%Ss/%Ss", Parrot_file_getcwd(interp), path);
+
+    mtime = Parrot_file_stat_intval(interp, fullname, STAT_MODIFYTIME);
+
+    /* the interpreter's hash seed is randomized; the key must not be */
+    return Parrot_sprintf_c(interp, "%Ss/%vx-%vx-%vx.pbc", dir,
+            (UINTVAL)STRING_hash(interp, path, 0), program_size, mtime);
+}
+
+/*
+
+=item C<static STRING * source_cache_key(PARROT_INTERP, STRING *path, INTVAL
+flags)>
+
+Returns the stem of the names under which the bytecode compiled from the PIR
+or PASM file C<path> with the IMCC optimization C<flags> is kept, or
+STRINGNULL if the C<PARROT_PBC_CACHE> environment variable does not name a
+cache directory. The stem is derived from the absolute path, the flags and the
+Parrot and PBC versions, so a different compile never shares an entry.
+
+=cut
+
+*/
+
+PARROT_CANNOT_RETURN_NULL
+static STRING *
+source_cache_key(PARROT_INTERP, ARGIN(STRING *path), INTVAL flags)
+{
+    ASSERT_ARGS(source_cache_key)
+    static const char version[] = PARROT_VERSION;
+    STRING * const dir = Parrot_getenv(interp, CONST_STRING(interp, "PARROT_PBC_CACHE"));
+    size_t         hash;
+
+    if (STRING_IS_NULL(dir) || STRING_IS_EMPTY(dir))
+        return STRINGNULL;
+
+    hash = Parrot_hash_buffer((const unsigned char *)version, sizeof (version) - 1,
+                PARROT_PBC_MAJOR * 1000 + PARROT_PBC_MINOR);
+    hash = Parrot_hash_buffer((const unsigned char *)&flags, sizeof (flags), hash);
+
+    /* the interpreter's hash seed is randomized; the key must not be */
+    hash = STRING_hash(interp, source_cache_path(interp, path), hash);
+
+    return Parrot_sprintf_c(interp, "%Ss/%vx", dir, (UINTVAL)hash);
+}
+
+/*
+
+=item C<static STRING * source_cache_name(PARROT_INTERP, STRING *cache_key,
+STRING *path, PMC *files, INTVAL is_pasm)>
+
+Returns the name under which the bytecode compiled from C<path>, which
+included the C<files>, is kept, or STRINGNULL if one of the files can't be
+read. The name is derived from C<cache_key> and from the names and contents of
+all the files, so an edit to any of them never hits a stale entry. It does not
+depend on modification times, which a fresh checkout of unchanged sources
+resets.
+
+=cut
+
+*/
+
+PARROT_CANNOT_RETURN_NULL
+static STRING *
+source_cache_name(PARROT_INTERP, ARGIN(STRING *cache_key), ARGIN(STRING *path),
+        ARGIN(PMC *files), INTVAL is_pasm)
+{
+    ASSERT_ARGS(source_cache_name)
+    const INTVAL n    = VTABLE_elements(interp, files);
+    size_t       hash = 0;
+    INTVAL       i;
+
+    if (!source_cache_hash_file(interp, path, &hash))
+        return STRINGNULL;
+
+    for (i = 0; i < n; ++i)
+        if (!source_cache_hash_file(interp,
+                VTABLE_get_string_keyed_int(interp, files, i), &hash))
+            return STRINGNULL;
+
+    return Parrot_sprintf_c(interp, "%Ss-%vx.%s.pbc", cache_key, (UINTVAL)hash,
+            is_pasm ? "pasm" : "pir");
+}
+
+/*
+
+=item C<static int source_cache_hash_file(PARROT_INTERP, STRING *path, size_t
+*hash)>
+
+Folds the absolute name, size and contents of the file C<path> into C<*hash>.
+Returns 0 if the file can't be read, 1 otherwise.
+
+=cut
+
+*/
+
+static int
+source_cache_hash_file(PARROT_INTERP, ARGIN(STRING *path), ARGMOD(size_t *hash))
+{
+    ASSERT_ARGS(source_cache_hash_file)
+    INTVAL     size;
+    char      *source;
+    PIOHANDLE  io = Parrot_io_internal_open(interp, path, PIO_F_READ);
+
+    if (io == PIO_INVALID_HANDLE)
+        return 0;
+
+    size   = Parrot_file_stat_intval(interp, path, STAT_FILESIZE);
+    source = read_pbc_file_bytes_handle(interp, io, &size);
+    Parrot_io_internal_close(interp, io);
+
+    *hash = STRING_hash(interp, source_cache_path(interp, path), *hash);
+    *hash = Parrot_hash_buffer((const unsigned char *)&size, sizeof (size), *hash);
+    *hash = Parrot_hash_buffer((unsigned char *)source, (size_t)size, *hash);
+    mem_gc_free(interp, source);
+
+    return 1;
+}
+
+/*
+
+=item C<static STRING * source_cache_path(PARROT_INTERP, STRING *path)>
+
+Returns C<path> made absolute against the current directory, as cache entries
+are shared by processes running in different directories.
+
+=cut
+
+*/
+
+PARROT_CANNOT_RETURN_NULL
+static STRING *
+source_cache_path(PARROT_INTERP, ARGIN(STRING *path))
+{
+    ASSERT_ARGS(source_cache_path)
+
+    if (STRING_ord(interp, path, 0) == '/')
+        return path;
+
+    return Parrot_sprintf_c(interp, "%Ss/%Ss", Parrot_file_getcwd(interp), path);
+}
+
+/*
+
+=item C<static PMC * source_cache_read_index(PARROT_INTERP, STRING *cache_key,
+INTVAL is_pasm)>
+
+Returns the names of the files that the last compile kept under C<cache_key>
+included, one per line of its index file, or an empty array if there is no
+index.
+
+=cut
+
+*/
+
+PARROT_CANNOT_RETURN_NULL
+static PMC *
+source_cache_read_index(PARROT_INTERP, ARGIN(STRING *cache_key), INTVAL is_pasm)
+{
+    ASSERT_ARGS(source_cache_read_index)
+    STRING * const index = Parrot_sprintf_c(interp, "%Ss.%s.files", cache_key,
+                                is_pasm ? "pasm" : "pir");
+    PMC    * const files = Parrot_pmc_new(interp, enum_class_ResizableStringArray);
+    PIOHANDLE      io    = Parrot_io_internal_open(interp, index, PIO_F_READ);
+    INTVAL         size, start, i;
+    char          *names;
+
+    if (io == PIO_INVALID_HANDLE)
+        return files;
+
+    size  = Parrot_file_stat_intval(interp, index, STAT_FILESIZE);
+    names = read_pbc_file_bytes_handle(interp, io, &size);
+    Parrot_io_internal_close(interp, io);
+
+    for (start = i = 0; i < size; ++i) {
+        if (names[i] == '\n') {
+            names[i] = '\0';
+            VTABLE_push_string(interp, files,
+                    Parrot_str_from_platform_cstring(interp, names + start));
+            start = i + 1;
+        }
+    }
+
+    mem_gc_free(interp, names);
+    return files;
+}
+
+/*
+
+=item C<static void source_cache_write_index(PARROT_INTERP, STRING *cache_key,
+INTVAL is_pasm, PMC *files)>
+
+Records the absolute names of the C<files> a compile kept under C<cache_key>
+included, so that the next load can check them. Like C<pbc_cache_write>, it
+writes a temporary file and renames it into place, and writes nothing if the
+file cannot be created.
+
+=cut
+
+*/
+
+static void
+source_cache_write_index(PARROT_INTERP, ARGIN(STRING *cache_key), INTVAL is_pasm,
+        ARGIN(PMC *files))
+{
+    ASSERT_ARGS(source_cache_write_index)
+    STRING * const index    = Parrot_sprintf_c(interp, "%Ss.%s.files", cache_key,
+                                    is_pasm ? "pasm" : "pir");
+    STRING * const tmp_name = Parrot_sprintf_c(interp, "%Ss.%vu",
+                                    index, Parrot_getpid());
+    const INTVAL   n        = VTABLE_elements(interp, files);
+    PIOHANDLE      fp       = Parrot_io_internal_open(interp, tmp_name, PIO_F_WRITE);
+    int            ok       = 1;
+    INTVAL         i;
+
+    if (fp == PIO_INVALID_HANDLE)
+        return;
+
+    for (i = 0; ok && i < n; ++i) {
+        STRING * const name = source_cache_path(interp,
+                                    VTABLE_get_string_keyed_int(interp, files, i));
+        char   * const c_name = Parrot_str_to_platform_cstring(interp, name);
+        const size_t   len    = strlen(c_name);
+
+        c_name[len] = '\n';
+        ok = Parrot_io_internal_write(interp, fp, c_name, len + 1) == len + 1;
+        c_name[len] = '\0';
+        Parrot_str_free_cstring(c_name);
+    }
+
+    Parrot_io_internal_close(interp, fp);
+
+    if (ok)
+        Parrot_file_rename(interp, tmp_name, index);
+    else
+        Parrot_file_unlink(interp, tmp_name);
+}
+
+/*
+
+=item C<static PackFile * source_cache_load(PARROT_INTERP, STRING *cache_name)>
+
+Reads the kept bytecode C<cache_name>. Returns NULL, having removed the file,
+if it can't be read, so that the caller compiles the source again.
+
+=cut
+
+*/
+
+PARROT_CAN_RETURN_NULL
+static PackFile *
+source_cache_load(PARROT_INTERP, ARGIN(STRING *cache_name))
+{
+    ASSERT_ARGS(source_cache_load)
+    source_cache_read_t read;
+
+    read.cache_name = cache_name;
+    read.pf         = NULL;
+
+    Parrot_ext_try(interp, source_cache_read, NULL, &read);
+
+    if (!read.pf && Parrot_file_stat_intval(interp, cache_name, STAT_EXISTS))
+        Parrot_file_unlink(interp, cache_name);
+
+    return read.pf;
+}
+
+/*
+
+=item C<static void source_cache_read(PARROT_INTERP, void *data)>
+
+Reads the file of the C<source_cache_read_t> C<data> for C<source_cache_load>,
+under C<Parrot_ext_try>.
+
+=cut
+
+*/
+
+static void
+source_cache_read(PARROT_INTERP, ARGIN_NULLOK(void *data))
+{
+    ASSERT_ARGS(source_cache_read)
+    source_cache_read_t * const read = (source_cache_read_t *)data;
+
+    read->pf = Parrot_pf_read_pbc_file(interp, read->cache_name);
+}
+
+/*
+
+=item C<static void pbc_cache_store(PARROT_INTERP, PackFile *pf, STRING
+*cache_name)>
+
+Writes a native-format copy of the foreign-format PackFile C<pf> to
+C<cache_name>.
+
+=cut
+
+*/
+
+static void
+pbc_cache_store(PARROT_INTERP, ARGMOD(PackFile *pf), ARGIN(STRING *cache_name))
+{
+    ASSERT_ARGS(pbc_cache_store)
+    PackFile_Header         native;
+    PackFile_Header * const header = pf->header;
+    const unsigned char     wordsize  = header->wordsize;
+    const unsigned char     byteorder = header->byteorder;
+    const unsigned char     floattype = header->floattype;
+
+    /* the unpacked data is native now; describe it so in the copy */
+    PackFile_set_header(&native);
+    header->wordsize  = native.wordsize;
+    header->byteorder = native.byteorder;
+    header->floattype = native.floattype;
+
+    pbc_cache_write(interp, pf, cache_name);
+
+    header->wordsize  = wordsize;
+    header->byteorder = byteorder;
+    header->floattype = floattype;
+}
+
+/*
+
+=item C<static void pbc_cache_write(PARROT_INTERP, PackFile *pf, STRING
+*cache_name)>
+
+Writes the native-format PackFile C<pf> to C<cache_name>. The copy is written
+to a temporary file and renamed into place, so processes mapping an older copy
+are unaffected and no process ever sees a partly written one. The cache is
+best effort: if the file cannot be created nothing is written.
+
+=cut
+
+*/
+
+static void
+pbc_cache_write(PARROT_INTERP, ARGMOD(PackFile *pf), ARGIN(STRING *cache_name))
+{
+    ASSERT_ARGS(pbc_cache_write)
+    STRING * const tmp_name = Parrot_sprintf_c(interp, "%Ss.%vu",
+                                    cache_name, Parrot_getpid());
+    PIOHANDLE      fp;
+    opcode_t      *packed;
+    size_t         size, wrote;
+
+    fp = Parrot_io_internal_open(interp, tmp_name, PIO_F_WRITE);
+    if (fp == PIO_INVALID_HANDLE)
+        return;
+
+    Parrot_block_GC_mark(interp);
+    size   = PackFile_pack_size(interp, pf) * sizeof (opcode_t);
+    packed = (opcode_t *)mem_sys_allocate(size);
+    PackFile_pack(interp, pf, packed);
+    wrote  = Parrot_io_internal_write(interp, fp, (char *)packed, size);
+    Parrot_io_internal_close(interp, fp);
+    mem_sys_free(packed);
+    Parrot_unblock_GC_mark(interp);
+
+    if (wrote == size)
+        Parrot_file_rename(interp, tmp_name, cache_name);
+    else
+        Parrot_file_unlink(interp, tmp_name);
+}
+
+/*
+
 =item C<static PMC* set_current_sub(PARROT_INTERP)>
 
 Search the fixup table for a PMC matching the argument.  On a match,
@@ -2760,8 +3445,9 @@ set_current_sub(PARROT_INTERP)
      */
 
     for (i = 0; i < ct->pmc.const_count; i++) {
+        /* lazily loaded constants are never Subs, so needn't be thawed */
         PMC * const sub_pmc = ct->pmc.constants[i];
-        if (VTABLE_isa(interp, sub_pmc, SUB)) {
+        if (sub_pmc && VTABLE_isa(interp, sub_pmc, SUB)) {
             Parrot_Sub_attributes *sub;
 
             PMC_get_sub(interp, sub_pmc, sub);
@@ -22,9 +22,17 @@ individual action vtable (freeze/thaw) is then called for all todo-PMCs.
 */
 
 #include "parrot/parrot.h"
+#include "parrot/extend.h"
 #include "pmc/pmc_callcontext.h"
 #include "object_serialization.str"
 
+/* Passed through Parrot_ext_try() by Parrot_thaw_snapshot() */
+typedef struct snapshot_thaw_t {
+    STRING *image;
+    PMC    *result;
+    PMC    *exception;
+} snapshot_thaw_t;
+
 /* when thawing a string longer then this size, we first do a GC run and then
  * block GC - the system can't give us more headers */
 
@@ -32,6 +40,22 @@ individual action vtable (freeze/thaw) is then called for all todo-PMCs.
 
 /* HEADERIZER HFILE: include/parrot/pmc_freeze.h */
 
+/* HEADERIZER BEGIN: static */
+/* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
+
+static void catch_snapshot_exception(PARROT_INTERP,
+    ARGIN_NULLOK(PMC *exception),
+    ARGIN_NULLOK(void *data));
+
+static void thaw_snapshot_image(PARROT_INTERP, ARGIN_NULLOK(void *data))
+        __attribute__nonnull__(1);
+
+#define ASSERT_ARGS_catch_snapshot_exception __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
+#define ASSERT_ARGS_thaw_snapshot_image __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp))
+/* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
+/* HEADERIZER END: static */
+
 /*
 
 =head2 Public Interface
@@ -59,6 +83,27 @@ Parrot_freeze(PARROT_INTERP, ARGIN(PMC *pmc))
 }
 
 
+/*
+
+=item C<void Parrot_freeze_to_handle(PARROT_INTERP, PMC *pmc, PMC *handle)>
+
+Freeze C<pmc> straight to C<handle> in the streaming format, without building
+the whole image in memory.
+
+=cut
+
+*/
+
+PARROT_EXPORT
+void
+Parrot_freeze_to_handle(PARROT_INTERP, ARGIN(PMC *pmc), ARGMOD(PMC *handle))
+{
+    ASSERT_ARGS(Parrot_freeze_to_handle)
+    PMC * const image = Parrot_pmc_new_init(interp, enum_class_ImageIOFreeze, handle);
+    VTABLE_set_pmc(interp, image, pmc);
+}
+
+
 /*
 
 =item C<opcode_t * Parrot_freeze_pbc(PARROT_INTERP, PMC *pmc, const
@@ -242,6 +287,30 @@ Parrot_thaw(PARROT_INTERP, ARGIN(STRING *image))
 }
 
 
+/*
+
+=item C<PMC* Parrot_thaw_from_handle(PARROT_INTERP, PMC *handle)>
+
+Thaw the next image frozen to C<handle> by C<Parrot_freeze_to_handle>.  Only
+the bytes of that image are read from C<handle>.
+
+=cut
+
+*/
+
+PARROT_EXPORT
+PARROT_WARN_UNUSED_RESULT
+PARROT_CANNOT_RETURN_NULL
+PMC*
+Parrot_thaw_from_handle(PARROT_INTERP, ARGMOD(PMC *handle))
+{
+    ASSERT_ARGS(Parrot_thaw_from_handle)
+    PMC * const info = Parrot_pmc_new(interp, enum_class_ImageIOThaw);
+    VTABLE_set_pmc(interp, info, handle);
+    return VTABLE_get_pmc(interp, info);
+}
+
+
 /*
 
 =item C<PMC* Parrot_thaw_pbc(PARROT_INTERP, PackFile_ConstTable *ct, const
@@ -290,6 +359,152 @@ Parrot_thaw_constants(PARROT_INTERP, ARGIN(STRING *image))
 }
 
 
+/*
+
+=item C<void Parrot_freeze_snapshot(PARROT_INTERP, PMC *pmc, STRING *filename)>
+
+Freezes C<pmc> and everything reachable from it into the snapshot file
+C<filename>. A snapshot is an ordinary freeze image, packfile header and all,
+so it carries the usual version check.
+
+=item C<PMC * Parrot_thaw_snapshot(PARROT_INTERP, STRING *filename)>
+
+Thaws the object graph stored in the snapshot file C<filename> and returns its
+root. The file is mapped into memory where possible and thawed in place;
+thawing copies everything it keeps, so the mapping is released afterwards,
+also when the image is rejected or thawing throws.
+
+Both are experimental, and kept out of the embedding API: only what the root
+reaches is stored, so Subs still need the packfile they were loaded from and an
+interpreter can't boot from a snapshot.
+
+=cut
+
+*/
+
+PARROT_EXPORT
+void
+Parrot_freeze_snapshot(PARROT_INTERP, ARGIN(PMC *pmc), ARGIN(STRING *filename))
+{
+    ASSERT_ARGS(Parrot_freeze_snapshot)
+    STRING * const image = Parrot_freeze(interp, pmc);
+    PIOHANDLE      fp    = Parrot_io_internal_open(interp, filename, PIO_F_WRITE);
+    size_t         size;
+
+    if (fp == PIO_INVALID_HANDLE)
+        Parrot_ex_throw_from_c_args(interp, NULL, EXCEPTION_PIO_ERROR,
+            "Cannot open snapshot file %Ss", filename);
+
+    size = Parrot_str_byte_length(interp, image);
+    if (Parrot_io_internal_write(interp, fp, image->strstart, size) != size) {
+        Parrot_io_internal_close(interp, fp);
+        Parrot_ex_throw_from_c_args(interp, NULL, EXCEPTION_PIO_ERROR,
+            "Cannot write snapshot file %Ss", filename);
+    }
+
+    Parrot_io_internal_close(interp, fp);
+}
+
+PARROT_EXPORT
+PARROT_WARN_UNUSED_RESULT
+PARROT_CANNOT_RETURN_NULL
+PMC *
+Parrot_thaw_snapshot(PARROT_INTERP, ARGIN(STRING *filename))
+{
+    ASSERT_ARGS(Parrot_thaw_snapshot)
+    PIOHANDLE        fp;
+    INTVAL           size;
+    char            *bytes     = NULL;
+    int              is_mapped = 0;
+    snapshot_thaw_t  thaw;
+
+    if (!Parrot_file_stat_intval(interp, filename, STAT_EXISTS))
+        Parrot_ex_throw_from_c_args(interp, NULL, EXCEPTION_PIO_ERROR,
+            "Snapshot file %Ss not found", filename);
+
+    size = Parrot_file_stat_intval(interp, filename, STAT_FILESIZE);
+    fp   = Parrot_io_internal_open(interp, filename, PIO_F_READ);
+    if (fp == PIO_INVALID_HANDLE)
+        Parrot_ex_throw_from_c_args(interp, NULL, EXCEPTION_PIO_ERROR,
+            "Cannot open snapshot file %Ss", filename);
+
+#ifdef PARROT_HAS_HEADER_SYSMMAN
+    bytes = (char *)mmap(NULL, (size_t)size, PROT_READ, MAP_PRIVATE, fp, (off_t)0);
+    if (bytes == (char *)MAP_FAILED)
+        bytes = NULL;
+    else
+        is_mapped = 1;
+#endif
+
+    if (!bytes) {
+        bytes = mem_gc_allocate_n_typed(interp, size, char);
+        if (Parrot_io_internal_read(interp, fp, bytes, (size_t)size) != (size_t)size) {
+            mem_gc_free(interp, bytes);
+            Parrot_io_internal_close(interp, fp);
+            Parrot_ex_throw_from_c_args(interp, NULL, EXCEPTION_PIO_ERROR,
+                "Cannot read snapshot file %Ss", filename);
+        }
+    }
+
+    Parrot_io_internal_close(interp, fp);
+
+    thaw.image     = Parrot_str_new_init(interp, bytes, (UINTVAL)size,
+                        Parrot_binary_encoding_ptr, PObj_external_FLAG);
+    thaw.result    = PMCNULL;
+    thaw.exception = PMCNULL;
+
+    Parrot_ext_try(interp, thaw_snapshot_image, catch_snapshot_exception, &thaw);
+
+#ifdef PARROT_HAS_HEADER_SYSMMAN
+    if (is_mapped)
+        munmap(bytes, (size_t)size);
+    else
+#endif
+        mem_gc_free(interp, bytes);
+
+    if (!PMC_IS_NULL(thaw.exception))
+        Parrot_ex_rethrow_from_c(interp, thaw.exception);
+
+    return thaw.result;
+}
+
+/*
+
+=item C<static void thaw_snapshot_image(PARROT_INTERP, void *data)>
+
+Verifies and thaws the image of the C<snapshot_thaw_t> C<data>, storing the
+root in it.
+
+=item C<static void catch_snapshot_exception(PARROT_INTERP, PMC *exception, void
+*data)>
+
+Keeps the C<exception> thrown by C<thaw_snapshot_image()> in the
+C<snapshot_thaw_t> C<data>, to be rethrown once the image is released.
+
+=cut
+
+*/
+
+static void
+thaw_snapshot_image(PARROT_INTERP, ARGIN_NULLOK(void *data))
+{
+    ASSERT_ARGS(thaw_snapshot_image)
+    snapshot_thaw_t * const thaw = (snapshot_thaw_t *)data;
+
+    Parrot_pf_verify_image_string(interp, thaw->image);
+    thaw->result = Parrot_thaw(interp, thaw->image);
+}
+
+static void
+catch_snapshot_exception(SHIM_INTERP, ARGIN_NULLOK(PMC *exception), ARGIN_NULLOK(void *data))
+{
+    ASSERT_ARGS(catch_snapshot_exception)
+    snapshot_thaw_t * const thaw = (snapshot_thaw_t *)data;
+
+    thaw->exception = exception;
+}
+
+
 /*
 
 =item C<PMC* Parrot_clone(PARROT_INTERP, PMC *pmc)>
@@ -115,8 +115,6 @@ PackFile_pack(PARROT_INTERP, ARGMOD(PackFile *self), ARGOUT(opcode_t *cursor))
     int padding_size;
     char *byte_cursor = (char*)cursor;
 
-    self->src = cursor;
-
     /* Pack the fixed part of the header */
     memcpy(cursor, self->header, PACKFILE_HEADER_BYTES);
     byte_cursor += PACKFILE_HEADER_BYTES;
@@ -219,7 +217,7 @@ PackFile_ConstTable_pack_size(PARROT_INTERP, ARGMOD(PackFile_Segment *seg))
     self->pmc_hash = Parrot_hash_create(interp, enum_type_PMC, Hash_key_type_PMC_ptr);
     for (i = 0; i < self->pmc.const_count; i++) {
         Hash *seen;
-        PMC * const c = self->pmc.constants[i];
+        PMC * const c = PackFile_ConstTable_get_pmc(interp, self, i);
         size += PF_size_strlen(Parrot_freeze_pbc_size(interp, c, self, &seen)) - 1;
         update_backref_hash(interp, self, seen, i);
     }
@@ -271,7 +269,7 @@ PackFile_ConstTable_pack(PARROT_INTERP,
     self->pmc_hash = Parrot_hash_create(interp, enum_type_PMC, Hash_key_type_PMC_ptr);
     for (i = 0; i < self->pmc.const_count; i++) {
         Hash *seen;
-        PMC * const c = self->pmc.constants[i];
+        PMC * const c = PackFile_ConstTable_get_pmc(interp, self, i);
         cursor  = Parrot_freeze_pbc(interp, c, self, cursor, &seen);
         update_backref_hash(interp, self, seen, i);
     }
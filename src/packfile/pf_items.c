@@ -1338,6 +1338,29 @@ PF_fetch_buf(PARROT_INTERP, ARGIN_NULLOK(PackFile *pf), ARGIN(const opcode_t **c
 }
 
 
+/*
+
+=item C<const opcode_t * PF_skip_buf(const PackFile *pf, const opcode_t
+*cursor)>
+
+Returns the position just past the buffer at C<cursor>, without fetching it.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+PARROT_CANNOT_RETURN_NULL
+const opcode_t *
+PF_skip_buf(ARGIN_NULLOK(const PackFile *pf), ARGIN(const opcode_t *cursor))
+{
+    ASSERT_ARGS(PF_skip_buf)
+    const int    wordsize = pf ? pf->header->wordsize : sizeof (opcode_t);
+    const size_t size     = PF_fetch_opcode(pf, &cursor);
+    return (const opcode_t *)((const unsigned char *)cursor + ROUND_UP_B(size, wordsize));
+}
+
+
 /*
 
 =item C<opcode_t* PF_store_buf(opcode_t *cursor, const STRING *s)>
@@ -16,6 +16,7 @@ Functions in this file represent behaviors for different PackFile segments.
 /* HEADERIZER HFILE: include/parrot/packfile.h */
 
 #include "parrot/parrot.h"
+#include "parrot/imageio.h"
 #include "pf_private.h"
 #include "pmc/pmc_parrotlibrary.h"
 #include "segments.str"
@@ -70,6 +71,14 @@ PARROT_CANNOT_RETURN_NULL
 static PackFile_Segment * const_new(PARROT_INTERP)
         __attribute__nonnull__(1);
 
+PARROT_CONST_FUNCTION
+PARROT_WARN_UNUSED_RESULT
+static opcode_t const_table_grow(opcode_t slots);
+
+PARROT_CONST_FUNCTION
+PARROT_WARN_UNUSED_RESULT
+static opcode_t const_table_slots(opcode_t count, opcode_t alloc);
+
 static void default_destroy(PARROT_INTERP,
     ARGFREE_NOTNULL(PackFile_Segment *self))
         __attribute__nonnull__(1)
@@ -200,6 +209,14 @@ static const opcode_t * pf_debug_unpack(PARROT_INTERP,
         __attribute__nonnull__(3)
         FUNC_MODIFIES(*self);
 
+PARROT_WARN_UNUSED_RESULT
+static int pmc_constant_is_sub(PARROT_INTERP,
+    ARGIN(PackFile *pf),
+    ARGIN(const opcode_t *cursor))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3);
+
 static void segment_init(
     ARGOUT(PackFile_Segment *self),
     ARGIN(PackFile *pf),
@@ -232,6 +249,8 @@ static void sort_segs(ARGMOD(PackFile_Directory *dir))
     , PARROT_ASSERT_ARG(self))
 #define ASSERT_ARGS_const_new __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp))
+#define ASSERT_ARGS_const_table_grow __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
+#define ASSERT_ARGS_const_table_slots __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
 #define ASSERT_ARGS_default_destroy __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(self))
@@ -290,6 +309,10 @@ static void sort_segs(ARGMOD(PackFile_Directory *dir))
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(self) \
     , PARROT_ASSERT_ARG(cursor))
+#define ASSERT_ARGS_pmc_constant_is_sub __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(pf) \
+    , PARROT_ASSERT_ARG(cursor))
 #define ASSERT_ARGS_segment_init __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(self) \
     , PARROT_ASSERT_ARG(pf) \
@@ -321,6 +344,10 @@ PackFile_ConstTable_clear(PARROT_INTERP, ARGMOD(PackFile_ConstTable *self))
 {
     ASSERT_ARGS(PackFile_ConstTable_clear)
 
+    self->num.const_alloc = 0;
+    self->str.const_alloc = 0;
+    self->pmc.const_alloc = 0;
+
     if (self->num.constants) {
         mem_gc_free(interp, self->num.constants);
         self->num.constants = NULL;
@@ -336,6 +363,16 @@ PackFile_ConstTable_clear(PARROT_INTERP, ARGMOD(PackFile_ConstTable *self))
         self->pmc.constants = NULL;
     }
 
+    if (self->pmc.images) {
+        mem_gc_free(interp, self->pmc.images);
+        self->pmc.images = NULL;
+    }
+
+    if (self->pmc.olists) {
+        mem_gc_free(interp, self->pmc.olists);
+        self->pmc.olists = NULL;
+    }
+
     if (self->string_hash) {
         Parrot_hash_destroy(interp, self->string_hash);
         self->string_hash = NULL;
@@ -350,6 +387,163 @@ PackFile_ConstTable_clear(PARROT_INTERP, ARGMOD(PackFile_ConstTable *self))
 }
 
 
+/*
+
+=item C<opcode_t PackFile_ConstTable_push_num(PARROT_INTERP, PackFile_ConstTable
+*self, FLOATVAL n)>
+
+Appends the number C<n> to the constant table C<self>, returning its index.
+
+The constant arrays of a table being built grow geometrically, so a compiler
+adding thousands of constants one at a time only copies each of them a few
+times.  C<const_alloc> holds the allocated size when it exceeds C<const_count>;
+code that allocates the arrays to their exact size can leave it at zero.
+
+=cut
+
+*/
+
+PARROT_EXPORT
+PARROT_IGNORABLE_RESULT
+opcode_t
+PackFile_ConstTable_push_num(PARROT_INTERP, ARGMOD(PackFile_ConstTable *self), FLOATVAL n)
+{
+    ASSERT_ARGS(PackFile_ConstTable_push_num)
+    const opcode_t slots = const_table_slots(self->num.const_count, self->num.const_alloc);
+
+    if (self->num.const_count == slots) {
+        self->num.const_alloc = const_table_grow(slots);
+        self->num.constants   = mem_gc_realloc_n_typed_zeroed(interp,
+                self->num.constants, self->num.const_alloc, slots, FLOATVAL);
+    }
+
+    self->num.constants[self->num.const_count] = n;
+
+    return self->num.const_count++;
+}
+
+
+/*
+
+=item C<opcode_t PackFile_ConstTable_push_str(PARROT_INTERP, PackFile_ConstTable
+*self, STRING *s)>
+
+Appends the string C<s> to the constant table C<self>, returning its index.
+The string is also entered into the table's reverse lookup hash, if it has
+one.  This doesn't check whether the string is already there; use
+C<PackFile_ConstTable_rlookup_str> for that.
+
+=cut
+
+*/
+
+PARROT_EXPORT
+PARROT_IGNORABLE_RESULT
+opcode_t
+PackFile_ConstTable_push_str(PARROT_INTERP, ARGMOD(PackFile_ConstTable *self),
+        ARGIN(STRING *s))
+{
+    ASSERT_ARGS(PackFile_ConstTable_push_str)
+    const opcode_t slots = const_table_slots(self->str.const_count, self->str.const_alloc);
+
+    if (self->str.const_count == slots) {
+        self->str.const_alloc = const_table_grow(slots);
+        self->str.constants   = mem_gc_realloc_n_typed_zeroed(interp,
+                self->str.constants, self->str.const_alloc, slots, STRING *);
+    }
+
+    self->str.constants[self->str.const_count] = s;
+
+    if (self->string_hash)
+        Parrot_hash_put(interp, self->string_hash, s,
+            (void *)self->str.const_count);
+
+    return self->str.const_count++;
+}
+
+
+/*
+
+=item C<opcode_t PackFile_ConstTable_push_pmc(PARROT_INTERP, PackFile_ConstTable
+*self, PMC *pmc)>
+
+Appends C<pmc> to the constant table C<self>, returning its index.  If the
+table was loaded lazily, its image and object list arrays grow along with the
+constants.
+
+=cut
+
+*/
+
+PARROT_EXPORT
+PARROT_IGNORABLE_RESULT
+opcode_t
+PackFile_ConstTable_push_pmc(PARROT_INTERP, ARGMOD(PackFile_ConstTable *self),
+        ARGIN(PMC *pmc))
+{
+    ASSERT_ARGS(PackFile_ConstTable_push_pmc)
+    const opcode_t slots = const_table_slots(self->pmc.const_count, self->pmc.const_alloc);
+
+    if (self->pmc.const_count == slots) {
+        self->pmc.const_alloc = const_table_grow(slots);
+        self->pmc.constants   = mem_gc_realloc_n_typed_zeroed(interp,
+                self->pmc.constants, self->pmc.const_alloc, slots, PMC *);
+
+        if (self->pmc.images) {
+            self->pmc.images = mem_gc_realloc_n_typed_zeroed(interp,
+                    self->pmc.images, self->pmc.const_alloc, slots, const opcode_t *);
+            self->pmc.olists = mem_gc_realloc_n_typed_zeroed(interp,
+                    self->pmc.olists, self->pmc.const_alloc, slots, PMC *);
+        }
+    }
+
+    self->pmc.constants[self->pmc.const_count] = pmc;
+
+    return self->pmc.const_count++;
+}
+
+
+/*
+
+=item C<static opcode_t const_table_slots(opcode_t count, opcode_t alloc)>
+
+Returns the number of slots allocated for a constant array holding C<count>
+constants, of which C<alloc> were recorded when it was last grown.
+
+=cut
+
+*/
+
+PARROT_CONST_FUNCTION
+PARROT_WARN_UNUSED_RESULT
+static opcode_t
+const_table_slots(opcode_t count, opcode_t alloc)
+{
+    ASSERT_ARGS(const_table_slots)
+    return alloc > count ? alloc : count;
+}
+
+
+/*
+
+=item C<static opcode_t const_table_grow(opcode_t slots)>
+
+Returns the new size of a full constant array of C<slots> elements.
+
+=cut
+
+*/
+
+PARROT_CONST_FUNCTION
+PARROT_WARN_UNUSED_RESULT
+static opcode_t
+const_table_grow(opcode_t slots)
+{
+    ASSERT_ARGS(const_table_grow)
+    return slots < 8 ? 8 : slots * 2;
+}
+
+
 /*
 
 =item C<const opcode_t * PackFile_ConstTable_unpack(PARROT_INTERP,
@@ -360,6 +554,10 @@ Unpacks a PackFile ConstTable from a block of memory. The format is:
   opcode_t const_count
   *  constants
 
+If the PackFile was opened with C<PFOPT_LAZY_CONSTS>, only Sub constants are
+thawed here; every other PMC constant keeps a pointer to its frozen image and
+is thawed by C<PackFile_ConstTable_thaw_pmc()> on first use.
+
 Returns cursor if everything is OK, else zero (0).
 
 =cut
@@ -377,6 +575,10 @@ PackFile_ConstTable_unpack(PARROT_INTERP, ARGMOD(PackFile_Segment *seg),
     STRING              * const sub_str = CONST_STRING(interp, "Sub");
     PackFile_ConstTable * const self    = (PackFile_ConstTable *)seg;
     PackFile            * const pf      = seg->pf;
+    /* a transformed mmap()ed image is unmapped right after unpacking */
+    const int                   lazy    = (pf->options & PFOPT_LAZY_CONSTS)
+                                       && !(pf->is_mmap_ped
+                                       && (pf->need_endianize || pf->need_wordsize));
     opcode_t                    i;
 
     PackFile_ConstTable_clear(interp, self);
@@ -404,6 +606,15 @@ PackFile_ConstTable_unpack(PARROT_INTERP, ARGMOD(PackFile_Segment *seg),
                                     self->pmc.const_count, PMC *);
         if (!self->pmc.constants)
             goto err;
+
+        if (lazy) {
+            self->pmc.images = mem_gc_allocate_n_zeroed_typed(interp,
+                                    self->pmc.const_count, const opcode_t *);
+            self->pmc.olists = mem_gc_allocate_n_zeroed_typed(interp,
+                                    self->pmc.const_count, PMC *);
+            if (!self->pmc.images || !self->pmc.olists)
+                goto err;
+        }
     }
 
     for (i = 0; i < self->num.const_count; i++)
@@ -412,19 +623,37 @@ PackFile_ConstTable_unpack(PARROT_INTERP, ARGMOD(PackFile_Segment *seg),
     for (i = 0; i < self->str.const_count; i++)
         self->str.constants[i] = PF_fetch_string(interp, pf, &cursor);
 
-    for (i = 0; i < self->pmc.const_count; i++)
-        self->pmc.constants[i] = PackFile_Constant_unpack_pmc(interp, self, &cursor);
-
-    for (i = 0; i < self->pmc.const_count; i++) {
-        /* XXX unpack returned the lists of all objects in the object graph
-         * must dereference the first object into the constant slot */
-        PMC      * const pmc  = self->pmc.constants[i]
-                              = VTABLE_get_pmc_keyed_int(interp, self->pmc.constants[i], 0);
+    if (lazy) {
+        /* remember where each image starts; only Subs are needed right away,
+         * as they have to be placed into namespaces */
+        for (i = 0; i < self->pmc.const_count; i++) {
+            self->pmc.images[i] = cursor;
+            if (pmc_constant_is_sub(interp, pf, cursor))
+                (void)PackFile_ConstTable_thaw_pmc(interp, self, i);
+            cursor = PF_skip_buf(pf, cursor);
+        }
 
-        /* magically place subs into namespace stashes
-         * XXX make this explicit with :load subs in PBC */
-        if (VTABLE_isa(interp, pmc, sub_str))
-            Parrot_ns_store_sub(interp, pmc);
+        for (i = 0; i < self->pmc.const_count; i++) {
+            PMC * const pmc = self->pmc.constants[i];
+            if (pmc && VTABLE_isa(interp, pmc, sub_str))
+                Parrot_ns_store_sub(interp, pmc);
+        }
+    }
+    else {
+        for (i = 0; i < self->pmc.const_count; i++)
+            self->pmc.constants[i] = PackFile_Constant_unpack_pmc(interp, self, &cursor);
+
+        for (i = 0; i < self->pmc.const_count; i++) {
+            /* XXX unpack returned the lists of all objects in the object graph
+             * must dereference the first object into the constant slot */
+            PMC      * const pmc  = self->pmc.constants[i]
+                                  = VTABLE_get_pmc_keyed_int(interp, self->pmc.constants[i], 0);
+
+            /* magically place subs into namespace stashes
+             * XXX make this explicit with :load subs in PBC */
+            if (VTABLE_isa(interp, pmc, sub_str))
+                Parrot_ns_store_sub(interp, pmc);
+        }
     }
 
     self->ntags = PF_fetch_opcode(pf, &cursor);
@@ -515,6 +744,119 @@ PackFile_Constant_unpack_pmc(PARROT_INTERP, ARGIN(PackFile_ConstTable *constt),
 }
 
 
+/*
+
+=item C<PMC * PackFile_ConstTable_thaw_pmc(PARROT_INTERP, PackFile_ConstTable
+*self, opcode_t idx)>
+
+Thaws the lazily loaded PMC constant C<idx> from its frozen image and stores
+it into the constant table. Returns the constant. Use the
+C<PackFile_ConstTable_get_pmc> macro to only get here when needed.
+
+=cut
+
+*/
+
+PARROT_EXPORT
+PARROT_CANNOT_RETURN_NULL
+PMC *
+PackFile_ConstTable_thaw_pmc(PARROT_INTERP, ARGMOD(PackFile_ConstTable *self), opcode_t idx)
+{
+    ASSERT_ARGS(PackFile_ConstTable_thaw_pmc)
+    const opcode_t *cursor;
+    PMC            *olist;
+
+    if (self->pmc.constants[idx])
+        return self->pmc.constants[idx];
+
+    if (!self->pmc.images || !self->pmc.images[idx])
+        Parrot_ex_throw_from_c_args(interp, NULL, EXCEPTION_MALFORMED_PACKFILE,
+            "PMC constant %d is missing", (int)idx);
+
+    cursor = self->pmc.images[idx];
+
+    Parrot_block_GC_mark(interp);
+    olist = PackFile_Constant_unpack_pmc(interp, self, &cursor);
+    self->pmc.olists[idx]    = olist;
+    self->pmc.constants[idx] = VTABLE_get_pmc_keyed_int(interp, olist, 0);
+    self->pmc.images[idx]    = NULL;
+    Parrot_unblock_GC_mark(interp);
+
+    return self->pmc.constants[idx];
+}
+
+
+/*
+
+=item C<PMC * PackFile_ConstTable_get_olist(PARROT_INTERP, PackFile_ConstTable
+*self, opcode_t idx)>
+
+Returns the list of all objects thawed with PMC constant C<idx>, which
+back-references from later constants index into. While the table is being
+unpacked eagerly, that list is still held in the constant slot itself.
+
+=cut
+
+*/
+
+PARROT_EXPORT
+PARROT_CANNOT_RETURN_NULL
+PMC *
+PackFile_ConstTable_get_olist(PARROT_INTERP, ARGMOD(PackFile_ConstTable *self), opcode_t idx)
+{
+    ASSERT_ARGS(PackFile_ConstTable_get_olist)
+
+    if (!self->pmc.olists)
+        return self->pmc.constants[idx];
+
+    if (!self->pmc.olists[idx])
+        (void)PackFile_ConstTable_thaw_pmc(interp, self, idx);
+
+    return self->pmc.olists[idx];
+}
+
+
+/*
+
+=item C<static int pmc_constant_is_sub(PARROT_INTERP, PackFile *pf, const
+opcode_t *cursor)>
+
+Peeks at the frozen PMC constant image at C<cursor> and returns true if its
+root object is a Sub, or if that can't be told without thawing it.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+static int
+pmc_constant_is_sub(PARROT_INTERP, ARGIN(PackFile *pf), ARGIN(const opcode_t *cursor))
+{
+    ASSERT_ARGS(pmc_constant_is_sub)
+    STRING * const sub_str = CONST_STRING(interp, "Sub");
+    const opcode_t image_size = PF_fetch_opcode(pf, &cursor);
+    const VTABLE  *vtable;
+    UINTVAL        packid;
+    INTVAL         type;
+
+    UNUSED(image_size);
+    packid = (UINTVAL)PF_fetch_integer(pf, &cursor);
+
+    if (PackID_get_FLAGS(packid) != enum_PackID_normal)
+        return 1;
+
+    type = PF_fetch_integer(pf, &cursor);
+    if (type <= 0 || type >= interp->n_vtable_max
+    || !(vtable = interp->vtables[type]))
+        return 1;
+
+    if (vtable->isa_hash)
+        return Parrot_hash_exists(interp, vtable->isa_hash, sub_str);
+
+    return STRING_equal(interp, vtable->whoami, sub_str);
+}
+
+
 /*
 
 =item C<PackFile_Segment * PackFile_Annotations_new(PARROT_INTERP)>
@@ -774,11 +1116,9 @@ default_unpack(PARROT_INTERP, ARGMOD(PackFile_Segment *self), ARGIN(const opcode
     if (self->size == 0)
         return cursor;
 
-    /* if the packfile is mmap()ed just point to it if we don't
-     * need any fetch transforms */
-    if (self->pf->is_mmap_ped
-    && !self->pf->need_endianize
-    && !self->pf->need_wordsize) {
+    /* if the packfile image is mmap()ed or owned by the packfile, just
+     * point to it if we don't need any fetch transforms */
+    if (PackFile_shares_src(self->pf)) {
         self->data  = PARROT_const_cast(opcode_t *, cursor);
         cursor     += self->size;
         return cursor;
@@ -1617,7 +1957,7 @@ static void
 default_destroy(PARROT_INTERP, ARGFREE_NOTNULL(PackFile_Segment *self))
 {
     ASSERT_ARGS(default_destroy)
-    if (!self->pf->is_mmap_ped && self->data) {
+    if (!PackFile_shares_src(self->pf) && self->data) {
         mem_gc_free(interp, self->data);
         self->data = NULL;
     }
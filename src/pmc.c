@@ -222,6 +222,53 @@ Parrot_pmc_new(PARROT_INTERP, INTVAL base_type)
 
 /*
 
+=item C<PMC * Parrot_pmc_renew(PARROT_INTERP, PMC *pmc, INTVAL base_type)>
+
+As C<Parrot_pmc_new()>, but if C<pmc> is of exactly the type C<base_type>,
+it is destroyed and initialized again in place instead of allocating a new
+header. The caller must know that nothing else refers to C<pmc>, which is
+then returned. Singleton, constant and shared types, and types replaced by
+a PIR class always get a new PMC.
+
+=cut
+
+*/
+
+PARROT_EXPORT
+PARROT_CANNOT_RETURN_NULL
+PARROT_WARN_UNUSED_RESULT
+PMC *
+Parrot_pmc_renew(PARROT_INTERP, ARGMOD_NULLOK(PMC *pmc), INTVAL base_type)
+{
+    ASSERT_ARGS(Parrot_pmc_renew)
+    VTABLE * const vtable = interp->vtables[base_type];
+
+    if (PMC_IS_NULL(pmc) || pmc->vtable != vtable || PObj_constant_TEST(pmc)
+    ||  vtable->flags & (VTABLE_PMC_IS_SINGLETON | VTABLE_IS_CONST_PMC_FLAG
+                       | VTABLE_IS_SHARED_FLAG)
+    || (!PMC_IS_NULL(vtable->pmc_class) && PObj_is_class_TEST(vtable->pmc_class)))
+        return Parrot_pmc_new(interp, base_type);
+    else {
+        const UINTVAL gc_flags = PObj_get_FLAGS(pmc) & PObj_GC_all_FLAGS;
+
+        if (PObj_custom_destroy_TEST(pmc))
+            VTABLE_destroy(interp, pmc);
+
+        /* the PMC may be in an older generation, as in Parrot_pmc_reuse() */
+        PObj_flags_SETTO(pmc, PObj_is_PMC_FLAG | gc_flags);
+        PARROT_GC_WRITE_BARRIER(interp, pmc);
+        PMC_metadata(pmc) = PMCNULL;
+
+        if (vtable->attr_size)
+            memset(PMC_data(pmc), 0, vtable->attr_size);
+
+        VTABLE_init(interp, pmc);
+        return pmc;
+    }
+}
+
+/*
+
 =item C<PMC * Parrot_pmc_new_from_type(PARROT_INTERP, PMC *key)>
 
 Creates a new PMC of type C<key>. You probably do not want this function as
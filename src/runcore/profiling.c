@@ -30,6 +30,12 @@ Functions controlling Parrot's profiling runcore.
 
 #define PPROF_VERSION 2
 
+/* most bytes an unsigned LEB128 varint of a UHUGEINTVAL can take */
+#define PPROF_BINARY_VARINT_MAX 10
+
+/* map signed deltas onto small unsigned numbers: 0, -1, 1, -2, 2, ... */
+#define ZIGZAG(d) ((d) < 0 ? ~((UHUGEINTVAL)(d) << 1) : (UHUGEINTVAL)(d) << 1)
+
 #define code_start interp->code->base.data
 #define code_end (interp->code->base.data + interp->code->base.size)
 
@@ -38,10 +44,38 @@ Functions controlling Parrot's profiling runcore.
 /* HEADERIZER BEGIN: static */
 /* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
 
+static void binary_flush(ARGMOD(Parrot_profiling_runcore_t *runcore))
+        __attribute__nonnull__(1)
+        FUNC_MODIFIES(*runcore);
+
+static UINTVAL binary_intern(PARROT_INTERP,
+    ARGIN(Parrot_profiling_runcore_t *runcore),
+    ARGIN(const char *str))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3);
+
+static void binary_put_varint(
+    ARGMOD(Parrot_profiling_runcore_t *runcore),
+    UHUGEINTVAL value)
+        __attribute__nonnull__(1)
+        FUNC_MODIFIES(*runcore);
+
+static void binary_reserve(
+    ARGMOD(Parrot_profiling_runcore_t *runcore),
+    size_t size)
+        __attribute__nonnull__(1)
+        FUNC_MODIFIES(*runcore);
+
 static void destroy_basic_output(PARROT_INTERP,
     ARGIN(Parrot_profiling_runcore_t *runcore))
         __attribute__nonnull__(2);
 
+static void destroy_binary_output(PARROT_INTERP,
+    ARGIN(Parrot_profiling_runcore_t *runcore))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
 static void destroy_profiling_core(PARROT_INTERP,
     ARGIN(Parrot_profiling_runcore_t *runcore))
         __attribute__nonnull__(1)
@@ -74,6 +108,11 @@ static void init_basic_output(PARROT_INTERP,
         __attribute__nonnull__(1)
         __attribute__nonnull__(2);
 
+static void init_binary_output(PARROT_INTERP,
+    ARGIN(Parrot_profiling_runcore_t *runcore))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
 static void init_null_output(PARROT_INTERP,
     ARGIN(Parrot_profiling_runcore_t *runcore))
         __attribute__nonnull__(1)
@@ -130,6 +169,14 @@ static void record_values_ascii_pprof(PARROT_INTERP,
         __attribute__nonnull__(2)
         __attribute__nonnull__(3);
 
+static void record_values_binary_pprof(PARROT_INTERP,
+    ARGIN(Parrot_profiling_runcore_t * runcore),
+    ARGIN(PPROF_DATA *pprof_data),
+    ARGIN_NULLOK(Parrot_profiling_line type))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3);
+
 static void record_version_and_cli(PARROT_INTERP,
     ARGIN(Parrot_profiling_runcore_t *runcore),
     ARGIN(PPROF_DATA* pprof_data))
@@ -151,8 +198,21 @@ static void store_postop_time(PARROT_INTERP,
         __attribute__nonnull__(1)
         __attribute__nonnull__(2);
 
+#define ASSERT_ARGS_binary_flush __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(runcore))
+#define ASSERT_ARGS_binary_intern __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(runcore) \
+    , PARROT_ASSERT_ARG(str))
+#define ASSERT_ARGS_binary_put_varint __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(runcore))
+#define ASSERT_ARGS_binary_reserve __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(runcore))
 #define ASSERT_ARGS_destroy_basic_output __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(runcore))
+#define ASSERT_ARGS_destroy_binary_output __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(runcore))
 #define ASSERT_ARGS_destroy_profiling_core __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(runcore))
@@ -170,6 +230,9 @@ static void store_postop_time(PARROT_INTERP,
 #define ASSERT_ARGS_init_basic_output __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(runcore))
+#define ASSERT_ARGS_init_binary_output __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(runcore))
 #define ASSERT_ARGS_init_null_output __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(runcore))
@@ -199,6 +262,10 @@ static void store_postop_time(PARROT_INTERP,
 #define ASSERT_ARGS_record_values_ascii_pprof __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(runcore) \
     , PARROT_ASSERT_ARG(pprof_data))
+#define ASSERT_ARGS_record_values_binary_pprof __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(runcore) \
+    , PARROT_ASSERT_ARG(pprof_data))
 #define ASSERT_ARGS_record_version_and_cli __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(runcore) \
@@ -291,6 +358,11 @@ init_profiling_core(PARROT_INTERP, ARGIN(Parrot_profiling_runcore_t *runcore), A
             runcore->output.store   = record_values_ascii_pprof;
             runcore->output.destroy = destroy_basic_output;
         }
+        else if (STRING_equal(interp, profile_format_str, CONST_STRING(interp, "binary"))) {
+            runcore->output.init    = init_binary_output;
+            runcore->output.store   = record_values_binary_pprof;
+            runcore->output.destroy = destroy_binary_output;
+        }
         else if (STRING_equal(interp, profile_format_str, CONST_STRING(interp, "none"))) {
             runcore->output.init    = init_null_output;
             runcore->output.store   = NULL;
@@ -298,7 +370,8 @@ init_profiling_core(PARROT_INTERP, ARGIN(Parrot_profiling_runcore_t *runcore), A
         }
         else {
             Parrot_eprintf(interp, "'%Ss' is not a valid profiling output format.\n", output_str);
-            Parrot_eprintf(interp, "Valid values are pprof and none.  The default is pprof.\n");
+            Parrot_eprintf(interp, "Valid values are pprof, binary and none.  "
+                    "The default is pprof.\n");
             Parrot_x_jump_out(interp, 1);
         }
     }
@@ -788,9 +861,14 @@ destroy_profiling_core(PARROT_INTERP, ARGIN(Parrot_profiling_runcore_t *runcore)
 
     char * const filename_cstr = Parrot_str_to_cstring(interp, runcore->profile_filename);
 
-    fprintf(stderr, "\nPROFILING RUNCORE: wrote profile to %s\n"
-        "Use tools/dev/pprof2cg.pl to generate Callgrind-compatible "
-        "output from this file.\n", filename_cstr);
+    if (runcore->output.store == record_values_binary_pprof)
+        fprintf(stderr, "\nPROFILING RUNCORE: wrote profile to %s\n"
+            "Use pprof_summary to report per-sub and per-line times "
+            "from this file.\n", filename_cstr);
+    else
+        fprintf(stderr, "\nPROFILING RUNCORE: wrote profile to %s\n"
+            "Use tools/dev/pprof2cg.pl to generate Callgrind-compatible "
+            "output from this file.\n", filename_cstr);
 
     Parrot_str_free_cstring(filename_cstr);
     Parrot_hash_destroy(interp, runcore->line_cache);
@@ -867,6 +945,231 @@ record_values_ascii_pprof(SHIM_INTERP, ARGIN(Parrot_profiling_runcore_t * runcor
 
 /*
 
+=item C<static void record_values_binary_pprof(PARROT_INTERP,
+Parrot_profiling_runcore_t * runcore, PPROF_DATA *pprof_data,
+Parrot_profiling_line type)>
+
+Record profiling data in the compact binary format described in
+F<docs/dev/profiling.pod>.  Strings are written once and referred to by id
+afterwards; lines and sub and context addresses are written as deltas from
+the previous record, so a typical op record takes three or four bytes.
+
+=cut
+
+*/
+
+static void
+record_values_binary_pprof(PARROT_INTERP, ARGIN(Parrot_profiling_runcore_t * runcore),
+    ARGIN(PPROF_DATA *pprof_data), ARGIN_NULLOK(Parrot_profiling_line type))
+{
+    ASSERT_ARGS(record_values_binary_pprof)
+
+    switch (type) {
+        case PPROF_LINE_CONTEXT_SWITCH:
+            {
+                const char * const pd_namespace = (const char *) pprof_data[PPROF_DATA_NAMESPACE];
+                const char * const pd_filename  = (const char *) pprof_data[PPROF_DATA_FILENAME];
+                const PPROF_DATA   sub_addr     = pprof_data[PPROF_DATA_SUB_ADDR];
+                const PPROF_DATA   ctx_addr     = pprof_data[PPROF_DATA_CTX_ADDR];
+                const UINTVAL      ns_id        = binary_intern(interp, runcore, pd_namespace);
+                const UINTVAL      file_id      = binary_intern(interp, runcore, pd_filename);
+
+                binary_reserve(runcore, 1 + 4 * PPROF_BINARY_VARINT_MAX);
+                runcore->bin_buf[runcore->bin_len++] = PPROF_BIN_CONTEXT_SWITCH;
+                binary_put_varint(runcore, ns_id);
+                binary_put_varint(runcore, file_id);
+                binary_put_varint(runcore, ZIGZAG(sub_addr - runcore->bin_last_sub));
+                binary_put_varint(runcore, ZIGZAG(ctx_addr - runcore->bin_last_ctx));
+                runcore->bin_last_sub = sub_addr;
+                runcore->bin_last_ctx = ctx_addr;
+            }
+            break;
+
+        case PPROF_LINE_OP:
+            {
+                DECL_CONST_CAST;
+                const char * const opname = (const char *) pprof_data[PPROF_DATA_OPNAME];
+                const PPROF_DATA   line   = pprof_data[PPROF_DATA_LINE];
+                const PPROF_DATA   time   = pprof_data[PPROF_DATA_TIME];
+                UINTVAL            op_id  = (UINTVAL) Parrot_hash_get(interp,
+                                                runcore->bin_opnames, opname);
+
+                if (!op_id) {
+                    op_id = binary_intern(interp, runcore, opname);
+                    Parrot_hash_put(interp, runcore->bin_opnames,
+                            PARROT_const_cast(void *, opname), (void *) op_id);
+                }
+
+                binary_reserve(runcore, 1 + 3 * PPROF_BINARY_VARINT_MAX);
+                runcore->bin_buf[runcore->bin_len++] = PPROF_BIN_OP;
+                binary_put_varint(runcore, op_id);
+                binary_put_varint(runcore, ZIGZAG(line - runcore->bin_last_line));
+                binary_put_varint(runcore, (UHUGEINTVAL) time);
+                runcore->bin_last_line = line;
+            }
+            break;
+
+        case PPROF_LINE_ANNOTATION:
+            {
+                const char * const name  = (const char *) pprof_data[PPROF_DATA_ANNOTATION_NAME];
+                const char * const value = (const char *) pprof_data[PPROF_DATA_ANNOTATION_VALUE];
+                const UINTVAL name_id    = binary_intern(interp, runcore, name);
+                const UINTVAL value_id   = binary_intern(interp, runcore, value);
+
+                binary_reserve(runcore, 1 + 2 * PPROF_BINARY_VARINT_MAX);
+                runcore->bin_buf[runcore->bin_len++] = PPROF_BIN_ANNOTATION;
+                binary_put_varint(runcore, name_id);
+                binary_put_varint(runcore, value_id);
+            }
+            break;
+
+        case PPROF_LINE_CLI:
+            {
+                const UINTVAL cli_id = binary_intern(interp, runcore,
+                                            (const char *) pprof_data[PPROF_DATA_CLI]);
+
+                binary_reserve(runcore, 1 + PPROF_BINARY_VARINT_MAX);
+                runcore->bin_buf[runcore->bin_len++] = PPROF_BIN_CLI;
+                binary_put_varint(runcore, cli_id);
+            }
+            break;
+
+        case PPROF_LINE_VERSION:
+            binary_reserve(runcore, 1 + PPROF_BINARY_VARINT_MAX);
+            runcore->bin_buf[runcore->bin_len++] = PPROF_BIN_VERSION;
+            binary_put_varint(runcore, (UHUGEINTVAL) pprof_data[PPROF_DATA_VERSION]);
+            break;
+
+        case PPROF_LINE_END_OF_RUNLOOP:
+            binary_reserve(runcore, 1);
+            runcore->bin_buf[runcore->bin_len++] = PPROF_BIN_END_OF_RUNLOOP;
+            break;
+
+        default:
+            break;
+    } /* switch */
+}
+
+/*
+
+=item C<static UINTVAL binary_intern(PARROT_INTERP, Parrot_profiling_runcore_t
+*runcore, const char *str)>
+
+Return the id of C<str> in the binary profile, writing a string record the
+first time it's seen.
+
+=cut
+
+*/
+
+static UINTVAL
+binary_intern(PARROT_INTERP, ARGIN(Parrot_profiling_runcore_t *runcore),
+    ARGIN(const char *str))
+{
+    ASSERT_ARGS(binary_intern)
+
+    UINTVAL      id  = (UINTVAL) Parrot_hash_get(interp, runcore->bin_strings, str);
+    const size_t len = strlen(str);
+
+    if (id)
+        return id;
+
+    id = ++runcore->bin_next_id;
+    Parrot_hash_put(interp, runcore->bin_strings, mem_sys_strdup(str), (void *) id);
+
+    binary_reserve(runcore, 1 + 2 * PPROF_BINARY_VARINT_MAX);
+    runcore->bin_buf[runcore->bin_len++] = PPROF_BIN_STRING;
+    binary_put_varint(runcore, id);
+    binary_put_varint(runcore, len);
+
+    /* anything too big for the buffer goes straight to the file */
+    if (len > PPROF_BINARY_BUFFER_SIZE) {
+        binary_flush(runcore);
+        fwrite(str, 1, len, runcore->profile_fd);
+    }
+    else {
+        binary_reserve(runcore, len);
+        memcpy(runcore->bin_buf + runcore->bin_len, str, len);
+        runcore->bin_len += len;
+    }
+
+    return id;
+}
+
+/*
+
+=item C<static void binary_put_varint(Parrot_profiling_runcore_t *runcore,
+UHUGEINTVAL value)>
+
+Append C<value> to the binary output buffer as an unsigned LEB128 varint: seven
+bits per byte, low bits first, with the high bit set on all but the last byte.
+The caller must have reserved C<PPROF_BINARY_VARINT_MAX> bytes.
+
+=cut
+
+*/
+
+static void
+binary_put_varint(ARGMOD(Parrot_profiling_runcore_t *runcore), UHUGEINTVAL value)
+{
+    ASSERT_ARGS(binary_put_varint)
+
+    unsigned char *out = runcore->bin_buf + runcore->bin_len;
+
+    while (value >= 0x80) {
+        *out++   = (unsigned char) (value | 0x80);
+        value  >>= 7;
+    }
+    *out++ = (unsigned char) value;
+
+    runcore->bin_len = out - runcore->bin_buf;
+}
+
+/*
+
+=item C<static void binary_reserve(Parrot_profiling_runcore_t *runcore, size_t
+size)>
+
+Make room for C<size> more bytes in the binary output buffer, flushing it to
+the file if necessary.
+
+=cut
+
+*/
+
+static void
+binary_reserve(ARGMOD(Parrot_profiling_runcore_t *runcore), size_t size)
+{
+    ASSERT_ARGS(binary_reserve)
+
+    if (runcore->bin_len + size > PPROF_BINARY_BUFFER_SIZE)
+        binary_flush(runcore);
+}
+
+/*
+
+=item C<static void binary_flush(Parrot_profiling_runcore_t *runcore)>
+
+Write out the contents of the binary output buffer.  The buffer is large, so
+this happens rarely and in big blocks rather than once per op.
+
+=cut
+
+*/
+
+static void
+binary_flush(ARGMOD(Parrot_profiling_runcore_t *runcore))
+{
+    ASSERT_ARGS(binary_flush)
+
+    if (runcore->bin_len) {
+        fwrite(runcore->bin_buf, 1, runcore->bin_len, runcore->profile_fd);
+        runcore->bin_len = 0;
+    }
+}
+
+/*
+
 =item C<static void init_basic_output(PARROT_INTERP, Parrot_profiling_runcore_t
 *runcore)>
 
@@ -953,6 +1256,68 @@ destroy_basic_output(SHIM_INTERP, ARGIN(Parrot_profiling_runcore_t *runcore))
 
 /*
 
+=item C<static void init_binary_output(PARROT_INTERP, Parrot_profiling_runcore_t
+*runcore)>
+
+Perform initialization needed by the binary output methods: open the file as
+for the text format, then set up the output buffer and string tables and
+write the file header.
+
+=cut
+
+*/
+
+static void
+init_binary_output(PARROT_INTERP, ARGIN(Parrot_profiling_runcore_t *runcore))
+{
+    ASSERT_ARGS(init_binary_output)
+
+    init_basic_output(interp, runcore);
+
+    runcore->bin_buf       = (unsigned char *) mem_sys_allocate(PPROF_BINARY_BUFFER_SIZE);
+    runcore->bin_len       = 0;
+    runcore->bin_strings   = Parrot_hash_create(interp, enum_type_ptr, Hash_key_type_cstring);
+    runcore->bin_opnames   = Parrot_hash_new_pointer_hash(interp);
+    runcore->bin_next_id   = 0;
+    runcore->bin_last_line = 0;
+    runcore->bin_last_sub  = 0;
+    runcore->bin_last_ctx  = 0;
+
+    memcpy(runcore->bin_buf, PPROF_BINARY_MAGIC, PPROF_BINARY_MAGIC_LEN);
+    runcore->bin_len = PPROF_BINARY_MAGIC_LEN;
+    binary_put_varint(runcore, PPROF_BINARY_VERSION);
+}
+
+/*
+
+=item C<static void destroy_binary_output(PARROT_INTERP,
+Parrot_profiling_runcore_t *runcore)>
+
+Flush any buffered binary output, then free the string tables and close the
+file.
+
+=cut
+
+*/
+
+static void
+destroy_binary_output(PARROT_INTERP, ARGIN(Parrot_profiling_runcore_t *runcore))
+{
+    ASSERT_ARGS(destroy_binary_output)
+
+    binary_flush(runcore);
+
+    parrot_hash_iterate(runcore->bin_strings,
+        mem_sys_free(_bucket->key););
+    Parrot_hash_destroy(interp, runcore->bin_strings);
+    Parrot_hash_destroy(interp, runcore->bin_opnames);
+    mem_sys_free(runcore->bin_buf);
+
+    destroy_basic_output(interp, runcore);
+}
+
+/*
+
 =item C<static void init_null_output(PARROT_INTERP, Parrot_profiling_runcore_t
 *runcore)>
 
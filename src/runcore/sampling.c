@@ -0,0 +1,777 @@
+/*
+Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+src/runcore/sampling.c - Parrot's sampling profiler runcore
+
+=head1 DESCRIPTION
+
+The sampling runcore is a statistical profiler which is cheap enough to leave
+enabled on production workloads.  Instead of recording every op or every call,
+it arms a C<SIGPROF> interval timer and looks at the call chain only when the
+timer has fired.
+
+The signal handler does nothing but bump a counter.  The runloop compares that
+counter against the last value it saw before dispatching each op, and when it
+has changed copies the C<CallContext> chain (sub and pc of every frame) into a
+fixed-size ring of raw samples.  Copying a few pointers is all that happens on
+the hot path; turning subs and pcs into names, file names and line numbers is
+deferred until the ring fills up or the outermost runloop exits.
+
+At interpreter destruction the aggregated samples are written in the "folded
+stacks" format understood by flame graph tools: one line per distinct call
+chain, outermost frame first, frames separated by C<;>, followed by the number
+of samples.
+
+=head2 Functions
+
+=over 4
+
+=cut
+
+*/
+
+#include "parrot/runcore_api.h"
+#include "parrot/runcore_sampling.h"
+#include "parrot/oplib/ops.h"
+#include "parrot/oplib/core_ops.h"
+
+#include "sampling.str"
+
+#include "pmc/pmc_sub.h"
+
+#ifndef _WIN32
+#  include <sys/time.h>
+#  include <signal.h>
+#endif
+
+/* the tick counter wraps well before it could overflow a sig_atomic_t */
+#define SAMPLING_TICK_MASK 0x3fffffff
+
+/* Timer ticks since the profiler was started.  Written only by the signal
+ * handler; every sampling runloop compares it against its own last-seen
+ * value, so no locking is needed. */
+static volatile sig_atomic_t sampling_ticks = 0;
+
+#ifndef _WIN32
+static struct sigaction sampling_old_action;
+#endif
+
+/* HEADERIZER HFILE: include/parrot/runcore_sampling.h */
+
+/* HEADERIZER BEGIN: static */
+/* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
+
+static size_t append_frame(
+    ARGMOD(Parrot_sampling_runcore_t *runcore),
+    size_t len,
+    ARGIN(const char *text))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(3)
+        FUNC_MODIFIES(*runcore);
+
+static INTVAL debug_line(PARROT_INTERP,
+    ARGIN(PackFile_ByteCode *seg),
+    size_t offs)
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+static void destroy_sampling_core(PARROT_INTERP,
+    ARGIN(Parrot_sampling_runcore_t *runcore))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+static void drain_samples(PARROT_INTERP,
+    ARGMOD(Parrot_sampling_runcore_t *runcore))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(*runcore);
+
+PARROT_CANNOT_RETURN_NULL
+static const char * frame_label(PARROT_INTERP,
+    ARGMOD(Parrot_sampling_runcore_t *runcore),
+    ARGIN(const sampling_frame *frame))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        FUNC_MODIFIES(*runcore);
+
+static void init_sampling_core(PARROT_INTERP,
+    ARGMOD(Parrot_sampling_runcore_t *runcore))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(*runcore);
+
+PARROT_WARN_UNUSED_RESULT
+PARROT_CAN_RETURN_NULL
+static opcode_t * runops_sampling_core(PARROT_INTERP,
+    ARGIN(Parrot_sampling_runcore_t *runcore),
+    ARGIN(opcode_t *pc))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3);
+
+static void sampling_signal_handler(int sig_number);
+static void start_sampling_timer(PARROT_INTERP, UINTVAL hz)
+        __attribute__nonnull__(1);
+
+static void stop_sampling_timer(void);
+static void take_sample(PARROT_INTERP,
+    ARGMOD(Parrot_sampling_runcore_t *runcore))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(*runcore);
+
+static void write_folded_stacks(PARROT_INTERP,
+    ARGIN(Parrot_sampling_runcore_t *runcore))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+#define ASSERT_ARGS_append_frame __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(runcore) \
+    , PARROT_ASSERT_ARG(text))
+#define ASSERT_ARGS_debug_line __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(seg))
+#define ASSERT_ARGS_destroy_sampling_core __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(runcore))
+#define ASSERT_ARGS_drain_samples __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(runcore))
+#define ASSERT_ARGS_frame_label __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(runcore) \
+    , PARROT_ASSERT_ARG(frame))
+#define ASSERT_ARGS_init_sampling_core __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(runcore))
+#define ASSERT_ARGS_runops_sampling_core __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(runcore) \
+    , PARROT_ASSERT_ARG(pc))
+#define ASSERT_ARGS_sampling_signal_handler __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
+#define ASSERT_ARGS_start_sampling_timer __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp))
+#define ASSERT_ARGS_stop_sampling_timer __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
+#define ASSERT_ARGS_take_sample __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(runcore))
+#define ASSERT_ARGS_write_folded_stacks __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(runcore))
+/* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
+/* HEADERIZER END: static */
+
+/*
+
+=item C<void Parrot_runcore_sampling_init(PARROT_INTERP)>
+
+Registers the sampling runcore with Parrot.
+
+=cut
+
+*/
+
+void
+Parrot_runcore_sampling_init(PARROT_INTERP)
+{
+    ASSERT_ARGS(Parrot_runcore_sampling_init)
+
+    Parrot_sampling_runcore_t * const coredata =
+                                mem_gc_allocate_zeroed_typed(interp, Parrot_sampling_runcore_t);
+
+    coredata->name        = CONST_STRING(interp, "sampling");
+    coredata->id          = PARROT_SAMPLING_CORE;
+    coredata->opinit      = PARROT_CORE_OPLIB_INIT;
+    coredata->runops      = (Parrot_runcore_runops_fn_t) runops_sampling_core;
+    coredata->prepare_run = NULL;
+    coredata->destroy     = (Parrot_runcore_destroy_fn_t) destroy_sampling_core;
+    coredata->flags       = 0;
+
+    PARROT_RUNCORE_FUNC_TABLE_SET(coredata);
+
+    Parrot_runcore_register(interp, (Parrot_runcore_t *) coredata);
+}
+
+/*
+
+=item C<static void sampling_signal_handler(int sig_number)>
+
+C<SIGPROF> handler.  Only touches the tick counter, which keeps it
+async-signal-safe.
+
+=cut
+
+*/
+
+static void
+sampling_signal_handler(SHIM(int sig_number))
+{
+    ASSERT_ARGS(sampling_signal_handler)
+
+    sampling_ticks = (sampling_ticks + 1) & SAMPLING_TICK_MASK;
+}
+
+/*
+
+=item C<static void start_sampling_timer(PARROT_INTERP, UINTVAL hz)>
+
+Installs the C<SIGPROF> handler and arms the process CPU-time interval timer to
+fire C<hz> times per second.  Platforms without C<SIGPROF> can't drive the
+core, so it refuses to run there rather than run without taking samples.
+
+=cut
+
+*/
+
+static void
+start_sampling_timer(PARROT_INTERP, UINTVAL hz)
+{
+    ASSERT_ARGS(start_sampling_timer)
+#ifdef _WIN32
+    UNUSED(hz);
+    Parrot_ex_throw_from_c_args(interp, NULL, EXCEPTION_UNIMPLEMENTED,
+        "The sampling runcore is not available on this platform");
+#else
+    struct sigaction sa;
+    struct itimerval itmr;
+    const long       usec = 1000000 / hz;
+
+    memset(&sa, 0, sizeof (struct sigaction));
+    sa.sa_handler = sampling_signal_handler;
+    sa.sa_flags   = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+
+    if (sigaction(SIGPROF, &sa, &sampling_old_action) == -1)
+        Parrot_ex_throw_from_c_args(interp, NULL, EXCEPTION_EXTERNAL_ERROR,
+            "sigaction failed in sampling runcore");
+
+    itmr.it_value.tv_sec     = usec / 1000000;
+    itmr.it_value.tv_usec    = usec % 1000000;
+    itmr.it_interval         = itmr.it_value;
+
+    if (setitimer(ITIMER_PROF, &itmr, NULL) == -1)
+        Parrot_ex_throw_from_c_args(interp, NULL, EXCEPTION_EXTERNAL_ERROR,
+            "setitimer failed in sampling runcore");
+#endif
+}
+
+/*
+
+=item C<static void stop_sampling_timer(void)>
+
+Disarms the interval timer and restores the previous C<SIGPROF> disposition.
+
+=cut
+
+*/
+
+static void
+stop_sampling_timer(void)
+{
+    ASSERT_ARGS(stop_sampling_timer)
+#ifndef _WIN32
+    struct itimerval itmr;
+
+    memset(&itmr, 0, sizeof (struct itimerval));
+    setitimer(ITIMER_PROF, &itmr, NULL);
+    sigaction(SIGPROF, &sampling_old_action, NULL);
+#endif
+}
+
+/*
+
+=item C<static void init_sampling_core(PARROT_INTERP, Parrot_sampling_runcore_t
+*runcore)>
+
+Reads the C<PARROT_SAMPLING_*> environment variables, starts the timer and
+sets up the sample buffers.  Called the first time the core runs.
+
+=cut
+
+*/
+
+static void
+init_sampling_core(PARROT_INTERP, ARGMOD(Parrot_sampling_runcore_t *runcore))
+{
+    ASSERT_ARGS(init_sampling_core)
+
+    STRING * const env_hz       = Parrot_getenv(interp, CONST_STRING(interp, "PARROT_SAMPLING_HZ"));
+    STRING * const env_filename = Parrot_getenv(interp, CONST_STRING(interp, "PARROT_SAMPLING_FILENAME"));
+
+    runcore->hz = SAMPLING_DEFAULT_HZ;
+    if (!STRING_IS_NULL(env_hz)) {
+        const INTVAL hz = Parrot_str_to_int(interp, env_hz);
+        if (hz > 0 && hz <= 1000000)
+            runcore->hz = hz;
+    }
+
+    if (!STRING_IS_NULL(env_filename)) {
+        STRING * const lc_filename = Parrot_str_downcase(interp, env_filename);
+        STRING * const s_stderr    = CONST_STRING(interp, "stderr");
+        STRING * const s_stdout    = CONST_STRING(interp, "stdout");
+
+        if (STRING_equal(interp, lc_filename, s_stderr)
+        ||  STRING_equal(interp, lc_filename, s_stdout))
+            runcore->filename = Parrot_str_to_cstring(interp, lc_filename);
+        else
+            runcore->filename = Parrot_str_to_cstring(interp, env_filename);
+    }
+    else
+        runcore->filename = Parrot_str_to_cstring(interp,
+            Parrot_sprintf_c(interp, "parrot.folded.%vu", Parrot_getpid()));
+
+    /* throws where there is no timer, before anything needs cleaning up */
+    start_sampling_timer(interp, runcore->hz);
+
+    runcore->ring      = mem_gc_allocate_n_zeroed_typed(interp,
+                            SAMPLING_RING_SIZE, sampling_record);
+    runcore->seen_subs = Parrot_hash_create(interp, enum_type_ptr, Hash_key_type_PMC_ptr);
+    runcore->labels    = Parrot_hash_create(interp, enum_type_ptr, Hash_key_type_ptr);
+    runcore->stacks    = Parrot_hash_create(interp, enum_type_ptr, Hash_key_type_cstring);
+    runcore->markpmcs  = Parrot_pmc_new(interp, enum_class_ResizablePMCArray);
+    Parrot_pmc_gc_register(interp, runcore->markpmcs);
+
+    runcore->buf_size  = 256;
+    runcore->buf       = (char *) mem_sys_allocate(runcore->buf_size);
+
+    runcore->ticks_seen = sampling_ticks;
+}
+
+/*
+
+=item C<static opcode_t * runops_sampling_core(PARROT_INTERP,
+Parrot_sampling_runcore_t *runcore, opcode_t *pc)>
+
+Runs the opcodes starting at C<pc> like the fast core, taking a sample at the
+first op boundary after each timer tick.
+
+=cut
+
+*/
+
+PARROT_WARN_UNUSED_RESULT
+PARROT_CAN_RETURN_NULL
+static opcode_t *
+runops_sampling_core(PARROT_INTERP, ARGIN(Parrot_sampling_runcore_t *runcore),
+        ARGIN(opcode_t *pc))
+{
+    ASSERT_ARGS(runops_sampling_core)
+
+    if (!runcore->ring)
+        init_sampling_core(interp, runcore);
+
+    while (pc) {
+        Parrot_pcc_set_pc(interp, CURRENT_CONTEXT(interp), pc);
+
+        if (sampling_ticks != runcore->ticks_seen)
+            take_sample(interp, runcore);
+
+        DO_OP(pc, interp);
+    }
+
+    /* symbolize while the code is certainly still around */
+    if (interp->current_runloop_level <= 1)
+        drain_samples(interp, runcore);
+
+    return pc;
+}
+
+/*
+
+=item C<static void take_sample(PARROT_INTERP, Parrot_sampling_runcore_t
+*runcore)>
+
+Copies the current call chain into the next free slot of the ring, draining
+the ring first if it is full.  Only pointers are copied; a sub seen for the
+first time is anchored so it survives until its sample has been symbolized.
+
+=cut
+
+*/
+
+static void
+take_sample(PARROT_INTERP, ARGMOD(Parrot_sampling_runcore_t *runcore))
+{
+    ASSERT_ARGS(take_sample)
+
+    const int        ticks = sampling_ticks;
+    PMC * const      top   = CURRENT_CONTEXT(interp);
+    PMC             *ctx   = top;
+    sampling_record *rec;
+    UINTVAL          depth = 0;
+
+    if (runcore->ring_head - runcore->ring_tail == SAMPLING_RING_SIZE)
+        drain_samples(interp, runcore);
+
+    rec            = &runcore->ring[runcore->ring_head % SAMPLING_RING_SIZE];
+    rec->weight    = (UINTVAL)((ticks - runcore->ticks_seen) & SAMPLING_TICK_MASK);
+    rec->truncated = 0;
+    runcore->ticks_seen = ticks;
+
+    while (!PMC_IS_NULL(ctx)) {
+        PMC * const sub = Parrot_pcc_get_sub(interp, ctx);
+
+        if (!PMC_IS_NULL(sub)) {
+            opcode_t *pc = Parrot_pcc_get_pc(interp, ctx);
+
+            if (depth == SAMPLING_MAX_DEPTH) {
+                rec->truncated = 1;
+                break;
+            }
+
+            /* callers have already advanced past the invoke op */
+            if (pc && ctx != top)
+                --pc;
+
+            rec->frames[depth].sub = sub;
+            rec->frames[depth].pc  = pc;
+            ++depth;
+
+            if (!Parrot_hash_exists(interp, runcore->seen_subs, sub)) {
+                Parrot_hash_put(interp, runcore->seen_subs, sub, sub);
+                VTABLE_push_pmc(interp, runcore->markpmcs, sub);
+            }
+        }
+
+        ctx = Parrot_pcc_get_caller_ctx(interp, ctx);
+    }
+
+    rec->depth = depth;
+    ++runcore->ring_head;
+    ++runcore->samples;
+}
+
+/*
+
+=item C<static void drain_samples(PARROT_INTERP, Parrot_sampling_runcore_t
+*runcore)>
+
+Symbolizes every buffered sample and adds it to the folded stack totals.
+Once the ring is empty no sample refers to a sub any more, so the subs kept
+alive for it are let go.  Only the first C<SAMPLING_MAX_STACKS> distinct call
+chains get a line of their own; samples of any further ones are counted as
+C<[other]>.
+
+=cut
+
+*/
+
+static void
+drain_samples(PARROT_INTERP, ARGMOD(Parrot_sampling_runcore_t *runcore))
+{
+    ASSERT_ARGS(drain_samples)
+
+    while (runcore->ring_tail != runcore->ring_head) {
+        const sampling_record * const rec =
+                &runcore->ring[runcore->ring_tail % SAMPLING_RING_SIZE];
+        sampling_stack *stack;
+        size_t          len = 0;
+        UINTVAL         i;
+
+        runcore->buf[0] = '\0';
+
+        if (rec->truncated)
+            len = append_frame(runcore, len, "[truncated]");
+
+        for (i = rec->depth; i > 0; --i)
+            len = append_frame(runcore, len,
+                    frame_label(interp, runcore, &rec->frames[i - 1]));
+
+        if (!len)
+            len = append_frame(runcore, len, "[unknown]");
+
+        stack = (sampling_stack *) Parrot_hash_get(interp, runcore->stacks, runcore->buf);
+
+        if (!stack && Parrot_hash_size(interp, runcore->stacks) >= SAMPLING_MAX_STACKS) {
+            runcore->buf[0] = '\0';
+            append_frame(runcore, 0, "[other]");
+            stack = (sampling_stack *) Parrot_hash_get(interp, runcore->stacks, runcore->buf);
+        }
+
+        if (!stack) {
+            stack         = mem_gc_allocate_zeroed_typed(interp, sampling_stack);
+            stack->folded = mem_sys_strdup(runcore->buf);
+            Parrot_hash_put(interp, runcore->stacks, stack->folded, stack);
+        }
+
+        stack->count += rec->weight;
+        ++runcore->ring_tail;
+    }
+
+    if (Parrot_hash_size(interp, runcore->seen_subs)) {
+        Parrot_hash_destroy(interp, runcore->seen_subs);
+        runcore->seen_subs = Parrot_hash_create(interp, enum_type_ptr, Hash_key_type_PMC_ptr);
+        VTABLE_set_integer_native(interp, runcore->markpmcs, 0);
+    }
+}
+
+/*
+
+=item C<static size_t append_frame(Parrot_sampling_runcore_t *runcore, size_t
+len, const char *text)>
+
+Appends C<text> as a new frame to the folded stack being built in the
+runcore's buffer, which currently holds C<len> characters.  Returns the new
+length.
+
+=cut
+
+*/
+
+static size_t
+append_frame(ARGMOD(Parrot_sampling_runcore_t *runcore), size_t len,
+        ARGIN(const char *text))
+{
+    ASSERT_ARGS(append_frame)
+
+    const size_t text_len = strlen(text);
+    const size_t needed   = len + text_len + 2;
+
+    if (needed > runcore->buf_size) {
+        while (needed > runcore->buf_size)
+            runcore->buf_size *= 2;
+        runcore->buf = (char *) mem_sys_realloc(runcore->buf, runcore->buf_size);
+    }
+
+    if (len)
+        runcore->buf[len++] = ';';
+
+    memcpy(runcore->buf + len, text, text_len + 1);
+    return len + text_len;
+}
+
+/*
+
+=item C<static const char * frame_label(PARROT_INTERP, Parrot_sampling_runcore_t
+*runcore, const sampling_frame *frame)>
+
+Returns the printable name of a frame: the sub's full name with namespaces
+joined by C<::>, followed by the source position.  The position comes from the
+C<file> and C<line> annotations if the HLL compiler emitted them, and from the
+PIR debug segment otherwise.  Labels are cached per pc.
+
+=cut
+
+*/
+
+PARROT_CANNOT_RETURN_NULL
+static const char *
+frame_label(PARROT_INTERP, ARGMOD(Parrot_sampling_runcore_t *runcore),
+        ARGIN(const sampling_frame *frame))
+{
+    ASSERT_ARGS(frame_label)
+
+    void * const       key   = frame->pc ? (void *) frame->pc : (void *) frame->sub;
+    sampling_label    *label = (sampling_label *) Parrot_hash_get(interp, runcore->labels, key);
+    Parrot_Sub_attributes *sub;
+    STRING            *name, *file = STRINGNULL;
+    INTVAL             line = -1;
+
+    if (label && label->sub == frame->sub)
+        return label->text;
+
+    name = Parrot_sub_full_sub_name(interp, frame->sub);
+    if (STRING_IS_NULL(name))
+        name = CONST_STRING(interp, "(anon)");
+    else {
+        STRING * const ns_sep     = CONST_STRING(interp, ";");
+        STRING * const folded_sep = CONST_STRING(interp, "::");
+        name = Parrot_str_join(interp, folded_sep, Parrot_str_split(interp, ns_sep, name));
+    }
+
+    PMC_get_sub(interp, frame->sub, sub);
+
+    if (frame->pc && sub->seg
+    &&  frame->pc >= sub->seg->base.data
+    &&  frame->pc <  sub->seg->base.data + sub->seg->base.size) {
+        PackFile_ByteCode * const seg  = sub->seg;
+        const size_t              offs = frame->pc - seg->base.data;
+
+        if (seg->annotations) {
+            STRING * const file_key = CONST_STRING(interp, "file");
+            STRING * const line_key = CONST_STRING(interp, "line");
+            PMC    * const ann_file = PackFile_Annotations_lookup(interp,
+                                        seg->annotations, offs + 1, file_key);
+            PMC    * const ann_line = PackFile_Annotations_lookup(interp,
+                                        seg->annotations, offs + 1, line_key);
+
+            if (!PMC_IS_NULL(ann_file))
+                file = VTABLE_get_string(interp, ann_file);
+            if (!PMC_IS_NULL(ann_line))
+                line = VTABLE_get_integer(interp, ann_line);
+        }
+
+        if (seg->debugs) {
+            if (STRING_IS_NULL(file))
+                file = Parrot_debug_pc_to_filename(interp, seg->debugs, offs);
+            if (line < 0)
+                line = debug_line(interp, seg, offs);
+        }
+    }
+
+    if (!STRING_IS_NULL(file))
+        name = Parrot_sprintf_c(interp, "%Ss (%Ss:%d)", name, file, line);
+
+    if (!label) {
+        label = mem_gc_allocate_zeroed_typed(interp, sampling_label);
+        Parrot_hash_put(interp, runcore->labels, key, label);
+    }
+    else
+        mem_sys_free(label->text);
+
+    {
+        char * const cstr = Parrot_str_to_cstring(interp, name);
+        label->sub  = frame->sub;
+        label->text = mem_sys_strdup(cstr);
+        Parrot_str_free_cstring(cstr);
+    }
+
+    return label->text;
+}
+
+/*
+
+=item C<static INTVAL debug_line(PARROT_INTERP, PackFile_ByteCode *seg, size_t
+offs)>
+
+Returns the source line of the op in C<seg> which contains bytecode offset
+C<offs>, or -1 if the debug segment doesn't cover it.
+
+=cut
+
+*/
+
+static INTVAL
+debug_line(PARROT_INTERP, ARGIN(PackFile_ByteCode *seg), size_t offs)
+{
+    ASSERT_ARGS(debug_line)
+
+    const PackFile_Debug * const debug = seg->debugs;
+    opcode_t *pc = seg->base.data;
+    size_t    i, n;
+
+    for (i = n = 0; n < seg->base.size && i < debug->base.size; ++i) {
+        op_info_t * const op_info  = seg->op_info_table[*pc];
+        opcode_t          var_args = 0;
+
+        ADD_OP_VAR_PART(interp, seg, pc, var_args);
+        n  += op_info->op_count + var_args;
+        pc += op_info->op_count + var_args;
+
+        if (n > offs)
+            return debug->base.data[i];
+    }
+
+    return -1;
+}
+
+/*
+
+=item C<static void write_folded_stacks(PARROT_INTERP, Parrot_sampling_runcore_t
+*runcore)>
+
+Writes the collected folded stacks to the output file.
+
+=cut
+
+*/
+
+static void
+write_folded_stacks(PARROT_INTERP, ARGIN(Parrot_sampling_runcore_t *runcore))
+{
+    ASSERT_ARGS(write_folded_stacks)
+
+    FILE *out;
+
+    if (STREQ(runcore->filename, "stderr"))
+        out = stderr;
+    else if (STREQ(runcore->filename, "stdout"))
+        out = stdout;
+    else
+        out = fopen(runcore->filename, "w");
+
+    if (!out) {
+        fprintf(stderr, "SAMPLING RUNCORE: unable to open %s for writing\n",
+                runcore->filename);
+        return;
+    }
+
+    parrot_hash_iterate(runcore->stacks,
+        const sampling_stack * const stack = (const sampling_stack *) _bucket->value;
+        fprintf(out, "%s %lu\n", stack->folded, (unsigned long) stack->count););
+
+    if (out == stdout || out == stderr)
+        fflush(out);
+    else
+        fclose(out);
+
+    fprintf(stderr, "\nSAMPLING RUNCORE: wrote %lu samples to %s\n",
+            (unsigned long) runcore->samples, runcore->filename);
+}
+
+/*
+
+=item C<static void destroy_sampling_core(PARROT_INTERP,
+Parrot_sampling_runcore_t *runcore)>
+
+Stops the timer, writes the profile and releases everything the core
+allocated.
+
+=cut
+
+*/
+
+static void
+destroy_sampling_core(PARROT_INTERP, ARGIN(Parrot_sampling_runcore_t *runcore))
+{
+    ASSERT_ARGS(destroy_sampling_core)
+
+    if (!runcore->ring)
+        return;
+
+    stop_sampling_timer();
+    drain_samples(interp, runcore);
+    write_folded_stacks(interp, runcore);
+
+    parrot_hash_iterate(runcore->stacks,
+        sampling_stack * const stack = (sampling_stack *) _bucket->value;
+        mem_sys_free(stack->folded);
+        mem_gc_free(interp, stack););
+
+    parrot_hash_iterate(runcore->labels,
+        sampling_label * const label = (sampling_label *) _bucket->value;
+        mem_sys_free(label->text);
+        mem_gc_free(interp, label););
+
+    Parrot_hash_destroy(interp, runcore->stacks);
+    Parrot_hash_destroy(interp, runcore->labels);
+    Parrot_hash_destroy(interp, runcore->seen_subs);
+    Parrot_pmc_gc_unregister(interp, runcore->markpmcs);
+
+    Parrot_str_free_cstring(runcore->filename);
+    mem_sys_free(runcore->buf);
+    mem_gc_free(interp, runcore->ring);
+    runcore->ring = NULL;
+}
+
+/*
+
+=back
+
+=head1 SEE ALSO
+
+F<src/runcore/profiling.c>, F<src/runcore/subprof.c>, F<docs/dev/profiling.pod>
+
+=cut
+
+*/
+
+/*
+ * Local variables:
+ *   c-file-style: "parrot"
+ * End:
+ * vim: expandtab shiftwidth=4 cinoptions='\:2=2' :
+ */
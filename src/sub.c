@@ -337,6 +337,41 @@ Parrot_sub_find_pad(PARROT_INTERP, ARGIN(STRING *lex_name), ARGIN(PMC *ctx))
 }
 
 
+/*
+
+=item C<PMC* Parrot_sub_find_lex_ctx(PARROT_INTERP, PMC *ctx, INTVAL depth,
+INTVAL regno, INTVAL regtype)>
+
+Follow the C<outer_ctx> chain C<depth> steps up from C<ctx> and return the
+context found there, if register C<regno> of type C<regtype> exists in it.
+Return PMCNULL if the chain is too short or the register is out of range.
+This is the runtime half of IMCC's compile-time resolved lexical addressing,
+used by the C<find_lex_slot> and C<store_lex_slot> ops.
+
+=cut
+
+*/
+
+PARROT_CAN_RETURN_NULL
+PARROT_WARN_UNUSED_RESULT
+PMC*
+Parrot_sub_find_lex_ctx(PARROT_INTERP, ARGIN(PMC *ctx), INTVAL depth,
+        INTVAL regno, INTVAL regtype)
+{
+    ASSERT_ARGS(Parrot_sub_find_lex_ctx)
+    while (depth-- > 0) {
+        ctx = Parrot_pcc_get_outer_ctx(interp, ctx);
+        if (PMC_IS_NULL(ctx))
+            return PMCNULL;
+    }
+
+    if (regno < 0 || (UINTVAL)regno >= Parrot_pcc_get_regs_used(interp, ctx, regtype))
+        return PMCNULL;
+
+    return ctx;
+}
+
+
 /*
 
 =item C<PMC* Parrot_sub_find_dynamic_pad(PARROT_INTERP, STRING *lex_name, PMC
@@ -23,6 +23,46 @@ Opcode helper functions that don't really fit elsewhere.
 
 typedef unsigned short _rand_buf[3];
 
+/* Parrot_util_sort state and comparators */
+typedef struct sort_info_t sort_info_t;
+
+typedef INTVAL (*sort_cmp_func_t)(PARROT_INTERP, const sort_info_t *, void *, void *);
+
+struct sort_info_t {
+    sort_cmp_func_t  cmp_func;  /* compares two slots */
+    PMC             *cmp;       /* user comparator or PMCNULL */
+    PMC             *arg_flags; /* parsed arguments of cmp */
+    PMC             *ret_flags; /* parsed returns of cmp */
+    int              indirect;  /* slots point at the elements */
+};
+
+/* a PMC and its native value, for sort_pmcs_by_key */
+typedef struct sort_key_t {
+    union {
+        INTVAL    i;
+        FLOATVAL  n;
+        STRING   *s;
+    } key;
+    PMC *pmc;
+} sort_key_t;
+
+/* a sort_slots call made under Parrot_ext_try, see Parrot_util_sort */
+typedef struct sort_try_t {
+    void        **data;
+    void        **scratch;
+    UINTVAL       n;
+    sort_info_t  *info;
+    PMC          *exception; /* thrown by a comparator, or PMCNULL */
+} sort_try_t;
+
+/* C comparator behind an NCI PMC */
+typedef INTVAL (*sort_func_t)(PARROT_INTERP, void *, void *);
+
+#define SORT_CMP(interp, info, a, b) ((info)->cmp_func((interp), (info), (a), (b)))
+
+/* chunk size sorted by insertion before merging */
+#define SORT_MIN_RUN 32
+
 /* Parrot_util_register_move companion functions i and data */
 typedef struct parrot_prm_context {
     unsigned char *dest_regs;
@@ -48,18 +88,119 @@ static long _lrand48(void);
 static long _mrand48(void);
 static long _nrand48(_rand_buf buf);
 static void _srand48(long seed);
-static INTVAL COMPARE(PARROT_INTERP,
+static void next_rand(_rand_buf X);
+static INTVAL sort_cmp_call(PARROT_INTERP,
+    ARGIN(const sort_info_t *info),
+    ARGIN_NULLOK(void *a),
+    ARGIN_NULLOK(void *b))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+static INTVAL sort_cmp_floatval(PARROT_INTERP,
+    const sort_info_t *info,
+    ARGIN(void *a),
+    ARGIN(void *b))
+        __attribute__nonnull__(3)
+        __attribute__nonnull__(4);
+
+static INTVAL sort_cmp_int_key(PARROT_INTERP,
+    const sort_info_t *info,
+    ARGIN(void *a),
+    ARGIN(void *b))
+        __attribute__nonnull__(3)
+        __attribute__nonnull__(4);
+
+static INTVAL sort_cmp_intval(PARROT_INTERP,
+    const sort_info_t *info,
+    ARGIN(void *a),
+    ARGIN(void *b))
+        __attribute__nonnull__(3)
+        __attribute__nonnull__(4);
+
+static INTVAL sort_cmp_nci(PARROT_INTERP,
+    ARGIN(const sort_info_t *info),
+    ARGIN_NULLOK(void *a),
+    ARGIN_NULLOK(void *b))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2);
+
+static INTVAL sort_cmp_num_key(PARROT_INTERP,
+    const sort_info_t *info,
+    ARGIN(void *a),
+    ARGIN(void *b))
+        __attribute__nonnull__(3)
+        __attribute__nonnull__(4);
+
+static INTVAL sort_cmp_pmc(PARROT_INTERP,
+    const sort_info_t *info,
     ARGIN(void *a),
-    ARGIN(void *b),
-    ARGIN(PMC *cmp),
-    ARGIN(const char * cmp_signature))
+    ARGIN(void *b))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(3)
+        __attribute__nonnull__(4);
+
+static INTVAL sort_cmp_str_key(PARROT_INTERP,
+    const sort_info_t *info,
+    ARGIN(void *a),
+    ARGIN(void *b))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(3)
+        __attribute__nonnull__(4);
+
+static INTVAL sort_cmp_string(PARROT_INTERP,
+    const sort_info_t *info,
+    ARGIN_NULLOK(void *a),
+    ARGIN_NULLOK(void *b))
+        __attribute__nonnull__(1);
+
+static void sort_merge(PARROT_INTERP,
+    ARGMOD(void **data),
+    ARGMOD(void **scratch),
+    UINTVAL lo,
+    UINTVAL mid,
+    UINTVAL hi,
+    ARGIN(const sort_info_t *info))
         __attribute__nonnull__(1)
         __attribute__nonnull__(2)
         __attribute__nonnull__(3)
-        __attribute__nonnull__(4)
-        __attribute__nonnull__(5);
+        __attribute__nonnull__(7)
+        FUNC_MODIFIES(*data)
+        FUNC_MODIFIES(*scratch);
+
+static int sort_pmcs_by_key(PARROT_INTERP, ARGMOD(PMC **data), UINTVAL n)
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        FUNC_MODIFIES(*data);
+
+static void sort_run(PARROT_INTERP,
+    ARGMOD(void **data),
+    UINTVAL lo,
+    UINTVAL hi,
+    ARGIN(const sort_info_t *info))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(5)
+        FUNC_MODIFIES(*data);
+
+static void sort_slots(PARROT_INTERP,
+    ARGMOD(void **data),
+    ARGMOD(void **scratch),
+    UINTVAL n,
+    ARGIN(const sort_info_t *info))
+        __attribute__nonnull__(1)
+        __attribute__nonnull__(2)
+        __attribute__nonnull__(3)
+        __attribute__nonnull__(5)
+        FUNC_MODIFIES(*data)
+        FUNC_MODIFIES(*scratch);
+
+static void sort_slots_catch(PARROT_INTERP,
+    ARGIN_NULLOK(PMC *exception),
+    ARGIN_NULLOK(void *data));
+
+static void sort_slots_try(PARROT_INTERP, ARGIN_NULLOK(void *data))
+        __attribute__nonnull__(1);
 
-static void next_rand(_rand_buf X);
 #define ASSERT_ARGS__drand48 __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
 #define ASSERT_ARGS__erand48 __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
 #define ASSERT_ARGS__jrand48 __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
@@ -67,13 +208,55 @@ static void next_rand(_rand_buf X);
 #define ASSERT_ARGS__mrand48 __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
 #define ASSERT_ARGS__nrand48 __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
 #define ASSERT_ARGS__srand48 __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
-#define ASSERT_ARGS_COMPARE __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+#define ASSERT_ARGS_next_rand __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
+#define ASSERT_ARGS_sort_cmp_call __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(info))
+#define ASSERT_ARGS_sort_cmp_floatval __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(a) \
+    , PARROT_ASSERT_ARG(b))
+#define ASSERT_ARGS_sort_cmp_int_key __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(a) \
+    , PARROT_ASSERT_ARG(b))
+#define ASSERT_ARGS_sort_cmp_intval __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(a) \
+    , PARROT_ASSERT_ARG(b))
+#define ASSERT_ARGS_sort_cmp_nci __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(info))
+#define ASSERT_ARGS_sort_cmp_num_key __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(a) \
+    , PARROT_ASSERT_ARG(b))
+#define ASSERT_ARGS_sort_cmp_pmc __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
        PARROT_ASSERT_ARG(interp) \
     , PARROT_ASSERT_ARG(a) \
-    , PARROT_ASSERT_ARG(b) \
-    , PARROT_ASSERT_ARG(cmp) \
-    , PARROT_ASSERT_ARG(cmp_signature))
-#define ASSERT_ARGS_next_rand __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
+    , PARROT_ASSERT_ARG(b))
+#define ASSERT_ARGS_sort_cmp_str_key __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(a) \
+    , PARROT_ASSERT_ARG(b))
+#define ASSERT_ARGS_sort_cmp_string __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp))
+#define ASSERT_ARGS_sort_merge __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(data) \
+    , PARROT_ASSERT_ARG(scratch) \
+    , PARROT_ASSERT_ARG(info))
+#define ASSERT_ARGS_sort_pmcs_by_key __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(data))
+#define ASSERT_ARGS_sort_run __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(data) \
+    , PARROT_ASSERT_ARG(info))
+#define ASSERT_ARGS_sort_slots __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp) \
+    , PARROT_ASSERT_ARG(data) \
+    , PARROT_ASSERT_ARG(scratch) \
+    , PARROT_ASSERT_ARG(info))
+#define ASSERT_ARGS_sort_slots_catch __attribute__unused__ int _ASSERT_ARGS_CHECK = (0)
+#define ASSERT_ARGS_sort_slots_try __attribute__unused__ int _ASSERT_ARGS_CHECK = (\
+       PARROT_ASSERT_ARG(interp))
 /* Don't modify between HEADERIZER BEGIN / HEADERIZER END.  Your changes will be lost. */
 /* HEADERIZER END: static */
 
@@ -653,106 +836,542 @@ Parrot_util_byte_rindex(SHIM_INTERP, ARGIN(const STRING *base),
     return -1;
 }
 
-typedef INTVAL (*sort_func_t)(PARROT_INTERP, void *, void *);
+/*
+
+=item C<static INTVAL sort_cmp_intval(PARROT_INTERP, const sort_info_t *info,
+void *a, void *b)>
+
+=item C<static INTVAL sort_cmp_floatval(PARROT_INTERP, const sort_info_t *info,
+void *a, void *b)>
+
+=item C<static INTVAL sort_cmp_string(PARROT_INTERP, const sort_info_t *info,
+void *a, void *b)>
+
+=item C<static INTVAL sort_cmp_pmc(PARROT_INTERP, const sort_info_t *info, void
+*a, void *b)>
+
+Default comparators.  C<INTVAL> and C<FLOATVAL> slots point at the values,
+C<STRING> and PMC slots are the values themselves.
+
+=cut
+
+*/
+
+static INTVAL
+sort_cmp_intval(SHIM_INTERP, SHIM(const sort_info_t *info),
+        ARGIN(void *a), ARGIN(void *b))
+{
+    ASSERT_ARGS(sort_cmp_intval)
+    const INTVAL x = *(const INTVAL *)a;
+    const INTVAL y = *(const INTVAL *)b;
+
+    return (x > y) - (x < y);
+}
+
+static INTVAL
+sort_cmp_floatval(SHIM_INTERP, SHIM(const sort_info_t *info),
+        ARGIN(void *a), ARGIN(void *b))
+{
+    ASSERT_ARGS(sort_cmp_floatval)
+    const FLOATVAL x = *(const FLOATVAL *)a;
+    const FLOATVAL y = *(const FLOATVAL *)b;
+
+    return (x > y) - (x < y);
+}
+
+static INTVAL
+sort_cmp_string(PARROT_INTERP, SHIM(const sort_info_t *info),
+        ARGIN_NULLOK(void *a), ARGIN_NULLOK(void *b))
+{
+    ASSERT_ARGS(sort_cmp_string)
+    return STRING_compare(interp, (STRING *)a, (STRING *)b);
+}
+
+static INTVAL
+sort_cmp_pmc(PARROT_INTERP, SHIM(const sort_info_t *info),
+        ARGIN(void *a), ARGIN(void *b))
+{
+    ASSERT_ARGS(sort_cmp_pmc)
+    return VTABLE_cmp(interp, (PMC *)a, (PMC *)b);
+}
 
 /*
 
-=item C<static INTVAL COMPARE(PARROT_INTERP, void *a, void *b, PMC *cmp, const
-char * cmp_signature)>
+=item C<static INTVAL sort_cmp_int_key(PARROT_INTERP, const sort_info_t *info,
+void *a, void *b)>
+
+=item C<static INTVAL sort_cmp_num_key(PARROT_INTERP, const sort_info_t *info,
+void *a, void *b)>
 
-General PMC comparison function. Takes two PMCs. Returns 0 if they are equal,
-returns 1 if C<a> is bigger, and returns -1 if C<b> is bigger.
+=item C<static INTVAL sort_cmp_str_key(PARROT_INTERP, const sort_info_t *info,
+void *a, void *b)>
+
+Compare the keys of two C<sort_key_t> slots, as filled in by
+C<sort_pmcs_by_key>.
 
 =cut
 
 */
 
-/* TODO: Macroize COMPARE */
-/* This is an awfully expensive function to call, what with all the */
-/* comparisons that never change. We ought to precompute everything. */
-/* XXX We should be able to guarantee that *a and *b never change via const parameters. */
 static INTVAL
-COMPARE(PARROT_INTERP, ARGIN(void *a), ARGIN(void *b),
-        ARGIN(PMC *cmp),
-        ARGIN(const char * cmp_signature))
+sort_cmp_int_key(SHIM_INTERP, SHIM(const sort_info_t *info),
+        ARGIN(void *a), ARGIN(void *b))
 {
-    ASSERT_ARGS(COMPARE)
-    INTVAL result = 0;
-    if (PMC_IS_NULL(cmp))
-        return VTABLE_cmp(interp, (PMC *)a, (PMC *)b);
+    ASSERT_ARGS(sort_cmp_int_key)
+    const INTVAL x = ((const sort_key_t *)a)->key.i;
+    const INTVAL y = ((const sort_key_t *)b)->key.i;
 
-    if (cmp->vtable->base_type == enum_class_NCI) {
-        const sort_func_t f = (sort_func_t)D2FPTR(PARROT_NCI(cmp)->func);
-        return f(interp, a, b);
+    return (x > y) - (x < y);
+}
+
+static INTVAL
+sort_cmp_num_key(SHIM_INTERP, SHIM(const sort_info_t *info),
+        ARGIN(void *a), ARGIN(void *b))
+{
+    ASSERT_ARGS(sort_cmp_num_key)
+    const FLOATVAL x = ((const sort_key_t *)a)->key.n;
+    const FLOATVAL y = ((const sort_key_t *)b)->key.n;
+
+    return (x > y) - (x < y);
+}
+
+static INTVAL
+sort_cmp_str_key(PARROT_INTERP, SHIM(const sort_info_t *info),
+        ARGIN(void *a), ARGIN(void *b))
+{
+    ASSERT_ARGS(sort_cmp_str_key)
+    return STRING_compare(interp,
+            ((const sort_key_t *)a)->key.s, ((const sort_key_t *)b)->key.s);
+}
+
+/*
+
+=item C<static INTVAL sort_cmp_nci(PARROT_INTERP, const sort_info_t *info, void
+*a, void *b)>
+
+Call a C comparator wrapped in an NCI PMC directly.
+
+=cut
+
+*/
+
+static INTVAL
+sort_cmp_nci(PARROT_INTERP, ARGIN(const sort_info_t *info),
+        ARGIN_NULLOK(void *a), ARGIN_NULLOK(void *b))
+{
+    ASSERT_ARGS(sort_cmp_nci)
+    const sort_func_t f = (sort_func_t)D2FPTR(PARROT_NCI(info->cmp)->func);
+
+    return f(interp, a, b);
+}
+
+/*
+
+=item C<static INTVAL sort_cmp_call(PARROT_INTERP, const sort_info_t *info, void
+*a, void *b)>
+
+Invoke a user comparator.  The argument and return signatures were parsed
+once by C<Parrot_util_sort>; only the CallContext, which becomes the callee's
+context, is created for each comparison.
+
+=cut
+
+*/
+
+static INTVAL
+sort_cmp_call(PARROT_INTERP, ARGIN(const sort_info_t *info),
+        ARGIN_NULLOK(void *a), ARGIN_NULLOK(void *b))
+{
+    ASSERT_ARGS(sort_cmp_call)
+    PMC * const old_call_obj = Parrot_pcc_get_signature(interp, CURRENT_CONTEXT(interp));
+    PMC        *call_obj     = Parrot_pcc_new_call_object(interp);
+    INTVAL      result       = 0;
+    void       *args[2];
+    void       *ret[1];
+
+    if (info->indirect) {
+        args[0] = a;
+        args[1] = b;
     }
+    else {
+        args[0] = &a;
+        args[1] = &b;
+    }
+    ret[0] = &result;
+
+    Parrot_pcc_set_call_from_c_ptrs(interp, call_obj, info->arg_flags, args);
+    Parrot_pcc_invoke_from_sig_object(interp, info->cmp, call_obj);
+    call_obj = Parrot_pcc_get_signature(interp, CURRENT_CONTEXT(interp));
+    Parrot_pcc_fill_params_from_c_ptrs(interp, call_obj, info->ret_flags, ret);
+    Parrot_pcc_set_signature(interp, CURRENT_CONTEXT(interp), old_call_obj);
 
-    Parrot_ext_call(interp, cmp, cmp_signature, a, b, &result);
     return result;
 }
 
 /*
 
-=item C<void Parrot_util_quicksort(PARROT_INTERP, void **data, UINTVAL n, PMC
-*cmp, const char * cmp_signature)>
+=item C<static void sort_run(PARROT_INTERP, void **data, UINTVAL lo, UINTVAL hi,
+const sort_info_t *info)>
 
-Perform a quicksort on a PMC array.
+Sort C<data[lo .. hi)>.  The natural run at C<lo> is taken as it is (a
+strictly descending one is reversed first); the rest is added by binary
+insertion, which keeps the number of comparisons low.
+
+=cut
+
+*/
+
+static void
+sort_run(PARROT_INTERP, ARGMOD(void **data), UINTVAL lo, UINTVAL hi,
+        ARGIN(const sort_info_t *info))
+{
+    ASSERT_ARGS(sort_run)
+    UINTVAL i = lo + 1;
+
+    if (hi - lo < 2)
+        return;
+
+    if (SORT_CMP(interp, info, data[i], data[lo]) < 0) {
+        UINTVAL j, k;
+
+        for (++i; i < hi && SORT_CMP(interp, info, data[i], data[i - 1]) < 0; ++i)
+            ;
+
+        for (j = lo, k = i - 1; j < k; ++j, --k) {
+            void * const temp = data[j];
+            data[j]           = data[k];
+            data[k]           = temp;
+        }
+    }
+    else {
+        for (++i; i < hi && SORT_CMP(interp, info, data[i], data[i - 1]) >= 0; ++i)
+            ;
+    }
+
+    for (; i < hi; ++i) {
+        void * const pivot = data[i];
+        UINTVAL      l     = lo;
+        UINTVAL      r     = i;
+
+        /* search first, then move: data stays complete during comparisons */
+        while (l < r) {
+            const UINTVAL m = l + (r - l) / 2;
+
+            if (SORT_CMP(interp, info, pivot, data[m]) < 0)
+                r = m;
+            else
+                l = m + 1;
+        }
+
+        memmove(data + l + 1, data + l, (i - l) * sizeof (void *));
+        data[l] = pivot;
+    }
+}
+
+/*
+
+=item C<static void sort_merge(PARROT_INTERP, void **data, void **scratch,
+UINTVAL lo, UINTVAL mid, UINTVAL hi, const sort_info_t *info)>
+
+Merge the sorted ranges C<data[lo .. mid)> and C<data[mid .. hi)>.  Ranges
+that are already in order or entirely reversed are handled without a merge;
+otherwise the parts of both ranges that are already in place are trimmed
+off by binary search.  The merge goes into C<scratch> and is copied back
+afterwards, so C<data> holds every element while the comparator runs.
+
+=cut
+
+*/
+
+static void
+sort_merge(PARROT_INTERP, ARGMOD(void **data), ARGMOD(void **scratch),
+        UINTVAL lo, UINTVAL mid, UINTVAL hi, ARGIN(const sort_info_t *info))
+{
+    ASSERT_ARGS(sort_merge)
+    UINTVAL i, j, k, l, r;
+
+    if (SORT_CMP(interp, info, data[mid], data[mid - 1]) >= 0)
+        return;
+
+    if (SORT_CMP(interp, info, data[hi - 1], data[lo]) < 0) {
+        memcpy(scratch, data + mid, (hi - mid) * sizeof (void *));
+        memmove(data + lo + (hi - mid), data + lo, (mid - lo) * sizeof (void *));
+        memcpy(data + lo, scratch, (hi - mid) * sizeof (void *));
+        return;
+    }
+
+    /* left elements not greater than the first right one stay put */
+    for (l = lo, r = mid - 1; l < r;) {
+        const UINTVAL m = l + (r - l) / 2;
+
+        if (SORT_CMP(interp, info, data[mid], data[m]) < 0)
+            r = m;
+        else
+            l = m + 1;
+    }
+    lo = l;
+
+    /* and so do right elements not less than the last left one */
+    for (l = mid, r = hi; l < r;) {
+        const UINTVAL m = l + (r - l) / 2;
+
+        if (SORT_CMP(interp, info, data[m], data[mid - 1]) < 0)
+            l = m + 1;
+        else
+            r = m;
+    }
+    hi = l;
+
+    for (i = lo, j = mid, k = 0; i < mid && j < hi; ++k) {
+        if (SORT_CMP(interp, info, data[j], data[i]) < 0)
+            scratch[k] = data[j++];
+        else
+            scratch[k] = data[i++];
+    }
+
+    while (i < mid)
+        scratch[k++] = data[i++];
+
+    while (j < hi)
+        scratch[k++] = data[j++];
+
+    memcpy(data + lo, scratch, k * sizeof (void *));
+}
+
+/*
+
+=item C<static void sort_slots(PARROT_INTERP, void **data, void **scratch,
+UINTVAL n, const sort_info_t *info)>
+
+Stable merge sort of C<n> slots.  Chunks of C<SORT_MIN_RUN> slots are
+sorted by C<sort_run> and then merged bottom-up.  C<scratch> must have
+room for C<n> slots.
+
+=cut
+
+*/
+
+static void
+sort_slots(PARROT_INTERP, ARGMOD(void **data), ARGMOD(void **scratch),
+        UINTVAL n, ARGIN(const sort_info_t *info))
+{
+    ASSERT_ARGS(sort_slots)
+    UINTVAL lo, width;
+
+    for (lo = 0; lo < n; lo += SORT_MIN_RUN)
+        sort_run(interp, data, lo, n - lo < SORT_MIN_RUN ? n : lo + SORT_MIN_RUN, info);
+
+    for (width = SORT_MIN_RUN; width < n; width *= 2) {
+        for (lo = 0; lo + width < n; lo += 2 * width) {
+            const UINTVAL mid = lo + width;
+            const UINTVAL hi  = n - mid < width ? n : mid + width;
+
+            sort_merge(interp, data, scratch, lo, mid, hi, info);
+        }
+    }
+}
+
+/*
+
+=item C<static void sort_slots_try(PARROT_INTERP, void *data)>
+
+Runs C<sort_slots> with the arguments in the C<sort_try_t> C<data>.
+
+=item C<static void sort_slots_catch(PARROT_INTERP, PMC *exception, void *data)>
+
+Keeps the C<exception> thrown by a comparator in the C<sort_try_t> C<data>,
+to be rethrown once the scratch slots are freed.
+
+=cut
+
+*/
+
+static void
+sort_slots_try(PARROT_INTERP, ARGIN_NULLOK(void *data))
+{
+    ASSERT_ARGS(sort_slots_try)
+    sort_try_t * const t = (sort_try_t *)data;
+
+    sort_slots(interp, t->data, t->scratch, t->n, t->info);
+}
+
+static void
+sort_slots_catch(SHIM_INTERP, ARGIN_NULLOK(PMC *exception), ARGIN_NULLOK(void *data))
+{
+    ASSERT_ARGS(sort_slots_catch)
+    sort_try_t * const t = (sort_try_t *)data;
+
+    t->exception = exception;
+}
+
+/*
+
+=item C<static int sort_pmcs_by_key(PARROT_INTERP, PMC **data, UINTVAL n)>
+
+Fast path for sorting PMCs without a comparator: if all elements are plain
+Integer, Float or String PMCs, extract their native values once and sort
+by those, which gives the same order as C<VTABLE_cmp> would.  Returns 0
+and leaves C<data> alone otherwise.
+
+=cut
+
+*/
+
+static int
+sort_pmcs_by_key(PARROT_INTERP, ARGMOD(PMC **data), UINTVAL n)
+{
+    ASSERT_ARGS(sort_pmcs_by_key)
+    const INTVAL  type = PMC_IS_NULL(data[0]) ? enum_class_default
+                                              : data[0]->vtable->base_type;
+    sort_info_t   info;
+    sort_key_t   *keys;
+    void        **slots;
+    UINTVAL       i;
+
+    if (type == enum_class_Integer)
+        info.cmp_func = sort_cmp_int_key;
+    else if (type == enum_class_Float)
+        info.cmp_func = sort_cmp_num_key;
+    else if (type == enum_class_String)
+        info.cmp_func = sort_cmp_str_key;
+    else
+        return 0;
+
+    for (i = 0; i < n; ++i)
+        if (PMC_IS_NULL(data[i]) || data[i]->vtable->base_type != type)
+            return 0;
+
+    info.cmp       = PMCNULL;
+    info.arg_flags = PMCNULL;
+    info.ret_flags = PMCNULL;
+    info.indirect  = 0;
+
+    keys  = mem_gc_allocate_n_typed(interp, n, sort_key_t);
+    slots = mem_gc_allocate_n_typed(interp, 2 * n, void *);
+
+    for (i = 0; i < n; ++i) {
+        sort_key_t * const k = keys + i;
+
+        k->pmc = data[i];
+        if (type == enum_class_Integer)
+            k->key.i = VTABLE_get_integer(interp, data[i]);
+        else if (type == enum_class_Float)
+            k->key.n = VTABLE_get_number(interp, data[i]);
+        else
+            k->key.s = VTABLE_get_string(interp, data[i]);
+
+        slots[i] = k;
+    }
+
+    sort_slots(interp, slots, slots + n, n, &info);
+
+    for (i = 0; i < n; ++i)
+        data[i] = ((sort_key_t *)slots[i])->pmc;
+
+    mem_gc_free(interp, slots);
+    mem_gc_free(interp, keys);
+
+    return 1;
+}
+
+/*
+
+=item C<void Parrot_util_sort(PARROT_INTERP, void *data, UINTVAL n, PMC *cmp,
+const char * cmp_signature)>
+
+Stable sort of the C<n> elements at C<data>.
+
+C<cmp_signature> is the PCC signature of C<cmp>, e.g. C<II->I> for an
+array of INTVALs; its first character gives the element type: C<I> for
+C<INTVAL>, C<N> for C<FLOATVAL>, C<S> for C<STRING *> and C<P> for C<PMC *>.
+
+Without a C<cmp>, elements are compared natively, PMCs with C<VTABLE_cmp>;
+arrays consisting only of Integer, Float or String PMCs are sorted by
+their native values directly.  An NCI C<cmp> on STRINGs or PMCs is called
+as a C function; any other C<cmp> is invoked as a Sub.
 
-cmp_signature is PCC signature for C<cmp>. E.g. C<II->I> for FIA.
 =cut
 
 */
 
 void
-Parrot_util_quicksort(PARROT_INTERP, ARGMOD(void **data), UINTVAL n,
+Parrot_util_sort(PARROT_INTERP, ARGMOD(void *data), UINTVAL n,
         ARGIN(PMC *cmp),
         ARGIN(const char * cmp_signature))
 {
-    ASSERT_ARGS(Parrot_util_quicksort)
-    while (n > 1) {
-        UINTVAL i, j, ln, rn;
-        void *temp;
+    ASSERT_ARGS(Parrot_util_sort)
+    const char   type     = *cmp_signature;
+    const size_t elemsize = type == 'I' ? sizeof (INTVAL)
+                          : type == 'N' ? sizeof (FLOATVAL)
+                          : sizeof (void *);
+    sort_info_t  info;
+    sort_try_t   run;
+    void       **slots;
+    UINTVAL      i;
+
+    if (n < 2)
+        return;
+
+    info.cmp       = cmp;
+    info.arg_flags = PMCNULL;
+    info.ret_flags = PMCNULL;
+    info.indirect  = type == 'I' || type == 'N';
+
+    if (PMC_IS_NULL(cmp)) {
+        if (type == 'P' && sort_pmcs_by_key(interp, (PMC **)data, n))
+            return;
+
+        info.cmp_func = type == 'I' ? sort_cmp_intval
+                      : type == 'N' ? sort_cmp_floatval
+                      : type == 'S' ? sort_cmp_string
+                      : sort_cmp_pmc;
+    }
+    else if (!info.indirect && cmp->vtable->base_type == enum_class_NCI)
+        info.cmp_func = sort_cmp_nci;
+    else {
+        Parrot_pcc_parse_signature_string(interp,
+                Parrot_str_new(interp, cmp_signature, 0),
+                &info.arg_flags, &info.ret_flags);
+        info.cmp_func = sort_cmp_call;
+    }
 
-        /* Swap */
-        temp      = data[0];
-        data[0]   = data[n/2];
-        data[n/2] = temp;
+    /* slots for native values point into data, the sorted values are
+     * gathered afterwards; the sort runs under a C handler so that the
+     * slots are freed even when a comparator throws */
+    slots = mem_gc_allocate_n_typed(interp, info.indirect ? 2 * n : n, void *);
 
-        for (i = 0, j = n; ;) {
-            do
-                --j;
-            while (j > 0 && COMPARE(interp, data[j], data[0], cmp, cmp_signature) > 0);
+    run.n         = n;
+    run.info      = &info;
+    run.exception = PMCNULL;
 
-            do
-                ++i;
-            while (i < j && COMPARE(interp, data[i], data[0], cmp, cmp_signature) < 0);
+    if (info.indirect) {
+        for (i = 0; i < n; ++i)
+            slots[n + i] = (char *)data + i * elemsize;
 
-            if (i >= j)
-                break;
+        run.data    = slots + n;
+        run.scratch = slots;
+    }
+    else {
+        run.data    = (void **)data;
+        run.scratch = slots;
+    }
 
-            /* Swap */
-            temp    = data[i];
-            data[i] = data[j];
-            data[j] = temp;
-        }
+    Parrot_ext_try(interp, sort_slots_try, sort_slots_catch, &run);
 
-        /* Swap */
-        temp    = data[j];
-        data[j] = data[0];
-        data[0] = temp;
+    if (info.indirect && PMC_IS_NULL(run.exception)) {
+        char * const sorted = mem_gc_allocate_n_typed(interp, n * elemsize, char);
 
-        ln = j;
-        rn = n - ++j;
+        for (i = 0; i < n; ++i)
+            memcpy(sorted + i * elemsize, slots[n + i], elemsize);
 
-        if (ln < rn) {
-            Parrot_util_quicksort(interp, data, ln, cmp, cmp_signature);
-            data += j;
-            n = rn;
-        }
-        else {
-            Parrot_util_quicksort(interp, data + j, rn, cmp, cmp_signature);
-            n = ln;
-        }
+        memcpy(data, sorted, n * elemsize);
+        mem_gc_free(interp, sorted);
     }
+
+    mem_gc_free(interp, slots);
+
+    if (!PMC_IS_NULL(run.exception))
+        Parrot_ex_rethrow_from_c(interp, run.exception);
 }
 
 /*
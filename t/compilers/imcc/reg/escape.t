@@ -0,0 +1,193 @@
+#!perl
+# Copyright (C) 2026, Parrot Foundation.
+
+use strict;
+use warnings;
+use lib qw( . lib ../lib ../../lib );
+use Parrot::Test tests => 6;
+
+=head1 NAME
+
+t/compilers/imcc/reg/escape.t - Reusing PMCs that never escape
+
+=head1 SYNOPSIS
+
+    % prove t/compilers/imcc/reg/escape.t
+
+=head1 DESCRIPTION
+
+Runs PIR compiled with C<-Oe>, which turns C<new> into C<renew> where the
+PMC never leaves its register, so that it is reset in place the next time
+instead of allocated again. Each program must behave exactly as it does
+without the optimization.
+
+=cut
+
+$ENV{TEST_PROG_ARGS} ||= '';
+local $ENV{TEST_PROG_ARGS} = $ENV{TEST_PROG_ARGS} . ' -Oe';
+
+pir_output_is( <<'CODE', <<'OUT', "containers reused in a loop start out empty" );
+.sub main :main
+    .local int i
+    i = 0
+  loop:
+    $P0 = new 'ResizablePMCArray'
+    $I0 = elements $P0
+    push $P0, i
+    push $P0, 'x'
+    $S0 = join ',', $P0
+    $P1 = new 'Hash'
+    $I1 = elements $P1
+    $P1[i] = $S0
+    $S1 = $P1[i]
+    print $I0
+    print $I1
+    print ' '
+    say $S1
+    inc i
+    if i < 3 goto loop
+.end
+CODE
+00 0,x
+00 1,x
+00 2,x
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "scalars reused in a loop are reinitialized" );
+.sub main :main
+    .local int i
+    i = 0
+  loop:
+    $P0 = new 'Integer'
+    $I0 = $P0
+    $P0 = i
+    inc $P0
+    $P1 = new 'String'
+    $S1 = $P1
+    concat $P1, 'ab'
+    $P2 = new 'StringBuilder'
+    push $P2, 'c'
+    push $P2, 'd'
+    print $I0
+    print ' '
+    print $P0
+    print ' ['
+    print $S1
+    print '] '
+    print $P1
+    print ' '
+    say $P2
+    inc i
+    if i < 2 goto loop
+.end
+CODE
+0 1 [] ab cd
+0 2 [] ab cd
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "a PMC that changed its type gets a new one" );
+.sub main :main
+    .local int i
+    i = 0
+  loop:
+    $P0 = new 'Integer'
+    $I0 = $P0
+    say $I0
+    $P0 = 2.5
+    say $P0
+    inc i
+    if i < 2 goto loop
+.end
+CODE
+0
+2.5
+0
+2.5
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "PMCs stored into an aggregate stay distinct" );
+.sub main :main
+    .local int i
+    .local pmc all
+    all = new 'ResizablePMCArray'
+    i = 0
+  loop:
+    $P0 = new 'Integer'
+    $P0 = i
+    push all, $P0
+    inc i
+    if i < 3 goto loop
+    $S0 = join ',', all
+    say $S0
+.end
+CODE
+0,1,2
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "PMCs passed to a sub or copied stay distinct" );
+.sub main :main
+    .local int i
+    .local pmc keep
+    i = 0
+  loop:
+    $P0 = new 'ResizablePMCArray'
+    push $P0, i
+    remember($P0)
+    $P1 = new 'Hash'
+    $P1['i'] = i
+    keep = $P1
+    inc i
+    if i < 3 goto loop
+    $P2 = get_global 'seen'
+    $I0 = elements $P2
+    $P3 = $P2[0]
+    $I1 = $P3[0]
+    $I2 = keep['i']
+    print $I0
+    print ' '
+    print $I1
+    print ' '
+    say $I2
+.end
+
+.sub remember
+    .param pmc x
+    $P0 = get_global 'seen'
+    unless null $P0 goto have
+    $P0 = new 'ResizablePMCArray'
+    set_global 'seen', $P0
+  have:
+    push $P0, x
+.end
+CODE
+3 0 2
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "a HLL class of the same name is instantiated" );
+.HLL 'mine'
+
+.sub main :main
+    $P9 = subclass 'Integer', 'Integer'
+    .local int i
+    i = 0
+  loop:
+    $P0 = new 'Integer'
+    $I0 = $P0
+    $P0 = 7
+    print $I0
+    print ' '
+    say $P0
+    inc i
+    if i < 2 goto loop
+.end
+CODE
+0 7
+0 7
+OUT
+
+# Local Variables:
+#   mode: cperl
+#   cperl-indent-level: 4
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4:
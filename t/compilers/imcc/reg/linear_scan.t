@@ -0,0 +1,204 @@
+#!perl
+# Copyright (C) 2026, Parrot Foundation.
+
+use strict;
+use warnings;
+use lib qw( . lib ../lib ../../lib );
+use Parrot::Test tests => 7;
+
+=head1 NAME
+
+t/compilers/imcc/reg/linear_scan.t - Linear scan register allocation
+
+=head1 SYNOPSIS
+
+    % prove t/compilers/imcc/reg/linear_scan.t
+
+=head1 DESCRIPTION
+
+Runs PIR compiled with C<-Or>, which lets variables whose live ranges don't
+overlap share a parrot register. Each program must behave exactly as it does
+without the optimization.
+
+=cut
+
+$ENV{TEST_PROG_ARGS} ||= '';
+local $ENV{TEST_PROG_ARGS} = $ENV{TEST_PROG_ARGS} . ' -Or';
+
+pir_output_is( <<'CODE', <<'OUT', "disjoint ranges share a register" );
+.sub main :main
+    $P0 = get_global 'seq'
+    $I0 = $P0(1)
+    say $I0
+    $I0 = $P0.'__get_regs_used'('I')
+    say $I0
+    $I0 = $P0.'__get_regs_used'('S')
+    say $I0
+.end
+
+.sub seq
+    .param int n
+    $I1 = n
+    $I2 = $I1 + 2
+    $I3 = $I2 * 3
+    $I4 = $I3 - 4
+    $I5 = $I4 * 5
+    $S1 = $I5
+    $S2 = concat $S1, "0"
+    $I6 = $S2
+    .return ($I6)
+.end
+CODE
+250
+2
+2
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "values live around a loop" );
+.sub main :main
+    .local int i, sum, step
+    sum = 0
+    step = 3
+    i = 0
+  loop:
+    $I0 = i * step
+    sum += $I0
+    inc i
+    if i < 10 goto loop
+    $I1 = sum + step
+    say $I1
+    say i
+.end
+CODE
+138
+10
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "read before write in a loop" );
+.sub main :main
+    .local int i, prev
+    i = 0
+    prev = 0
+  loop:
+    $I0 = prev
+    say $I0
+    prev = i * 2
+    inc i
+    if i < 5 goto loop
+.end
+CODE
+0
+0
+2
+4
+6
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "variables live into an exception handler" );
+.sub main :main
+    $S0 = "kept"
+    $I0 = 42
+    push_eh handler
+    $I1 = 7
+    $P0 = new 'Exception'
+    throw $P0
+    say "not reached"
+    .return ()
+  handler:
+    .get_results ($P1)
+    pop_eh
+    say $S0
+    say $I0
+.end
+CODE
+kept
+42
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "arguments and results of calls" );
+.sub main :main
+    $I0 = ident(1)
+    $I1 = ident(2)
+    ($I2, $I3) = swap($I0, $I1)
+    $I4 = $I2 * 10
+    $I4 += $I3
+    say $I4
+    $S0 = twice("")
+    $S0 = concat $S0, "a"
+    $S1 = twice($S0)
+    $S2 = twice($S1)
+    say $S2
+.end
+
+.sub ident
+    .param int n
+    .return (n)
+.end
+
+.sub swap
+    .param int a
+    .param int b
+    .return (b, a)
+.end
+
+.sub twice
+    .param string s
+    $S0 = concat s, s
+    .return ($S0)
+.end
+CODE
+21
+aaaa
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "continuation labels keep their values" );
+.sub main :main
+    $I0 = 5
+    $P0 = new 'Continuation'
+    set_label $P0, resume
+    $I1 = 6
+    $P1 = get_global 'call_cc'
+    $P1($P0)
+    say "not reached"
+  resume:
+    $I2 = $I0 * 2
+    say $I2
+.end
+
+.sub call_cc
+    .param pmc cc
+    cc()
+.end
+CODE
+10
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "computed jumps fall back to one register per variable" );
+.sub main :main
+    $P0 = get_global 'computed'
+    $I0 = $P0()
+    say $I0
+    $I0 = $P0.'__get_regs_used'('I')
+    say $I0
+.end
+
+.sub computed
+    $I1 = 1
+    $I2 = $I1 + 1
+    set_addr $I3, target
+    jump $I3
+    $I2 = 0
+  target:
+    .return ($I2)
+.end
+CODE
+2
+3
+OUT
+
+# Local Variables:
+#   mode: cperl
+#   cperl-indent-level: 4
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4:
@@ -0,0 +1,169 @@
+#!perl
+# Copyright (C) 2026, Parrot Foundation.
+
+use strict;
+use warnings;
+use lib qw( . lib ../lib ../../lib );
+use Parrot::Test tests => 4;
+
+=head1 NAME
+
+t/compilers/imcc/reg/parallel.t - Register allocation on several threads
+
+=head1 SYNOPSIS
+
+    % prove t/compilers/imcc/reg/parallel.t
+
+=head1 DESCRIPTION
+
+Runs PIR compiled with C<-Oj4>, which allocates the registers of the subs of
+a file on four threads and emits them in order afterwards. Each program must
+behave exactly as it does without the flag.
+
+=cut
+
+$ENV{TEST_PROG_ARGS} ||= '';
+local $ENV{TEST_PROG_ARGS} = $ENV{TEST_PROG_ARGS} . ' -Oj4';
+
+pir_output_is( <<'CODE', <<'OUT', "many subs" );
+.sub main :main
+    $I0 = sum(10)
+    say $I0
+    $S0 = twice("ab")
+    say $S0
+    $N0 = half(5)
+    say $N0
+    $P0 = pair(1, 2)
+    $I0 = elements $P0
+    say $I0
+.end
+
+.sub sum
+    .param int n
+    .local int i, s
+    s = 0
+    i = 0
+  loop:
+    s += i
+    inc i
+    if i <= n goto loop
+    .return (s)
+.end
+
+.sub twice
+    .param string s
+    $S0 = concat s, s
+    .return ($S0)
+.end
+
+.sub half
+    .param num n
+    $N0 = n / 2
+    .return ($N0)
+.end
+
+.sub pair
+    .param pmc a
+    .param pmc b
+    $P0 = new 'ResizablePMCArray'
+    push $P0, a
+    push $P0, b
+    .return ($P0)
+.end
+CODE
+55
+abab
+2.5
+2
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', ":immediate subs between other subs" );
+.sub before
+    $S0 = "before"
+    .return ($S0)
+.end
+
+.sub make_total :immediate :anon
+    .local int i, total
+    total = 0
+    i = 1
+  loop:
+    total += i
+    inc i
+    if i <= 4 goto loop
+    $P0 = box total
+    set_global 'total', $P0
+.end
+
+.sub main :main
+    $P0 = get_global 'total'
+    say $P0
+    $S0 = before()
+    say $S0
+.end
+CODE
+10
+before
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "closures over outer lexicals" );
+.sub main :main
+    .local pmc x
+    x = box 1
+    .lex '$x', x
+    .const 'Sub' inner = 'inner'
+    $P0 = newclosure inner
+    $P0()
+    $P0()
+    say x
+.end
+
+.sub inner :outer('main')
+    $P0 = find_lex '$x'
+    $I0 = $P0
+    $I0 *= 3
+    $P1 = box $I0
+    store_lex '$x', $P1
+.end
+CODE
+9
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "loops and calls" );
+.sub main :main
+    .local int i, sum
+    sum = 0
+    i = 0
+  loop:
+    $I0 = square(i)
+    sum += $I0
+    inc i
+    if i < 4 goto loop
+    say sum
+    $S0 = times("x", 3)
+    say $S0
+.end
+
+.sub square
+    .param int n
+    $I0 = n * n
+    .return ($I0)
+.end
+
+.sub times
+    .param string s
+    .param int n
+    $S0 = repeat s, n
+    .return ($S0)
+.end
+CODE
+14
+xxx
+OUT
+
+# Local Variables:
+#   mode: cperl
+#   cperl-indent-level: 4
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4:
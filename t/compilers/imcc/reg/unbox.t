@@ -0,0 +1,155 @@
+#!perl
+# Copyright (C) 2026, Parrot Foundation.
+
+use strict;
+use warnings;
+use lib qw( . lib ../lib ../../lib );
+use Parrot::Test tests => 7;
+
+=head1 NAME
+
+t/compilers/imcc/reg/unbox.t - Unboxing of Integer and Float temporaries
+
+=head1 SYNOPSIS
+
+    % prove t/compilers/imcc/reg/unbox.t
+
+=head1 DESCRIPTION
+
+Runs PIR compiled with C<-Ou>, which keeps C<Integer> and C<Float> PMC
+temporaries in I and N registers. Each program must behave exactly as it
+does without the optimization.
+
+=cut
+
+$ENV{TEST_PROG_ARGS} ||= '';
+local $ENV{TEST_PROG_ARGS} = $ENV{TEST_PROG_ARGS} . ' -Ou';
+
+pir_output_is( <<'CODE', <<'OUT', "integer and float loop" );
+.sub main :main
+    $P0 = new 'Integer'
+    $P0 = 0
+    $P1 = new 'Float'
+    $P1 = 0.5
+    $P2 = new 'Integer'
+  loop:
+    $P2 = $P0 * 3
+    $P0 += $P2
+    $P1 += 1.25
+    inc $P0
+    if $P0 < 1000 goto loop
+    say $P0
+    say $P1
+.end
+CODE
+1365
+8
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "boxed at a call" );
+.sub main :main
+    $P0 = box 20
+    $P0 += 22
+    show($P0)
+.end
+.sub show
+    .param pmc p
+    $S0 = typeof p
+    print $S0
+    print ' '
+    say p
+.end
+CODE
+Integer 42
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "escaped PMC used afterwards stays boxed" );
+.sub main :main
+    .local pmc arr
+    arr = new 'ResizablePMCArray'
+    $P0 = new 'Integer'
+    $P0 = 5
+    push arr, $P0
+    inc $P0
+    $P1 = arr[0]
+    say $P1
+.end
+CODE
+6
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "escape inside a loop" );
+.sub main :main
+    .local pmc arr
+    arr = new 'ResizablePMCArray'
+    $P0 = new 'Integer'
+    $P0 = 1
+  loop:
+    push arr, $P0
+    $P0 += 1
+    if $P0 <= 3 goto loop
+    $S0 = join ',', arr
+    say $S0
+.end
+CODE
+4,4,4
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "morphing assignment is left alone" );
+.sub main :main
+    $P0 = new 'Integer'
+    $P0 = 1.5
+    inc $P0
+    say $P0
+    $S0 = typeof $P0
+    say $S0
+.end
+CODE
+2.5
+Float
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "parameters are left alone" );
+.sub main :main
+    $P0 = box 3
+    $P1 = twice($P0)
+    say $P0
+    say $P1
+.end
+.sub twice
+    .param pmc p
+    p *= 2
+    .return (p)
+.end
+CODE
+6
+6
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "comparisons and truth tests" );
+.sub main :main
+    $P0 = new 'Float'
+    $P0 = 2.5
+    $P1 = new 'Integer'
+    $P1 = 0
+  loop:
+    $P0 -= 1.0
+    inc $P1
+    unless $P0 goto done
+    if $P0 > -2.0 goto loop
+  done:
+    say $P1
+    $I0 = $P1
+    say $I0
+.end
+CODE
+5
+5
+OUT
+
+# Local Variables:
+#   mode: cperl
+#   cperl-indent-level: 4
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4:
@@ -0,0 +1,272 @@
+#!perl
+# Copyright (C) 2026, Parrot Foundation.
+
+use strict;
+use warnings;
+use lib qw( . lib ../lib ../../lib );
+use Parrot::Test tests => 10;
+
+=head1 NAME
+
+t/compilers/imcc/reg/value_numbering.t - Value numbering and loop invariants
+
+=head1 SYNOPSIS
+
+    % prove t/compilers/imcc/reg/value_numbering.t
+
+=head1 DESCRIPTION
+
+Runs PIR compiled with C<-Og>, which deletes ops recomputing a value already
+held in a register and moves loop invariant ops in front of their loop. Each
+program must behave exactly as it does without the optimization.
+
+=cut
+
+$ENV{TEST_PROG_ARGS} ||= '';
+local $ENV{TEST_PROG_ARGS} = $ENV{TEST_PROG_ARGS} . ' -Og';
+
+pir_output_is( <<'CODE', <<'OUT', "redundant and invariant arithmetic" );
+.sub main :main
+    .local int i, n, sum
+    n = ident(10)
+    sum = 0
+    i = 0
+  loop:
+    $I0 = n * 3
+    $I1 = $I0 + i
+    $I2 = n * 3
+    $I3 = $I2 - 1
+    sum += $I3
+    sum += $I1
+    inc i
+    if i < 3 goto loop
+    say sum
+.end
+
+.sub ident
+    .param int n
+    .return (n)
+.end
+CODE
+180
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "values on different paths aren't shared" );
+.sub main :main
+    $I0 = ident(1)
+    $I1 = ident(4)
+    unless $I0 goto other
+    $I2 = $I1 * 2
+    goto done
+  other:
+    $I3 = $I1 * 2
+  done:
+    $I4 = $I1 * 2
+    say $I4
+.end
+
+.sub ident
+    .param int n
+    .return (n)
+.end
+CODE
+8
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "globals stored in the loop are reloaded" );
+.sub main :main
+    .local int i
+    $P0 = box 0
+    set_global 'counter', $P0
+    i = 0
+  loop:
+    $P1 = get_global 'counter'
+    say $P1
+    $P2 = box i
+    inc $P2
+    set_global 'counter', $P2
+    inc i
+    if i < 3 goto loop
+.end
+CODE
+0
+1
+2
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "outer lexicals changed by a call are reloaded" );
+.sub main :main
+    .local pmc x
+    x = box 1
+    .lex '$x', x
+    .const 'Sub' inner = 'inner'
+    $P0 = newclosure inner
+    $P0()
+.end
+
+.sub inner :outer('main')
+    .local int i
+    i = 0
+  loop:
+    $P1 = find_lex '$x'
+    say $P1
+    bump()
+    inc i
+    if i < 3 goto loop
+.end
+
+.sub bump :outer('inner')
+    $P0 = find_lex '$x'
+    $I0 = $P0
+    $I0 *= 2
+    $P1 = box $I0
+    store_lex '$x', $P1
+.end
+CODE
+1
+2
+4
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "attributes set in the loop are reloaded" );
+.sub main :main
+    .local int i
+    $P0 = newclass 'Point'
+    addattribute $P0, 'x'
+    $P1 = new 'Point'
+    $P2 = box 5
+    setattribute $P1, 'x', $P2
+    i = 0
+  loop:
+    $P3 = getattribute $P1, 'x'
+    say $P3
+    $P4 = box i
+    setattribute $P1, 'x', $P4
+    inc i
+    if i < 3 goto loop
+.end
+CODE
+5
+0
+1
+OUT
+
+# -O2 also deletes ops whose result goes unused
+for my $level ( '', '2' ) {
+    local $ENV{TEST_PROG_ARGS} = $ENV{TEST_PROG_ARGS} . " -O${level}g";
+
+    pir_output_is( <<'CODE', <<'OUT', "attributes set by a vtable override are reloaded (-O${level}g)" );
+.sub main :main
+    .local int i
+    $P0 = newclass 'Counter'
+    addattribute $P0, 'x'
+    $P1 = new 'Counter'
+    $P2 = box 0
+    setattribute $P1, 'x', $P2
+    i = 0
+  loop:
+    $P3 = getattribute $P1, 'x'
+    say $P3
+    $I0 = $P1
+    inc i
+    if i < 3 goto loop
+.end
+
+.namespace ['Counter']
+
+.sub get_integer :vtable :method
+    $P0 = getattribute self, 'x'
+    $I0 = $P0
+    inc $I0
+    $P1 = box $I0
+    setattribute self, 'x', $P1
+    .return ($I0)
+.end
+CODE
+0
+1
+2
+OUT
+}
+
+pir_output_is( <<'CODE', <<'OUT', "ops that may throw stay in a loop that never runs" );
+.sub main :main
+    .local int i, d, n
+    d = ident(0)
+    n = ident(0)
+    i = 0
+    goto test
+  loop:
+    $I0 = 10 / d
+    say $I0
+    inc i
+  test:
+    if i < n goto loop
+    say "done"
+.end
+
+.sub ident
+    .param int n
+    .return (n)
+.end
+CODE
+done
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "ops that may throw stay behind their guard" );
+.sub main :main
+    .local int i, d, sum
+    d = ident(0)
+    sum = 0
+    i = 0
+  loop:
+    unless d goto skip
+    $I0 = 10 / d
+    sum += $I0
+  skip:
+    inc i
+    if i < 3 goto loop
+    say sum
+.end
+
+.sub ident
+    .param int n
+    .return (n)
+.end
+CODE
+0
+OUT
+
+pir_output_is( <<'CODE', <<'OUT', "computed jumps are left alone" );
+.sub main :main
+    .local int i, n, sum
+    n = ident(2)
+    sum = 0
+    i = 0
+    set_addr $I9, loop
+  loop:
+    $I0 = n * 3
+    $I1 = n * 3
+    sum += $I0
+    sum += $I1
+    inc i
+    if i >= 2 goto done
+    jump $I9
+  done:
+    say sum
+.end
+
+.sub ident
+    .param int n
+    .return (n)
+.end
+CODE
+24
+OUT
+
+# Local Variables:
+#   mode: cperl
+#   cperl-indent-level: 4
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4:
@@ -12,7 +12,7 @@ use Test::More;
 
 use Parrot::Test::Util 'create_tempfile';
 use Parrot::Config;
-use Parrot::Test tests => 14;
+use Parrot::Test tests => 16;
 
 =head1 NAME
 
@@ -491,6 +491,124 @@ without_slash() called!
 OUT
 }
 unlink(@temp_files);
+
+SKIP:
+{
+    my @dirs = map { File::Spec->catdir( File::Spec->tmpdir(), "parrot_inc_$$\_$_" ) } 1 .. 2;
+
+    for my $i ( 0 .. 1 ) {
+        mkdir $dirs[$i] or skip( "Cannot create temporary directory $dirs[$i]", 1 );
+        my $file = File::Spec->catfile( $dirs[$i], 'cached_inc.pasm' );
+        open( my $out_fh, '>', $file ) or skip( "Cannot write temporary file to $file", 1 );
+        print {$out_fh} "  .macro_const WHICH $i\n";
+        close $out_fh;
+        push @temp_files, $file;
+    }
+
+    pir_output_is( <<"CODE", <<'OUT', '.include finds a file again after the paths change' );
+  .include 'iglobals.pasm'
+  .include 'libpaths.pasm'
+
+  .sub main :main
+      .local pmc interp, lib_paths, include_paths, compiler
+      getinterp interp
+      lib_paths     = interp[.IGLOBALS_LIB_PATHS]
+      include_paths = lib_paths[.PARROT_LIB_PATH_INCLUDE]
+      compiler      = compreg 'PIR'
+
+      push include_paths, '$dirs[1]'
+      compile_and_run(compiler)
+      compile_and_run(compiler)
+
+      unshift include_paths, '$dirs[0]'
+      compile_and_run(compiler)
+
+      \$S0 = shift include_paths
+      compile_and_run(compiler)
+  .end
+
+  .sub compile_and_run
+      .param pmc compiler
+      \$P0 = compiler.'compile'(<<'PIR')
+.include 'cached_inc.pasm'
+.sub included :anon
+    say .WHICH
+.end
+PIR
+      \$P1 = \$P0.'main_sub'()
+      \$P1()
+  .end
+CODE
+1
+1
+0
+1
+OUT
+
+    unlink(@temp_files);
+    rmdir $_ for @dirs;
+}
+
+SKIP:
+{
+    my %dirs = map { $_ => File::Spec->catdir( File::Spec->tmpdir(), "parrot_cwd_$$\_$_" ) }
+        qw( a b c );
+
+    for my $name ( sort keys %dirs ) {
+        mkdir $dirs{$name} or skip( "Cannot create temporary directory $dirs{$name}", 1 );
+    }
+    for my $name (qw( a c )) {
+        my $file = File::Spec->catfile( $dirs{$name}, 'cwd_inc.pasm' );
+        open( my $out_fh, '>', $file ) or skip( "Cannot write temporary file to $file", 1 );
+        print {$out_fh} "  .macro_const WHICH '$name'\n";
+        close $out_fh;
+        push @temp_files, $file;
+    }
+
+    pir_output_is( <<"CODE", <<'OUT', '.include finds a file again after changing directory' );
+  .include 'iglobals.pasm'
+  .include 'libpaths.pasm'
+
+  .sub main :main
+      .local pmc interp, lib_paths, include_paths, compiler, os
+      getinterp interp
+      lib_paths     = interp[.IGLOBALS_LIB_PATHS]
+      include_paths = lib_paths[.PARROT_LIB_PATH_INCLUDE]
+      compiler      = compreg 'PIR'
+      os            = new ['OS']
+
+      push include_paths, '$dirs{c}'
+      os.'chdir'('$dirs{a}')
+      compile_and_run(compiler)
+
+      os.'chdir'('$dirs{b}')
+      compile_and_run(compiler)
+
+      os.'chdir'('$dirs{a}')
+      compile_and_run(compiler)
+  .end
+
+  .sub compile_and_run
+      .param pmc compiler
+      \$P0 = compiler.'compile'(<<'PIR')
+.include 'cwd_inc.pasm'
+.sub included :anon
+    say .WHICH
+.end
+PIR
+      \$P1 = \$P0.'main_sub'()
+      \$P1()
+  .end
+CODE
+a
+c
+a
+OUT
+
+    unlink(@temp_files);
+    rmdir $_ for values %dirs;
+}
+
 $ended_ok = 1;
 
 exit;
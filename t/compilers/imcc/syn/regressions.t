@@ -5,7 +5,7 @@ use strict;
 use warnings;
 use lib qw( . lib ../lib ../../lib );
 use Test::More;
-use Parrot::Test tests => 21;
+use Parrot::Test tests => 22;
 
 pir_error_output_like( <<'CODE', <<'OUT', 'invalid get_results syntax');
 .sub main :main
@@ -250,6 +250,44 @@ CODE
 OUT
 }
 
+pir_output_is( <<'CODE', <<'OUT', 'labels, subids and constants across subs and namespaces');
+.namespace ['Opts']
+.sub 'Opts' :method :subid('opts')
+    .return ('Opts method')
+.end
+
+.namespace ['A']
+.sub 'f' :subid('a_f')
+    .return ('A f')
+.end
+
+.namespace ['B']
+.sub 'f' :subid('b_f')
+    .return ('B f')
+.end
+
+.namespace []
+.sub main :main
+    $P0 = newclass ['Opts']
+    $P1 = new ['Opts']
+    $S0 = $P1.'Opts'()
+    say $S0
+    .const 'Sub' af = 'a_f'
+    $S0 = af()
+    say $S0
+    .const 'Sub' bf = 'b_f'
+    $S0 = bf()
+    say $S0
+    $S0 = 'Opts'
+    say $S0
+.end
+CODE
+Opts method
+A f
+B f
+Opts
+OUT
+
 # This test probably belongs in subflags.t
 # The test inspired by TT #744, even though it presents differently.
 {
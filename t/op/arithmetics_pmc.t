@@ -19,7 +19,7 @@ Test handling C<dest> arg in 3-args arithmetic.
     .include 'test_more.pir'
     .include "iglobals.pasm"
 
-    plan(40)
+    plan(48)
 
     # Don't check BigInt or BigNum without gmp
     .local pmc interp     # a handle to our interpreter object.
@@ -31,14 +31,16 @@ Test handling C<dest> arg in 3-args arithmetic.
 
     run_tests_for('Integer')
     run_tests_for('Float')
+    test_derived_and_mixed()
 
     if gmp goto do_big_ones
-        skip( 20, "will not test BigInt or BigNum without gmp" )
+        skip( 22, "will not test BigInt or BigNum without gmp" )
         goto end
 
   do_big_ones:
     run_tests_for('BigInt')
     run_tests_for('BigNum')
+    test_overflow()
 
   end:
 .end
@@ -357,6 +359,61 @@ Test handling C<dest> arg in 3-args arithmetic.
   end:
 .end
 
+.sub test_derived_and_mixed
+    $P0 = subclass 'Integer', 'Backwards'
+    $P1 = new ['Backwards']
+    $P1 = 1
+    $P2 = new ['Backwards']
+    $P2 = 2
+
+    $I0 = cmp $P1, $P2
+    is( $I0, 1, "cmp uses the vtable override of an Integer subclass" )
+    $I0 = islt $P1, $P2
+    is( $I0, 0, "islt uses the vtable override of an Integer subclass" )
+
+    $P3 = $P1 + $P2
+    $S0 = typeof $P3
+    is( $S0, 'Backwards', "add keeps the type of an Integer subclass" )
+
+    $P1 = new ['Integer']
+    $P1 = 1
+    $P2 = new ['Float']
+    $P2 = 2.5
+    $P3 = $P1 + $P2
+    is( $P3, 3.5, "add of an Integer and a Float" )
+    $I0 = cmp $P2, $P1
+    is( $I0, 1, "cmp of a Float and an Integer" )
+
+    $I0 = 0
+    lt $P2, 3, float_lt_int
+    $I0 = 1
+  float_lt_int:
+    is( $I0, 0, "lt of a Float and an integer" )
+.end
+
+.sub test_overflow
+    $P0 = new ['Integer']
+    $P0 = 9223372036854775807
+    inc $P0
+    $S0 = typeof $P0
+    is( $S0, 'BigInt', "inc past the largest Integer gives a BigInt" )
+
+    $P0 = new ['Integer']
+    $P0 = 4294967296
+    $P1 = $P0 * $P0
+    is( $P1, '18446744073709551616', "mul overflowing an Integer gives a BigInt" )
+.end
+
+.namespace ['Backwards']
+
+.sub 'cmp' :vtable
+    .param pmc other
+    $I0 = self
+    $I1 = other
+    $I2 = cmp $I1, $I0
+    .return ($I2)
+.end
+
 # Local Variables:
 #   mode: pir
 #   fill-column: 100
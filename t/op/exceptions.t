@@ -5,7 +5,7 @@ use strict;
 use warnings;
 use lib qw( . lib ../lib ../../lib );
 use Test::More;
-use Parrot::Test tests => 32,
+use Parrot::Test tests => 34,
     qw[run_command slurp_file];
 use Parrot::Test::Util 'create_tempfile';
 
@@ -778,6 +778,103 @@ WX2
         "user-level backtraces the same as automatically generated backtraces");
 }
 
+pir_output_is( <<'CODE', <<'OUTPUT', "throw_control passes its type and payload" );
+.include 'except_types.pasm'
+.sub main :main
+    .local pmc eh
+    .local int i
+    eh = new 'ExceptionHandler', .CONTROL_LOOP_NEXT
+    set_label eh, handler
+    push_eh eh
+    i = 0
+  loop:
+    inc i
+    if i > 3 goto done
+    skip(i)
+  handler:
+    .local pmc ex
+    .get_results (ex)
+    $I0 = ex['type']
+    $P0 = ex['payload']
+    print $I0
+    print ' '
+    say $P0
+    goto loop
+  done:
+    pop_eh
+    $P0 = count(5)
+    say $P0
+.end
+
+.sub skip
+    .param int i
+    $P0 = box i
+    throw_control .CONTROL_LOOP_NEXT, $P0
+.end
+
+.sub count
+    .param int n
+    .local pmc eh
+    eh = new 'ExceptionHandler', .CONTROL_RETURN
+    set_label eh, handler
+    push_eh eh
+    $P0 = box n
+    throw_control .CONTROL_RETURN, $P0
+  handler:
+    .local pmc ex
+    .get_results (ex)
+    pop_eh
+    $P1 = ex['payload']
+    .return ($P1)
+.end
+CODE
+65544 1
+65544 2
+65544 3
+5
+OUTPUT
+
+pir_output_is( <<'CODE', <<'OUTPUT', "an exception kept by a handler outlives later throws" );
+.include 'except_types.pasm'
+.sub main :main
+    .local pmc eh
+    eh = new 'ExceptionHandler', .CONTROL_LOOP_LAST
+    set_label eh, handler
+    push_eh eh
+    $P0 = box 'outer payload'
+    throw_control .CONTROL_LOOP_LAST, $P0
+  handler:
+    .local pmc ex
+    .get_results (ex)
+    pop_eh
+    $P1 = inner()
+    $I0 = issame ex, $P1
+    say $I0
+    $P2 = ex['payload']
+    say $P2
+    $P3 = $P1['payload']
+    say $P3
+.end
+
+.sub inner
+    .local pmc eh
+    eh = new 'ExceptionHandler', .CONTROL_LOOP_LAST
+    set_label eh, handler
+    push_eh eh
+    $P0 = box 'inner payload'
+    throw_control .CONTROL_LOOP_LAST, $P0
+  handler:
+    .local pmc ex
+    .get_results (ex)
+    pop_eh
+    .return (ex)
+.end
+CODE
+0
+outer payload
+inner payload
+OUTPUT
+
 # Local Variables:
 #   mode: cperl
 #   cperl-indent-level: 4
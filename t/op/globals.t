@@ -15,7 +15,7 @@ Tests the C<get_global> and C<set_global> operations.
 
 =cut
 
-.const int TESTS = 12
+.const int TESTS = 15
 
 .namespace []
 
@@ -32,6 +32,7 @@ Tests the C<get_global> and C<set_global> operations.
     find_null_global()
     get_hll_global_not_found()
     find_store_with_key()
+    lookup_sees_changes()
 .end
 
 .namespace []
@@ -152,6 +153,53 @@ Tests the C<get_global> and C<set_global> operations.
     set_hll_global [ "Monkey2"; "Toaster" ], "Explosion", $P0
 .end
 
+.namespace []
+.sub 'lookup_sees_changes'
+    .local pmc ns, seen
+    ns   = get_namespace ['Monkey3']
+    seen = new ['ResizableStringArray']
+    $I0  = 0
+  loop:
+    $P0 = get_hll_global ['Monkey3'], 'banana'
+    if null $P0 goto missing
+    $S0 = $P0
+    push seen, $S0
+    goto next
+  missing:
+    push seen, 'null'
+  next:
+    inc $I0
+    if $I0 == 1 goto store
+    if $I0 == 2 goto replace
+    if $I0 == 3 goto delete
+    goto done
+  store:
+    $P1 = new ['String']
+    $P1 = 'yellow'
+    set_hll_global ['Monkey3'], 'banana', $P1
+    goto loop
+  replace:
+    $P1 = new ['String']
+    $P1 = 'green'
+    ns['banana'] = $P1
+    goto loop
+  delete:
+    ns.'del_var'('banana')
+    goto loop
+  done:
+    $S0 = join ' ', seen
+    is($S0, 'null yellow green null', 'repeated lookup sees stores and deletes')
+
+    $P0 = get_global 'lookup_sees_changes'
+    ok($P0, 'get_global finds a sub in the current namespace')
+    $P0 = get_root_global ['parrot'], 'lookup_sees_changes'
+    ok($P0, 'get_root_global with key finds a sub')
+.end
+
+.namespace ['Monkey3']
+.sub 'placeholder'
+.end
+
 # Local Variables:
 #   mode: pir
 #   fill-column: 100
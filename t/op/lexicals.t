@@ -7,13 +7,15 @@ use lib qw( . lib ../lib ../../lib );
 
 use Test::More;
 use Parrot::Test;
+use Parrot::Config;
+use File::Spec;
 
 $ENV{TEST_PROG_ARGS} ||= '';
 
 plan( skip_all => 'lexicals not thawed properly from PBC, GH #430' )
     if $ENV{TEST_PROG_ARGS} =~ /--run-pbc/;
 
-plan( tests => 54 );
+plan( tests => 59 );
 
 =head1 NAME
 
@@ -1644,6 +1646,103 @@ Starobrno
 Pilsner Urquell
 OUTPUT
 
+pasm_output_is( <<'CODE', <<'OUTPUT', 'find_lex_slot/store_lex_slot - PASM' );
+.pcc_sub :main main:
+    .lex "$a", P0
+    new P0, 'String'
+    set P0, "slot 0"
+    find_lex_slot P1, 0, 0
+    print P1
+    print "\n"
+    new P2, 'String'
+    set P2, "stored"
+    store_lex_slot 0, 0, P2
+    print P0
+    print "\n"
+    find_lex_slot P3, 1, 0
+    isnull I0, P3
+    print I0
+    print "\n"
+    end
+CODE
+slot 0
+stored
+1
+OUTPUT
+
+pir_error_output_like( <<'CODE', <<'OUTPUT', 'store_lex_slot - missing outer context' );
+.sub main :main
+    $P0 = box 1
+    store_lex_slot 3, 0, $P0
+.end
+CODE
+/Lexical slot 0 at depth 3 not found/
+OUTPUT
+
+{
+    local $ENV{TEST_PROG_ARGS} = $ENV{TEST_PROG_ARGS} . ' -Ol';
+
+    my $code = <<'CODE';
+.sub main :main
+    .lex '$x', $P0
+    .lex '$i', $I0
+    $P0 = box 'outer'
+    $I0 = 1
+    'inner'()
+    $P1 = find_lex '$x'
+    say $P1
+    say $I0
+.end
+.sub 'inner' :outer('main')
+    .lex '$y', $S0
+    $S0 = 'y'
+    $P1 = find_lex '$x'
+    say $P1
+    $P1 = box 'changed'
+    store_lex '$x', $P1
+    store_lex '$i', 2
+    'innermost'()
+.end
+.sub 'innermost' :outer('inner')
+    $S1 = find_lex '$y'
+    say $S1
+    $I1 = find_lex '$i'
+    say $I1
+    $P1 = find_lex '$missing'
+    $I2 = isnull $P1
+    say $I2
+.end
+CODE
+
+    pir_output_is( $code, <<'OUTPUT', 'lexicals resolved to slots (-Ol)' );
+outer
+y
+2
+1
+changed
+2
+OUTPUT
+
+    my $parrot = File::Spec->catfile( '.', $PConfig{test_prog} );
+    my $disasm = File::Spec->catfile( '.', "pbc_disassemble$PConfig{exe}" );
+    my $pirfn  = "$0.slots.pir";
+    my $pbcfn  = "$0.slots.pbc";
+
+  SKIP: {
+        skip 'pbc_disassemble has not been built', 2 unless -f $disasm;
+
+        open my $fh, '>', $pirfn or die "Can't write $pirfn: $!";
+        print {$fh} $code;
+        close $fh;
+        system("$parrot -Ol -o $pbcfn $pirfn");
+        my $asm = `$disasm $pbcfn`;
+        unlink $pirfn, $pbcfn;
+
+        like( $asm, qr/find_lex_slot_p_ic_ic/,  'outer lexical fetched by slot (-Ol)' );
+        like( $asm, qr/store_lex_slot_ic_ic_p/, 'outer lexical stored by slot (-Ol)' );
+    }
+}
+
 # Local Variables:
 #   mode: cperl
 #   cperl-indent-level: 4
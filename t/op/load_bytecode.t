@@ -5,7 +5,10 @@ use strict;
 use warnings;
 use lib qw( . lib ../lib ../../lib );
 use Test::More;
-use Parrot::Test tests => 3;
+use File::Spec;
+use File::Temp qw( tempdir );
+use Parrot::Config;
+use Parrot::Test tests => 21;
 
 =head1 NAME
 
@@ -45,6 +48,238 @@ CODE
 /"load_bytecode" couldn't find file 'no_file_by_this_name'/
 OUTPUT
 
+{
+    my $cache = tempdir( CLEANUP => 1 );
+    my $lib   = "$cache/cached_lib.pir";
+    local $ENV{PARROT_PBC_CACHE} = $cache;
+
+    my $write_lib = sub {
+        my $greeting = shift;
+        open my $fh, '>', $lib or die "Can't write $lib: $!";
+        print $fh <<"LIB";
+.sub onload :load
+    say 'loading'
+.end
+.sub greet
+    say '$greeting'
+.end
+LIB
+        close $fh;
+    };
+
+    my $code = <<"CODE";
+.sub main :main
+    load_bytecode '$lib'
+    \$P0 = get_global 'greet'
+    \$P0()
+.end
+CODE
+
+    $write_lib->('compiled');
+    pir_output_is( $code, <<'OUTPUT', "PARROT_PBC_CACHE: compile .pir and keep it" );
+loading
+compiled
+OUTPUT
+
+    my @kept = glob "$cache/*.pir.pbc";
+    is( scalar @kept, 1, 'PARROT_PBC_CACHE: one entry kept' );
+
+    pir_output_is( $code, <<'OUTPUT', "PARROT_PBC_CACHE: load kept bytecode, run :load" );
+loading
+compiled
+OUTPUT
+
+    $write_lib->('edited');
+    pir_output_is( $code, <<'OUTPUT', "PARROT_PBC_CACHE: edited source is recompiled" );
+loading
+edited
+OUTPUT
+}
+
+{
+    my $cache = tempdir( CLEANUP => 1 );
+    my $lib   = "$cache/including_lib.pir";
+    my $inc   = "$cache/included.pir";
+    local $ENV{PARROT_PBC_CACHE} = $cache;
+
+    my $write_inc = sub {
+        my $version = shift;
+        open my $fh, '>', $inc or die "Can't write $inc: $!";
+        print $fh ".macro_const VERSION '$version'\n";
+        close $fh;
+    };
+
+    open my $fh, '>', $lib or die "Can't write $lib: $!";
+    print $fh <<"LIB";
+.include '$inc'
+.sub version
+    say .VERSION
+.end
+LIB
+    close $fh;
+
+    my $code = <<"CODE";
+.sub main :main
+    load_bytecode '$lib'
+    \$P0 = get_global 'version'
+    \$P0()
+.end
+CODE
+
+    $write_inc->('v1');
+    pir_output_is( $code, "v1\n", "PARROT_PBC_CACHE: compile .pir with an .include" );
+
+    $write_inc->('v2');
+    pir_output_is( $code, "v2\n", "PARROT_PBC_CACHE: edited .include is recompiled" );
+
+    for my $kept ( glob "$cache/*.pir.pbc" ) {
+        open my $out, '>', $kept or die "Can't write $kept: $!";
+        print $out "not bytecode\n";
+        close $out;
+    }
+    pir_output_is( $code, "v2\n", "PARROT_PBC_CACHE: damaged entry is recompiled" );
+
+    my @kept = glob "$cache/*.pir.files";
+    is( scalar @kept, 1, 'PARROT_PBC_CACHE: one index per source and flags' );
+
+    SKIP: {
+        skip( 'optimizing already', 2 ) if ( $ENV{TEST_PROG_ARGS} || '' ) =~ /-O/;
+
+        local $ENV{TEST_PROG_ARGS} = ( $ENV{TEST_PROG_ARGS} || '' ) . ' -O2';
+        pir_output_is( $code, "v2\n", "PARROT_PBC_CACHE: compile again with -O2" );
+
+        @kept = glob "$cache/*.pir.files";
+        is( scalar @kept, 2, 'PARROT_PBC_CACHE: -O2 gets an entry of its own' );
+    }
+}
+
+my $PARROT = File::Spec->catfile( File::Spec->curdir, "parrot$PConfig{exe}" );
+
+{
+    my $dir = tempdir( CLEANUP => 1 );
+    my $big = 'x' x 10000;
+    my $pbc = make_pbc( $dir, 'big', <<"PIR" );
+.sub main :main
+    \$S0 = '$big'
+    \$I0 = length \$S0
+    say \$I0
+.end
+PIR
+
+    SKIP: {
+        skip( 'needs mmap and /proc/self/maps', 1 )
+            unless $PConfig{i_sysmman} && -r '/proc/self/maps';
+
+        pir_output_is( <<"CODE", "mapped\n", 'bytecode files are mapped' );
+.sub main :main
+    load_bytecode '$pbc'
+    \$P0 = new ['FileHandle']
+    \$P0.'open'('/proc/self/maps', 'r')
+    \$S0 = ''
+  read:
+    \$S1 = \$P0.'readline'()
+    if \$S1 == '' goto done
+    \$S0 .= \$S1
+    goto read
+  done:
+    \$I0 = index \$S0, '$pbc'
+    if \$I0 < 0 goto not_mapped
+    say 'mapped'
+    .return ()
+  not_mapped:
+    say 'read'
+.end
+CODE
+    }
+
+    my $loader = "$dir/loader.pir";
+    open my $fh, '>', $loader or die "Can't write $loader: $!";
+    print $fh <<'PIR';
+.sub main :main
+    $P0 = new ['PackfileView']
+    $P0.'read_from_file'('')
+    $P1 = $P0.'main_sub'()
+    $P1()
+.end
+PIR
+    close $fh;
+
+    is( scalar `$PARROT $loader < $pbc`, "10000\n",
+        'bytecode redirected to stdin is read in one piece' );
+    is( scalar `"$^X" -e "binmode STDIN; binmode STDOUT; print <STDIN>" < $pbc | $PARROT $loader`,
+        "10000\n", 'bytecode piped to stdin is read until the pipe closes' );
+}
+
+{
+    my $dir   = tempdir( CLEANUP => 1 );
+    my $cache = tempdir( CLEANUP => 1 );
+    local $ENV{PARROT_PBC_CACHE} = $cache;
+
+    my $greet = <<'PIR';
+.sub greet
+    say 'GREETING'
+.end
+PIR
+    ( my $foreign_pir = $greet ) =~ s/GREETING/foreign/;
+    ( my $native_pir  = $greet ) =~ s/GREETING/cached/;
+    my $foreign = make_pbc( $dir, 'foreign', $foreign_pir );
+    my $native  = make_pbc( $dir, 'native',  $native_pir );
+
+    # without float constants, bytecode differs from a foreign float format's
+    # only in the floattype byte of its header
+    open my $fh, '+<', $foreign or die "Can't open $foreign: $!";
+    binmode $fh;
+    seek $fh, 10, 0;
+    read $fh, my $floattype, 1;
+    seek $fh, 10, 0;
+    print $fh chr( ord $floattype ? 0 : 2 );
+    close $fh;
+
+    my $code = <<"CODE";
+.sub main :main
+    load_bytecode '$foreign'
+    \$P0 = get_global 'greet'
+    \$P0()
+.end
+CODE
+
+    pir_output_is( $code, "foreign\n", 'PARROT_PBC_CACHE: foreign bytecode is converted' );
+
+    my @kept = glob "$cache/*";
+    is( scalar @kept, 1, 'PARROT_PBC_CACHE: one native copy, renamed into place' );
+
+    open my $in, '<', $native or die "Can't read $native: $!";
+    binmode $in;
+    my $bytes = do { local $/; <$in> };
+    close $in;
+    open my $out, '>', $kept[0] or die "Can't write $kept[0]: $!";
+    binmode $out;
+    print $out $bytes;
+    close $out;
+    pir_output_is( $code, "cached\n", 'PARROT_PBC_CACHE: the native copy is loaded' );
+
+    my $mtime = ( stat $foreign )[9] - 100;
+    utime $mtime, $mtime, $foreign;
+    pir_output_is( $code, "foreign\n", 'PARROT_PBC_CACHE: changed bytecode is converted again' );
+
+    @kept = glob "$cache/*";
+    is( scalar @kept, 2, 'PARROT_PBC_CACHE: changed bytecode gets a copy of its own' );
+}
+
+# compile PIR source to bytecode file $name.pbc in $dir
+sub make_pbc {
+    my ( $dir, $name, $source ) = @_;
+    my $pir = "$dir/$name.pir";
+    my $pbc = "$dir/$name.pbc";
+
+    open my $fh, '>', $pir or die "Can't write $pir: $!";
+    print $fh $source;
+    close $fh;
+
+    system( $PARROT, '-o', $pbc, $pir ) == 0 or die "Can't compile $pir";
+    return $pbc;
+}
+
 # Local Variables:
 #   mode: cperl
 #   cperl-indent-level: 4
@@ -20,7 +20,7 @@ Tests the BigInt PMC.
     .include 'test_more.pir'
 
     .local int num_tests
-    num_tests = 89
+    num_tests = 98
     plan(num_tests)
 
     .local int good
@@ -51,6 +51,7 @@ Tests the BigInt PMC.
     pi()
     is_equal()
     get_long()
+    small_values()
     bugfixes()
 
   done:
@@ -1589,6 +1590,66 @@ stop:
     ret:
 .end
 
+.sub small_values
+    .local int max
+    .local int min
+    .local pmc big
+    (min, max) = 'get_int_minmax'()
+
+    big = new ['BigInt']
+    big = max
+    inc big
+    $P0 = box max
+    $S0 = $P0
+    $S1 = big
+    $I0 = $S1 > $S0
+    ok($I0, 'increment past the largest native integer')
+    dec big
+    $I0 = big
+    is($I0, max, '... and back down to a native integer')
+
+    big = min
+    $P0 = big - 1
+    $P0 = $P0 + 1
+    $I0 = $P0
+    is($I0, min, 'subtract past the smallest native integer and back')
+
+    big = max
+    $P0 = big * 2
+    $P0 = $P0 / 2
+    $I0 = $P0
+    is($I0, max, 'multiply past the largest native integer and back')
+
+    big = min
+    $P0 = big * -1
+    $P1 = box max
+    inc $P1
+    is($P0, $P1, 'min integer times -1 overflows')
+
+    big = 3037000499
+    $P0 = big * big
+    $S0 = $P0
+    is($S0, '9223372030926249001', 'product just below 2**63')
+
+    big = '100000000000000000000000000000'
+    $P0 = new ['BigInt']
+    $P0 = '-99999999999999999999999999999'
+    big += $P0
+    $I0 = big
+    is($I0, 1, 'sum of huge values demotes to a native integer')
+
+    $P0 = new ['BigInt']
+    $P0 = 7
+    $P0 *= 6
+    $P0 -= 2
+    is($P0, 40, 'in-place arithmetic on small values')
+
+    $P1 = new ['BigInt']
+    $P1 = 41
+    $I0 = cmp $P0, $P1
+    is($I0, -1, 'compare small values')
+.end
+
 .sub bugfixes
 
     $P0 = new ['BigInt']
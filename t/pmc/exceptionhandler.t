@@ -22,7 +22,7 @@ Tests the ExceptionHandler PMC.
     .include 'test_more.pir'
 
     # If test exited with "bad plan" MyHandlerCan.can_handle wasn't invoked.
-    plan(25)
+    plan(28)
 
     test_bool()
     test_int()
@@ -105,6 +105,7 @@ Tests the ExceptionHandler PMC.
     test_handle_types_except()
     test_init_pmc_with_key()
     test_all_types()
+    test_control_loop()
 
     goto init_int
 
@@ -412,6 +413,63 @@ Tests the ExceptionHandler PMC.
     pop_eh
 .end
 
+.sub 'test_control_loop'
+    .local pmc last_eh, other_eh, next_eh, ex
+    .local int i, nexts
+    i = 0
+    nexts = 0
+
+    last_eh = new ['ExceptionHandler'], .CONTROL_LOOP_LAST
+    set_label last_eh, last
+    push_eh last_eh
+    next_eh = new ['ExceptionHandler'], .CONTROL_LOOP_NEXT
+    set_label next_eh, next
+    push_eh next_eh
+    other_eh = new ['ExceptionHandler']
+    other_eh.'handle_types_except'(.CONTROL_LOOP_NEXT, .CONTROL_LOOP_LAST)
+    set_label other_eh, other
+    push_eh other_eh
+
+  loop:
+    inc i
+    'throw_control'(i)
+    goto loop
+  next:
+    .get_results (ex)
+    inc nexts
+    goto loop
+  last:
+    .get_results (ex)
+    pop_eh
+    pop_eh
+    pop_eh
+    is(nexts, 999, 'control exceptions skip handlers for other types')
+    $I0 = ex['type']
+    is($I0, .CONTROL_LOOP_LAST, 'handler receives the control exception')
+    $P0 = ex['payload']
+    is($P0, 1000, 'control exception keeps its payload')
+    .return ()
+  other:
+    pop_eh
+    pop_eh
+    pop_eh
+    ok(0, 'control exceptions skip handlers for other types')
+    ok(0, 'handler receives the control exception')
+    ok(0, 'control exception keeps its payload')
+.end
+
+.sub 'throw_control'
+    .param int i
+    $P0 = new ['Exception']
+    $P0['type'] = .CONTROL_LOOP_NEXT
+    if i < 1000 goto throw_it
+    $P0['type'] = .CONTROL_LOOP_LAST
+    $P1 = box i
+    $P0['payload'] = $P1
+  throw_it:
+    throw $P0
+.end
+
 # Local Variables:
 #   mode: pir
 #   fill-column: 100
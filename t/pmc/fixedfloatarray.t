@@ -19,7 +19,7 @@ out-of-bounds test. Checks INT and PMC keys.
 .sub main :main
     .include 'fp_equality.pasm'
     .include 'test_more.pir'
-    plan(32)
+    plan(47)
 
     array_size_tests()
     element_set_tests()
@@ -32,6 +32,9 @@ out-of-bounds test. Checks INT and PMC keys.
     test_new_style_init()
     test_invalid_init_tt1509()
     test_get_string()
+    test_sort()
+    test_bulk_methods()
+    test_slice()
 .end
 
 .sub array_size_tests
@@ -284,6 +287,109 @@ CODE
     is($S0, '[ -1.5, 0, 3.14 ]', 'has string representation')
 .end
 
+.sub test_sort
+    $P0 = new 'FixedFloatArray', 5
+    $P0[0] = 2.5
+    $P0[1] = -1.5
+    $P0[2] = 10
+    $P0[3] = 0
+    $P0[4] = -1.5
+    $P0.'sort'()
+    $S0 = join ' ', $P0
+    is($S0, '-1.5 -1.5 0 2.5 10', 'default sort')
+
+    .const 'Sub' descending = 'descending_num'
+    $P0.'sort'(descending)
+    $S0 = join ' ', $P0
+    is($S0, '10 2.5 0 -1.5 -1.5', 'sort with custom cmp function')
+.end
+
+.sub descending_num
+    .param num a
+    .param num b
+    $I0 = cmp b, a
+    .return ($I0)
+.end
+
+.sub test_bulk_methods
+    .local pmc a, b
+    a = new 'FixedFloatArray', 3
+    a[0] = 1.5
+    a[1] = -2
+    a[2] = 4
+    b = new 'FixedFloatArray', 3
+    b[0] = 2
+    b[1] = 0.5
+    b[2] = 0.25
+
+    a.'add'(b)
+    $S0 = join ' ', a
+    is($S0, '3.5 -1.5 4.25', 'add an array elementwise')
+
+    a.'mul'(2)
+    $S0 = join ' ', a
+    is($S0, '7 -3 8.5', 'multiply by a scalar')
+
+    $P0 = new 'ResizableIntegerArray'
+    push $P0, 1
+    push $P0, 2
+    push $P0, 4
+    a.'fma'(b, $P0)
+    $S0 = join ' ', a
+    is($S0, '9 -2 9.5', 'fma with an integer array converted')
+
+    $N0 = a.'sum'()
+    is($N0, 16.5, 'sum')
+    $N0 = a.'min'()
+    is($N0, -2, 'min')
+    $N0 = a.'max'()
+    is($N0, 9.5, 'max')
+    $N0 = a.'dot'(b)
+    is($N0, 19.375, 'dot product')
+
+    a.'prefix_sum'()
+    $S0 = join ' ', a
+    is($S0, '9 7 16.5', 'prefix sum')
+
+    $P0 = new 'FixedIntegerArray', 2
+    $P0[0] = 2
+    $P0[1] = 0
+    $P1 = a.'gather'($P0)
+    $S0 = join ' ', $P1
+    is($S0, '16.5 9', 'gather')
+
+    a.'scatter'($P0, 0.5)
+    $S0 = join ' ', a
+    is($S0, '0.5 7 0.5', 'scatter a scalar')
+
+    $P0[1] = 3
+    push_eh handle_scatter
+    a.'scatter'($P0, 1.5)
+  handle_scatter:
+    $S0 = join ' ', a
+    is($S0, '0.5 7 0.5', 'scatter stores nothing when an index is out of bounds')
+.end
+
+.sub test_slice
+    .local pmc a, s
+    a = new 'FixedFloatArray', 4
+    a[0] = 1
+    a[1] = 2
+    a[2] = 3
+    a[3] = 4
+    s = a.'slice'(1, 3)
+    s.'mul'(0.5)
+    $S0 = join ' ', a
+    is($S0, '1 1 1.5 4', 'slice shares storage with its array')
+
+    throws_substring(<<'CODE', 'slice out of bounds', 'slice checks its bounds')
+    .sub main :main
+        $P0 = new 'FixedFloatArray', 2
+        $P0.'slice'(2, 1)
+    .end
+CODE
+.end
+
 # Local Variables:
 #   mode: pir
 #   fill-column: 100
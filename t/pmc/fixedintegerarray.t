@@ -34,6 +34,10 @@ out-of-bounds test. Checks INT and PMC keys.
     test_new_style_init()
     test_invalid_init_tt1509()
     test_custom_cmp()
+    test_bulk_arithmetic()
+    test_reductions()
+    test_gather_scatter()
+    test_slice()
 
     done_testing()
 .end
@@ -290,6 +294,15 @@ out-of-bounds test. Checks INT and PMC keys.
     a1.'sort'()
     $I0 = iseq a1, a2
     is($I0, 1, 'default sort')
+
+    a1 = new ['FixedIntegerArray'], 4
+    a1[0] = 3000000000
+    a1[1] = -3000000000
+    a1[2] = 0
+    a1[3] = 1
+    a1.'sort'()
+    $S0 = join ' ', a1
+    is($S0, '-3000000000 0 1 3000000000', 'default sort of large values')
 .end
 
 .sub test_invalid_init_tt1509
@@ -326,6 +339,170 @@ CODE
     .return ($I0)
 .end
 
+.sub 'fia_from_string'
+    .param string s
+    .local pmc parts, fia
+    parts = split ' ', s
+    $I0 = parts
+    fia = new ['FixedIntegerArray'], $I0
+    $I1 = 0
+  loop:
+    if $I1 >= $I0 goto done
+    $I2 = parts[$I1]
+    fia[$I1] = $I2
+    inc $I1
+    goto loop
+  done:
+    .return (fia)
+.end
+
+.sub 'test_bulk_arithmetic'
+    .local pmc a, b
+    a = 'fia_from_string'('1 2 3 4')
+    b = 'fia_from_string'('10 20 30 40')
+
+    a.'add'(b)
+    $S0 = join ' ', a
+    is($S0, '11 22 33 44', 'add an array elementwise')
+
+    a.'add'(-1)
+    $S0 = join ' ', a
+    is($S0, '10 21 32 43', 'add a scalar to every element')
+
+    a.'mul'(2)
+    $S0 = join ' ', a
+    is($S0, '20 42 64 86', 'multiply by a scalar')
+
+    $P0 = new ['ResizableIntegerArray']
+    push $P0, 1
+    push $P0, 0
+    push $P0, -1
+    push $P0, 2
+    a.'mul'($P0)
+    $S0 = join ' ', a
+    is($S0, '20 0 -64 172', 'multiply by a ResizableIntegerArray')
+
+    $P0 = new ['ResizablePMCArray']
+    push $P0, 1
+    push $P0, 2
+    push $P0, 3
+    push $P0, 4
+    b.'fma'($P0, 3)
+    $S0 = join ' ', b
+    is($S0, '13 26 39 52', 'fma with a generic array and a scalar')
+
+    throws_substring(<<'CODE', 'operand has 3 elements, expected 4', 'mismatched sizes throw')
+    .sub main :main
+        $P0 = new ['FixedIntegerArray'], 4
+        $P1 = new ['FixedIntegerArray'], 3
+        $P0.'add'($P1)
+    .end
+CODE
+.end
+
+.sub 'test_reductions'
+    .local pmc a
+    a = 'fia_from_string'('3 -7 12 5')
+
+    $I0 = a.'sum'()
+    is($I0, 13, 'sum')
+    $I0 = a.'min'()
+    is($I0, -7, 'min')
+    $I0 = a.'max'()
+    is($I0, 12, 'max')
+
+    $P0 = 'fia_from_string'('1 2 3 4')
+    $I0 = a.'dot'($P0)
+    is($I0, 45, 'dot product')
+
+    a.'prefix_sum'()
+    $S0 = join ' ', a
+    is($S0, '3 -4 8 13', 'prefix sum')
+
+    throws_substring(<<'CODE', 'min of an empty array', 'min of an empty array throws')
+    .sub main :main
+        $P0 = new ['FixedIntegerArray']
+        $P0.'min'()
+    .end
+CODE
+.end
+
+.sub 'test_gather_scatter'
+    .local pmc a, idx
+    a   = 'fia_from_string'('10 11 12 13 14')
+    idx = 'fia_from_string'('4 0 4 2')
+
+    $P0 = a.'gather'(idx)
+    $S0 = typeof $P0
+    is($S0, 'FixedIntegerArray', 'gather returns a FixedIntegerArray')
+    $S0 = join ' ', $P0
+    is($S0, '14 10 14 12', 'gather')
+
+    $P1 = 'fia_from_string'('1 2 3')
+    idx = 'fia_from_string'('1 3 0')
+    a.'scatter'(idx, $P1)
+    $S0 = join ' ', a
+    is($S0, '3 1 12 2 14', 'scatter an array')
+
+    idx = 'fia_from_string'('2 4')
+    a.'scatter'(idx, 0)
+    $S0 = join ' ', a
+    is($S0, '3 1 0 2 0', 'scatter a scalar')
+
+    idx = 'fia_from_string'('1 5')
+    push_eh handle_scatter
+    a.'scatter'(idx, 9)
+  handle_scatter:
+    $S0 = join ' ', a
+    is($S0, '3 1 0 2 0', 'scatter stores nothing when an index is out of bounds')
+
+    throws_substring(<<'CODE', 'index out of bounds', 'gather checks its indices')
+    .sub main :main
+        $P0 = new ['FixedIntegerArray'], 2
+        $P1 = new ['FixedIntegerArray'], 1
+        $P1[0] = 2
+        $P0.'gather'($P1)
+    .end
+CODE
+.end
+
+.sub 'test_slice'
+    .local pmc a, s
+    a = 'fia_from_string'('1 2 3 4 5 6')
+    s = a.'slice'(2, 5)
+    $I0 = s
+    is($I0, 3, 'slice has the requested size')
+    $S0 = join ' ', s
+    is($S0, '3 4 5', 'slice has the requested elements')
+
+    s.'mul'(10)
+    $S0 = join ' ', a
+    is($S0, '1 2 30 40 50 6', 'slice shares storage with its array')
+
+    $P0 = s.'slice'(1, 3)
+    $P0[0] = 0
+    $S0 = join ' ', a
+    is($S0, '1 2 30 0 50 6', 'slice of a slice shares storage too')
+
+    $P0 = a.'slice'(3, 3)
+    $I0 = $P0
+    is($I0, 0, 'empty slice')
+
+    throws_substring(<<'CODE', 'slice out of bounds', 'slice checks its bounds')
+    .sub main :main
+        $P0 = new ['FixedIntegerArray'], 2
+        $P0.'slice'(1, 3)
+    .end
+CODE
+
+    throws_substring(<<'CODE', 'only a FixedIntegerArray can be sliced', 'resizable arrays cannot be sliced')
+    .sub main :main
+        $P0 = new ['ResizableIntegerArray'], 2
+        $P0.'slice'(0, 1)
+    .end
+CODE
+.end
+
 
 
 # Local Variables:
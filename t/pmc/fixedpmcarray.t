@@ -20,7 +20,7 @@ out-of-bounds test. Checks INT and PMC keys.
 
 .sub main :main
     .include 'test_more.pir'
-    plan(86)
+    plan(88)
     test_setting_array_size()
     test_resize_exception()
     test_truthiness()
@@ -44,6 +44,7 @@ out-of-bounds test. Checks INT and PMC keys.
     test_multi_keys()
     test_splice()
     test_sort()
+    test_sort_stable_and_mixed()
     test_exists()
     test_new_style_init()
     test_invalid_init_tt1509()
@@ -117,6 +118,50 @@ out-of-bounds test. Checks INT and PMC keys.
 
 .end
 
+.sub test_sort_stable_and_mixed
+    .local pmc array, pair
+    array = new ['FixedPMCArray'], 6
+    $I0 = 0
+  fill:
+    pair = new ['FixedIntegerArray'], 2
+    $I1 = $I0 % 2
+    pair[0] = $I1
+    pair[1] = $I0
+    array[$I0] = pair
+    inc $I0
+    if $I0 < 6 goto fill
+
+    .const 'Sub' by_first = 'cmp_first'
+    array.'sort'(by_first)
+    $S0 = ''
+    $I0 = 0
+  walk:
+    pair = array[$I0]
+    $S1 = pair[1]
+    $S0 .= $S1
+    inc $I0
+    if $I0 < 6 goto walk
+    is($S0, '024135', 'sort with cmp function is stable')
+
+    array = new ['FixedPMCArray'], 4
+    array[0] = 2.5
+    array[1] = 2
+    array[2] = -7
+    array[3] = 3
+    array.'sort'()
+    $S0 = join ' ', array
+    is($S0, '-7 2 2.5 3', 'sort of mixed Integer and Float elements')
+.end
+
+.sub cmp_first
+    .param pmc a
+    .param pmc b
+    $I0 = a[0]
+    $I1 = b[0]
+    $I0 = cmp $I0, $I1
+    .return ($I0)
+.end
+
 # this is used by test_sort
 .sub cmp_fun
     .param pmc a
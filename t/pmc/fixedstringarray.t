@@ -18,7 +18,7 @@ out-of-bounds test. Checks INT and PMC keys.
 
 .sub 'main' :main
     .include 'test_more.pir'
-    plan(50)
+    plan(52)
 
     test_set_size()
     test_reset_size()
@@ -39,6 +39,7 @@ out-of-bounds test. Checks INT and PMC keys.
     test_number()
     test_new_style_init()
     test_invalid_init_tt1509()
+    test_sort()
 .end
 
 .sub 'test_set_size'
@@ -403,6 +404,32 @@ CODE
 CODE
 .end
 
+.sub 'test_sort'
+    $P0 = new ['FixedStringArray'], 5
+    $P0[0] = 'pear'
+    $P0[1] = 'Apple'
+    $P0[2] = 'fig'
+    $P0[3] = 'apple'
+    $P0[4] = 'banana'
+    $P0.'sort'()
+    $S0 = join ' ', $P0
+    is($S0, 'Apple apple banana fig pear', 'default sort')
+
+    .const 'Sub' by_length = 'by_length'
+    $P0.'sort'(by_length)
+    $S0 = join ' ', $P0
+    is($S0, 'fig pear Apple apple banana', 'sort with custom cmp function is stable')
+.end
+
+.sub 'by_length'
+    .param string a
+    .param string b
+    $I0 = length a
+    $I1 = length b
+    $I0 = cmp $I0, $I1
+    .return ($I0)
+.end
+
 # Local Variables:
 #   mode: pir
 #   fill-column: 100
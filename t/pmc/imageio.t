@@ -11,14 +11,14 @@ t/pmc/imageio.t - test ImageIOFreeze and ImageIOThaw PMC
 
 =head1 DESCRIPTION
 
-Tests the ImageIO PMC.
+Tests the ImageIO PMC, including images streamed to and from handles.
 
 =cut
 
 .sub main :main
     .include 'test_more.pir'
 
-    plan(12)
+    plan(27)
 
     .local pmc frz, thw
     frz = new ['ImageIOFreeze']
@@ -57,6 +57,192 @@ Tests the ImageIO PMC.
     $P1 = thaw $S1
     is_deeply($P0, $P1, 'thaw gives same PMC as ImageIO (aggregate)')
     is_deeply($P0, test_pmc, 'round trip gives same PMC (aggregate)')
+
+    'test_stream_round_trip'()
+    'test_stream_large_graph'()
+    'test_stream_errors'()
+.end
+
+.sub test_stream_round_trip
+    .local pmc sh, frz, thw, test_pmc
+    sh = 'new_binary_handle'('stream', 'wb')
+    test_pmc = 'get_test_aggregate'()
+    frz = new ['ImageIOFreeze'], sh
+    setref frz, test_pmc
+    $P0 = new ['Integer']
+    $P0 = 42
+    frz = new ['ImageIOFreeze'], sh
+    setref frz, $P0
+    print sh, "trailer"
+    $S0 = sh.'readall'()
+    sh.'close'()
+
+    $S1 = freeze test_pmc
+    $I0 = length $S0
+    $I1 = length $S1
+    $I2 = $I0 < $I1
+    ok($I2, 'streamed image is smaller than the string image')
+
+    sh = 'reopen_binary_handle'('stream', $S0)
+    thw = new ['ImageIOThaw']
+    setref thw, sh
+    $P1 = deref thw
+    is_deeply($P1, test_pmc, 'round trip through a handle gives same PMC')
+    thw = new ['ImageIOThaw']
+    setref thw, sh
+    $P1 = deref thw
+    is($P1, 42, 'a second image on the same handle thaws too')
+    $S2 = sh.'read'(100)
+    is($S2, 'trailer', 'thaw leaves the handle just past the image')
+
+    sh = 'new_binary_handle'('stream', 'wb')
+    $P0 = new ['ResizablePMCArray']
+    $P2 = new ['Float']
+    $P2 = -0.125
+    push $P0, $P2
+    $P2 = new ['Integer']
+    $P2 = -9223372036854775807
+    push $P0, $P2
+    $P2 = new ['String']
+    $P2 = unicode:"snow \u2603"
+    push $P0, $P2
+    null $P2
+    push $P0, $P2
+    frz = new ['ImageIOFreeze'], sh
+    setref frz, $P0
+    $S0 = sh.'readall'()
+    sh.'close'()
+    sh = 'reopen_binary_handle'('stream', $S0)
+    thw = new ['ImageIOThaw']
+    setref thw, sh
+    $P1 = deref thw
+    $N0 = $P1[0]
+    is($N0, -0.125, 'floats survive streaming')
+    $I0 = $P1[1]
+    is($I0, -9223372036854775807, 'large negative integers survive streaming')
+    $S3 = $P1[2]
+    is($S3, unicode:"snow \u2603", 'non-ASCII strings survive streaming')
+    $P2 = $P1[3]
+    $I0 = isnull $P2
+    ok($I0, 'NULL elements survive streaming')
+.end
+
+.sub test_stream_large_graph
+    .local pmc sh, frz, thw, root, list
+    root = new ['Hash']
+    list = new ['ResizablePMCArray']
+    root['list'] = list
+    $S0 = repeat 'x', 100000
+    root['big'] = $S0
+    $I0 = 0
+  fill:
+    $P0 = new ['Integer']
+    $P0 = $I0
+    push list, $P0
+    push list, root
+    inc $I0
+    if $I0 < 20000 goto fill
+
+    sh = 'new_binary_handle'('graph', 'wb')
+    frz = new ['ImageIOFreeze'], sh
+    setref frz, root
+    $S1 = sh.'readall'()
+    sh.'close'()
+
+    sh = 'reopen_binary_handle'('graph', $S1)
+    thw = new ['ImageIOThaw']
+    setref thw, sh
+    $P1 = deref thw
+    $P2 = $P1['list']
+    $I1 = elements $P2
+    is($I1, 40000, 'large graph streams across many chunks')
+    $P3 = $P2[39999]
+    $P3 = $P3['list']
+    $I2 = issame $P3, $P2
+    ok($I2, 'cycles are preserved')
+    $P4 = $P2[39998]
+    is($P4, 19999, 'last element is intact')
+    $S2 = $P1['big']
+    $I3 = length $S2
+    is($I3, 100000, 'strings larger than a chunk are reassembled')
+.end
+
+.sub test_stream_errors
+    .local pmc sh, thw, frz
+    sh = 'reopen_binary_handle'('bogus', 'this is not a freeze image')
+    thw = new ['ImageIOThaw']
+    push_eh bad_header
+    setref thw, sh
+    ok(0, 'bad header is rejected')
+    goto truncated
+  bad_header:
+    .get_results($P0)
+    $S0 = $P0['message']
+    is($S0, 'Not a freeze image', 'bad header is rejected')
+
+  truncated:
+    pop_eh
+    sh = 'new_binary_handle'('cut', 'wb')
+    $P1 = 'get_test_aggregate'()
+    frz = new ['ImageIOFreeze'], sh
+    setref frz, $P1
+    $S1 = sh.'readall'()
+    sh.'close'()
+    $I0 = length $S1
+    $I0 -= 4
+    $S1 = substr $S1, 0, $I0
+    sh = 'reopen_binary_handle'('cut', $S1)
+    thw = new ['ImageIOThaw']
+    push_eh bad_end
+    setref thw, sh
+    ok(0, 'truncated image is rejected')
+    goto oversized
+  bad_end:
+    .get_results($P0)
+    $S0 = $P0['message']
+    is($S0, 'Unexpected end of freeze image', 'truncated image is rejected')
+
+  oversized:
+    pop_eh
+    # replace the length of the first chunk with 65537, one byte more than
+    # the writer ever puts in a chunk
+    $P2 = new ['ByteBuffer']
+    $P2 = $S1
+    $P2[8]  = 0x81
+    $P2[9]  = 0x80
+    $P2[10] = 0x04
+    $S2 = $P2.'get_string_as'(binary:"")
+    sh = 'reopen_binary_handle'('long', $S2)
+    thw = new ['ImageIOThaw']
+    push_eh bad_length
+    setref thw, sh
+    ok(0, 'oversized chunk length is rejected')
+    goto done
+  bad_length:
+    .get_results($P0)
+    $S0 = $P0['message']
+    is($S0, 'Bad chunk length in freeze image', 'oversized chunk length is rejected')
+  done:
+    pop_eh
+.end
+
+.sub new_binary_handle
+    .param string name
+    .param string mode
+    $P0 = new ['StringHandle']
+    $P0.'open'(name, mode)
+    $P0.'encoding'('binary')
+    .return ($P0)
+.end
+
+.sub reopen_binary_handle
+    .param string name
+    .param string contents
+    $P0 = 'new_binary_handle'(name, 'wb')
+    print $P0, contents
+    $P0.'close'()
+    $P0.'open'(name, 'rb')
+    .return ($P0)
 .end
 
 .sub get_test_simple
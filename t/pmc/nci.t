@@ -38,7 +38,7 @@ SKIP: {
     unless ( -e "runtime/parrot/dynext/libnci_test$PConfig{load_ext}" ) {
         plan skip_all => "Please make libnci_test$PConfig{load_ext}";
     }
-    plan tests => 60;
+    plan tests => 61;
 
     pir_output_is( << 'CODE', << 'OUTPUT', 'load library fails' );
 .sub test :main
@@ -728,6 +728,29 @@ CODE
 2
 OUTPUT
 
+SKIP:
+    {
+
+        skip( "only libffi builds thunks for arbitrary signatures", 1 )
+            unless $PConfig{HAS_LIBFFI};
+
+        pir_output_is( << 'CODE', << 'OUTPUT', 'nci_isum10 - more arguments than fit on the C stack' );
+.sub test :main
+    .local pmc libnci_test, nci_isum10
+    libnci_test = loadlib "libnci_test"
+    nci_isum10  = dlfunc libnci_test, "nci_isum10", "iiiiiiiiiii"
+
+    $I0 = nci_isum10(1, 1, 1, 1, 1, 1, 1, 1, 1, 1)
+    say $I0
+    $I0 = nci_isum10(10, 0, 0, 0, 0, 0, 0, 0, 0, 1)
+    say $I0
+.end
+CODE
+55
+20
+OUTPUT
+    }
+
     pasm_output_is( <<'CODE', <<'OUTPUT', 'nci_pi - struct with ints' );
 .pcc_sub :main main:
   loadlib P1, "libnci_test"
@@ -21,7 +21,7 @@ Tests the ParrotInterpreter PMC.
 .sub main :main
 .include 'test_more.pir'
 
-    plan(14)
+    plan(22)
     test_new()      # 1 test
     test_hll_map()  # 3 tests
     test_hll_map_invalid()  # 1 tests
@@ -29,6 +29,7 @@ Tests the ParrotInterpreter PMC.
 # Need for testing
 .annotate 'foo', 'bar'
     test_inspect()  # 9 tests
+    test_gc_telemetry()  # 7 tests
 .end
 
 .sub test_new
@@ -140,6 +141,86 @@ Tests the ParrotInterpreter PMC.
 
 .end
 
+.include 'interpinfo.pasm'
+
+.sub 'test_gc_telemetry'
+    .local pmc interp, telemetry, gens, gen, pause, phases, last
+    .local int before, collections, counted, i
+    interp    = getinterp
+    telemetry = interp.'gc_telemetry'()
+    before    = telemetry['collections']
+
+    $S0 = interpinfo .INTERPINFO_GC_SYS_NAME
+    if $S0 == 'gms' goto reporting
+    if $S0 == 'ms2' goto reporting
+    skip(8, 'this collector does not report telemetry')
+    .return ()
+
+  reporting:
+    interp.'run_gc'()
+    interp.'run_gc'()
+    telemetry   = interp.'gc_telemetry'()
+    collections = telemetry['collections']
+    $I0 = before + 2
+    $I1 = collections >= $I0
+    ok($I1, 'gc_telemetry counts collections')
+
+    gens = telemetry['generations']
+    $I0 = elements gens
+    is($I0, 4, 'gc_telemetry has a histogram per generation')
+
+    counted = 0
+    i = 0
+  count_gens:
+    gen     = gens[i]
+    pause   = gen['pause']
+    $I0     = pause['count']
+    counted += $I0
+    inc i
+    if i < 4 goto count_gens
+    is(counted, collections, 'every collection is in a pause histogram')
+
+    gen    = gens[0]
+    pause  = gen['pause']
+    $P0    = pause['buckets']
+    counted = 0
+    i = 0
+  count_buckets:
+    $I0 = $P0[i]
+    counted += $I0
+    inc i
+    if i < 24 goto count_buckets
+    $I0 = pause['count']
+    is(counted, $I0, 'histogram buckets add up to its count')
+
+    phases = gen['phases']
+    $P0 = phases['mark']
+    $I0 = $P0['count']
+    $I1 = gen['collections']
+    is($I0, $I1, 'phases are timed for every collection')
+
+    # a GMS nursery collection does not compact strings
+    $P0 = phases['compact']
+    $I0 = $P0['count']
+    if $S0 == 'gms' goto no_compact
+    is($I0, $I1, 'phases that ran are timed')
+    goto compact_done
+  no_compact:
+    is($I0, 0, 'phases that did not run are not timed')
+  compact_done:
+
+    $N0 = telemetry['survivor_rate']
+    $I0 = $N0 > 0.0
+    $I1 = $N0 <= 1.0
+    $I0 = $I0 && $I1
+    ok($I0, 'survivor rate is a fraction')
+
+    last = telemetry['last']
+    $I0  = last['number']
+    $I1  = collections - 1
+    is($I0, $I1, 'describes the last collection')
+.end
+
 # Local Variables:
 #   mode: pir
 #   fill-column: 100
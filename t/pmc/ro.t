@@ -38,12 +38,13 @@ Tests automatically generated read-only PMC support.
 .sub main :main
     .include 'test_more.pir'
 
-    plan(13)
+    plan(14)
 
     integer_set_read_only_is_not_writable() # 1 test
     integer_set_read_only_can_be_read()     # 6 tests
     integer_stays_integer()                 # 1 test
     integer_add()                           # 1 test
+    integer_inc()                           # 1 test
     complex_i_add()                         # 1 test
     resizablepmcarray_non_recursive_part()  # 1 test
     objects()                               # 1 test
@@ -137,6 +138,32 @@ Tests automatically generated read-only PMC support.
   end:
 .end
 
+.sub integer_inc
+    .local pmc foo, eh
+
+    foo = new ['Integer']
+    foo = 42
+
+    eh = new ['ExceptionHandler']
+    eh.'handle_types'(.EXCEPTION_WRITE_TO_CONSTCLASS)
+    set_label eh, eh_label
+
+    make_readonly(foo)
+    push_eh eh
+    inc foo
+    pop_eh
+
+    ok(0, 'integer_inc')
+    goto end
+
+  eh_label:
+    .local string message
+    .get_results($P0)
+    message = $P0['message']
+    is( message, "increment() in read-only instance of 'Integer'", 'integer_inc' )
+  end:
+.end
+
 .sub complex_i_add
     .local pmc foo, eh
 
@@ -0,0 +1,112 @@
+#! perl
+# Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+t/profiling/pprof_summary.t - test binary profiles and pprof_summary
+
+=head1 SYNOPSIS
+
+    % prove t/profiling/pprof_summary.t
+
+=head1 DESCRIPTION
+
+Profiles a recursive program with C<PARROT_PROFILING_OUTPUT=binary>, checks the
+file header and then checks the report C<pprof_summary> produces from it
+against a text profile of the same program.
+
+=cut
+
+use strict;
+use warnings;
+use lib qw( . lib ../lib ../../lib );
+
+use Test::More tests => 9;
+use Parrot::Config;
+use File::Spec;
+use File::Temp qw(tempfile);
+
+my $PARROT  = ".$PConfig{slash}$PConfig{test_prog}";
+my $SUMMARY = ".$PConfig{slash}pprof_summary$PConfig{exe}";
+my $devnull = File::Spec->devnull;
+
+my $pir = <<'END_PIR';
+.sub 'main' :main
+    $I0 = 'fib'(12)
+    say $I0
+.end
+
+.sub 'fib'
+    .param int n
+    if n >= 2 goto rec
+    .return (n)
+  rec:
+    $I0 = n - 1
+    $I1 = 'fib'($I0)
+    $I0 = n - 2
+    $I2 = 'fib'($I0)
+    $I0 = $I1 + $I2
+    .return ($I0)
+.end
+END_PIR
+
+my ($pir_fh, $pir_file) = tempfile( SUFFIX => '.pir', UNLINK => 1 );
+print $pir_fh $pir;
+close $pir_fh;
+
+my $bin_file = profile( 'binary', '.pprof' );
+my $txt_file = profile( 'pprof',  '.txt' );
+
+open my $bin_fh, '<:raw', $bin_file or die "can't open $bin_file: $!";
+read $bin_fh, my $magic, 8;
+close $bin_fh;
+is( $magic, 'PPROFBIN', 'binary profile starts with the magic' );
+ok( -s $bin_file < -s $txt_file, 'binary profile is smaller than the text one' );
+
+# count the ops executed in fib, and on each of its lines, in the text profile
+my ($fib_ops, %line_ops, $in_fib) = (0);
+open my $txt_fh, '<', $txt_file or die "can't open $txt_file: $!";
+while (<$txt_fh>) {
+    $in_fib = /\{x\{ns:[^}]*fib\}x\}/ if /^CS:/;
+    next unless $in_fib && /^OP:\{x\{line:(\d+)\}x\}/;
+    $fib_ops++;
+    $line_ops{$1}++;
+}
+close $txt_fh;
+
+my @report = `"$SUMMARY" -n 0 "$bin_file"`;
+is( $?, 0, 'pprof_summary succeeded' );
+
+my ($total) = map { /^total time: (\d+)$/ ? $1 : () } @report;
+ok( $total, 'reports the total time' );
+
+my @fib = grep { /^\s*\d+ .*\bfib \(\Q$pir_file\E\)$/ } @report;
+my ($incl, $excl, $ops) = (split ' ', $fib[0] || '')[0, 2, 4];
+is( $ops, $fib_ops, 'sub op count matches the text profile' );
+is( $incl, $excl, 'recursion is counted once in inclusive time' );
+
+my @line = grep { /^\s*\d+ .*\Q$pir_file\E:12 \(/ } @report;
+my ($line_incl, $line_excl, $line_ops) = (split ' ', $line[0] || '')[0, 2, 4];
+is( $line_ops, $line_ops{12}, 'line op count matches the text profile' );
+ok( $line_incl > $line_excl, 'a line making a call includes the time of the callee' );
+
+my $bogus = `"$SUMMARY" "$pir_file" 2>&1`;
+like( $bogus, qr/not a binary profile/, 'rejects files that are not binary profiles' );
+
+sub profile {
+    my ($format, $suffix) = @_;
+    my ($fh, $file) = tempfile( SUFFIX => $suffix, UNLINK => 1 );
+    close $fh;
+
+    local $ENV{PARROT_PROFILING_OUTPUT}   = $format;
+    local $ENV{PARROT_PROFILING_FILENAME} = $file;
+    system(qq{"$PARROT" -R profiling "$pir_file" >$devnull 2>&1});
+    return $file;
+}
+
+# Local Variables:
+#   mode: cperl
+#   cperl-indent-level: 4
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4:
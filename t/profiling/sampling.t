@@ -0,0 +1,126 @@
+#! perl
+# Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+t/profiling/sampling.t - test the sampling profiler runcore
+
+=head1 SYNOPSIS
+
+    % prove t/profiling/sampling.t
+
+=head1 DESCRIPTION
+
+Runs a CPU-bound program under C<-R sampling> and checks the folded stacks it
+writes.
+
+=cut
+
+use strict;
+use warnings;
+use lib qw( . lib ../lib ../../lib );
+
+use Test::More tests => 7;
+use Parrot::Config;
+use File::Spec;
+use File::Temp qw(tempfile);
+
+my $PARROT = ".$PConfig{slash}$PConfig{test_prog}";
+
+my $busy_pir = <<'END_PIR';
+.namespace ['Foo']
+.sub 'busy'
+    .param int n
+    .local int i, s
+    i = 0
+    s = 0
+  loop:
+    s += i
+    inc i
+    if i < n goto loop
+    .return (s)
+.end
+
+.namespace []
+.sub 'main' :main
+    $I0 = 'outer'()
+    say $I0
+.end
+
+.sub 'outer'
+    $P0 = get_hll_global ['Foo'], 'busy'
+    $I0 = $P0(5000000)
+    .return ($I0)
+.end
+END_PIR
+
+my @stacks = run_sampled($busy_pir);
+
+ok( scalar @stacks, 'profile is not empty' );
+ok( !grep( { !/^\S.* \d+$/ } @stacks ), 'every line is a folded stack and a count' );
+
+my @busy = grep { /;parrot::Foo::busy \([^;]*:\d+\) \d+$/ } @stacks;
+ok( scalar @busy, 'samples land in the busy sub, namespaces joined with ::' );
+like( $busy[0] || '', qr/parrot::main \([^;]*:16\);parrot::outer \([^;]*:22\);/,
+    'callers are outermost first, at the line of the call' );
+
+my $total = 0;
+$total += (split ' ')[-1] for @busy;
+ok( $total > 0, 'sample counts are positive' );
+
+my $annotated_pir = <<'END_PIR';
+.sub 'main' :main
+    .annotate 'file', 'spin.hll'
+    .annotate 'line', 42
+    .local int i
+    i = 0
+  loop:
+    inc i
+    if i < 5000000 goto loop
+    say i
+.end
+END_PIR
+
+@stacks = run_sampled($annotated_pir);
+ok( grep( { /parrot::main \(spin\.hll:42\) \d+$/ } @stacks ),
+    'file and line annotations are preferred over PIR positions' );
+
+my ($fh, $small_file) = tempfile( SUFFIX => '.pir', UNLINK => 1 );
+print $fh ".sub 'main' :main\n    say 'ok'\n.end\n";
+close $fh;
+my ($ofh, $out_file) = tempfile( SUFFIX => '.folded', UNLINK => 1 );
+close $ofh;
+{
+    local $ENV{PARROT_SAMPLING_FILENAME} = $out_file;
+    my $devnull = File::Spec->devnull;
+    my $stderr  = `"$PARROT" -R sampling "$small_file" 2>&1 >$devnull`;
+    like( $stderr, qr/SAMPLING RUNCORE: wrote \d+ samples to \Q$out_file\E/,
+        'reports where the profile went' );
+}
+
+sub run_sampled {
+    my $code = shift;
+    my ($pir_fh, $pir_file) = tempfile( SUFFIX => '.pir', UNLINK => 1 );
+    print $pir_fh $code;
+    close $pir_fh;
+
+    my ($out_fh, $out) = tempfile( SUFFIX => '.folded', UNLINK => 1 );
+    close $out_fh;
+
+    local $ENV{PARROT_SAMPLING_FILENAME} = $out;
+    local $ENV{PARROT_SAMPLING_HZ}       = 1000;
+    system(qq{"$PARROT" -R sampling "$pir_file" >} . File::Spec->devnull . ' 2>&1');
+
+    open my $in, '<', $out or return;
+    my @lines = <$in>;
+    close $in;
+    chomp @lines;
+    return @lines;
+}
+
+# Local Variables:
+#   mode: cperl
+#   cperl-indent-level: 4
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4:
@@ -19,7 +19,7 @@ use strict;
 use warnings;
 use lib qw( lib . ../lib ../../lib );
 
-use Test::More tests => 35;
+use Test::More tests => 36;
 use Parrot::Config;
 use File::Temp 0.13 qw/tempfile/;
 use File::Spec;
@@ -119,6 +119,30 @@ is( $exit, 0, '... and should not crash' );
 # Test --leak-test. See issue GH #765
 is( qx{$PARROT --leak-test "$first_pir_file"}, "first\n", '--leak-test' );
 
+# Test --lazy-constants: Key and signature constants are thawed on first use
+{
+    my ( $fh, $lazy_pir_file ) = tempfile( SUFFIX => '.pir', UNLINK => 1 );
+    print $fh <<'END_PIR';
+.sub main :main
+    $P0 = new ['Hash']
+    $P0['k'] = 'lazy'
+    show($P0)
+.end
+
+.sub show
+    .param pmc h
+    $S0 = h['k']
+    say $S0
+.end
+END_PIR
+    close $fh;
+
+    ( my $lazy_pbc_file = $lazy_pir_file ) =~ s/\.pir$/.pbc/;
+    system qq{"$PARROT" -o "$lazy_pbc_file" "$lazy_pir_file"};
+    is( qx{$PARROT --lazy-constants "$lazy_pbc_file"}, "lazy\n", '--lazy-constants' );
+    unlink $lazy_pbc_file;
+}
+
 # clean up temporary files
 unlink $first_pir_file;
 unlink $second_pir_file;
@@ -14,7 +14,7 @@ my $parrot_config = "parrot_config" . $PConfig{o};
 
 plan skip_all => 'src/parrot_config.o does not exist' unless -e catfile("src", $parrot_config);
 
-plan tests => 9;
+plan tests => 10;
 
 =head1 NAME
 
@@ -453,10 +453,36 @@ foo
 fooError
 OUTPUT
 
+c_output_is( linedirective(__LINE__) . <<"CODE", << 'OUTPUT', "Parrot_api_gc_telemetry");
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "parrot/api.h"
+
+int main(void) {
+    Parrot_PMC interp, telemetry, generations;
+    Parrot_String key;
+    Parrot_Int count;
+
+    Parrot_api_make_interpreter(NULL, 0, NULL, &interp);
+    if (!Parrot_api_gc_telemetry(interp, &telemetry)) {
+        printf("Parrot_api_gc_telemetry failed\\n");
+        return 1;
+    }
+
+    Parrot_api_string_import_ascii(interp, "generations", &key);
+    Parrot_api_pmc_get_keyed_string(interp, telemetry, key, &generations);
+    Parrot_api_pmc_get_integer(interp, generations, &count);
+    printf("%d generations\\n", (int)count);
+    return 0;
+}
+CODE
+4 generations
+OUTPUT
+
 # Local Variables:
 #   mode: cperl
 #   cperl-indent-level: 4
 #   fill-column: 100
 # End:
 # vim: expandtab shiftwidth=4:
-
@@ -16,7 +16,7 @@ my $parrot_config = "parrot_config" . $PConfig{o};
 
 plan skip_all => 'src/parrot_config.o does not exist' unless -e catfile("src", $parrot_config);
 
-plan tests => 19;
+plan tests => 20;
 
 =head1 NAME
 
@@ -740,6 +740,64 @@ CODE
 Result is 300.
 OUTPUT
 
+c_output_is( <<'CODE', <<'OUTPUT', 'Parrot_freeze_snapshot/Parrot_thaw_snapshot' );
+
+#include <stdio.h>
+#include "parrot/parrot.h"
+#include "parrot/extend.h"
+
+static void
+thaw_it(Parrot_Interp interp, void *data)
+{
+    PMC * const root = Parrot_thaw_snapshot(interp, (STRING *)data);
+    Parrot_eprintf(interp, "thawed %Ss\n", VTABLE_name(interp, root));
+}
+
+static void
+report(Parrot_Interp interp, PMC *exception, void *data)
+{
+    Parrot_eprintf(interp, "rejected %Ss\n", (STRING *)data);
+}
+
+int
+main(int argc, const char *argv[])
+{
+    Parrot_Interp interp = Parrot_interp_new(NULL);
+    Parrot_Interp booted = Parrot_interp_new(NULL);
+    PMC          *hash, *root;
+    STRING       *file, *key;
+    FILE         *junk;
+
+    hash = Parrot_pmc_new(interp, enum_class_Hash);
+    key  = Parrot_str_new(interp, "greeting", 0);
+    VTABLE_set_string_keyed_str(interp, hash, key,
+        Parrot_str_new(interp, "booted from snapshot", 0));
+
+    file = Parrot_str_new(interp, "extend_snapshot.img", 0);
+    Parrot_freeze_snapshot(interp, hash, file);
+
+    file = Parrot_str_new(booted, "extend_snapshot.img", 0);
+    root = Parrot_thaw_snapshot(booted, file);
+    remove("extend_snapshot.img");
+    key  = Parrot_str_new(booted, "greeting", 0);
+    Parrot_eprintf(booted, "%Ss\n", VTABLE_get_string_keyed_str(booted, root, key));
+
+    junk = fopen("extend_snapshot_junk.img", "wb");
+    fputs("this is not a freeze image, just some bytes", junk);
+    fclose(junk);
+    file = Parrot_str_new(booted, "extend_snapshot_junk.img", 0);
+    Parrot_ext_try(booted, &thaw_it, &report, file);
+    remove("extend_snapshot_junk.img");
+
+    Parrot_interp_destroy(booted);
+    Parrot_interp_destroy(interp);
+    return 0;
+}
+CODE
+booted from snapshot
+rejected extend_snapshot_junk.img
+OUTPUT
+
 c_output_is( <<'CODE', <<'OUTPUT', 'multiple Parrot_interp_new/Parrot_x_exit cycles' );
 
 #include <stdio.h>
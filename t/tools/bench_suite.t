@@ -0,0 +1,124 @@
+#! perl
+# Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+t/tools/bench_suite.t - test the benchmark suite runner
+
+=head1 SYNOPSIS
+
+    % prove t/tools/bench_suite.t
+
+=head1 DESCRIPTION
+
+Runs F<tools/dev/bench_suite.pl> on a directory of two tiny benchmarks and
+checks the JSON it writes, then checks that comparing with a much faster
+baseline reports a regression and comparing with itself doesn't.
+
+=cut
+
+use strict;
+use warnings;
+use lib qw( . lib ../lib ../../lib );
+
+use Test::More;
+use Parrot::Config;
+use File::Spec;
+use File::Temp qw(tempdir);
+
+BEGIN {
+    unless ( eval { require JSON::PP; 1 } ) {
+        plan skip_all => 'JSON::PP is not installed';
+        exit(0);
+    }
+    plan tests => 12;
+}
+
+my $PARROT = ".$PConfig{slash}$PConfig{test_prog}";
+my $SUITE  = File::Spec->catfile( qw(tools dev bench_suite.pl) );
+my $dir    = tempdir( CLEANUP => 1 );
+
+write_file( 'loop_count.pir', <<'END_PIR' );
+.sub 'main' :main
+    $I0 = 0
+  loop:
+    inc $I0
+    if $I0 < 10000 goto loop
+.end
+END_PIR
+
+write_file( 'startup_empty.pir', <<'END_PIR' );
+.sub 'main' :main
+.end
+END_PIR
+
+write_file( 'not_a_benchmark.txt', "ignored\n" );
+
+my @common = ( '--parrot', $PARROT, '--dir', $dir, '--warmup', 0 );
+
+my $list = run_suite( @common, '--list' );
+like( $list, qr/^loop\s+count$/m, 'lists a benchmark with its category' );
+unlike( $list, qr/not_a_benchmark/, 'ignores files that are not .pir' );
+
+my $json = File::Spec->catfile( $dir, 'results.json' );
+run_suite( @common, '--runs', 6, '--json', $json );
+is( $?, 0, 'suite ran' );
+
+my $results = read_json($json);
+is( $results->{runs}, 6, 'records the number of runs' );
+
+my $loop = $results->{benchmarks}{loop_count};
+is( scalar @{ $loop->{times} }, 6, 'records every run' );
+ok( $loop->{ci_low} <= $loop->{median} && $loop->{median} <= $loop->{ci_high},
+    'median lies within its confidence interval' );
+ok( $loop->{ci_exact}, 'six runs give an order-statistic interval' );
+ok( exists $loop->{gc_mark_runs} && exists $loop->{mem_alloc}, 'records GC counters' );
+ok( !exists $results->{benchmarks}{startup_empty}{gc_mark_runs},
+    'startup benchmarks are timed as whole processes' );
+
+# a baseline ten times faster than what was measured
+my %fast = %$results;
+$fast{benchmarks} = {};
+for my $id ( keys %{ $results->{benchmarks} } ) {
+    my %b = %{ $results->{benchmarks}{$id} };
+    $b{$_} /= 10 for qw(median ci_low ci_high);
+    $fast{benchmarks}{$id} = \%b;
+}
+my $fast_json = File::Spec->catfile( $dir, 'fast.json' );
+write_file( 'fast.json', JSON::PP->new->encode( \%fast ) );
+
+my $cmp = run_suite( @common, '--runs', 6, '--bench', 'loop', '--baseline', $fast_json );
+is( $? >> 8, 1, 'exits with 1 when a benchmark regressed' );
+like( $cmp, qr/loop_count\s+\+[\d.]+%\s+REGRESSED/, 'reports the regression' );
+
+run_suite( @common, '--runs', 1, '--bench', 'loop', '--threshold', 10000,
+    '--baseline', $fast_json );
+is( $? >> 8, 0, 'a slowdown within the threshold is not a regression' );
+
+sub write_file {
+    my ( $name, $contents ) = @_;
+    my $file = File::Spec->catfile( $dir, $name );
+    open my $fh, '>', $file or die "can't write $file: $!";
+    print $fh $contents;
+    close $fh;
+}
+
+sub read_json {
+    my ($file) = @_;
+    open my $fh, '<', $file or die "can't read $file: $!";
+    my $data = JSON::PP::decode_json( do { local $/; <$fh> } );
+    close $fh;
+    return $data;
+}
+
+sub run_suite {
+    my @args = map { qq{"$_"} } @_;
+    return scalar `$^X $SUITE @args 2>&1`;
+}
+
+# Local Variables:
+#   mode: cperl
+#   cperl-indent-level: 4
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4:
@@ -0,0 +1,73 @@
+# Copyright (C) 2012, Parrot Foundation.
+
+=head1 NAME
+
+tools/dev/bench_driver.pir - Time one benchmark inside the interpreter
+
+=head1 SYNOPSIS
+
+    % ./parrot tools/dev/bench_driver.pir examples/benchmarks/suite/calls_fib.pir
+
+=head1 DESCRIPTION
+
+Compiles the given PIR benchmark, runs its main sub and prints a single line
+to standard error:
+
+    BENCH time=0.306 gc_mark_runs=3 gc_collect_runs=1 mem_alloc=1234567 total_pmcs=8192
+
+C<time> is the wall-clock time of the main sub alone, so neither interpreter
+startup nor compiling the benchmark is included.  The GC figures are the
+number of mark and collect runs during the benchmark, and the memory and PMC
+headers allocated at the end of it, as reported by C<interpinfo>.
+
+This is used by F<tools/dev/bench_suite.pl>; the benchmark's own output is
+left on standard output.
+
+=cut
+
+.include 'interpinfo.pasm'
+
+.sub main :main
+    .param pmc argv
+    .local pmc compiler, code, bench_main, stderr
+    .local num start, elapsed
+    .local int marks, collects
+
+    $I0 = elements argv
+    if $I0 == 2 goto have_file
+    die "usage: parrot bench_driver.pir benchmark.pir"
+  have_file:
+    $S0 = argv[1]
+    compiler = compreg 'PIR'
+    code = compiler.'compile_file'($S0)
+    bench_main = code.'main_sub'()
+
+    marks    = interpinfo .INTERPINFO_GC_MARK_RUNS
+    collects = interpinfo .INTERPINFO_GC_COLLECT_RUNS
+    start    = time
+    bench_main()
+    elapsed  = time
+    elapsed -= start
+    $I0 = interpinfo .INTERPINFO_GC_MARK_RUNS
+    marks = $I0 - marks
+    $I0 = interpinfo .INTERPINFO_GC_COLLECT_RUNS
+    collects = $I0 - collects
+    $I1 = interpinfo .INTERPINFO_TOTAL_MEM_ALLOC
+    $I2 = interpinfo .INTERPINFO_TOTAL_PMCS
+
+    $P0 = new ['ResizablePMCArray']
+    push $P0, elapsed
+    push $P0, marks
+    push $P0, collects
+    push $P0, $I1
+    push $P0, $I2
+    $S1 = sprintf "BENCH time=%.6f gc_mark_runs=%d gc_collect_runs=%d mem_alloc=%d total_pmcs=%d\n", $P0
+    stderr = getstderr
+    print stderr, $S1
+.end
+
+# Local Variables:
+#   mode: pir
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4 ft=pir:
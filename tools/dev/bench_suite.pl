@@ -0,0 +1,294 @@
+#! perl
+# Copyright (C) 2012, Parrot Foundation.
+
+use strict;
+use warnings;
+use lib qw( lib );
+
+use File::Basename qw(basename);
+use File::Spec;
+use Getopt::Long;
+use Pod::Usage;
+use POSIX qw(strftime);
+use Time::HiRes qw(time);
+use Parrot::Config;
+
+# JSON::PP is only core from Perl 5.14, and only --json and --baseline need it
+my $HAVE_JSON = eval { require JSON::PP; 1 };
+
+=head1 NAME
+
+tools/dev/bench_suite.pl - Run the categorized VM benchmark suite
+
+=head1 SYNOPSIS
+
+    % make bench
+    % perl tools/dev/bench_suite.pl [options]
+
+ Options:
+   --runs N          timed runs of each benchmark (default 10)
+   --warmup N        untimed runs before those (default 2)
+   --category NAME   only run benchmarks in this category (repeatable)
+   --bench REGEX     only run benchmarks whose name matches (repeatable)
+   --json FILE       write the results to FILE as JSON
+   --baseline FILE   compare against results saved earlier with --json
+   --threshold PCT   slowdown that counts as a regression (default 5)
+   --parrot PATH     parrot executable to benchmark (default ./parrot)
+   --dir DIR         benchmark directory (default examples/benchmarks/suite)
+   --list            list the benchmarks and exit
+   --help            show this help and exit
+
+=head1 DESCRIPTION
+
+Runs every benchmark in F<examples/benchmarks/suite>.  The category of a
+benchmark is the part of its file name before the first underscore, so
+F<calls_fib.pir> is the C<fib> benchmark in the C<calls> category.
+
+Each run is a fresh process.  Warm-up runs fill the OS caches and are thrown
+away.  Benchmarks are timed by F<tools/dev/bench_driver.pir>, which times only
+the benchmark's main sub and also reports GC mark and collect runs, memory
+allocated and PMCs allocated, from C<interpinfo>.  The C<startup> category is
+instead timed as whole processes, since startup is what it measures.
+
+For every benchmark the report gives the median time and a 95% confidence
+interval for it.  The interval comes from order statistics and so makes no
+assumption about the shape of the timing distribution.  Fewer than six runs
+are too few for that; the interval is then the range of the runs and is
+marked C<~> in the report.
+
+With C<--baseline>, each benchmark is compared to the saved result.  It counts
+as a regression only if its median is more than C<--threshold> percent slower
+I<and> the confidence intervals don't overlap, so noise alone doesn't flag it.
+The script exits with status 1 if anything regressed.
+
+=cut
+
+my %opt = (
+    runs      => 10,
+    warmup    => 2,
+    threshold => 5,
+    parrot    => File::Spec->catfile( File::Spec->curdir, "parrot$PConfig{exe}" ),
+    dir       => File::Spec->catdir( qw(examples benchmarks suite) ),
+    category  => [],
+    bench     => [],
+);
+
+GetOptions( \%opt,
+    'runs=i', 'warmup=i', 'category=s@', 'bench=s@', 'json=s', 'baseline=s',
+    'threshold=f', 'parrot=s', 'dir=s', 'list', 'help|?' )
+    or pod2usage(2);
+pod2usage(1) if $opt{help};
+pod2usage('--runs must be at least 1') if $opt{runs} < 1;
+pod2usage('--json and --baseline need the JSON::PP module')
+    if ( $opt{json} || $opt{baseline} ) && !$HAVE_JSON;
+
+my $DRIVER = File::Spec->catfile( qw(tools dev bench_driver.pir) );
+
+my @benchmarks = find_benchmarks();
+die "no benchmarks found in $opt{dir}\n" unless @benchmarks;
+
+if ( $opt{list} ) {
+    printf "%-10s %s\n", $_->{category}, $_->{name} for @benchmarks;
+    exit 0;
+}
+
+my %results;
+for my $bench (@benchmarks) {
+    printf STDERR "%-10s %-22s", $bench->{category}, $bench->{name};
+    run_once($bench) for 1 .. $opt{warmup};
+    my @runs = map { run_once($bench) } 1 .. $opt{runs};
+    $results{ $bench->{id} } = summarize( $bench, \@runs );
+    printf STDERR " %s\n", format_time( $results{ $bench->{id} }{median} );
+}
+
+my $report = {
+    parrot     => {
+        version => $PConfig{VERSION},
+        cc      => $PConfig{cc},
+        optimize => $PConfig{optimize},
+        gc      => $PConfig{gc_type},
+        os      => $PConfig{osname},
+        cpu     => $PConfig{cpuarch},
+    },
+    date       => strftime( '%Y-%m-%dT%H:%M:%S', localtime ),
+    runs       => $opt{runs},
+    warmup     => $opt{warmup},
+    benchmarks => \%results,
+};
+
+print_report( \%results );
+
+if ( $opt{json} ) {
+    open my $fh, '>', $opt{json} or die "can't write $opt{json}: $!\n";
+    print $fh JSON::PP->new->canonical->pretty->encode($report);
+    close $fh;
+    print "\nresults written to $opt{json}\n";
+}
+
+if ( $opt{baseline} ) {
+    my $regressions = compare_baseline( \%results, $opt{baseline} );
+    exit( $regressions ? 1 : 0 );
+}
+
+exit 0;
+
+# find the benchmarks to run, sorted by category and name
+sub find_benchmarks {
+    opendir my $dh, $opt{dir} or die "can't open $opt{dir}: $!\n";
+    my @found;
+    for my $file ( sort readdir $dh ) {
+        next unless $file =~ /^([a-z]+)_(\w+)\.pir$/;
+        my %bench = (
+            id       => "$1_$2",
+            category => $1,
+            name     => $2,
+            file     => File::Spec->catfile( $opt{dir}, $file ),
+        );
+        next if @{ $opt{category} } && !grep { $_ eq $bench{category} } @{ $opt{category} };
+        next if @{ $opt{bench} }    && !grep { $bench{id} =~ /$_/ } @{ $opt{bench} };
+        push @found, \%bench;
+    }
+    closedir $dh;
+    return @found;
+}
+
+# run a benchmark once and return a hash of its measurements
+sub run_once {
+    my ($bench) = @_;
+    my $devnull = File::Spec->devnull;
+
+    if ( $bench->{category} eq 'startup' ) {
+        my $start = time;
+        system(qq{"$opt{parrot}" "$bench->{file}" >$devnull 2>&1}) == 0
+            or die "\n$bench->{file} failed\n";
+        return { time => time - $start };
+    }
+
+    my $out = `"$opt{parrot}" "$DRIVER" "$bench->{file}" 2>&1 >$devnull`;
+    die "\n$bench->{file} failed:\n$out" if $?;
+    my ($line) = $out =~ /^BENCH (.*)$/m
+        or die "\n$bench->{file} reported no result:\n$out";
+    return { map { my ( $k, $v ) = split /=/; ( $k, $v + 0 ) } split ' ', $line };
+}
+
+# reduce the runs of a benchmark to the figures that are reported
+sub summarize {
+    my ( $bench, $runs ) = @_;
+    my @times = sort { $a <=> $b } map { $_->{time} } @$runs;
+    my ( $low, $high, $exact ) = median_interval(@times);
+    my $mean = 0;
+    $mean += $_ / @times for @times;
+    my $var = 0;
+    $var += ( $_ - $mean )**2 / ( @times > 1 ? @times - 1 : 1 ) for @times;
+
+    my %summary = (
+        category => $bench->{category},
+        times    => [ map { $_->{time} + 0 } @$runs ],
+        median   => median(@times),
+        ci_low   => $low,
+        ci_high  => $high,
+        ci_exact => $exact ? 1 : 0,
+        mean     => $mean,
+        stddev   => sqrt $var,
+    );
+
+    for my $counter (qw(gc_mark_runs gc_collect_runs mem_alloc total_pmcs)) {
+        next unless defined $runs->[0]{$counter};
+        $summary{$counter} = median( sort { $a <=> $b } map { $_->{$counter} } @$runs ) + 0;
+    }
+
+    return \%summary;
+}
+
+sub median {
+    my @sorted = @_;
+    my $mid    = int( @sorted / 2 );
+    return @sorted % 2 ? $sorted[$mid] : ( $sorted[ $mid - 1 ] + $sorted[$mid] ) / 2;
+}
+
+# A distribution-free 95% confidence interval for the median of sorted
+# samples: the k-th smallest and k-th largest, for the largest k that leaves at
+# most 2.5% probability on each side under Binomial(n, 1/2).
+sub median_interval {
+    my @sorted = @_;
+    my $n      = @sorted;
+    my ( $k, $tail, $term ) = ( 0, 0, 0.5**$n );
+
+    for my $i ( 0 .. $n - 1 ) {
+        last if $tail + $term > 0.025;
+        $tail += $term;
+        $k     = $i + 1;
+        $term  = $term * ( $n - $i ) / ( $i + 1 );
+    }
+
+    return ( $sorted[0], $sorted[-1], 0 ) unless $k;
+    return ( $sorted[ $k - 1 ], $sorted[ $n - $k ], 1 );
+}
+
+sub format_time {
+    my ($seconds) = @_;
+    return sprintf '%8.2fms', $seconds * 1000;
+}
+
+sub print_report {
+    my ($results) = @_;
+    printf "\n%-10s %-22s %10s  %-25s %7s %7s %10s\n",
+        qw(category benchmark median), '95% CI', 'marks', 'sweeps', 'alloc KiB';
+    for my $id ( sort { $results->{$a}{category} cmp $results->{$b}{category} || $a cmp $b }
+        keys %$results )
+    {
+        my $r = $results->{$id};
+        ( my $name = $id ) =~ s/^[a-z]+_//;
+        printf "%-10s %-22s %10s %s[%s,%s] %7s %7s %10s\n",
+            $r->{category}, $name, format_time( $r->{median} ),
+            ( $r->{ci_exact} ? ' ' : '~' ),
+            format_time( $r->{ci_low} ), format_time( $r->{ci_high} ),
+            defined $r->{gc_mark_runs}    ? $r->{gc_mark_runs}    : '-',
+            defined $r->{gc_collect_runs} ? $r->{gc_collect_runs} : '-',
+            defined $r->{mem_alloc} ? int( $r->{mem_alloc} / 1024 ) : '-';
+    }
+}
+
+# print how the results compare with a saved baseline; returns the number of
+# regressions
+sub compare_baseline {
+    my ( $results, $file ) = @_;
+    open my $fh, '<', $file or die "can't read baseline $file: $!\n";
+    my $baseline = JSON::PP::decode_json( do { local $/; <$fh> } )->{benchmarks};
+    close $fh;
+
+    my $limit = $opt{threshold} / 100;
+    my ( $regressions, $improvements ) = ( 0, 0 );
+
+    printf "\ncompared to %s (threshold %g%%):\n", $file, $opt{threshold};
+    for my $id ( sort keys %$results ) {
+        my $old = $baseline->{$id};
+        unless ($old) {
+            printf "  %-32s new\n", $id;
+            next;
+        }
+        my $new    = $results->{$id};
+        my $change = $new->{median} / $old->{median} - 1;
+        my $status = 'same';
+
+        if ( $change > $limit && $new->{ci_low} > $old->{ci_high} ) {
+            $status = 'REGRESSED';
+            $regressions++;
+        }
+        elsif ( $change < -$limit && $new->{ci_high} < $old->{ci_low} ) {
+            $status = 'improved';
+            $improvements++;
+        }
+        printf "  %-32s %+7.1f%%  %s\n", $id, $change * 100, $status;
+    }
+
+    printf "%d regressed, %d improved\n", $regressions, $improvements;
+    return $regressions;
+}
+
+# Local Variables:
+#   mode: cperl
+#   cperl-indent-level: 4
+#   fill-column: 100
+# End:
+# vim: expandtab shiftwidth=4: